@@ -1,28 +1,278 @@
-Import("env")
+"""
+PigeonHub WASM embed step
+
+Compresses pigeonhub_client.wasm into an LZ4 image that PlatformIO links into
+the firmware through board_build.embed_files (objcopy, no custom linker
+flags). The image is inflated straight into the wasm3 parse buffer at boot by
+wasm_image.cpp.
+
+Image layout (little endian):
+    0   4  magic "PHW2"
+    4   4  raw (uncompressed) module size
+    8   8  build ID: first 8 bytes of the module's SHA-256
+   16   n  LZ4 block
+
+The image is only rewritten when the build ID changes, so firmware builds do
+not re-link an unchanged module. The hub reports the ID as "buildId".
+
+Usable both as a PlatformIO pre-script and standalone:
+    python3 embed_wasm.py [input.wasm] [output.lz4]
+
+Signing a module for hot swap (POST /api/module, see module_key.h):
+    python3 embed_wasm.py sign <image.lz4> <key.pem> <out.bin>
+
+`make embed` is the only step that rebuilds the module. It records the
+SHA-256 of pigeonhub_client.c and of the module it built in
+pigeonhub_client.wasm.sha256, committed next to the module:
+    python3 embed_wasm.py stamp <source.c> <module.wasm>
+Without a WASI SDK the PlatformIO build embeds the committed module, and
+fails if that record no longer matches the source.
+"""
+
+import hashlib
 import os
+import struct
+import subprocess
+import sys
+
+IMAGE_MAGIC = b"PHW2"
+BUILD_ID_SIZE = 8
+IMAGE_NAME = "pigeonhub_client.wasm.lz4"
+SIGNATURE_MAGIC = b"PHS1"
+
+# LZ4 block format constraints
+MIN_MATCH = 4
+LAST_LITERALS = 5
+MF_LIMIT = 12
+MAX_OFFSET = 0xFFFF
+
+
+def _write_length(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def _emit_sequence(out, literals, offset, match_len):
+    lit_len = len(literals)
+    token = (min(lit_len, 15) << 4)
+    if offset:
+        token |= min(match_len - MIN_MATCH, 15)
+    out.append(token)
+    if lit_len >= 15:
+        _write_length(out, lit_len - 15)
+    out += literals
+    if offset:
+        out += struct.pack("<H", offset)
+        if match_len - MIN_MATCH >= 15:
+            _write_length(out, match_len - MIN_MATCH - 15)
+
+
+def lz4_compress_block(data):
+    """Greedy single-pass LZ4 block compressor (hash of 4-byte sequences)."""
+    n = len(data)
+    out = bytearray()
+    table = {}
+    anchor = 0
+    i = 0
+    while i < n - MF_LIMIT:
+        key = data[i:i + MIN_MATCH]
+        candidate = table.get(key)
+        table[key] = i
+        if candidate is None or i - candidate > MAX_OFFSET:
+            i += 1
+            continue
+
+        match_len = MIN_MATCH
+        max_len = n - LAST_LITERALS - i
+        while match_len < max_len and data[candidate + match_len] == data[i + match_len]:
+            match_len += 1
+
+        _emit_sequence(out, data[anchor:i], i - candidate, match_len)
+        i += match_len
+        anchor = i
+
+    _emit_sequence(out, data[anchor:], 0, 0)
+    return bytes(out)
+
+
+def lz4_decompress_block(src, raw_size):
+    """Reference decoder, used to verify every image before it is embedded."""
+    out = bytearray()
+    i = 0
+    while i < len(src):
+        token = src[i]
+        i += 1
+        lit_len = token >> 4
+        if lit_len == 15:
+            while True:
+                b = src[i]
+                i += 1
+                lit_len += b
+                if b != 255:
+                    break
+        out += src[i:i + lit_len]
+        i += lit_len
+        if i >= len(src):
+            break
+        offset = src[i] | (src[i + 1] << 8)
+        i += 2
+        match_len = token & 0x0F
+        if match_len == 15:
+            while True:
+                b = src[i]
+                i += 1
+                match_len += b
+                if b != 255:
+                    break
+        match_len += MIN_MATCH
+        start = len(out) - offset
+        for k in range(match_len):
+            out.append(out[start + k])
+    if len(out) != raw_size:
+        raise ValueError("LZ4 round trip size mismatch")
+    return bytes(out)
+
+
+def build_id(raw):
+    return hashlib.sha256(raw).digest()[:BUILD_ID_SIZE]
+
+
+def read_image_build_id(image_path):
+    """Returns the build ID of an existing image, or None."""
+    try:
+        with open(image_path, "rb") as f:
+            header = f.read(8 + BUILD_ID_SIZE)
+    except OSError:
+        return None
+    if len(header) != 8 + BUILD_ID_SIZE or header[:4] != IMAGE_MAGIC:
+        return None
+    return header[8:]
+
+
+def build_image(wasm_path, image_path):
+    with open(wasm_path, "rb") as f:
+        raw = f.read()
+
+    module_id = build_id(raw)
+    if read_image_build_id(image_path) == module_id:
+        print("WASM image up to date (build %s), skipping" % module_id.hex())
+        return
+
+    block = lz4_compress_block(raw)
+    if lz4_decompress_block(block, len(raw)) != raw:
+        raise ValueError("LZ4 round trip mismatch for %s" % wasm_path)
+
+    image = IMAGE_MAGIC + struct.pack("<I", len(raw)) + module_id + block
+    os.makedirs(os.path.dirname(image_path) or ".", exist_ok=True)
+    with open(image_path, "wb") as f:
+        f.write(image)
+
+    saved = len(raw) - len(image)
+    print("Embedding WASM image: %s" % image_path)
+    print("  build ID:    %s" % module_id.hex())
+    print("  raw module:  %6d bytes" % len(raw))
+    print("  LZ4 image:   %6d bytes (%.1f%%)" % (len(image), 100.0 * len(image) / max(len(raw), 1)))
+    print("  flash saved: %6d bytes" % saved)
+
+
+def sign_image(image_path, key_path, out_path):
+    """Appends an ECDSA-P256 signature trailer for upload to POST /api/module.
+
+    Layout: image | DER signature over SHA-256(image) | u16 length (LE) | "PHS1"
+    """
+    with open(image_path, "rb") as f:
+        image = f.read()
+    if image[:4] != IMAGE_MAGIC:
+        raise ValueError("%s is not a WASM image" % image_path)
+
+    sig = subprocess.run(["openssl", "dgst", "-sha256", "-sign", key_path, image_path],
+                         check=True, stdout=subprocess.PIPE).stdout
+    with open(out_path, "wb") as f:
+        f.write(image + sig + struct.pack("<H", len(sig)) + SIGNATURE_MAGIC)
+    print("Signed module: %s (build %s, %d bytes)" % (out_path, image[8:8 + BUILD_ID_SIZE].hex(),
+                                                    len(image) + len(sig) + 6))
+
+
+def _sha256_file(path):
+    with open(path, "rb") as f:
+        return hashlib.sha256(f.read()).hexdigest()
+
+
+def write_stamp(source_path, wasm_path):
+    """Records which source the module was built from (sha256sum format)."""
+    with open(wasm_path + ".sha256", "w") as f:
+        for path in (source_path, wasm_path):
+            f.write("%s  %s\n" % (_sha256_file(path), os.path.basename(path)))
+
+
+def stale_module(source_path, wasm_path, stamp_path):
+    """Returns why wasm_path is not what `make embed` built from source_path, or None."""
+    try:
+        with open(stamp_path) as f:
+            recorded = dict(reversed(line.split()) for line in f if line.strip())
+    except (OSError, ValueError):
+        return "%s is missing or unreadable" % stamp_path
+    if recorded.get(os.path.basename(source_path)) != _sha256_file(source_path):
+        return "%s changed since the module was built" % os.path.basename(source_path)
+    if recorded.get("pigeonhub_client.wasm") != _sha256_file(wasm_path):
+        return "%s is not the module built from it" % wasm_path
+    return None
+
+
+def _make_embed(env, wasm_dir, wasm_file):
+    """Runs `make embed` when the WASI SDK is installed.
+
+    make only recompiles when pigeonhub_client.c or the flags changed, so this
+    is cheap on an unchanged tree. Without the SDK the committed module is
+    embedded as-is, and an out-of-date one stops the build.
+    """
+    sdk = os.environ.get("WASI_SDK_PATH", "/opt/wasi-sdk")
+    if os.path.exists(os.path.join(sdk, "bin", "clang")):
+        subprocess.run(["make", "-C", wasm_dir, "embed", "WASI_SDK_PATH=" + sdk], check=True)
+        return True
+
+    source = os.path.join(wasm_dir, "pigeonhub_client.c")
+    if os.path.exists(source) and os.path.exists(wasm_file):
+        reason = stale_module(source, wasm_file, os.path.join(wasm_dir, "pigeonhub_client.wasm.sha256"))
+        if reason:
+            print("ERROR: the committed WASM module is out of date: %s" % reason)
+            print("Install the WASI SDK (or set WASI_SDK_PATH) and run 'make embed' in %s." % wasm_dir)
+            env.Exit(1)
+    return False
+
+
+def _run_platformio(env):
+    project_dir = env.subst("$PROJECT_DIR")
+    wasm_file = os.path.join(project_dir, "pigeonhub_client.wasm")
+    image_file = os.path.join(project_dir, "embed", IMAGE_NAME)
+
+    # `make embed` rewrites the image itself; otherwise embed what is there
+    if _make_embed(env, os.path.dirname(project_dir), wasm_file):
+        return
+
+    if not os.path.exists(wasm_file):
+        print("ERROR: WASM file not found at %s" % wasm_file)
+        print("Run 'make embed' in embedded/esp32 first.")
+        env.Exit(1)
+
+    build_image(wasm_file, image_file)
+
 
-# Get the project directory
-project_dir = env.subst("$PROJECT_DIR")
-
-# Path to the WASM file
-wasm_file = os.path.join(project_dir, "pigeonhub_client.wasm")
-
-# Check if file exists
-if os.path.exists(wasm_file):
-    print(f"Embedding WASM binary: {wasm_file}")
-    # Add linker flags to embed the binary
-    env.Append(
-        LINKFLAGS=[
-            "-Wl,--embedded-file",
-            f"-Wl,{wasm_file}"
-        ]
-    )
-    # Alternative method using objcopy
-    env.Append(
-        BUILD_FLAGS=[
-            f'-DWASM_BINARY_PATH=\\"{wasm_file}\\"'
-        ]
-    )
+if __name__ == "__main__" and len(sys.argv) > 1 and sys.argv[1] == "sign":
+    if len(sys.argv) != 5:
+        sys.exit("usage: embed_wasm.py sign <image.lz4> <key.pem> <out.bin>")
+    sign_image(sys.argv[2], sys.argv[3], sys.argv[4])
+elif __name__ == "__main__" and len(sys.argv) > 1 and sys.argv[1] == "stamp":
+    if len(sys.argv) != 4:
+        sys.exit("usage: embed_wasm.py stamp <source.c> <module.wasm>")
+    write_stamp(sys.argv[2], sys.argv[3])
+elif __name__ == "__main__":
+    here = os.path.dirname(os.path.abspath(__file__))
+    src = sys.argv[1] if len(sys.argv) > 1 else os.path.join(here, "pigeonhub_client.wasm")
+    dst = sys.argv[2] if len(sys.argv) > 2 else os.path.join(here, "embed", IMAGE_NAME)
+    build_image(src, dst)
 else:
-    print(f"WARNING: WASM file not found at {wasm_file}")
-    print("PigeonHub will compile but WASM functionality will not work!")
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+    _run_platformio(env)  # noqa: F821
@@ -0,0 +1,49 @@
+/*
+ * PigeonHub Admission Throttle
+ */
+
+#include "admission_throttle.h"
+#include <string.h>
+
+static void refill(AdmissionThrottle* throttle, uint32_t now) {
+    uint32_t cap = throttle->burst * 1000;
+    uint32_t elapsed = now - throttle->lastMs;
+    throttle->lastMs = now;
+    // elapsed * rate stays in range for any gap under ~50 days at 1000/s;
+    // a full bucket only needs burst / rate seconds anyway
+    uint64_t credit = throttle->credit + (uint64_t)elapsed * throttle->ratePerSec;
+    throttle->credit = credit > cap ? cap : (uint32_t)credit;
+}
+
+void admissionInit(AdmissionThrottle* throttle, uint32_t ratePerSec, uint32_t burst,
+                   uint32_t pendingMax, uint32_t jitterMs, uint32_t now) {
+    memset(throttle, 0, sizeof(*throttle));
+    throttle->ratePerSec = ratePerSec ? ratePerSec : 1;
+    throttle->burst = burst ? burst : 1;
+    throttle->pendingMax = pendingMax;
+    throttle->jitterMs = jitterMs;
+    throttle->credit = throttle->burst * 1000;
+    throttle->lastMs = now;
+}
+
+bool admissionTry(AdmissionThrottle* throttle, uint32_t now, uint32_t pending,
+                  uint32_t random, uint32_t* retryAfterMs) {
+    refill(throttle, now);
+
+    uint32_t wait = 0;
+    if (pending >= throttle->pendingMax) {
+        // Roughly the time for the backlog to drain at the admission rate
+        wait = (pending - throttle->pendingMax + 1) * 1000 / throttle->ratePerSec;
+        throttle->backlogged++;
+    } else if (throttle->credit < 1000) {
+        wait = (1000 - throttle->credit + throttle->ratePerSec - 1) / throttle->ratePerSec;
+        throttle->deferred++;
+    } else {
+        throttle->credit -= 1000;
+        throttle->admitted++;
+        return true;
+    }
+
+    *retryAfterMs = wait + (throttle->jitterMs ? random % throttle->jitterMs : 0);
+    return false;
+}
@@ -0,0 +1,51 @@
+/*
+ * PigeonHub Admission Throttle
+ *
+ * When the hub or its Wi-Fi comes back, every client reconnects at once. Each
+ * WebSocket upgrade is handled on the same loop that relays signaling, and
+ * each new peer then announces and gets a peer list. Admitting them all in
+ * one burst stalls relaying for everyone.
+ *
+ * New connections are admitted from a token bucket (rate per second, up to
+ * `burst` at once). A connection is also deferred while too many admitted
+ * peers are still between handshake and announce: that count is the hub's
+ * queue of unfinished work. A deferred client is told when to retry, with
+ * jitter so that a storm spreads out instead of coming back in lockstep.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_ADMISSION_THROTTLE_H
+#define PIGEONHUB_ADMISSION_THROTTLE_H
+
+#include <stdint.h>
+
+// The burst is the hub's WebSocket client limit, which depends on the board
+#define ADMIT_RATE         4     // Peers per second, sustained
+#define ADMIT_PENDING_MAX  3     // Connected but not yet announced
+#define ADMIT_JITTER_MS    2000
+
+struct AdmissionThrottle {
+    uint32_t ratePerSec;
+    uint32_t burst;
+    uint32_t pendingMax;   // Admitted peers that haven't announced yet
+    uint32_t jitterMs;     // Added to retry hints, uniformly at random
+
+    uint32_t credit;       // Tokens in thousandths
+    uint32_t lastMs;
+
+    uint32_t admitted;
+    uint32_t deferred;     // Turned away by the rate
+    uint32_t backlogged;   // Turned away by pendingMax
+};
+
+void admissionInit(AdmissionThrottle* throttle, uint32_t ratePerSec, uint32_t burst,
+                   uint32_t pendingMax, uint32_t jitterMs, uint32_t now);
+
+// Returns true to admit a new connection given `pending` unannounced peers.
+// Otherwise *retryAfterMs is how long the client should wait; `random` is
+// any 32-bit random value, used for the jitter.
+bool admissionTry(AdmissionThrottle* throttle, uint32_t now, uint32_t pending,
+                  uint32_t random, uint32_t* retryAfterMs);
+
+#endif // PIGEONHUB_ADMISSION_THROTTLE_H
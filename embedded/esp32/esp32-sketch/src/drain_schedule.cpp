@@ -0,0 +1,41 @@
+/*
+ * PigeonHub Drain Schedule
+ */
+
+#include "drain_schedule.h"
+#include <string.h>
+
+void drainInit(DrainSchedule* drain) {
+    memset(drain, 0, sizeof(*drain));
+}
+
+void drainStart(DrainSchedule* drain, uint32_t now, uint32_t windowMs, uint32_t retrySpreadMs,
+                uint32_t graceMs) {
+    drain->active = true;
+    drain->startMs = now;
+    drain->windowMs = windowMs;
+    drain->retrySpreadMs = retrySpreadMs;
+    drain->graceMs = graceMs;
+}
+
+uint32_t drainCloseIn(DrainSchedule* drain, uint32_t now, uint32_t random) {
+    drain->notified++;
+    uint32_t elapsed = now - drain->startMs;
+    if (elapsed >= drain->windowMs) return 0;
+    return random % (drain->windowMs - elapsed);
+}
+
+uint32_t drainRetryAfter(const DrainSchedule* drain, uint32_t random) {
+    return drain->retrySpreadMs ? random % drain->retrySpreadMs : 0;
+}
+
+uint32_t drainRefuse(DrainSchedule* drain, uint32_t now, uint32_t random) {
+    drain->refused++;
+    uint32_t elapsed = now - drain->startMs;
+    uint32_t left = elapsed < drain->windowMs + drain->graceMs ? drain->windowMs + drain->graceMs - elapsed : 0;
+    return left + drainRetryAfter(drain, random);
+}
+
+bool drainExpired(const DrainSchedule* drain, uint32_t now) {
+    return drain->active && now - drain->startMs >= drain->windowMs + drain->graceMs;
+}
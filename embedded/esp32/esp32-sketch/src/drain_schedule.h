@@ -0,0 +1,60 @@
+/*
+ * PigeonHub Drain Schedule
+ *
+ * Restarting the hub used to drop every connection at once. Every client
+ * then reconnected in the same second, to this hub once it was back or to
+ * whichever hub it tried next. Draining spreads the departures out instead.
+ * New connections are refused. Each connected peer is told its close time,
+ * which is a random point in the drain window. It also gets a random retry
+ * delay after that, and the hubs it could use meanwhile. Each peer is then
+ * closed at its time. Reconnects arrive spread over the window plus the
+ * retry spread instead of in one spike.
+ *
+ * The schedule only hands out times; the caller keeps each peer's close
+ * time and does the closing.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_DRAIN_SCHEDULE_H
+#define PIGEONHUB_DRAIN_SCHEDULE_H
+
+#include <stdint.h>
+
+#define DRAIN_WINDOW_MS        10000  // Peers close at random points over this
+#define DRAIN_RETRY_SPREAD_MS  5000   // Reconnect delay after a peer is closed
+#define DRAIN_GRACE_MS         2000   // Past the window: restart even if peers remain
+
+struct DrainSchedule {
+    bool active;
+    uint32_t startMs;
+    uint32_t windowMs;       // Peers close at random points in this
+    uint32_t retrySpreadMs;  // Retry hints are random in [0, retrySpreadMs)
+    uint32_t graceMs;        // After the window, stop waiting for stragglers
+
+    uint32_t notified;
+    uint32_t closed;
+    uint32_t refused;        // New connections turned away while draining
+};
+
+void drainInit(DrainSchedule* drain);
+
+void drainStart(DrainSchedule* drain, uint32_t now, uint32_t windowMs, uint32_t retrySpreadMs,
+                uint32_t graceMs);
+
+// Delay from now until a connected peer should be closed; `random` is any
+// 32-bit random value
+uint32_t drainCloseIn(DrainSchedule* drain, uint32_t now, uint32_t random);
+
+// How long a peer should wait after being closed (or refused) before
+// reconnecting
+uint32_t drainRetryAfter(const DrainSchedule* drain, uint32_t random);
+
+// Retry hint for a connection refused while draining: past the end of the
+// window, so it doesn't come back to a hub that is about to restart
+uint32_t drainRefuse(DrainSchedule* drain, uint32_t now, uint32_t random);
+
+// True once the window and grace period are over
+bool drainExpired(const DrainSchedule* drain, uint32_t now);
+
+#endif // PIGEONHUB_DRAIN_SCHEDULE_H
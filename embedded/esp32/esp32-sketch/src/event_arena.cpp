@@ -0,0 +1,53 @@
+/*
+ * PigeonHub Event Arena
+ */
+
+#include "event_arena.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void arenaInit(EventArena* arena, void* buf, size_t cap) {
+    memset(arena, 0, sizeof(*arena));
+    arena->base = (uint8_t*)buf;
+    arena->cap = cap;
+}
+
+void* arenaAlloc(EventArena* arena, size_t size) {
+    size_t start = (arena->used + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if (start <= arena->cap && size <= arena->cap - start) {
+        arena->used = start + size;
+        if (arena->used > arena->highWater) arena->highWater = arena->used;
+        return arena->base + start;
+    }
+
+    arena->overflows++;
+    if (arena->spillCount >= ARENA_SPILL_MAX) return NULL;
+    void* p = malloc(size);
+    if (p) arena->spills[arena->spillCount++] = p;
+    return p;
+}
+
+char* arenaPrintf(EventArena* arena, size_t* len, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(NULL, 0, fmt, args);
+    va_end(args);
+    if (n < 0) return NULL;
+
+    char* out = (char*)arenaAlloc(arena, (size_t)n + 1);
+    if (!out) return NULL;
+    va_start(args, fmt);
+    vsnprintf(out, (size_t)n + 1, fmt, args);
+    va_end(args);
+    if (len) *len = (size_t)n;
+    return out;
+}
+
+void arenaReset(EventArena* arena) {
+    for (int i = 0; i < arena->spillCount; i++) free(arena->spills[i]);
+    arena->spillCount = 0;
+    arena->used = 0;
+    arena->resets++;
+}
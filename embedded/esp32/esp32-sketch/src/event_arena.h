@@ -0,0 +1,49 @@
+/*
+ * PigeonHub Event Arena
+ *
+ * Bump allocator for memory that only lives while one WebSocket event is
+ * handled (converted frames, stamped copies, generated replies). Allocation
+ * is a pointer increment and everything is released at once by
+ * arenaReset(), so steady-state relaying doesn't touch the general heap.
+ *
+ * Requests that don't fit spill to malloc and are counted as overflows;
+ * arenaReset() frees those too, so callers never free arena memory.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_EVENT_ARENA_H
+#define PIGEONHUB_EVENT_ARENA_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ARENA_ALIGN      8
+#define ARENA_SPILL_MAX  8   // Heap allocations per event beyond the arena
+
+struct EventArena {
+    uint8_t* base;
+    size_t cap;
+    size_t used;
+    void* spills[ARENA_SPILL_MAX];
+    int spillCount;
+
+    size_t highWater;     // Most bytes used by one event
+    uint32_t resets;
+    uint32_t overflows;   // Requests that spilled to (or failed on) the heap
+};
+
+// buf must stay valid and ARENA_ALIGN aligned for the arena's lifetime
+void arenaInit(EventArena* arena, void* buf, size_t cap);
+
+// Returns NULL only if the arena is full and the spill fails
+void* arenaAlloc(EventArena* arena, size_t size);
+
+// printf into arena memory; returns NULL on failure. *len (optional) gets
+// the length without the terminator.
+char* arenaPrintf(EventArena* arena, size_t* len, const char* fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+
+void arenaReset(EventArena* arena);
+
+#endif // PIGEONHUB_EVENT_ARENA_H
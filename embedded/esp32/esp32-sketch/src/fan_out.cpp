@@ -0,0 +1,48 @@
+/*
+ * PigeonHub Fan-Out
+ */
+
+#include "fan_out.h"
+#include <string.h>
+
+void fanOutInit(FanOut* fan, const WireMsg* msg, const uint8_t* frame, size_t frameLen, uint8_t frameWire) {
+    memset(fan, 0, sizeof(*fan));
+    fan->msg = msg;
+    fan->frame = frame;
+    fan->frameLen = frameLen;
+    fan->frameWire = frameWire;
+}
+
+uint8_t fanOutWire(const FanOut* fan, uint8_t peerWire) {
+    return fan->msg ? peerWire : fan->frameWire;
+}
+
+uint8_t* fanOutBuffer(FanOut* fan, EventArena* arena, uint8_t wire, size_t* len) {
+    if (wire > WIRE_V2) return NULL;
+    if (!fan->framed[wire]) {
+        uint8_t* buf = NULL;
+        size_t dataLen = 0;
+        if (fan->frame && (!fan->msg || fan->frameWire == wire)) {
+            buf = (uint8_t*)arenaAlloc(arena, FAN_OUT_HEADROOM + fan->frameLen);
+            if (buf) {
+                memcpy(buf + FAN_OUT_HEADROOM, fan->frame, fan->frameLen);
+                dataLen = fan->frameLen;
+            }
+        } else if (fan->msg) {
+            size_t cap = wire == WIRE_V2 ? wireEncodedSize(fan->msg) : wireJsonSize(fan->msg) + 1;
+            buf = (uint8_t*)arenaAlloc(arena, FAN_OUT_HEADROOM + cap);
+            if (buf) {
+                uint8_t* data = buf + FAN_OUT_HEADROOM;
+                dataLen = wire == WIRE_V2 ? wireEncode(fan->msg, data, cap)
+                                          : wireRenderJson(fan->msg, (char*)data, cap);
+            }
+            fan->conversions++;
+        }
+        if (!buf || dataLen == 0) return NULL;
+        fan->framed[wire] = buf;
+        fan->framedLen[wire] = dataLen;
+        fan->renders++;
+    }
+    *len = fan->framedLen[wire];
+    return fan->framed[wire];
+}
@@ -0,0 +1,52 @@
+/*
+ * PigeonHub Fan-Out
+ *
+ * One message to many local peers. Each encoding is rendered at most once,
+ * into the event arena behind FAN_OUT_HEADROOM bytes of header room, and
+ * every recipient is sent that same buffer with headerToPayload set: the
+ * WebSockets library writes the frame header into the room (server frames
+ * are unmasked, so the data is never touched) and sends header and data
+ * with one socket write instead of a temporary buffer and a copy.
+ *
+ * With headerToPayload the library takes the start of the room, not the
+ * data: it writes the header at buf + FAN_OUT_HEADROOM - headerSize and
+ * sends from there.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_FAN_OUT_H
+#define PIGEONHUB_FAN_OUT_H
+
+#include "wire_codec.h"
+#include "event_arena.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#define FAN_OUT_HEADROOM  14  // WEBSOCKETS_MAX_HEADER_SIZE
+
+struct FanOut {
+    const WireMsg* msg;    // NULL: the frame goes to everyone unchanged
+    const uint8_t* frame;  // As received, or NULL if built by the hub
+    size_t frameLen;
+    uint8_t frameWire;
+    uint8_t* framed[3];    // Per encoding, rendered on first use: header room, then data
+    size_t framedLen[3];   // Data length, without the room
+
+    uint32_t renders;      // Buffers filled; at most one per encoding
+    uint32_t conversions;  // Renders that had to re-encode msg
+};
+
+void fanOutInit(FanOut* fan, const WireMsg* msg, const uint8_t* frame, size_t frameLen, uint8_t frameWire);
+
+// Encoding a recipient speaking `peerWire` gets: unconverted frames keep
+// their own whatever the receiver speaks
+uint8_t fanOutWire(const FanOut* fan, uint8_t peerWire);
+
+// The buffer for `wire`, rendered into `arena` on first use. Returns the
+// start of the header room (pass it as is, with *len, to sendTXT/sendBIN
+// with headerToPayload); the frame itself starts FAN_OUT_HEADROOM bytes in.
+// NULL if msg can't be rendered or the arena is out of memory.
+uint8_t* fanOutBuffer(FanOut* fan, EventArena* arena, uint8_t wire, size_t* len);
+
+#endif // PIGEONHUB_FAN_OUT_H
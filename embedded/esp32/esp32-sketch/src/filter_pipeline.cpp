@@ -0,0 +1,169 @@
+/*
+ * PigeonHub Filter Pipeline
+ */
+
+#include "filter_pipeline.h"
+#include "m3_env.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void putU32(uint8_t* p, uint32_t v) {
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = (v >> 24) & 0xFF;
+}
+
+static void freePlugin(FilterPlugin* plugin) {
+    if (plugin->runtime) m3_FreeRuntime(plugin->runtime);
+    free(plugin->buf);
+    memset(plugin, 0, sizeof(*plugin));
+}
+
+void filterPipelineInit(FilterPipeline* pipe, FilterClockFn clock) {
+    memset(pipe, 0, sizeof(*pipe));
+    pipe->clock = clock;
+}
+
+M3Result filterPipelineAdd(FilterPipeline* pipe, const char* name, uint8_t* buf, size_t len,
+                           uint32_t cycleBudget, uint32_t memoryBudget) {
+    if (pipe->count >= FILTER_MAX_PLUGINS) {
+        free(buf);
+        return "filter pipeline full";
+    }
+    if (!pipe->env) pipe->env = m3_NewEnvironment();
+    if (!pipe->env) {
+        free(buf);
+        return "failed to create WASM environment";
+    }
+
+    FilterPlugin* plugin = &pipe->plugins[pipe->count];
+    memset(plugin, 0, sizeof(*plugin));
+    plugin->buf = buf;
+    strncpy(plugin->name, name, FILTER_NAME_LEN - 1);
+    plugin->cycleBudget = cycleBudget;
+    plugin->memoryBudget = memoryBudget;
+
+    plugin->runtime = m3_NewRuntime(pipe->env, FILTER_STACK_SIZE, plugin);
+    if (!plugin->runtime) {
+        freePlugin(plugin);
+        return "failed to create WASM runtime";
+    }
+    // Linear memory is allocated at load time, clamped to the budget
+    plugin->runtime->memoryLimit = memoryBudget;
+
+    IM3Module module = NULL;
+    M3Result result = m3_ParseModule(pipe->env, &module, buf, len);
+    if (result) {
+        freePlugin(plugin);
+        return result;
+    }
+    result = m3_LoadModule(plugin->runtime, module);
+    if (result) {
+        m3_FreeModule(module);
+        freePlugin(plugin);
+        return result;
+    }
+
+    IM3Function viewFn = NULL;
+    result = m3_FindFunction(&viewFn, plugin->runtime, "filter_view");
+    if (!result) result = m3_FindFunction(&plugin->filter, plugin->runtime, "filter");
+    if (!result) result = m3_CallV(viewFn);
+    if (!result) result = m3_GetResultsV(viewFn, &plugin->view);
+
+    uint32_t memSize = 0;
+    m3_GetMemory(plugin->runtime, &memSize, 0);
+    if (!result && (plugin->view > memSize || memSize - plugin->view < FILTER_VIEW_SIZE)) {
+        result = "filter view outside plugin memory";
+    }
+    if (result) {
+        freePlugin(plugin);
+        return result;
+    }
+
+    plugin->memoryBytes = memSize;
+    plugin->enabled = true;
+    pipe->count++;
+    return m3Err_none;
+}
+
+void filterPipelineClear(FilterPipeline* pipe) {
+    for (int i = 0; i < pipe->count; i++) {
+        freePlugin(&pipe->plugins[i]);
+    }
+    pipe->count = 0;
+}
+
+static void strike(FilterPlugin* plugin, const char* reason) {
+    plugin->lastError = reason;
+    if (++plugin->strikes >= FILTER_MAX_STRIKES) plugin->enabled = false;
+}
+
+// Writes the view into the plugin's memory; returns false if it no longer fits
+static bool writeView(FilterPlugin* plugin, const FilterMessage* msg) {
+    uint32_t memSize = 0;
+    uint8_t* mem = m3_GetMemory(plugin->runtime, &memSize, 0);
+    if (!mem || plugin->view > memSize || memSize - plugin->view < FILTER_VIEW_SIZE) return false;
+
+    uint8_t* view = mem + plugin->view;
+    size_t room = FILTER_VIEW_SIZE - 24;
+    size_t nsLen = msg->nsLen < room ? msg->nsLen : room;
+    room -= nsLen;
+    size_t typeLen = msg->typeLen < room ? msg->typeLen : room;
+    room -= typeLen;
+    size_t copied = msg->length < room ? msg->length : room;
+
+    putU32(view + 0, msg->direction);
+    putU32(view + 4, msg->peer);
+    putU32(view + 8, msg->length);
+    putU32(view + 12, nsLen);
+    putU32(view + 16, typeLen);
+    putU32(view + 20, copied);
+    memcpy(view + 24, msg->ns, nsLen);
+    memcpy(view + 24 + nsLen, msg->type, typeLen);
+    memcpy(view + 24 + nsLen + typeLen, msg->data, copied);
+    return true;
+}
+
+int filterPipelineRun(FilterPipeline* pipe, const FilterMessage* msg, int* dropper) {
+    for (int i = 0; i < pipe->count; i++) {
+        FilterPlugin* plugin = &pipe->plugins[i];
+        if (!plugin->enabled) continue;
+
+        if (!writeView(plugin, msg)) {
+            plugin->errors++;
+            strike(plugin, "filter view outside plugin memory");
+            continue;
+        }
+
+        uint32_t start = pipe->clock();
+        int32_t verdict = FILTER_PASS;
+        M3Result result = m3_CallV(plugin->filter, plugin->view);
+        if (!result) result = m3_GetResultsV(plugin->filter, &verdict);
+        uint32_t spent = pipe->clock() - start;
+
+        plugin->calls++;
+        plugin->cycles += spent;
+        if (spent > plugin->maxCycles) plugin->maxCycles = spent;
+
+        uint32_t memSize = 0;
+        m3_GetMemory(plugin->runtime, &memSize, 0);
+        plugin->memoryBytes = memSize;
+
+        if (result) {
+            plugin->errors++;
+            strike(plugin, result);
+            continue;  // Fail open
+        }
+        if (plugin->cycleBudget && spent > plugin->cycleBudget) {
+            plugin->overruns++;
+            strike(plugin, "cycle budget exceeded");
+        }
+        if (verdict != FILTER_PASS) {
+            plugin->drops++;
+            if (dropper) *dropper = i;
+            return FILTER_DROP;
+        }
+    }
+    return FILTER_PASS;
+}
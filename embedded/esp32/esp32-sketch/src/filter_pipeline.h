@@ -0,0 +1,106 @@
+/*
+ * PigeonHub Filter Pipeline
+ *
+ * Ordered chain of small WASM filter plugins that see every signaling
+ * message before the hub routes it (namespace allow-lists, payload caps...).
+ * All plugins share one wasm3 environment; each gets its own runtime so its
+ * linear memory can be capped independently.
+ *
+ * Plugin ABI (module "env" imports: none):
+ *   i32 filter_view()        -> address of a buffer of >= FILTER_VIEW_SIZE bytes
+ *   i32 filter(i32 view)     -> FILTER_PASS (0) or FILTER_DROP (non-zero)
+ *
+ * View layout written by the hub (little endian):
+ *   0   u32 direction   (FILTER_FROM_PEER / FILTER_FROM_UPLINK)
+ *   4   u32 peer        (local connection number, 0xFF for the uplink)
+ *   8   u32 length      (full message length)
+ *  12   u32 ns_len
+ *  16   u32 type_len
+ *  20   u32 copied      (message bytes present in the view)
+ *  24   ns, type, message[copied]
+ *
+ * Costs are measured per call (CPU cycles) and per plugin (linear memory).
+ * wasm3 cannot preempt a call, so the cycle budget is enforced after the
+ * fact: a plugin that overruns it (or traps) FILTER_MAX_STRIKES times is
+ * disabled. Disabled or failing plugins pass messages through.
+ *
+ * Depends only on wasm3 - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_FILTER_PIPELINE_H
+#define PIGEONHUB_FILTER_PIPELINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "wasm3.h"
+
+#define FILTER_MAX_PLUGINS   4
+#define FILTER_NAME_LEN      16
+#define FILTER_VIEW_SIZE     512    // Bytes of the view a plugin must provide
+#define FILTER_STACK_SIZE    2048   // wasm3 value stack per plugin
+#define FILTER_MAX_STRIKES   3      // Overruns/traps before a plugin is disabled
+
+#define FILTER_PASS  0
+#define FILTER_DROP  1
+
+#define FILTER_FROM_PEER    0
+#define FILTER_FROM_UPLINK  1
+
+struct FilterMessage {
+    uint8_t direction;
+    uint8_t peer;
+    const char* ns;
+    size_t nsLen;
+    const char* type;
+    size_t typeLen;
+    const uint8_t* data;
+    size_t length;
+};
+
+struct FilterPlugin {
+    char name[FILTER_NAME_LEN];
+    IM3Runtime runtime;
+    IM3Function filter;
+    uint32_t view;      // Address of the view in the plugin's memory
+    uint8_t* buf;       // Module bytes; wasm3 keeps pointers into them
+
+    // Budget
+    uint32_t cycleBudget;   // Per call
+    uint32_t memoryBudget;  // Linear memory bytes (wasm3 memoryLimit)
+
+    // Accounting
+    uint32_t calls;
+    uint32_t drops;
+    uint64_t cycles;
+    uint32_t maxCycles;
+    uint32_t overruns;      // Calls over the cycle budget
+    uint32_t errors;        // Traps
+    uint32_t strikes;       // overruns + errors; disabled at FILTER_MAX_STRIKES
+    uint32_t memoryBytes;
+    bool enabled;
+    const char* lastError;  // Static string
+};
+
+typedef uint32_t (*FilterClockFn)();
+
+struct FilterPipeline {
+    IM3Environment env;
+    FilterClockFn clock;
+    FilterPlugin plugins[FILTER_MAX_PLUGINS];
+    int count;
+};
+
+void filterPipelineInit(FilterPipeline* pipe, FilterClockFn clock);
+
+// Appends a plugin. Takes ownership of buf (malloc'd) on success and on failure.
+M3Result filterPipelineAdd(FilterPipeline* pipe, const char* name, uint8_t* buf, size_t len,
+                           uint32_t cycleBudget, uint32_t memoryBudget);
+
+// Removes every plugin; the shared environment is kept
+void filterPipelineClear(FilterPipeline* pipe);
+
+// Runs the message through each enabled plugin in order. Returns FILTER_DROP
+// with *dropper set to the plugin index if one rejects it.
+int filterPipelineRun(FilterPipeline* pipe, const FilterMessage* msg, int* dropper);
+
+#endif // PIGEONHUB_FILTER_PIPELINE_H
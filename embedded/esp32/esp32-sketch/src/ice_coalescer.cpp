@@ -0,0 +1,139 @@
+/*
+ * PigeonHub ICE Candidate Coalescer
+ */
+
+#include "ice_coalescer.h"
+#include <string.h>
+
+void iceCoalescerInit(IceCoalescer* ice, uint32_t windowMs, IceFlushFn flush) {
+    memset(ice, 0, sizeof(*ice));
+    ice->windowMs = windowMs;
+    ice->flush = flush;
+}
+
+static IceBatch* findBatch(IceCoalescer* ice, uint8_t to, const uint8_t* from) {
+    for (int i = 0; i < ICE_BATCH_SLOTS; i++) {
+        IceBatch* batch = &ice->batches[i];
+        if (batch->open && batch->to == to && memcmp(batch->from, from, WIRE_PEER_ID_LEN) == 0) {
+            return batch;
+        }
+    }
+    return NULL;
+}
+
+// Sends what is queued and leaves the window open but empty
+static void flushBatch(IceCoalescer* ice, IceBatch* batch) {
+    if (batch->count == 0) return;
+
+    WireMsg msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.flags = WIRE_FLAG_FROM | WIRE_FLAG_TARGET;
+    msg.timestamp = batch->timestamp;
+    memcpy(msg.from, batch->from, WIRE_PEER_ID_LEN);
+    memcpy(msg.target, batch->target, WIRE_PEER_ID_LEN);
+    msg.ns = batch->ns;
+    msg.nsLen = strlen(batch->ns);
+
+    if (batch->count == 1) {
+        msg.type = WIRE_ICE_CANDIDATE;
+        msg.blob = batch->data + 1;
+        msg.blobLen = batch->len - 1;
+    } else {
+        batch->data[batch->len] = ']';  // Room is reserved in iceCoalescerOffer
+        msg.type = WIRE_ICE_CANDIDATES;
+        msg.blob = batch->data;
+        msg.blobLen = batch->len + 1;
+        ice->merged += batch->count;
+        ice->messages++;
+    }
+    ice->flush(batch->to, &msg);
+
+    batch->count = 0;
+    batch->len = 0;
+}
+
+static void closeBatch(IceCoalescer* ice, IceBatch* batch) {
+    flushBatch(ice, batch);
+    batch->open = false;
+}
+
+bool iceCoalescerOffer(IceCoalescer* ice, uint8_t to, const WireMsg* msg, uint32_t now) {
+    if (!(msg->flags & WIRE_FLAG_FROM)) return false;
+    IceBatch* batch = findBatch(ice, to, msg->from);
+
+    // Anything other than a plain candidate (answer, verbatim JSON...) must
+    // not overtake what is queued
+    bool mergeable = msg->type == WIRE_ICE_CANDIDATE && !(msg->flags & WIRE_FLAG_RAW) &&
+                     (msg->flags & WIRE_FLAG_TARGET) && msg->nsLen < NAMESPACE_NAME_LEN;
+    if (!mergeable) {
+        if (batch) closeBatch(ice, batch);
+        return false;
+    }
+    ice->candidates++;
+
+    if (batch && now - batch->openedMs >= ice->windowMs) {
+        closeBatch(ice, batch);
+        batch = NULL;
+    }
+
+    // First candidate: send it now and open the window
+    if (!batch) {
+        for (int i = 0; i < ICE_BATCH_SLOTS; i++) {
+            if (!ice->batches[i].open) {
+                batch = &ice->batches[i];
+                memset(batch, 0, offsetof(IceBatch, data));
+                batch->open = true;
+                batch->to = to;
+                memcpy(batch->from, msg->from, WIRE_PEER_ID_LEN);
+                batch->openedMs = now;
+                break;
+            }
+        }
+        return false;
+    }
+
+    // Separator plus closing bracket must fit; otherwise send what we have first
+    bool sameRoute = memcmp(batch->target, msg->target, WIRE_PEER_ID_LEN) == 0 &&
+                     strlen(batch->ns) == msg->nsLen && memcmp(batch->ns, msg->ns, msg->nsLen) == 0;
+    if (batch->count > 0 && !sameRoute) flushBatch(ice, batch);
+    if (msg->blobLen + 2 > ICE_BATCH_BYTES - batch->len) {
+        flushBatch(ice, batch);
+        if (msg->blobLen + 2 > ICE_BATCH_BYTES) return false;
+    }
+
+    if (batch->count == 0) {
+        memcpy(batch->target, msg->target, WIRE_PEER_ID_LEN);
+        memcpy(batch->ns, msg->ns, msg->nsLen);
+        batch->ns[msg->nsLen] = '\0';
+    }
+    batch->data[batch->len++] = batch->count == 0 ? '[' : ',';
+    memcpy(batch->data + batch->len, msg->blob, msg->blobLen);
+    batch->len += msg->blobLen;
+    batch->timestamp = msg->timestamp;
+    batch->count++;
+
+    if (batch->count >= ICE_BATCH_MAX) flushBatch(ice, batch);
+    return true;
+}
+
+void iceCoalescerFlush(IceCoalescer* ice, uint8_t to, const uint8_t* from) {
+    IceBatch* batch = findBatch(ice, to, from);
+    if (batch) closeBatch(ice, batch);
+}
+
+void iceCoalescerPoll(IceCoalescer* ice, uint32_t now) {
+    for (int i = 0; i < ICE_BATCH_SLOTS; i++) {
+        IceBatch* batch = &ice->batches[i];
+        if (batch->open && now - batch->openedMs >= ice->windowMs) {
+            closeBatch(ice, batch);
+        }
+    }
+}
+
+void iceCoalescerDrop(IceCoalescer* ice, uint8_t to) {
+    for (int i = 0; i < ICE_BATCH_SLOTS; i++) {
+        if (ice->batches[i].open && ice->batches[i].to == to) {
+            ice->batches[i].open = false;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * PigeonHub ICE Candidate Coalescer
+ *
+ * Trickle ICE sends bursts of small ice-candidate messages for the same peer
+ * pair within milliseconds. For receivers that understand it, the hub merges
+ * them into one "ice-candidates" message whose data is the JSON array of the
+ * individual candidate data values.
+ *
+ * The first candidate for a pair is always sent immediately and opens a
+ * window. Candidates arriving inside the window are queued and go out as one
+ * message when the window closes, ICE_BATCH_MAX are queued, or any other
+ * message for the same pair has to be sent (so ordering is preserved).
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_ICE_COALESCER_H
+#define PIGEONHUB_ICE_COALESCER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "wire_codec.h"
+#include "namespace_table.h"
+
+#define ICE_BATCH_SLOTS  8     // Peer pairs with an open window
+#define ICE_BATCH_BYTES  1024  // Queued candidate data per pair
+#define ICE_BATCH_MAX    8     // Candidates per merged message
+
+// Sends a merged (or single) candidate message to local connection `to`
+typedef void (*IceFlushFn)(uint8_t to, const WireMsg* msg);
+
+struct IceBatch {
+    bool open;
+    uint8_t to;
+    uint8_t from[WIRE_PEER_ID_LEN];
+    uint8_t target[WIRE_PEER_ID_LEN];
+    char ns[NAMESPACE_NAME_LEN];
+    uint32_t openedMs;
+    uint64_t timestamp;  // Of the newest queued candidate
+    uint8_t count;
+    size_t len;
+    uint8_t data[ICE_BATCH_BYTES];  // "[c1,c2,..." without the closing bracket
+};
+
+struct IceCoalescer {
+    IceBatch batches[ICE_BATCH_SLOTS];
+    uint32_t windowMs;
+    IceFlushFn flush;
+
+    uint32_t candidates;  // Offered for coalescing
+    uint32_t merged;      // Candidates that went out inside a merged message
+    uint32_t messages;    // Merged messages sent
+};
+
+void iceCoalescerInit(IceCoalescer* ice, uint32_t windowMs, IceFlushFn flush);
+
+// Offers a message headed for local connection `to`. Returns true if it was
+// queued; otherwise the caller sends it now (anything queued for the same
+// pair has already been flushed ahead of it).
+bool iceCoalescerOffer(IceCoalescer* ice, uint8_t to, const WireMsg* msg, uint32_t now);
+
+// Sends anything queued from `from` to `to` and closes its window
+void iceCoalescerFlush(IceCoalescer* ice, uint8_t to, const uint8_t* from);
+
+// Flushes windows that have expired
+void iceCoalescerPoll(IceCoalescer* ice, uint32_t now);
+
+// Discards everything queued for connection `to`
+void iceCoalescerDrop(IceCoalescer* ice, uint8_t to);
+
+#endif // PIGEONHUB_ICE_COALESCER_H
@@ -23,10 +23,43 @@
 #include <DNSServer.h>
 #include <ESPmDNS.h>
 #include <esp_efuse.h>
+#include <esp_system.h>
+#include <esp_attr.h>
+#include <esp_heap_caps.h>
 #include <mbedtls/sha1.h>
+#include <mbedtls/sha256.h>
+#include <mbedtls/pk.h>
+#include <mbedtls/platform.h>
+#include <mbedtls/md.h>
+#include <mbedtls/md5.h>
+#include <mbedtls/base64.h>
+#include <lwip/sockets.h>
 #include "wasm3.h"
 #include "m3_env.h"
 #include "wasm_data.h"
+#include "wasm_image.h"
+#include "namespace_table.h"
+#include "warm_state.h"
+#include "wasm_slot.h"
+#include "module_key.h"
+#include "filter_pipeline.h"
+#include "wire_codec.h"
+#include "ice_coalescer.h"
+#include "event_arena.h"
+#include "ram_budget.h"
+#include "mem_policy.h"
+#include "peer_directory.h"
+#include "admission_throttle.h"
+#include "stun_server.h"
+#include "turn_relay.h"
+#include "xor_distance.h"
+#include "remote_peer_cache.h"
+#include "uplink_mux.h"
+#include "namespace_usage.h"
+#include "signal_timing.h"
+#include "drain_schedule.h"
+#include "uplink_backoff.h"
+#include "fan_out.h"
 
 // WASM3 Error Handling Macro
 #define _(call) { M3Result res = call; if (res) { result = res; goto _catch; } }
@@ -43,6 +76,8 @@ const char* AP_PASSWORD = "pigeonhub123";  // At least 8 characters
 const int SERVER_PORT = 3000;
 const int MAX_CONNECTIONS = 20;
 const int DNS_PORT = 53;
+const int STUN_PORT = STUN_PORT_DEFAULT;  // STUN and TURN, see STUN and TURN
+const uint32_t TURN_CREDENTIAL_TTL_S = 3600;  // Short-term TURN credentials, see STUN and TURN
 
 // PigeonHub Configuration - THIS IS A HUB SERVER!
 const char* HUB_MESH_NAMESPACE = "pigeonhub-mesh";
@@ -61,48 +96,466 @@ bool is_sta_connected = false;
 // WebSocket Server & Web Server
 // ============================================================================
 
-WebSocketsServer webSocket = WebSocketsServer(SERVER_PORT);
-WebSocketsClient bootstrapHub;  // Connection to bootstrap hub
+// Offers the v2 binary subprotocol; clients that don't ask for it stay on JSON
+class HubSocketServer : public WebSocketsServer {
+public:
+    HubSocketServer(uint16_t port) : WebSocketsServer(port, "", WIRE_V2_PROTOCOL) {}
+
+    // Sec-WebSocket-Protocol list the client sent in its handshake
+    bool clientRequested(uint8_t num, const char* protocol) {
+        return num < WEBSOCKETS_SERVER_CLIENT_MAX && _clients[num].cProtocol.indexOf(protocol) >= 0;
+    }
+
+    // One frame of a fragmented message (opcode WSop_continuation after the first)
+    bool sendFragment(uint8_t num, WSopcode_t opcode, uint8_t* payload, size_t length, bool fin) {
+        return num < WEBSOCKETS_SERVER_CLIENT_MAX && sendFrame(&_clients[num], opcode, payload, length, fin);
+    }
+};
+
+// Bootstrap uplink; exposes fragment sends for the streaming relay
+class UplinkClient : public WebSocketsClient {
+public:
+    bool sendFragment(WSopcode_t opcode, uint8_t* payload, size_t length, bool fin) {
+        return sendFrame(&_client, opcode, payload, length, fin);
+    }
+};
+
+HubSocketServer webSocket(SERVER_PORT);
+UplinkClient bootstrapHub;  // Connection to bootstrap hub
 WebServer webServer(80);
 DNSServer dnsServer;
 
-// Bootstrap hub state
-bool bootstrapConnected = false;
-unsigned long lastBootstrapAttempt = 0;
-const unsigned long BOOTSTRAP_RETRY_INTERVAL = 10000;  // 10 seconds
+// Bootstrap hub state (see Uplink below)
+enum UplinkState {
+    UPLINK_IDLE,        // No WiFi
+    UPLINK_CONNECTING,  // Connect issued, waiting for the WebSocket to open
+    UPLINK_READY,       // Open and announced
+    UPLINK_BACKOFF      // Lost or failed; retrying after uplinkBackoff.retryMs
+};
+const char* UPLINK_STATE_NAMES[] = {"idle", "connecting", "ready", "backoff"};
+UplinkState uplinkState = UPLINK_IDLE;
+unsigned long uplinkSince = 0;  // When the current state was entered
+UplinkBackoff uplinkBackoff;    // Retry timing (see uplink_backoff.h)
+uint32_t uplinkConnects = 0;
+uint32_t uplinkDrops = 0;
+// Connect to open: DNS, TCP, the full TLS handshake and the WebSocket upgrade
+uint32_t uplinkHandshakeMsLast = 0;
+uint32_t uplinkHandshakeMsTotal = 0;
+uint32_t uplinkHandshakeMsMax = 0;
+const uint32_t UPLINK_CONNECT_TIMEOUT_MS = 15000;
+
+// Cost of whole frames sent to the bootstrap hub. Record encryption is
+// mbedtls on the loop task; with CONFIG_MBEDTLS_HARDWARE_AES the block
+// cipher runs on the AES peripheral, otherwise in software.
+struct UplinkTlsStats {
+    uint32_t records;  // One per frame (see sendUplinkFrame)
+    uint32_t bytes;
+    uint32_t us;       // In the send call: framing, encryption and the socket write
+};
+UplinkTlsStats uplinkTls = {0};
+#if CONFIG_MBEDTLS_HARDWARE_AES
+const char* UPLINK_TLS_CRYPTO = "hardware";
+#else
+const char* UPLINK_TLS_CRYPTO = "software";
+#endif
+
+// Frames waiting for the uplink, per namespace and priority (see uplink_mux.h)
+UplinkMux uplinkMux;
+String bootstrapHost = "pigeonhub.fly.dev";  // Overridden by the last good uplink on warm boot
+uint16_t bootstrapPort = 443;  // WSS uses 443
 
 // Connection tracking
 struct Connection {
     uint8_t num;
     int peer_id;  // Internal numeric ID
     String clientPeerId;  // Client's 40-char hex peer ID
-    String networkName;  // Client's network namespace from announce
+    int nsId;  // Client's network namespace from announce (index into namespaces)
+    uint8_t wire;  // WIRE_V1 (JSON text) or WIRE_V2 (binary), fixed at handshake
+    uint8_t rawPeerId[WIRE_PEER_ID_LEN];  // clientPeerId decoded, for v2 routing
+    bool iceBatch;  // Announced "ice-candidates" support (merged candidates)
+    uint8_t discoveryK;  // Announced "discoveryK": introduce only the K closest peers, 0 = all
+    bool hopStamps;  // Announced "hop-timestamps": relayed v1 signaling carries a "hop" field
+    bool draining;  // Scheduled to be closed at drainAtMs
+    unsigned long drainAtMs;
+    bool announced;
     bool active;
+    unsigned long connectedMs;
     unsigned long last_seen;
 };
 
 Connection connections[MAX_CONNECTIONS];
 int next_peer_id = 1;
 
+// Binary peer ID -> index into connections, for routing
+PeerDirectory peerDirectory;
+static_assert(MAX_CONNECTIONS <= PEER_DIR_SLOTS * 3 / 4, "peer directory too small for MAX_CONNECTIONS");
+
+// Top-K discovery (see Connection Management): smaller requests are raised
+// to DISCOVERY_K_MIN. With a fifth of a full namespace (MAX_CONNECTIONS
+// peers) leaving, K=3 cuts off 0.7% of the rest and K=4 0.08%.
+static_assert(MAX_CONNECTIONS <= DISCOVERY_K_MESH, "DISCOVERY_K_MIN not checked for this many peers");
+static_assert(XOR_ID_LEN == WIRE_PEER_ID_LEN, "XOR distance and wire peer IDs differ");
+
+struct DiscoveryStats {
+    uint32_t topK;           // Announces that asked for a K
+    uint32_t introductions;  // peer-discovered messages sent for announces
+    uint32_t skipped;        // Introductions top-K left out
+};
+DiscoveryStats discoveryStats = {0};
+
+// Signaling latency (see signal_timing.h). decodeFrame() notes when the
+// frame being handled arrived.
+SignalTiming signalTiming;
+const uint32_t SIGNAL_PAIR_IDLE_MS = 10000;  // Quiet this long: setup is over
+unsigned long frameRxUs = 0;
+unsigned long frameRxMs = 0;
+
+// Peers on other hubs, from the bootstrap hub's peer-discovered messages,
+// for introducing to local peers that join later
+RemotePeerCache remotePeers;
+const uint32_t REMOTE_PEER_TTL_MS = 120000;
+static_assert(REMOTE_CACHE_ID_LEN == WIRE_PEER_ID_LEN, "remote peer cache and wire peer IDs differ");
+
+// Reconnect storms: new peers are admitted at a steady rate, and not while
+// too many admitted ones have yet to announce (see admission_throttle.h)
+AdmissionThrottle admission;
+const uint32_t ADMIT_BURST = WEBSOCKETS_SERVER_CLIENT_MAX;
+const uint32_t ADMIT_PENDING_WINDOW_MS = 5000;   // Silent longer than this: no longer counted
+
+// Restarts close peers over a window instead of all at once (see
+// drain_schedule.h)
+DrainSchedule drain;
+
+// STUN Binding responder and TURN relay on one non-blocking UDP socket
+// (-1 if it failed to open); each TURN allocation has a relay socket too
+int stunSocket = -1;
+StunStats stunStats = {0};
+TurnRelay turnRelay;
+int turnSockets[TURN_MAX_ALLOCATIONS];  // -1 when the slot has none, set in startStun()
+const int UDP_DATAGRAM_MAX = 1472;  // Longer datagrams are dropped
+const int UDP_POLL_BATCH = 8;       // Datagrams per socket per loop()
+const int TURN_ALLOCATIONS = 2;     // Each holds an lwIP socket
+const int TURN_PER_NAMESPACE = 1;
+const uint32_t TURN_BYTES_PER_SEC = 64 * 1024;  // Per namespace
+const uint32_t TURN_BURST = 16 * 1024;
+static_assert(TURN_ALLOCATIONS <= TURN_MAX_ALLOCATIONS, "TURN_ALLOCATIONS exceeds turn_relay.h");
+uint32_t udpOversize = 0;           // Datagrams over UDP_DATAGRAM_MAX
+
+// Long-term TURN password, generated once per device and kept in NVS
+// ("turn"/"secret"). It also signs the short-term credentials announced
+// peers receive.
+String turnSecret = "";
+
+// Shared receive buffer; TURN writes relay headers into the headroom. One
+// byte more than UDP_DATAGRAM_MAX is read, so longer datagrams show up as
+// such instead of being silently cut.
+uint8_t udpBuffer[TURN_HEADROOM + UDP_DATAGRAM_MAX + 4];
+
+// Interned network namespaces
+NamespaceTable namespaces;
+
+// Who generates the traffic, per namespace slot (see namespace_usage.h)
+NamespaceUsage nsUsage;
+const int NS_USAGE_TOP_DEFAULT = 5;
+
+// Wire protocol cost, per encoding (index WIRE_V1 / WIRE_V2)
+struct WireStats {
+    uint32_t framesIn[3];
+    uint32_t bytesIn[3];
+    uint32_t decodeUs[3];   // Total time to turn frames into WireMsg
+    uint32_t framesOut[3];
+    uint32_t bytesOut[3];
+    uint32_t encodeUs[3];   // Total time spent converting for the receiver
+    uint32_t converted[3];  // Frames that had to be converted to this encoding
+    uint32_t v2AsJsonBytes; // What the v2 frames sent would have cost as JSON
+
+    // Fragmented messages from local peers (see Streaming Relay)
+    uint32_t streamsCut;         // Forwarded fragment by fragment
+    uint32_t streamsReassembled; // Routing fields not up front, or needed conversion
+    uint32_t streamsAborted;     // Sender vanished or stalled mid-message
+    uint32_t streamBytes;
+    uint32_t framesHeld;         // Sends delayed behind a stream to the same receiver
+
+    // One message to many local peers (see FanOut)
+    uint32_t fanOuts;
+    uint32_t fanOutSends;
+    uint32_t fanOutRenders;      // Encodings rendered; at most two per fan-out
+};
+
+WireStats wireStats = {0};
+
+// Transient memory for the event being handled on the loop task; reset when
+// the outermost EventScope ends
+const size_t EVENT_ARENA_SIZE = 8 * 1024;
+alignas(ARENA_ALIGN) uint8_t eventArenaBuf[EVENT_ARENA_SIZE];
+EventArena eventArena;
+int eventDepth = 0;
+
+struct EventScope {
+    EventScope() { eventDepth++; }
+    ~EventScope() {
+        if (--eventDepth == 0) arenaReset(&eventArena);
+    }
+};
+
+// Trickle ICE coalescing toward local peers that support it
+IceCoalescer iceCoalescer;
+const uint32_t ICE_BATCH_WINDOW_MS = 20;
+
+// Placement of bulk buffers (see Memory Placement)
+MemPolicy memPolicy;
+const size_t MEM_BULK_MIN = 256;
+const size_t PSRAM_MALLOC_MIN = 2048;  // Library mallocs this big (WebSocket payloads, long Strings) go to PSRAM
+
+// ============================================================================
+// Warm-Restart State
+// ============================================================================
+
+// Survives watchdog/panic/software resets and OTA reboots (not power loss)
+RTC_NOINIT_ATTR uint8_t rtcWarmBlob[WARM_STATE_BLOB_SIZE];
+
+HubCounters hubCounters = {0};
+bool warmBoot = false;
+unsigned long lastWarmSave = 0;
+const unsigned long WARM_SAVE_INTERVAL = 1000;  // 1 second
+
 // ============================================================================
 // WASM3 Runtime
 // ============================================================================
 
-IM3Environment wasm_env = NULL;
-IM3Runtime wasm_runtime = NULL;
-IM3Module wasm_module = NULL;
+// Two runtime slots: the active one serves while a replacement module is
+// parsed and initialized in the other (see Module Hot Swap below)
+WasmSlot wasmSlots[2];
+WasmSlot* activeWasm = NULL;
+#ifdef BOARD_HAS_PSRAM
+const uint32_t WASM_STACK_SIZE = 32 * 1024;
+const uint32_t WASM_MEMORY_MAX = 256 * 1024;  // The module's declared maximum (Makefile)
+const size_t WASM_MODULE_MAX = 24 * 1024;     // Inflated module bytes
+#else
+// Internal RAM only. The module's shadow stack ends ~70 KB into linear
+// memory (Makefile layout), so 80 KB still leaves it a small heap.
+const uint32_t WASM_STACK_SIZE = 16 * 1024;
+const uint32_t WASM_MEMORY_MAX = 80 * 1024;
+const size_t WASM_MODULE_MAX = 12 * 1024;
+#endif
+
+// Request body collected from WebServer raw upload callbacks
+struct UploadBuffer {
+    uint8_t* data;
+    size_t len;
+    size_t cap;
+};
+
+// Module hot swap
+enum ModuleSwapState { SWAP_IDLE, SWAP_RECEIVING, SWAP_PREPARING, SWAP_READY };
+volatile ModuleSwapState swapState = SWAP_IDLE;
+WasmSlot* swapStandby = NULL;
+UploadBuffer moduleUpload = {0};
+const char* swapError = NULL;  // Last failure (static string), reported by GET /api/module
+const char* moduleUploadError = "no module received";
+uint32_t swapCount = 0;
+unsigned long lastSwapPauseUs = 0;
+#ifdef BOARD_HAS_PSRAM
+const bool MODULE_HOT_SWAP = true;
+const size_t MODULE_UPLOAD_MAX = 128 * 1024;
+#else
+const bool MODULE_HOT_SWAP = false;  // No room for a second slot
+const size_t MODULE_UPLOAD_MAX = 0;
+#endif
+const uint32_t MODULE_PREPARE_STACK = 16 * 1024;
+
+// Filter plugins (ordered by NVS slot, see Filter Plugins below)
+FilterPipeline filters;
+int filterSlots[FILTER_MAX_PLUGINS];  // NVS slot of each loaded plugin
+const char* filterLoadErrors[FILTER_MAX_PLUGINS] = {NULL};
+UploadBuffer pluginUpload = {0};
+const char* pluginUploadError = "no plugin received";
+const uint32_t FILTER_DEFAULT_CYCLES = 240000;  // ~1 ms at 240 MHz
+const uint32_t FILTER_DEFAULT_MEMORY = 4096;
+const size_t PLUGIN_UPLOAD_MAX = 16 * 1024;
+const uint32_t FILTER_MEMORY_MAX = 16 * 1024;  // Per plugin; the "memory" upload argument is clamped to it
+const size_t FILTER_MODULE_MAX = 4 * 1024;
+#ifdef BOARD_HAS_PSRAM
+const int FILTER_PLUGIN_SLOTS = FILTER_MAX_PLUGINS;
+#else
+const int FILTER_PLUGIN_SLOTS = 0;
+#endif
 
-// WASM function pointers
-IM3Function wasm_init = NULL;
-IM3Function wasm_start_server = NULL;
-IM3Function wasm_on_peer_connected = NULL;
-IM3Function wasm_on_peer_disconnected = NULL;
-IM3Function wasm_on_message = NULL;
-IM3Function wasm_loop = NULL;
+// Fragmented messages from local peers, indexed by sender (see Streaming Relay)
+struct StreamRelay {
+    bool active;
+    bool cut;              // Forwarding fragments as they arrive; else reassembling
+    uint8_t dest;          // Local client num, STREAM_UPLINK or STREAM_NOWHERE
+    uint8_t wire;
+    bool stamp;            // v1 without fromPeerId: add it before the closing brace
+    int destNs;            // Namespace the forwarded bytes are counted to
+    unsigned long startedMs;
+    UploadBuffer buf;      // Reassembly only
+};
 
-// WASM binary is included from wasm_data.h
-extern const uint8_t pigeonhub_wasm_data[];
-extern const size_t pigeonhub_wasm_size;
+// Copy of a frame for a receiver that is in the middle of a streamed message
+struct HeldFrame {
+    uint8_t dest;
+    bool binary;
+    uint8_t* data;
+    size_t len;
+};
+
+const uint8_t STREAM_UPLINK = 0xFF;
+const uint8_t STREAM_NOWHERE = 0xFE;  // Dropped by a filter, or the receiver left
+#ifdef BOARD_HAS_PSRAM
+const size_t STREAM_REASSEMBLY_MAX = 16 * 1024;
+const size_t STREAM_HOLD_BYTES = 16 * 1024;  // All held frames together
+const size_t UPLINK_QUEUE_MAX = 16 * 1024;   // Uplink backlog, all streams together
+#else
+const size_t STREAM_REASSEMBLY_MAX = 2 * 1024;
+const size_t STREAM_HOLD_BYTES = 4 * 1024;
+const size_t UPLINK_QUEUE_MAX = 4 * 1024;
+#endif
+const uint32_t STREAM_TIMEOUT_MS = 5000;
+const int STREAM_HOLD_MAX = 8;
+StreamRelay streams[WEBSOCKETS_SERVER_CLIENT_MAX];
+HeldFrame heldFrames[STREAM_HOLD_MAX];
+int heldCount = 0;
+size_t heldBytes = 0;
+
+// ============================================================================
+// RAM Budget
+// ============================================================================
+//
+// Worst case: every client connected, two module slots during a swap, every
+// plugin slot filled, every sender reassembling and both uploads in flight.
+// The build fails if this doesn't fit the board (see ram_budget.h); setup()
+// prints the breakdown. Add an item here for anything new that scales with
+// configuration. -DRAM_BUDGET_WARN_ONLY turns the failure into a boot-time
+// warning, for reading the breakdown on a board that doesn't fit.
+
+const size_t WASM_SLOTS_USED = MODULE_HOT_SWAP ? 2 : 1;
+
+constexpr RamItem RAM_BUDGET[] = {
+    {"peer records",        sizeof(connections) + sizeof(namespaces) + sizeof(peerDirectory), false},
+    {"namespace usage",     sizeof(nsUsage), false},
+    {"signal timing",       sizeof(signalTiming), false},
+    {"remote peer cache",   sizeof(remotePeers), false},
+    {"websocket clients",   WEBSOCKETS_SERVER_CLIENT_MAX * RAM_WS_CLIENT, false},
+    {"websocket frame",     WEBSOCKETS_MAX_DATA_SIZE, true},
+    {"uplink TLS",          RAM_TLS_SESSION, false},
+    {"uplink TLS records",  RAM_TLS_RECORDS, true},
+    {"web portal",          RAM_WEB_PORTAL, false},
+    {"event arena",         sizeof(eventArenaBuf), false},
+    {"ICE batches",         sizeof(iceCoalescer), false},
+    {"STUN/TURN",           sizeof(turnRelay) + sizeof(udpBuffer), false},
+    {"stream records",      sizeof(streams) + sizeof(heldFrames), false},
+    {"stream reassembly",   WEBSOCKETS_SERVER_CLIENT_MAX * STREAM_REASSEMBLY_MAX, true},
+    {"held frames",         STREAM_HOLD_BYTES, true},
+    {"uplink streams",      sizeof(uplinkMux), false},
+    {"uplink backlog",      UPLINK_QUEUE_MAX, true},
+    {"WASM stacks",         WASM_SLOTS_USED * WASM_STACK_SIZE, true},
+    {"WASM linear memory",  WASM_SLOTS_USED * WASM_MEMORY_MAX, true},
+    {"WASM modules",        WASM_SLOTS_USED * WASM_MODULE_MAX, true},
+    {"WASM compiled code",  WASM_SLOTS_USED * WASM_MODULE_MAX * RAM_WASM_CODE_FACTOR, false},
+    {"module upload",       MODULE_UPLOAD_MAX, true},
+    {"module prepare task", MODULE_HOT_SWAP ? MODULE_PREPARE_STACK : 0, false},
+    {"plugin runtimes",     FILTER_PLUGIN_SLOTS * (FILTER_STACK_SIZE + FILTER_MODULE_MAX * (1 + RAM_WASM_CODE_FACTOR)), false},
+    {"plugin memory",       FILTER_PLUGIN_SLOTS * FILTER_MEMORY_MAX, true},
+    {"plugin upload",       FILTER_PLUGIN_SLOTS ? PLUGIN_UPLOAD_MAX : 0, true},
+};
+
+const size_t RAM_BUDGET_COUNT = sizeof(RAM_BUDGET) / sizeof(RAM_BUDGET[0]);
+const size_t RAM_BUDGET_INTERNAL = ramInternal(RAM_BUDGET, RAM_BUDGET_COUNT, BOARD_PSRAM);
+const size_t RAM_BUDGET_PSRAM = ramPsram(RAM_BUDGET, RAM_BUDGET_COUNT, BOARD_PSRAM);
+
+#ifndef RAM_BUDGET_WARN_ONLY
+static_assert(RAM_BUDGET_INTERNAL <= BOARD_INTERNAL_RAM,
+              "RAM budget exceeds internal RAM on this board (build with -DRAM_BUDGET_WARN_ONLY for the breakdown)");
+static_assert(RAM_BUDGET_PSRAM <= BOARD_PSRAM,
+              "RAM budget exceeds PSRAM on this board (build with -DRAM_BUDGET_WARN_ONLY for the breakdown)");
+#endif
+
+void printRamBudget() {
+    Serial.printf("RAM budget (%s%s):\n", BOARD_NAME, BOARD_PSRAM > 0 ? " + PSRAM" : "");
+    for (size_t i = 0; i < RAM_BUDGET_COUNT; i++) {
+        const RamItem* item = &RAM_BUDGET[i];
+        if (item->bytes == 0) continue;
+        Serial.printf("  %-20s %7u  %s\n", item->name, (unsigned)item->bytes,
+                      item->movable && BOARD_PSRAM > 0 ? "psram" : "internal");
+    }
+    Serial.printf("  internal %u of %u bytes, PSRAM %u of %u bytes\n",
+                  (unsigned)RAM_BUDGET_INTERNAL, (unsigned)BOARD_INTERNAL_RAM,
+                  (unsigned)RAM_BUDGET_PSRAM, (unsigned)BOARD_PSRAM);
+    if (BOARD_PSRAM > 0 && !psramFound()) {
+        Serial.println("  ⚠️  Built for PSRAM but none found - everything lands in internal RAM");
+    }
+    if (RAM_BUDGET_INTERNAL > BOARD_INTERNAL_RAM || RAM_BUDGET_PSRAM > BOARD_PSRAM) {
+        Serial.println("  ⚠️  Over budget - expect allocation failures under load");
+    }
+}
+
+// ============================================================================
+// Memory Placement
+// ============================================================================
+//
+// Connection records, namespaces, the event arena and other per-frame state
+// are statics in internal RAM. Bulk buffers go through memPolicy: the
+// hub's own (uploads, stream reassembly, held frames) and mbedTLS's (the
+// uplink's record buffers and certificate chain). The WebSocket library and
+// String allocate with plain malloc, so on PSRAM boards the heap itself is
+// told to place mallocs of PSRAM_MALLOC_MIN and up there.
+
+void* heapTierAlloc(uint8_t tier, size_t size) {
+    return heap_caps_malloc(size, tier == MEM_PSRAM ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+}
+
+void heapTierRelease(void* p) {
+    heap_caps_free(p);
+}
+
+const MemBackend heapTiers = {heapTierAlloc, heapTierRelease};
+
+void* tlsCalloc(size_t count, size_t size) {
+    return memCalloc(&memPolicy, MEM_BULK, count, size);
+}
+
+void tlsFree(void* p) {
+    memFree(&memPolicy, p);
+}
+
+// Runs first in setup(), before anything has allocated through mbedTLS
+void initMemoryPlacement() {
+    bool psram = psramFound();
+    memPolicyInit(&memPolicy, &heapTiers, psram, MEM_BULK_MIN);
+    mbedtls_platform_set_calloc_free(tlsCalloc, tlsFree);
+#ifdef BOARD_HAS_PSRAM
+    if (psram) heap_caps_malloc_extmem_enable(PSRAM_MALLOC_MIN);
+#endif
+}
+
+String memTierJson(const MemTierStats* tier) {
+    String json = "{";
+    json += "\"allocs\":" + String(tier->allocs) + ",";
+    json += "\"frees\":" + String(tier->frees) + ",";
+    json += "\"failures\":" + String(tier->failures) + ",";
+    json += "\"bytes\":" + String((unsigned)tier->bytes) + ",";
+    json += "\"highWater\":" + String((unsigned)tier->highWater);
+    json += "}";
+    return json;
+}
+
+void handleMemoryStats() {
+    String json = "{";
+    json += "\"psram\":" + String(memPolicy.psram ? "true" : "false") + ",";
+    json += "\"bulkMin\":" + String((unsigned)memPolicy.bulkMin) + ",";
+    json += "\"fallbacks\":" + String(memPolicy.fallbacks) + ",";
+    json += "\"internal\":" + memTierJson(&memPolicy.tiers[MEM_INTERNAL]) + ",";
+    json += "\"psramTier\":" + memTierJson(&memPolicy.tiers[MEM_PSRAM]) + ",";
+    json += "\"heap\":{\"internalFree\":" + String((unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL)) + ",";
+    json += "\"internalLargest\":" + String((unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL)) + ",";
+    json += "\"psramFree\":" + String((unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM)) + "},";
+    json += "\"budget\":{\"internal\":" + String((unsigned)RAM_BUDGET_INTERNAL) + ",";
+    json += "\"psram\":" + String((unsigned)RAM_BUDGET_PSRAM) + "}";
+    json += "}";
+    webServer.send(200, "application/json", json);
+}
 
 // ============================================================================
 // Connection Management
@@ -132,8 +585,17 @@ Connection* addConnection(uint8_t num, String clientPeerId = "") {
             connections[i].num = num;
             connections[i].peer_id = next_peer_id++;
             connections[i].clientPeerId = clientPeerId;
+            wireHexToId(clientPeerId.c_str(), clientPeerId.length(), connections[i].rawPeerId);
+            connections[i].nsId = NAMESPACE_NONE;
+            connections[i].iceBatch = false;
+            connections[i].discoveryK = 0;
+            connections[i].hopStamps = false;
+            connections[i].draining = false;
+            connections[i].announced = false;
             connections[i].active = true;
-            connections[i].last_seen = millis();
+            connections[i].connectedMs = millis();
+            connections[i].last_seen = connections[i].connectedMs;
+            peerDirPut(&peerDirectory, connections[i].rawPeerId, i);  // A reconnecting peer takes its ID over
             return &connections[i];
         }
     }
@@ -143,12 +605,606 @@ Connection* addConnection(uint8_t num, String clientPeerId = "") {
 void removeConnection(uint8_t num) {
     for (int i = 0; i < MAX_CONNECTIONS; i++) {
         if (connections[i].active && connections[i].num == num) {
+            nsRelease(&namespaces, connections[i].nsId);
+            connections[i].nsId = NAMESPACE_NONE;
             connections[i].active = false;
+            iceCoalescerDrop(&iceCoalescer, num);
+
+            // Hand the ID back to an older connection that still has it
+            peerDirRemove(&peerDirectory, connections[i].rawPeerId, i);
+            for (int j = 0; j < MAX_CONNECTIONS; j++) {
+                if (connections[j].active &&
+                    memcmp(connections[j].rawPeerId, connections[i].rawPeerId, WIRE_PEER_ID_LEN) == 0) {
+                    peerDirPut(&peerDirectory, connections[j].rawPeerId, j);
+                    break;
+                }
+            }
             break;
         }
     }
 }
 
+// Who a newcomer is introduced to, and who hears about it: the other peers
+// in its namespace or, if it asked for a K, only the K closest to it by XOR
+// distance. That keeps discovery O(n * K) per namespace instead of O(n^2).
+// Fills `peers` with connection indices; returns how many.
+int discoveryPeers(const Connection* conn, int peers[MAX_CONNECTIONS]) {
+    XorCandidate candidates[MAX_CONNECTIONS];
+    int count = 0;
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        if (connections[i].active && &connections[i] != conn && connections[i].nsId == conn->nsId) {
+            candidates[count++] = {connections[i].rawPeerId, i};
+        }
+    }
+
+    int introduced = count;
+    if (conn->discoveryK > 0) {
+        introduced = xorClosest(conn->rawPeerId, candidates, count, conn->discoveryK);
+        discoveryStats.topK++;
+        discoveryStats.skipped += 2 * (count - introduced);
+    }
+    for (int i = 0; i < introduced; i++) peers[i] = candidates[i].index;
+    discoveryStats.introductions += 2 * introduced;
+    nsUsageIntroductions(&nsUsage, conn->nsId, 2 * introduced);
+    return introduced;
+}
+
+// Takes a reference on a namespace. Usage counters start over when a name
+// takes a slot another name was evicted from.
+int acquireNamespace(const char* name, size_t len) {
+    bool known = nsFind(&namespaces, name, len) != NAMESPACE_NONE;
+    int id = nsAcquire(&namespaces, name, len, millis());
+    if (id != NAMESPACE_NONE && !known) nsUsageReset(&nsUsage, id, millis());
+    return id;
+}
+
+// Peers admitted recently that haven't announced yet
+uint32_t pendingAdmissions() {
+    uint32_t pending = 0;
+    unsigned long now = millis();
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        if (connections[i].active && !connections[i].announced &&
+            now - connections[i].connectedMs < ADMIT_PENDING_WINDOW_MS) {
+            pending++;
+        }
+    }
+    return pending;
+}
+
+// ============================================================================
+// Wire Protocol
+// ============================================================================
+//
+// Every frame is decoded once into a WireMsg (wire_codec.h) and routed on its
+// fixed fields. Frames are forwarded byte-for-byte when the receiver speaks
+// the sender's encoding and converted only when it doesn't; the uplink is
+// always v1 JSON.
+
+// Serial.printf without the heap: Print::printf mallocs any line over 64
+// bytes. Loop task only.
+void hubLog(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+void hubLog(const char* fmt, ...) {
+    static char line[192];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    Serial.print(line);
+}
+
+Connection* findConnectionByRawId(const uint8_t* rawPeerId) {
+    uint8_t owner = peerDirGet(&peerDirectory, rawPeerId);
+    return owner == PEER_DIR_NONE ? NULL : &connections[owner];
+}
+
+bool streamingTo(uint8_t dest) {
+    for (int i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+        if (streams[i].active && streams[i].cut && streams[i].dest == dest) return true;
+    }
+    return false;
+}
+
+// A whole frame can't be sent between the fragments of a streamed message,
+// so it waits until the stream to that receiver ends. Returns true if the
+// frame was taken (held, or dropped because no room was left).
+bool holdFrame(uint8_t dest, const uint8_t* frame, size_t len, bool binary) {
+    if (!streamingTo(dest)) return false;
+    bool room = heldCount < STREAM_HOLD_MAX && heldBytes + len <= STREAM_HOLD_BYTES;
+    uint8_t* copy = room ? (uint8_t*)memAlloc(&memPolicy, MEM_BULK, len) : NULL;
+    if (!copy) {
+        Serial.printf("[STREAM] No room to hold a frame for %u, dropped\n", dest);
+        return true;
+    }
+    memcpy(copy, frame, len);
+    heldFrames[heldCount++] = {dest, binary, copy, len};
+    heldBytes += len;
+    wireStats.framesHeld++;
+    return true;
+}
+
+// A whole frame to the bootstrap hub. Copied behind header headroom so the
+// library masks it in place and writes header and payload together: one TLS
+// record per frame, where payloads over 1400 bytes would otherwise take two
+// (header, then payload) and smaller ones a temporary heap copy. With
+// headerToPayload the library takes the start of the headroom, not the frame.
+void sendUplinkFrame(const uint8_t* frame, size_t len) {
+    EventScope scope;
+    unsigned long start = micros();
+    uint8_t* buf = (uint8_t*)arenaAlloc(&eventArena, WEBSOCKETS_MAX_HEADER_SIZE + len);
+    if (buf) {
+        memcpy(buf + WEBSOCKETS_MAX_HEADER_SIZE, frame, len);
+        bootstrapHub.sendTXT(buf, len, true);
+    } else {
+        bootstrapHub.sendTXT(frame, len);
+    }
+    uplinkTls.us += micros() - start;
+    uplinkTls.records++;
+    uplinkTls.bytes += len;
+}
+
+// Sends (or discards) what was held for dest, in order
+void releaseHeld(uint8_t dest, bool send) {
+    int kept = 0;
+    for (int i = 0; i < heldCount; i++) {
+        HeldFrame* held = &heldFrames[i];
+        if (held->dest != dest) {
+            heldFrames[kept++] = *held;
+            continue;
+        }
+        if (send && dest == STREAM_UPLINK) {
+            sendUplinkFrame(held->data, held->len);
+        } else if (send && held->binary) {
+            webSocket.sendBIN(dest, held->data, held->len);
+        } else if (send) {
+            webSocket.sendTXT(dest, held->data, held->len);
+        }
+        heldBytes -= held->len;
+        memFree(&memPolicy, held->data);
+    }
+    heldCount = kept;
+}
+
+void deliver(uint8_t num, const uint8_t* frame, size_t len, bool binary) {
+    if (holdFrame(num, frame, len, binary)) return;
+    if (binary) {
+        webSocket.sendBIN(num, frame, len);
+    } else {
+        webSocket.sendTXT(num, frame, len);
+    }
+}
+
+// Straight out, or queued behind its stream's backlog. `key` is the
+// namespace (nsId + 1, 0 for none).
+void deliverUplink(const uint8_t* frame, size_t len, uint32_t key, uint8_t priority) {
+    if (holdFrame(STREAM_UPLINK, frame, len, false)) return;
+    if (uplinkMuxDirect(&uplinkMux, priority, len, millis())) {
+        sendUplinkFrame(frame, len);
+    } else if (!uplinkMuxPush(&uplinkMux, key, priority, frame, len, millis())) {
+        hubLog("[BOOTSTRAP] Uplink backlog full, frame dropped\n");
+    }
+}
+
+// v2 frames start with the version byte, which JSON text never does
+void sendRaw(uint8_t num, const uint8_t* frame, size_t len) {
+    deliver(num, frame, len, len > 0 && frame[0] == WIRE_V2_VERSION);
+}
+
+bool decodeFrame(uint8_t wire, uint8_t* payload, size_t length, WireMsg* msg) {
+    unsigned long start = micros();
+    frameRxUs = start;
+    frameRxMs = millis();
+    bool ok = wire == WIRE_V2 ? wireDecode(payload, length, msg)
+                              : wireParseJson((const char*)payload, length, msg);
+    // wireDecode() dropped the hub-only flags; so does a frame forwarded as is
+    if (ok && wire == WIRE_V2) payload[2] &= ~WIRE_FLAGS_HUB_SET;
+    wireStats.decodeUs[wire] += micros() - start;
+    wireStats.framesIn[wire]++;
+    wireStats.bytesIn[wire] += length;
+    return ok;
+}
+
+// Converts msg to `wire` in the event arena; returns the frame or NULL
+uint8_t* convertFrame(const WireMsg* msg, uint8_t wire, size_t* len) {
+    unsigned long start = micros();
+    uint8_t* frame = NULL;
+    if (wire == WIRE_V2) {
+        size_t cap = wireEncodedSize(msg);
+        frame = (uint8_t*)arenaAlloc(&eventArena, cap);
+        *len = frame ? wireEncode(msg, frame, cap) : 0;
+    } else {
+        size_t cap = wireJsonSize(msg) + 1;
+        frame = (uint8_t*)arenaAlloc(&eventArena, cap);
+        *len = frame ? wireRenderJson(msg, (char*)frame, cap) : 0;
+    }
+    if (*len == 0) frame = NULL;
+    wireStats.encodeUs[wire] += micros() - start;
+    wireStats.converted[wire]++;
+    return frame;
+}
+
+// Sends msg to a local peer in its encoding. `frame` is msg as received
+// (encoding `frameWire`), or NULL if msg was built or modified by the hub.
+void sendWire(Connection* to, const WireMsg* msg, const uint8_t* frame, size_t frameLen, uint8_t frameWire) {
+    if (!frame || to->wire != frameWire) {
+        frame = convertFrame(msg, to->wire, &frameLen);
+        if (!frame) {
+            hubLog("[WIRE] Failed to convert %s for client %u\n", wireTypeName(msg->type), to->num);
+            return;
+        }
+    }
+
+    deliver(to->num, frame, frameLen, to->wire == WIRE_V2);
+    if (to->wire == WIRE_V2) wireStats.v2AsJsonBytes += wireJsonSize(msg);
+    wireStats.framesOut[to->wire]++;
+    wireStats.bytesOut[to->wire] += frameLen;
+    nsUsageFrame(&nsUsage, to->nsId, NS_TO_PEER, msg->type, frameLen);
+}
+
+// One message to many local peers (see fan_out.h)
+static_assert(FAN_OUT_HEADROOM == WEBSOCKETS_MAX_HEADER_SIZE, "fan-out header room differs from the WebSockets library's");
+
+FanOut fanOutBegin(const WireMsg* msg, const uint8_t* frame, size_t frameLen, uint8_t frameWire) {
+    FanOut fan;
+    fanOutInit(&fan, msg, frame, frameLen, frameWire);
+    wireStats.fanOuts++;
+    return fan;
+}
+
+void fanOutSend(FanOut* fan, Connection* to) {
+    uint8_t wire = fanOutWire(fan, to->wire);
+    uint32_t renders = fan->renders;
+    uint32_t conversions = fan->conversions;
+    unsigned long start = micros();
+    size_t len = 0;
+    uint8_t* buf = fanOutBuffer(fan, &eventArena, wire, &len);
+    if (fan->conversions != conversions) {
+        wireStats.encodeUs[wire] += micros() - start;
+        wireStats.converted[wire]++;
+    }
+    wireStats.fanOutRenders += fan->renders - renders;
+    if (!buf) {
+        hubLog("[WIRE] Failed to frame fan-out for client %u\n", to->num);
+        return;
+    }
+
+    // The library wants the start of the header room, the hold copy only the frame
+    bool binary = wire == WIRE_V2;
+    if (!holdFrame(to->num, buf + FAN_OUT_HEADROOM, len, binary)) {
+        if (binary) {
+            webSocket.sendBIN(to->num, buf, len, true);
+        } else {
+            webSocket.sendTXT(to->num, buf, len, true);
+        }
+    }
+    if (fan->msg && wire == WIRE_V2) wireStats.v2AsJsonBytes += wireJsonSize(fan->msg);
+    wireStats.framesOut[wire]++;
+    wireStats.bytesOut[wire] += len;
+    wireStats.fanOutSends++;
+    nsUsageFrame(&nsUsage, to->nsId, NS_TO_PEER, fan->msg ? fan->msg->type : WIRE_OTHER, len);
+}
+
+// Times a signaling frame the hub is passing on (see signal_timing.h)
+void timeSignal(const WireMsg* msg, bool viaUplink) {
+    static const uint8_t NO_ID[WIRE_PEER_ID_LEN] = {0};
+    uint8_t kind = msg->type == WIRE_OFFER ? SIGNAL_OFFER : msg->type == WIRE_ANSWER ? SIGNAL_ANSWER : SIGNAL_CANDIDATE;
+    signalForwarded(&signalTiming, kind, msg->flags & WIRE_FLAG_FROM ? msg->from : NO_ID, msg->target,
+                    viaUplink, micros() - frameRxUs, millis());
+}
+
+// Copy of a v1 message with a "hop" field appended (in the event arena):
+// this hub, when the message reached it (hub clock) and how long the hub
+// held it. NULL if it has no closing brace.
+char* stampHop(const char* json, size_t len, size_t* outLen) {
+    size_t brace = len;
+    while (brace > 0 && json[brace - 1] != '}') brace--;
+    if (brace == 0) return NULL;
+    brace--;
+
+    size_t cap = brace + 80;
+    char* out = (char*)arenaAlloc(&eventArena, cap);
+    if (!out) return NULL;
+    memcpy(out, json, brace);
+    *outLen = brace + snprintf(out + brace, cap - brace, ",\"hop\":{\"hub\":\"%.8s\",\"rxMs\":%lu,\"residenceUs\":%lu}}",
+                               hubPeerId.c_str(), frameRxMs, micros() - frameRxUs);
+    return out;
+}
+
+// Signaling toward a local peer: trickled candidates may be held briefly
+// and merged (see ice_coalescer.h)
+void relaySignal(Connection* to, const WireMsg* msg, const uint8_t* frame, size_t frameLen, uint8_t frameWire,
+                 bool viaUplink) {
+    timeSignal(msg, viaUplink);
+    if (to->iceBatch && iceCoalescerOffer(&iceCoalescer, to->num, msg, millis())) return;
+    if (to->hopStamps && to->wire == WIRE_V1) {
+        size_t len = frameLen;
+        const uint8_t* json = frame && frameWire == WIRE_V1 ? frame : convertFrame(msg, WIRE_V1, &len);
+        char* stamped = json ? stampHop((const char*)json, len, &len) : NULL;
+        if (stamped) {
+            sendWire(to, msg, (const uint8_t*)stamped, len, WIRE_V1);
+            return;
+        }
+    }
+    sendWire(to, msg, frame, frameLen, frameWire);
+}
+
+void flushIceBatch(uint8_t to, const WireMsg* msg) {
+    Connection* conn = findConnectionByNum(to);
+    if (conn) sendWire(conn, msg, NULL, 0, 0);
+}
+
+// Non-negative integer after token (e.g. "\"discoveryK\":") in the message
+// data, or -1 if absent
+long blobNumber(const WireMsg* msg, const char* token) {
+    size_t len = strlen(token);
+    for (size_t i = 0; i + len <= msg->blobLen; i++) {
+        if (memcmp(msg->blob + i, token, len) != 0) continue;
+        size_t pos = i + len;
+        while (pos < msg->blobLen && msg->blob[pos] == ' ') pos++;
+        if (pos == msg->blobLen || msg->blob[pos] < '0' || msg->blob[pos] > '9') return -1;
+        long value = 0;
+        while (pos < msg->blobLen && msg->blob[pos] >= '0' && msg->blob[pos] <= '9' && value < 100000) {
+            value = value * 10 + (msg->blob[pos++] - '0');
+        }
+        return value;
+    }
+    return -1;
+}
+
+// The "peerId" in the message data (peer-discovered, peer-disconnected)
+bool blobPeerId(const WireMsg* msg, uint8_t id[WIRE_PEER_ID_LEN]) {
+    static const char token[] = "\"peerId\":\"";
+    size_t len = sizeof(token) - 1;
+    for (size_t i = 0; i + len + WIRE_PEER_ID_LEN * 2 <= msg->blobLen; i++) {
+        if (memcmp(msg->blob + i, token, len) == 0) {
+            return wireHexToId((const char*)msg->blob + i + len, WIRE_PEER_ID_LEN * 2, id);
+        }
+    }
+    return false;
+}
+
+// True if the message data contains token (e.g. a capability name)
+bool blobContains(const WireMsg* msg, const char* token) {
+    size_t len = strlen(token);
+    for (size_t i = 0; i + len <= msg->blobLen; i++) {
+        if (memcmp(msg->blob + i, token, len) == 0) return true;
+    }
+    return false;
+}
+
+// Toward the bootstrap hub on behalf of a peer in namespace nsId.
+// Signaling goes ahead of announces and anything else.
+void sendUplink(const WireMsg* msg, const uint8_t* frame, size_t frameLen, uint8_t frameWire, int nsId) {
+    bool signaling = msg->type == WIRE_OFFER || msg->type == WIRE_ANSWER ||
+                     msg->type == WIRE_ICE_CANDIDATE || msg->type == WIRE_ICE_CANDIDATES;
+    uint8_t priority = signaling ? UPLINK_PRIO_SIGNAL : UPLINK_PRIO_BULK;
+    uint32_t key = nsId + 1;
+    if (frame && frameWire == WIRE_V1) {
+        deliverUplink(frame, frameLen, key, priority);
+        nsUsageFrame(&nsUsage, nsId, NS_TO_UPLINK, msg->type, frameLen);
+        return;
+    }
+    size_t len = 0;
+    uint8_t* json = convertFrame(msg, WIRE_V1, &len);
+    if (json) {
+        deliverUplink(json, len, key, priority);
+        nsUsageFrame(&nsUsage, nsId, NS_TO_UPLINK, msg->type, len);
+    }
+}
+
+// Copy of a v1 message with "fromPeerId" appended (in the event arena), or
+// NULL if it has no closing brace
+char* stampFromPeerId(const char* json, size_t len, const String& peerId, size_t* outLen) {
+    size_t brace = len;
+    while (brace > 0 && json[brace - 1] != '}') brace--;
+    if (brace == 0) return NULL;
+    brace--;
+
+    size_t cap = brace + peerId.length() + 20;
+    char* out = (char*)arenaAlloc(&eventArena, cap);
+    if (!out) return NULL;
+    memcpy(out, json, brace);
+    *outLen = brace + snprintf(out + brace, cap - brace, ",\"fromPeerId\":\"%s\"}", peerId.c_str());
+    return out;
+}
+
+// Hub-originated message ("fromPeerId":"system"); blob (NUL-terminated, may
+// be NULL) must outlive it
+WireMsg systemMessage(uint8_t type, const char* ns, const char* blob) {
+    WireMsg msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.type = type;
+    msg.flags = WIRE_FLAG_SYSTEM;
+    msg.timestamp = millis();
+    msg.ns = ns;
+    msg.nsLen = strlen(ns);
+    msg.blob = (const uint8_t*)blob;
+    msg.blobLen = blob ? strlen(blob) : 0;
+    return msg;
+}
+
+void handleWireStats() {
+    String json = "{";
+    for (uint8_t wire = WIRE_V1; wire <= WIRE_V2; wire++) {
+        json += String(wire == WIRE_V1 ? "\"v1\"" : "\"v2\"") + ":{";
+        json += "\"framesIn\":" + String(wireStats.framesIn[wire]) + ",";
+        json += "\"bytesIn\":" + String(wireStats.bytesIn[wire]) + ",";
+        json += "\"decodeUs\":" + String(wireStats.decodeUs[wire]) + ",";
+        json += "\"framesOut\":" + String(wireStats.framesOut[wire]) + ",";
+        json += "\"bytesOut\":" + String(wireStats.bytesOut[wire]) + ",";
+        json += "\"converted\":" + String(wireStats.converted[wire]) + ",";
+        json += "\"encodeUs\":" + String(wireStats.encodeUs[wire]) + "},";
+    }
+    json += "\"v2AsJsonBytes\":" + String(wireStats.v2AsJsonBytes) + ",";
+    json += "\"arena\":{\"size\":" + String(EVENT_ARENA_SIZE) + ",";
+    json += "\"highWater\":" + String(eventArena.highWater) + ",";
+    json += "\"overflows\":" + String(eventArena.overflows) + ",";
+    json += "\"events\":" + String(eventArena.resets) + "},";
+    json += "\"stream\":{\"cut\":" + String(wireStats.streamsCut) + ",";
+    json += "\"reassembled\":" + String(wireStats.streamsReassembled) + ",";
+    json += "\"aborted\":" + String(wireStats.streamsAborted) + ",";
+    json += "\"bytes\":" + String(wireStats.streamBytes) + ",";
+    json += "\"held\":" + String(wireStats.framesHeld) + "},";
+    json += "\"fanout\":{\"messages\":" + String(wireStats.fanOuts) + ",";
+    json += "\"sends\":" + String(wireStats.fanOutSends) + ",";
+    json += "\"renders\":" + String(wireStats.fanOutRenders) + "},";
+    json += "\"discovery\":{\"topK\":" + String(discoveryStats.topK) + ",";
+    json += "\"introductions\":" + String(discoveryStats.introductions) + ",";
+    json += "\"skipped\":" + String(discoveryStats.skipped) + "},";
+    json += "\"remotePeers\":{\"cached\":" + String(remoteCacheSize(&remotePeers)) + ",";
+    json += "\"stored\":" + String(remotePeers.stored) + ",";
+    json += "\"refreshed\":" + String(remotePeers.refreshed) + ",";
+    json += "\"evicted\":" + String(remotePeers.evicted) + ",";
+    json += "\"expired\":" + String(remotePeers.expired) + ",";
+    json += "\"removed\":" + String(remotePeers.removed) + ",";
+    json += "\"lookups\":" + String(remotePeers.lookups) + ",";
+    json += "\"hits\":" + String(remotePeers.hits) + ",";
+    json += "\"hitRatePct\":" + String(remotePeers.lookups ? remotePeers.hits * 100 / remotePeers.lookups : 0) + ",";
+    json += "\"served\":" + String(remotePeers.served) + ",";
+    json += "\"avgStaleMs\":" + String(remotePeers.served ? (uint32_t)(remotePeers.staleMsTotal / remotePeers.served) : 0) + ",";
+    json += "\"maxStaleMs\":" + String(remotePeers.staleMsMax) + "},";
+    json += "\"ice\":{\"candidates\":" + String(iceCoalescer.candidates) + ",";
+    json += "\"merged\":" + String(iceCoalescer.merged) + ",";
+    json += "\"messages\":" + String(iceCoalescer.messages) + "},";
+    json += "\"directory\":{\"peers\":" + String(peerDirectory.count) + ",";
+    json += "\"lookups\":" + String(peerDirectory.lookups) + ",";
+    json += "\"hits\":" + String(peerDirectory.hits) + ",";
+    json += "\"probes\":" + String(peerDirectory.probes) + "}}";
+    webServer.send(200, "application/json", json);
+}
+
+// s as the inside of a JSON string: quotes, backslashes and control
+// characters escaped
+String jsonEscape(const char* s) {
+    String out;
+    out.reserve(strlen(s));
+    for (; *s; s++) {
+        uint8_t c = *s;
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += (char)c;
+        } else if (c < 0x20) {
+            char esc[8];
+            snprintf(esc, sizeof(esc), "\\u%04x", c);
+            out += esc;
+        } else {
+            out += (char)c;
+        }
+    }
+    return out;
+}
+
+// Busiest namespaces: /api/namespaces?top=N&by=bytes|frames|peers
+void handleNamespaceUsage() {
+    static const char* const DIRECTIONS[NS_DIRECTION_COUNT] = {"fromPeer", "toPeer", "toUplink", "fromUplink"};
+    String by = webServer.hasArg("by") ? webServer.arg("by") : "bytes";
+    uint8_t rank = by == "frames" ? NS_RANK_FRAMES : by == "peers" ? NS_RANK_PEERS : NS_RANK_BYTES;
+    int top = webServer.hasArg("top") ? webServer.arg("top").toInt() : NS_USAGE_TOP_DEFAULT;
+    if (top < 1 || top > NAMESPACE_MAX) top = NAMESPACE_MAX;
+
+    int ids[NAMESPACE_MAX];
+    int count = nsUsageTop(&nsUsage, &namespaces, rank, ids, top);
+    String json = "{\"by\":\"" + String(rank == NS_RANK_FRAMES ? "frames" : rank == NS_RANK_PEERS ? "peers" : "bytes") + "\",";
+    json += "\"namespaces\":[";
+    for (int i = 0; i < count; i++) {
+        const NsUsage* ns = &nsUsage.ns[ids[i]];
+        if (i > 0) json += ",";
+        json += "{\"name\":\"" + jsonEscape(nsName(&namespaces, ids[i])) + "\",";
+        json += "\"peers\":" + String(namespaces.refs[ids[i]]) + ",";
+        json += "\"peersMax\":" + String(ns->peersMax) + ",";
+        json += "\"joins\":" + String(ns->joins) + ",";
+        json += "\"forMs\":" + String(millis() - ns->sinceMs) + ",";
+        json += "\"relayMisses\":" + String(ns->relayMisses) + ",";
+        json += "\"introductions\":" + String(ns->introductions);
+        for (uint8_t d = 0; d < NS_DIRECTION_COUNT; d++) {
+            json += ",\"" + String(DIRECTIONS[d]) + "\":{\"frames\":" + String(nsUsageFrames(ns, d)) + ",";
+            json += "\"bytes\":" + String(ns->bytes[d]) + ",\"types\":{";
+            bool first = true;
+            for (uint8_t t = 0; t < WIRE_TYPE_COUNT; t++) {
+                if (ns->frames[d][t] == 0) continue;
+                json += String(first ? "" : ",") + "\"" + String(t == WIRE_OTHER ? "other" : wireTypeName(t)) + "\":";
+                json += String(ns->frames[d][t]);
+                first = false;
+            }
+            json += "}}";
+        }
+        json += "}";
+    }
+    json += "]}";
+    webServer.send(200, "application/json", json);
+}
+
+String signalHistJson(const SignalHistogram* hist) {
+    String json = "{\"count\":" + String(hist->count) + ",";
+    json += "\"avg\":" + String(hist->count ? (uint32_t)(hist->total / hist->count) : 0) + ",";
+    json += "\"p50\":" + String(signalHistPercentile(hist, 50)) + ",";
+    json += "\"p90\":" + String(signalHistPercentile(hist, 90)) + ",";
+    json += "\"p99\":" + String(signalHistPercentile(hist, 99)) + ",";
+    json += "\"max\":" + String(hist->max) + ",\"buckets\":[";
+    for (int i = 0; i < SIGNAL_HIST_BUCKETS; i++) {
+        json += String(i ? "," : "") + String(hist->buckets[i]);
+    }
+    return json + "]}";
+}
+
+// Signaling latency histograms; bucket i counts values below 2^i
+void handleSignalLatency() {
+    static const char* const NAMES[SIGNAL_HIST_COUNT] = {
+        "residenceUs", "answerLocalMs", "answerUplinkMs", "iceSpanMs", "setupMs"
+    };
+    String json = "{\"pairs\":" + String(signalActivePairs(&signalTiming)) + ",";
+    json += "\"unmatched\":" + String(signalTiming.unmatched) + ",";
+    json += "\"evicted\":" + String(signalTiming.evicted);
+    for (int h = 0; h < SIGNAL_HIST_COUNT; h++) {
+        json += ",\"" + String(NAMES[h]) + "\":" + signalHistJson(&signalTiming.hists[h]);
+    }
+    json += "}";
+    webServer.send(200, "application/json", json);
+}
+
+// ============================================================================
+// Warm Restart Persistence
+// ============================================================================
+
+void saveWarmState() {
+    WarmState state;
+    memset(&state, 0, sizeof(state));
+
+    strncpy(state.hubPeerId, hubPeerId.c_str(), sizeof(state.hubPeerId) - 1);
+    strncpy(state.uplinkHost, bootstrapHost.c_str(), sizeof(state.uplinkHost) - 1);
+    state.uplinkPort = bootstrapPort;
+    memcpy(state.namespaces, namespaces.names, sizeof(state.namespaces));
+    state.counters = hubCounters;
+    state.remotePeers = &remotePeers;
+    state.nowMs = millis();
+
+    if (warmStateEncode(&state, rtcWarmBlob, sizeof(rtcWarmBlob)) == 0) {
+        Serial.println("[WARM] ⚠️ State does not fit in RTC blob");
+    }
+    lastWarmSave = millis();
+}
+
+// Returns true if state from before the last reset was restored
+bool restoreWarmState() {
+    WarmState state;
+    state.remotePeers = &remotePeers;  // Ages don't include the reboot itself; the TTL still bounds them
+    state.nowMs = millis();
+    if (!warmStateDecode(rtcWarmBlob, sizeof(rtcWarmBlob), &state)) {
+        remoteCacheInit(&remotePeers, REMOTE_PEER_TTL_MS);
+        return false;
+    }
+
+    hubPeerId = String(state.hubPeerId);
+    if (state.uplinkHost[0] != '\0') {
+        bootstrapHost = String(state.uplinkHost);
+        bootstrapPort = state.uplinkPort;
+    }
+    for (int i = 0; i < NAMESPACE_MAX; i++) {
+        memcpy(namespaces.names[i], state.namespaces[i], NAMESPACE_NAME_LEN);
+    }
+    hubCounters = state.counters;
+    return true;
+}
+
 // ============================================================================
 // WiFi Configuration Web Pages (Minimal versions to save memory)
 // ============================================================================
@@ -224,6 +1280,93 @@ const char SUCCESS_HTML[] PROGMEM = R"=====(
 </body></html>
 )=====";
 
+// ============================================================================
+// Drain Mode
+// ============================================================================
+//
+// Before a restart the hub stops admitting peers and tells each connected
+// one when it will be closed, how long to wait before reconnecting, and
+// which hubs it can use meanwhile. Then it closes them one by one over the
+// window, so they don't all land on the next hub in the same second.
+
+// A "hub-draining" message. Alternatives are the bootstrap hub and the
+// hubs cached for the peer's network (their peer-discovered data).
+void notifyDrain(Connection* conn, uint32_t closeInMs, uint32_t retryAfterMs) {
+    const char* network = nsName(&namespaces, conn->nsId);
+    RemotePeer* cached[REMOTE_CACHE_SLOTS];
+    int count = network[0] ? remoteCacheCollect(&remotePeers, network, strlen(network), millis(),
+                                                cached, REMOTE_CACHE_SLOTS) : 0;
+
+    size_t cap = 192 + bootstrapHost.length() + strlen(network) + count * REMOTE_CACHE_DATA_MAX;
+    char* json = (char*)arenaAlloc(&eventArena, cap);
+    if (!json) return;
+    size_t n = snprintf(json, cap,
+        "{\"type\":\"hub-draining\",\"data\":{\"closeInMs\":%u,\"retryAfterMs\":%u,"
+        "\"bootstrap\":\"wss://%s:%u/\",\"hubs\":[",
+        closeInMs, retryAfterMs, bootstrapHost.c_str(), bootstrapPort);
+    bool first = true;
+    for (int i = 0; i < count; i++) {
+        if (!(cached[i]->flags & WIRE_FLAG_HUB)) continue;
+        n += snprintf(json + n, cap - n, "%s%s", first ? "" : ",", cached[i]->data);
+        first = false;
+    }
+    n += snprintf(json + n, cap - n, "]}%s%s%s,\"fromPeerId\":\"system\"}",
+                  network[0] ? ",\"networkName\":\"" : "", network, network[0] ? "\"" : "");
+
+    WireMsg msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.type = WIRE_OTHER;
+    msg.flags = WIRE_FLAG_RAW;
+    msg.blob = (const uint8_t*)json;
+    msg.blobLen = n;
+    sendWire(conn, &msg, NULL, 0, 0);
+}
+
+// Stops admitting peers and schedules every connected one to close at a
+// random point in the window. The hub restarts once they are gone.
+void startDrain() {
+    if (drain.active) return;
+    unsigned long now = millis();
+    drainStart(&drain, now, DRAIN_WINDOW_MS, DRAIN_RETRY_SPREAD_MS, DRAIN_GRACE_MS);
+
+    EventScope scope;
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        Connection* conn = &connections[i];
+        if (!conn->active) continue;
+        uint32_t closeIn = drainCloseIn(&drain, now, esp_random());
+        conn->draining = true;
+        conn->drainAtMs = now + closeIn;
+        notifyDrain(conn, closeIn, drainRetryAfter(&drain, esp_random()));
+    }
+    hubLog("[DRAIN] Closing %u peers over %u ms\n", drain.notified, drain.windowMs);
+}
+
+// Closes peers whose time has come; restarts when none are left or the
+// grace period is over
+void drainPoll() {
+    if (!drain.active) return;
+    unsigned long now = millis();
+    int remaining = 0;
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        Connection* conn = &connections[i];
+        if (!conn->active || !conn->draining) continue;
+        if ((long)(now - conn->drainAtMs) < 0) {
+            remaining++;
+            continue;
+        }
+        conn->draining = false;
+        drain.closed++;
+        webSocket.disconnect(conn->num);  // Its disconnect event removes it
+    }
+
+    if (remaining == 0 || drainExpired(&drain, now)) {
+        hubLog("[DRAIN] %u peers closed, %d left; restarting\n", drain.closed, remaining);
+        saveWarmState();
+        delay(1000);  // Let the last frames and any HTTP response go out
+        ESP.restart();
+    }
+}
+
 // ============================================================================
 // Web Server Handlers
 // ============================================================================
@@ -259,7 +1402,51 @@ void handleInfo() {
     json += "\"mac\":\"" + String(macStr) + "\",";
     json += "\"ip\":\"" + WiFi.localIP().toString() + "\",";
     json += "\"port\":" + String(SERVER_PORT) + ",";
-    json += "\"connected\":" + String(is_sta_connected ? "true" : "false");
+    json += "\"connected\":" + String(is_sta_connected ? "true" : "false") + ",";
+    json += "\"admission\":{\"admitted\":" + String(admission.admitted) + ",";
+    json += "\"deferred\":" + String(admission.deferred) + ",";
+    json += "\"backlogged\":" + String(admission.backlogged) + "},";
+    json += "\"drain\":{\"active\":" + String(drain.active ? "true" : "false") + ",";
+    json += "\"notified\":" + String(drain.notified) + ",";
+    json += "\"closed\":" + String(drain.closed) + ",";
+    json += "\"refused\":" + String(drain.refused) + "},";
+    json += "\"stun\":{\"port\":" + String(stunSocket >= 0 ? STUN_PORT : 0) + ",";
+    json += "\"requests\":" + String(stunStats.requests) + ",";
+    json += "\"dropped\":" + String(stunStats.dropped) + ",";
+    json += "\"oversize\":" + String(udpOversize) + "},";
+    json += "\"turn\":{\"allocations\":" + String(turnActiveAllocations(&turnRelay)) + ",";
+    json += "\"allocated\":" + String(turnRelay.allocated) + ",";
+    json += "\"refused\":" + String(turnRelay.refused) + ",";
+    json += "\"authFailures\":" + String(turnRelay.authFailures) + ",";
+    json += "\"packets\":" + String(turnRelay.relayedPackets) + ",";
+    json += "\"bytes\":" + String(turnRelay.relayedBytes) + ",";
+    json += "\"rateDropped\":" + String(turnRelay.rateDropped) + ",";
+    json += "\"noPermission\":" + String(turnRelay.noPermission) + ",";
+    json += "\"forbidden\":" + String(turnRelay.forbidden) + "},";
+    json += "\"uplink\":{\"state\":\"" + String(UPLINK_STATE_NAMES[uplinkState]) + "\",";
+    json += "\"forMs\":" + String(millis() - uplinkSince) + ",";
+    json += "\"retryMs\":" + String(uplinkBackoff.retryMs) + ",";
+    json += "\"connects\":" + String(uplinkConnects) + ",";
+    json += "\"drops\":" + String(uplinkDrops) + ",";
+    json += "\"handshakeMs\":{\"last\":" + String(uplinkHandshakeMsLast) + ",";
+    json += "\"avg\":" + String(uplinkConnects ? uplinkHandshakeMsTotal / uplinkConnects : 0) + ",";
+    json += "\"max\":" + String(uplinkHandshakeMsMax) + "},";
+    json += "\"tls\":{\"crypto\":\"" + String(UPLINK_TLS_CRYPTO) + "\",";
+    json += "\"records\":" + String(uplinkTls.records) + ",";
+    json += "\"bytes\":" + String(uplinkTls.bytes) + ",";
+    json += "\"us\":" + String(uplinkTls.us) + ",";
+    json += "\"kBps\":" + String(uplinkTls.us ? (uint32_t)((uint64_t)uplinkTls.bytes * 1000 / uplinkTls.us) : 0) + "},";
+    json += "\"backlogBytes\":" + String(uplinkMux.bytes) + ",";
+    for (uint8_t p = 0; p < UPLINK_PRIO_COUNT; p++) {
+        const UplinkPrioStats* stats = &uplinkMux.stats[p];
+        json += String(p == UPLINK_PRIO_SIGNAL ? "\"signal\"" : "\"bulk\"") + ":{";
+        json += "\"direct\":" + String(stats->direct) + ",";
+        json += "\"queued\":" + String(stats->queued) + ",";
+        json += "\"dropped\":" + String(stats->dropped) + ",";
+        json += "\"avgWaitMs\":" + String(stats->sent ? stats->waitMsTotal / stats->sent : 0) + ",";
+        json += "\"maxWaitMs\":" + String(stats->waitMsMax) + "}";
+        json += p + 1 < UPLINK_PRIO_COUNT ? "," : "}";
+    }
     
     // Always show stored SSID if one exists
     if (stored_ssid.length() > 0) {
@@ -393,9 +1580,8 @@ void handleReset() {
     webServer.send(200, "text/html", 
         "<html><body><h1>Reset Complete</h1><p>Device restarting...</p></body></html>");
     
-    Serial.println("✅ Credentials cleared, restarting...");
-    delay(1000);
-    ESP.restart();
+    Serial.println("✅ Credentials cleared, restarting once peers have moved...");
+    startDrain();
 }
 
 // ============================================================================
@@ -447,6 +1633,241 @@ bool connectToWiFi() {
     return false; // Not connected yet, will connect in background
 }
 
+// ============================================================================
+// STUN and TURN
+// ============================================================================
+//
+// Clients gather server-reflexive candidates from the hub (stun_server.h) and,
+// when no direct path works, relay through it (turn_relay.h). Plain lwIP
+// sockets rather than WiFiUDP, which allocates a 1460-byte receive buffer per
+// datagram: everything is read into udpBuffer and answered or forwarded in
+// place.
+
+uint32_t hostOrder(IPAddress ip) {
+    return ((uint32_t)ip[0] << 24) | ((uint32_t)ip[1] << 16) | ((uint32_t)ip[2] << 8) | ip[3];
+}
+
+int openUdpSocket(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) return -1;
+
+    struct sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);  // AP and STA alike
+    if (bind(fd, (struct sockaddr*)&local, sizeof(local)) < 0) {
+        close(fd);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    return fd;
+}
+
+void sendUdp(int fd, const uint8_t* data, size_t len, uint32_t addr, uint16_t port) {
+    struct sockaddr_in to;
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_port = htons(port);
+    to.sin_addr.s_addr = htonl(addr);
+    sendto(fd, data, len, 0, (struct sockaddr*)&to, sizeof(to));
+}
+
+// The hub's address on the client's side of it: AP or WiFi network
+uint32_t hubAddressFor(uint32_t clientAddr) {
+    uint32_t apAddr = hostOrder(WiFi.softAPIP());
+    uint32_t apMask = hostOrder(WiFi.softAPSubnetMask());
+    return apAddr && ((clientAddr ^ apAddr) & apMask) == 0 ? apAddr : hostOrder(WiFi.localIP());
+}
+
+// Short-term password for a "<network>:<expires>" username: base64 of
+// HMAC-SHA1 over the relay nonce and the username, keyed with the device
+// secret. The nonce changes every boot, and so do the passwords.
+void turnShortTermPassword(const char* username, size_t len, char password[29]) {
+    char material[TURN_NONCE_LEN + TURN_USERNAME_MAX];
+    memcpy(material, turnRelay.nonce, TURN_NONCE_LEN);
+    memcpy(material + TURN_NONCE_LEN, username, len);
+    uint8_t mac[20];
+    mbedtls_md_hmac(mbedtls_md_info_from_type(MBEDTLS_MD_SHA1),
+                    (const unsigned char*)turnSecret.c_str(), turnSecret.length(),
+                    (const unsigned char*)material, TURN_NONCE_LEN + len, mac);
+    size_t written = 0;
+    mbedtls_base64_encode((unsigned char*)password, 29, &written, mac, sizeof(mac));
+    password[written] = '\0';
+}
+
+// TURN usernames start with a network the hub has seen peers in:
+// - "<network>:<expires>", expires in seconds of hub uptime: a short-term
+//   credential from a "turn-credentials" message (notifyTurnCredentials)
+// - "<network>" or "<network>:<anything else>": the device secret is the
+//   password
+int turnKey(const char* username, size_t len, uint8_t key[16]) {
+    size_t nsLen = 0;
+    while (nsLen < len && username[nsLen] != ':') nsLen++;
+    int ns = nsFind(&namespaces, username, nsLen);
+    if (ns == NAMESPACE_NONE) return -1;
+
+    uint32_t expires = 0;
+    size_t digits = 0;
+    for (size_t i = nsLen + 1; i < len && username[i] >= '0' && username[i] <= '9' && digits < 9; i++, digits++) {
+        expires = expires * 10 + (username[i] - '0');
+    }
+    char password[33];
+    if (digits > 0 && nsLen + 1 + digits == len) {
+        if ((int32_t)(expires - millis() / 1000) <= 0) return -1;
+        turnShortTermPassword(username, len, password);
+    } else {
+        snprintf(password, sizeof(password), "%s", turnSecret.c_str());
+    }
+
+    char material[TURN_USERNAME_MAX + 64];
+    int n = snprintf(material, sizeof(material), "%.*s:%s:%s", (int)len, username, TURN_REALM, password);
+    mbedtls_md5((const unsigned char*)material, n, key);
+    return ns;
+}
+
+// A "turn-credentials" message for a peer that announced: a short-term
+// TURN username and password for its network, valid TURN_CREDENTIAL_TTL_S
+void notifyTurnCredentials(Connection* conn) {
+    const char* network = nsName(&namespaces, conn->nsId);
+    char username[TURN_USERNAME_MAX];
+    int n = snprintf(username, sizeof(username), "%s:%u", network,
+                     (unsigned)(millis() / 1000 + TURN_CREDENTIAL_TTL_S));
+    if (stunSocket < 0 || n <= 0 || n >= (int)sizeof(username)) return;  // Network name too long
+    char password[29];
+    turnShortTermPassword(username, n, password);
+
+    uint32_t hub = hubAddressFor(hostOrder(webSocket.remoteIP(conn->num)));
+    const char* json = arenaPrintf(&eventArena, NULL,
+        "{\"type\":\"turn-credentials\",\"data\":{\"urls\":[\"turn:%u.%u.%u.%u:%d\"],"
+        "\"username\":\"%s\",\"credential\":\"%s\",\"ttl\":%u},"
+        "\"networkName\":\"%s\",\"fromPeerId\":\"system\"}",
+        hub >> 24, (hub >> 16) & 0xFF, (hub >> 8) & 0xFF, hub & 0xFF, STUN_PORT, username, password,
+        (unsigned)TURN_CREDENTIAL_TTL_S, network);
+    if (!json) return;
+
+    WireMsg msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.type = WIRE_OTHER;
+    msg.flags = WIRE_FLAG_RAW;
+    msg.blob = (const uint8_t*)json;
+    msg.blobLen = strlen(json);
+    sendWire(conn, &msg, NULL, 0, 0);
+}
+
+void turnHmacSha1(const uint8_t* key, size_t keyLen, const uint8_t* data, size_t len, uint8_t out[20]) {
+    mbedtls_md_hmac(mbedtls_md_info_from_type(MBEDTLS_MD_SHA1), key, keyLen, data, len, out);
+}
+
+uint16_t turnOpenRelay(int slot) {
+    int fd = openUdpSocket(0);
+    if (fd < 0) return 0;
+    struct sockaddr_in local;
+    socklen_t localLen = sizeof(local);
+    getsockname(fd, (struct sockaddr*)&local, &localLen);
+    turnSockets[slot] = fd;
+    return ntohs(local.sin_port);
+}
+
+void turnCloseRelay(int slot) {
+    close(turnSockets[slot]);
+    turnSockets[slot] = -1;
+}
+
+// The hub's addresses and its subnets' broadcast addresses
+bool turnLocalAddress(uint32_t addr) {
+    uint32_t apAddr = hostOrder(WiFi.softAPIP());
+    uint32_t apMask = hostOrder(WiFi.softAPSubnetMask());
+    uint32_t staAddr = hostOrder(WiFi.localIP());
+    uint32_t staMask = hostOrder(WiFi.subnetMask());
+    return (apAddr && (addr == apAddr || addr == (apAddr | ~apMask))) ||
+           (staAddr && (addr == staAddr || addr == (staAddr | ~staMask)));
+}
+
+const TurnBackend turnBackend = {turnKey, turnHmacSha1, turnOpenRelay, turnCloseRelay, turnLocalAddress};
+
+void loadTurnSecret() {
+    preferences.begin("turn", false);
+    turnSecret = preferences.getString("secret", "");
+    if (turnSecret.length() == 0) {
+        char secret[33];
+        snprintf(secret, sizeof(secret), "%08x%08x%08x%08x", esp_random(), esp_random(), esp_random(), esp_random());
+        turnSecret = secret;
+        preferences.putString("secret", turnSecret);
+    }
+    preferences.end();
+}
+
+void startStun() {
+    for (int slot = 0; slot < TURN_MAX_ALLOCATIONS; slot++) turnSockets[slot] = -1;
+    stunSocket = openUdpSocket(STUN_PORT);
+    if (stunSocket < 0) {
+        Serial.printf("STUN: failed to bind UDP port %d\n", STUN_PORT);
+        return;
+    }
+
+    loadTurnSecret();
+    char nonce[TURN_NONCE_LEN + 1];
+    snprintf(nonce, sizeof(nonce), "%08x%08x", esp_random(), esp_random());
+    turnInit(&turnRelay, &turnBackend, nonce, TURN_ALLOCATIONS, TURN_PER_NAMESPACE,
+             TURN_BYTES_PER_SEC, TURN_BURST);
+    Serial.printf("STUN/TURN on UDP port %d, TURN secret %s\n", STUN_PORT, turnSecret.c_str());
+}
+
+void turnSend(const TurnSend* send) {
+    if (send->len == 0) return;
+    int fd = send->relay == TURN_VIA_SERVER ? stunSocket : turnSockets[send->relay];
+    sendUdp(fd, send->data, send->len, send->addr, send->port);
+}
+
+void stunPoll() {
+    if (stunSocket < 0) return;
+    uint32_t now = millis();
+    for (int i = 0; i < UDP_POLL_BATCH; i++) {
+        struct sockaddr_in from;
+        socklen_t fromLen = sizeof(from);
+        int len = recvfrom(stunSocket, udpBuffer, UDP_DATAGRAM_MAX + 1, 0, (struct sockaddr*)&from, &fromLen);
+        if (len < 0) break;  // Nothing waiting
+        if (len > UDP_DATAGRAM_MAX) {
+            udpOversize++;
+            continue;
+        }
+        uint32_t addr = ntohl(from.sin_addr.s_addr);
+        uint16_t port = ntohs(from.sin_port);
+
+        // The relay address is the hub's address on the client's side
+        uint32_t localAddr = hubAddressFor(addr);
+
+        uint8_t response[TURN_RESPONSE_MAX];
+        TurnSend send;
+        if (turnFromClient(&turnRelay, udpBuffer, len, addr, port, localAddr, now, response, &send)) {
+            turnSend(&send);
+            continue;
+        }
+        size_t responseLen = stunRespond(&stunStats, udpBuffer, len, addr, port, response);
+        if (responseLen > 0) sendUdp(stunSocket, response, responseLen, addr, port);
+    }
+
+    // Peer traffic on the relay sockets
+    for (int slot = 0; slot < TURN_MAX_ALLOCATIONS; slot++) {
+        for (int i = 0; turnSockets[slot] >= 0 && i < UDP_POLL_BATCH; i++) {
+            struct sockaddr_in from;
+            socklen_t fromLen = sizeof(from);
+            uint8_t* packet = udpBuffer + TURN_HEADROOM;
+            int len = recvfrom(turnSockets[slot], packet, UDP_DATAGRAM_MAX + 1, 0, (struct sockaddr*)&from, &fromLen);
+            if (len < 0) break;
+            if (len > UDP_DATAGRAM_MAX) {
+                udpOversize++;
+                continue;
+            }
+            TurnSend send;
+            turnFromPeer(&turnRelay, slot, packet, len, ntohl(from.sin_addr.s_addr), ntohs(from.sin_port), now, &send);
+            turnSend(&send);
+        }
+    }
+    turnPoll(&turnRelay, now);
+}
+
 // ============================================================================
 // WASM Import Functions
 // ============================================================================
@@ -477,7 +1898,8 @@ m3ApiRawFunction(m3_ws_send_to_peer) {
         m3ApiReturn(-1);
     }
     
-    webSocket.sendTXT(conn->num, data, data_len);
+    sendRaw(conn->num, (const uint8_t*)data, data_len);
+    nsUsageFrame(&nsUsage, conn->nsId, NS_TO_PEER, WIRE_OTHER, data_len);
     m3ApiReturn(data_len);
 }
 
@@ -487,10 +1909,14 @@ m3ApiRawFunction(m3_ws_broadcast) {
     m3ApiGetArg(int32_t, data_len);
     m3ApiGetArg(int32_t, exclude_peer_id);
     
+    // v2 frames start with the version byte, which JSON text never does (see sendRaw)
+    EventScope scope;
+    uint8_t wire = data_len > 0 && data[0] == WIRE_V2_VERSION ? WIRE_V2 : WIRE_V1;
+    FanOut fan = fanOutBegin(NULL, (const uint8_t*)data, data_len, wire);
     int sent_count = 0;
     for (int i = 0; i < MAX_CONNECTIONS; i++) {
         if (connections[i].active && connections[i].peer_id != exclude_peer_id) {
-            webSocket.sendTXT(connections[i].num, data, data_len);
+            fanOutSend(&fan, &connections[i]);
             sent_count++;
         }
     }
@@ -526,136 +1952,733 @@ m3ApiRawFunction(m3_get_device_id) {
     m3ApiSuccess();
 }
 
-m3ApiRawFunction(m3_millis) {
-    m3ApiReturnType(uint32_t);
-    m3ApiReturn((uint32_t)millis());
+m3ApiRawFunction(m3_millis) {
+    m3ApiReturnType(uint32_t);
+    m3ApiReturn((uint32_t)millis());
+}
+
+m3ApiRawFunction(m3_get_build_id) {
+    m3ApiReturnType(void);
+    m3ApiGetArgMem(char*, buffer);
+    m3ApiGetArg(int32_t, buffer_len);
+
+    WasmSlot* slot = (WasmSlot*)m3_GetUserData(runtime);
+    snprintf(buffer, buffer_len, "%s", slot->buildId);
+    m3ApiSuccess();
+}
+
+// ============================================================================
+// WASM Module Loading
+// ============================================================================
+
+M3Result linkWasmImports(IM3Module module) {
+    M3Result result = m3Err_none;
+    const char* env = "env";
+    
+    _(m3_LinkRawFunction(module, env, "ws_server_start", "i(i)", &m3_ws_server_start));
+    _(m3_LinkRawFunction(module, env, "ws_server_stop", "v()", &m3_ws_server_stop));
+    _(m3_LinkRawFunction(module, env, "ws_send_to_peer", "i(iii)", &m3_ws_send_to_peer));
+    _(m3_LinkRawFunction(module, env, "ws_broadcast", "i(iii)", &m3_ws_broadcast));
+    _(m3_LinkRawFunction(module, env, "log_message", "v(ii)", &m3_log_message));
+    _(m3_LinkRawFunction(module, env, "get_device_id", "v(ii)", &m3_get_device_id));
+    _(m3_LinkRawFunction(module, env, "millis", "i()", &m3_millis));
+    
+    // Optional: modules built before the build ID was introduced don't import it
+    result = m3_LinkRawFunction(module, env, "get_build_id", "v(ii)", &m3_get_build_id);
+    if (result == m3Err_functionLookupFailed) result = m3Err_none;
+    
+_catch:
+    return result;
+}
+
+bool loadWasmModule() {
+    M3Result result = m3Err_none;
+    
+    Serial.println("Initializing WASM3 runtime...");
+
+    // Inflate the embedded image straight into the parse buffer
+    size_t imageLen = pigeonhub_wasm_image_end - pigeonhub_wasm_image_start;
+    size_t wasmSize = wasmImageRawSize(pigeonhub_wasm_image_start, imageLen);
+    if (wasmSize == 0) {
+        Serial.println("Invalid embedded WASM image");
+        return false;
+    }
+    if (wasmSize > WASM_MODULE_MAX) {
+        Serial.printf("WASM module is %d bytes, over the %d byte RAM budget\n", wasmSize, WASM_MODULE_MAX);
+        return false;
+    }
+
+    uint8_t* buf = (uint8_t*)malloc(wasmSize);
+    if (!buf) {
+        Serial.printf("Failed to allocate %d bytes for WASM module\n", wasmSize);
+        return false;
+    }
+
+    unsigned long inflateStart = micros();
+    if (wasmImageInflate(pigeonhub_wasm_image_start, imageLen, buf, wasmSize) != wasmSize) {
+        Serial.println("Failed to inflate WASM image");
+        free(buf);
+        return false;
+    }
+    Serial.printf("WASM image: %d bytes in flash, %d bytes inflated (%d saved) in %lu us\n",
+                  imageLen, wasmSize, wasmSize - imageLen, micros() - inflateStart);
+
+    // Parse, load, link and resolve exports (stack and memory per board, see RAM Budget)
+    WasmSlot* slot = &wasmSlots[0];
+    unsigned long parseStart = micros();
+    result = wasmSlotLoad(slot, buf, wasmSize, WASM_STACK_SIZE, WASM_MEMORY_MAX, linkWasmImports);
+    if (result) {
+        Serial.printf("Failed to load WASM module: %s\n", result);
+        return false;
+    }
+    Serial.printf("WASM module parsed in %lu us\n", micros() - parseStart);
+
+    wasmImageBuildId(pigeonhub_wasm_image_start, imageLen, slot->buildId, sizeof(slot->buildId));
+    Serial.printf("WASM build ID: %s\n", slot->buildId);
+    
+    Serial.println("WASM module loaded successfully!");
+    
+    // Call init
+    result = m3_CallV(slot->init);
+    if (result) {
+        Serial.printf("Failed to call init: %s\n", result);
+        wasmSlotFree(slot);
+        return false;
+    }
+    
+    // Call start_server
+    result = m3_CallV(slot->startServer, SERVER_PORT);
+    if (result) {
+        Serial.printf("Failed to call start_server: %s\n", result);
+        wasmSlotFree(slot);
+        return false;
+    }
+    
+    activeWasm = slot;
+    return true;
+}
+
+// ============================================================================
+// Module Hot Swap
+// ============================================================================
+//
+// POST /api/module uploads a signed protocol module:
+//   image (PHW2, see wasm_image.h) | DER ECDSA-P256 signature over SHA-256(image)
+//   | u16 signature length (LE) | "PHS1"
+// A background task verifies, inflates, loads and initializes it in the
+// standby slot while the active module keeps serving. loop() then does the
+// handover: snapshot peer state, restore it into the new module and swap the
+// active pointer. Only the handover pauses the hub, and its length is
+// reported as lastSwapPauseUs.
+
+#define MODULE_SIG_TRAILER      "PHS1"
+#define MODULE_SIG_TRAILER_SIZE 6  // u16 length + magic
+
+// Checks the trailer signature; on success sets *imageLen to the signed image size
+bool verifyModuleSignature(const uint8_t* data, size_t len, size_t* imageLen) {
+    if (MODULE_SIGNING_PUBKEY[0] == '\0') return false;
+    if (len < MODULE_SIG_TRAILER_SIZE ||
+        memcmp(data + len - 4, MODULE_SIG_TRAILER, 4) != 0) return false;
+
+    size_t sigLen = data[len - 6] | (data[len - 5] << 8);
+    if (sigLen == 0 || sigLen + MODULE_SIG_TRAILER_SIZE > len) return false;
+    *imageLen = len - MODULE_SIG_TRAILER_SIZE - sigLen;
+
+    uint8_t hash[32];
+    mbedtls_sha256(data, *imageLen, hash, 0);
+
+    mbedtls_pk_context pk;
+    mbedtls_pk_init(&pk);
+    int ret = mbedtls_pk_parse_public_key(&pk, (const unsigned char*)MODULE_SIGNING_PUBKEY,
+                                          sizeof(MODULE_SIGNING_PUBKEY));
+    if (ret == 0) {
+        ret = mbedtls_pk_verify(&pk, MBEDTLS_MD_SHA256, hash, sizeof(hash),
+                                data + *imageLen, sigLen);
+    }
+    mbedtls_pk_free(&pk);
+    return ret == 0;
+}
+
+void uploadDiscard(UploadBuffer* up) {
+    memFree(&memPolicy, up->data);
+    up->data = NULL;
+    up->len = 0;
+    up->cap = 0;
+}
+
+// Appends a chunk, doubling the buffer up to max. Returns NULL or an error.
+const char* uploadAppend(UploadBuffer* up, const uint8_t* data, size_t len, size_t max) {
+    size_t needed = up->len + len;
+    if (needed > max) return "upload too large";
+    if (needed > up->cap) {
+        size_t cap = up->cap ? up->cap * 2 : 4 * 1024;
+        while (cap < needed) cap *= 2;
+        if (cap > max) cap = max;
+        uint8_t* grown = (uint8_t*)memRealloc(&memPolicy, up->data, MEM_BULK, cap);
+        if (!grown) return "out of memory";
+        up->data = grown;
+        up->cap = cap;
+    }
+    memcpy(up->data + up->len, data, len);
+    up->len = needed;
+    return NULL;
+}
+
+// Verifies a signed upload and inflates its image (at most maxSize bytes)
+// into a new malloc'd buffer
+const char* unpackSignedImage(const UploadBuffer* up, size_t maxSize, uint8_t** out, size_t* outLen,
+                              char* buildId, size_t buildIdLen) {
+    size_t imageLen = 0;
+    if (!verifyModuleSignature(up->data, up->len, &imageLen)) return "invalid signature";
+
+    size_t wasmSize = wasmImageRawSize(up->data, imageLen);
+    if (wasmSize == 0) return "invalid module image";
+    if (wasmSize > maxSize) return "module too large";
+
+    uint8_t* buf = (uint8_t*)malloc(wasmSize);
+    if (!buf) return "out of memory";
+    if (wasmImageInflate(up->data, imageLen, buf, wasmSize) != wasmSize) {
+        free(buf);
+        return "corrupt module image";
+    }
+
+    wasmImageBuildId(up->data, imageLen, buildId, buildIdLen);
+    *out = buf;
+    *outLen = wasmSize;
+    return NULL;
+}
+
+// Verifies the upload and brings the module up in the standby slot.
+// Returns NULL on success or a static error string.
+const char* prepareModule(WasmSlot* slot) {
+    uint8_t* buf = NULL;
+    size_t wasmSize = 0;
+    char buildId[sizeof(slot->buildId)];
+    const char* error = unpackSignedImage(&moduleUpload, WASM_MODULE_MAX, &buf, &wasmSize, buildId, sizeof(buildId));
+    if (error) return error;
+
+    M3Result result = wasmSlotLoad(slot, buf, wasmSize, WASM_STACK_SIZE, WASM_MEMORY_MAX, linkWasmImports);
+    if (result) return result;
+    memcpy(slot->buildId, buildId, sizeof(buildId));
+
+    result = m3_CallV(slot->init);
+    if (result) {
+        wasmSlotFree(slot);
+        return result;
+    }
+    return NULL;
+}
+
+void modulePrepareTask(void* param) {
+    unsigned long start = millis();
+    const char* error = prepareModule(swapStandby);
+    uploadDiscard(&moduleUpload);
+
+    if (error) {
+        Serial.printf("[MODULE] Rejected upload: %s\n", error);
+        swapError = error;
+        swapState = SWAP_IDLE;
+    } else {
+        Serial.printf("[MODULE] Module %s ready in %lu ms, swapping\n",
+                      swapStandby->buildId, millis() - start);
+        swapState = SWAP_READY;
+    }
+    vTaskDelete(NULL);
+}
+
+// Runs on the loop task so no WebSocket events are dispatched mid-swap
+void completeModuleSwap() {
+    WasmSlot* next = swapStandby;
+    WasmSlot* prev = activeWasm;
+
+    unsigned long start = micros();
+    M3Result result = m3Err_none;
+    if (prev && prev->snapshot) {
+        result = wasmSlotMigrate(prev, next);
+    } else {
+        // Nothing to carry over; the new module starts with an empty peer table
+        if (prev) Serial.println("[MODULE] Active module has no snapshot export, starting fresh");
+        result = m3_CallV(next->startServer, SERVER_PORT);
+    }
+
+    if (result) {
+        unsigned long pause = micros() - start;
+        Serial.printf("[MODULE] Swap to %s aborted after %lu us: %s\n", next->buildId, pause, result);
+        swapError = result;
+        wasmSlotFree(next);
+    } else {
+        activeWasm = next;
+        lastSwapPauseUs = micros() - start;
+        swapCount++;
+        swapError = NULL;
+        Serial.printf("[MODULE] Swapped to %s, pause %lu us\n", next->buildId, lastSwapPauseUs);
+        if (prev) wasmSlotFree(prev);
+    }
+
+    swapStandby = NULL;
+    swapState = SWAP_IDLE;
+}
+
+// Streams the request body into moduleUpload
+void handleModuleUpload() {
+    HTTPRaw& raw = webServer.raw();
+
+    if (raw.status == RAW_START) {
+        moduleUploadError = NULL;
+        if (MODULE_SIGNING_PUBKEY[0] == '\0') {
+            moduleUploadError = "module uploads disabled (no signing key)";
+        } else if (!MODULE_HOT_SWAP) {
+            moduleUploadError = "module uploads disabled (no PSRAM)";
+        } else if (swapState != SWAP_IDLE) {
+            moduleUploadError = "swap already in progress";
+        } else {
+            uploadDiscard(&moduleUpload);
+            swapState = SWAP_RECEIVING;
+        }
+    } else if (raw.status == RAW_WRITE) {
+        if (moduleUploadError) return;
+        moduleUploadError = uploadAppend(&moduleUpload, raw.buf, raw.currentSize, MODULE_UPLOAD_MAX);
+        if (moduleUploadError) {
+            uploadDiscard(&moduleUpload);
+            swapState = SWAP_IDLE;
+        }
+    } else if (raw.status == RAW_ABORTED) {
+        if (!moduleUploadError) {
+            uploadDiscard(&moduleUpload);
+            swapState = SWAP_IDLE;
+        }
+        moduleUploadError = "upload aborted";
+    }
+}
+
+void handleModuleDone() {
+    const char* error = moduleUploadError;
+    moduleUploadError = "no module received";  // Until the next RAW_START
+
+    if (!error && swapState != SWAP_RECEIVING) error = "no module received";
+    if (error) {
+        int code = strcmp(error, "swap already in progress") == 0 ? 409 :
+                   strncmp(error, "module uploads disabled", 23) == 0 ? 403 : 400;
+        webServer.send(code, "application/json", String("{\"error\":\"") + error + "\"}");
+        return;
+    }
+
+    Serial.printf("[MODULE] Received %d byte module, preparing\n", moduleUpload.len);
+    swapStandby = (activeWasm == &wasmSlots[0]) ? &wasmSlots[1] : &wasmSlots[0];
+    swapError = NULL;
+    swapState = SWAP_PREPARING;
+    if (xTaskCreate(modulePrepareTask, "wasm_prepare", MODULE_PREPARE_STACK, NULL, 1, NULL) != pdPASS) {
+        uploadDiscard(&moduleUpload);
+        swapStandby = NULL;
+        swapState = SWAP_IDLE;
+        webServer.send(503, "application/json", "{\"error\":\"failed to start prepare task\"}");
+        return;
+    }
+
+    webServer.send(202, "application/json", "{\"status\":\"preparing\"}");
+}
+
+void handleModuleStatus() {
+    static const char* stateNames[] = {"idle", "receiving", "preparing", "ready"};
+    String json = "{";
+    json += "\"buildId\":\"" + String(activeWasm ? activeWasm->buildId : "none") + "\",";
+    json += "\"state\":\"" + String(stateNames[swapState]) + "\",";
+    json += "\"swaps\":" + String(swapCount) + ",";
+    json += "\"lastSwapPauseUs\":" + String(lastSwapPauseUs) + ",";
+    json += "\"uploadsEnabled\":" + String(MODULE_SIGNING_PUBKEY[0] != '\0' && MODULE_HOT_SWAP ? "true" : "false");
+    if (swapError) json += ",\"error\":\"" + String(swapError) + "\"";
+    json += "}";
+    webServer.send(200, "application/json", json);
+}
+
+// ============================================================================
+// Filter Plugins
+// ============================================================================
+//
+// Plugins live in NVS ("plugins" namespace), one per slot, and run in slot
+// order on every text frame before the hub routes it. Upload a signed plugin
+// (`make plugins` in embedded/esp32) with
+//   POST /api/plugins?slot=N&name=X[&cycles=C][&memory=M]
+// and remove it with POST /api/plugins/remove?slot=N. GET /api/plugins
+// reports each plugin's cost (cycles per call, linear memory) against its
+// budget, plus its verdict counters.
+
+uint32_t filterClock() {
+    return ESP.getCycleCount();
+}
+
+void loadFilterPlugins() {
+    filterPipelineClear(&filters);
+    preferences.begin("plugins", true);
+    for (int slot = 0; slot < FILTER_PLUGIN_SLOTS; slot++) {
+        char key[4];
+        filterLoadErrors[slot] = NULL;
+        snprintf(key, sizeof(key), "w%d", slot);
+        if (!preferences.isKey(key)) continue;
+
+        size_t len = preferences.getBytesLength(key);
+        if (len > FILTER_MODULE_MAX) {
+            filterLoadErrors[slot] = "module too large";
+            continue;
+        }
+        uint8_t* buf = (uint8_t*)malloc(len);
+        if (!buf) {
+            filterLoadErrors[slot] = "out of memory";
+            continue;
+        }
+        preferences.getBytes(key, buf, len);
+        snprintf(key, sizeof(key), "n%d", slot);
+        String name = preferences.getString(key, "plugin");
+        snprintf(key, sizeof(key), "c%d", slot);
+        uint32_t cycles = preferences.getUInt(key, FILTER_DEFAULT_CYCLES);
+        snprintf(key, sizeof(key), "m%d", slot);
+        uint32_t memory = preferences.getUInt(key, FILTER_DEFAULT_MEMORY);
+        if (memory > FILTER_MEMORY_MAX) memory = FILTER_MEMORY_MAX;
+
+        int index = filters.count;
+        M3Result result = filterPipelineAdd(&filters, name.c_str(), buf, len, cycles, memory);
+        if (result) {
+            filterLoadErrors[slot] = result;
+            Serial.printf("[FILTER] Failed to load %s (slot %d): %s\n", name.c_str(), slot, result);
+            continue;
+        }
+        filterSlots[index] = slot;
+        Serial.printf("[FILTER] Loaded %s (slot %d, %d bytes, %u bytes memory)\n",
+                      name.c_str(), slot, len, filters.plugins[index].memoryBytes);
+    }
+    preferences.end();
+}
+
+void removePluginSlot(int slot) {
+    const char prefixes[] = "wncm";
+    char key[4];
+    preferences.begin("plugins", false);
+    for (int i = 0; prefixes[i]; i++) {
+        snprintf(key, sizeof(key), "%c%d", prefixes[i], slot);
+        if (preferences.isKey(key)) preferences.remove(key);
+    }
+    preferences.end();
+}
+
+// Runs a frame through the plugins; returns true if one dropped it.
+// Frames without a known namespace expose their networkName field instead.
+bool filterFrame(uint8_t direction, uint8_t peer, int nsId, const WireMsg* msg,
+                 const uint8_t* payload, size_t length) {
+    if (filters.count == 0) return false;
+
+    const char* ns = nsName(&namespaces, nsId);
+    size_t nsLen = strlen(ns);
+    if (nsId == NAMESPACE_NONE) {
+        ns = msg->ns;
+        nsLen = msg->nsLen;
+    }
+
+    const char* type = wireTypeName(msg->type);
+    FilterMessage frame = {direction, peer, ns, nsLen, type, strlen(type), payload, length};
+    int dropper = -1;
+    if (filterPipelineRun(&filters, &frame, &dropper) == FILTER_PASS) return false;
+
+    hubLog("[FILTER] %s dropped %s from %s\n", filters.plugins[dropper].name,
+                  type, direction == FILTER_FROM_PEER ? "local peer" : "uplink");
+    return true;
+}
+
+// Streams the request body into pluginUpload
+void handlePluginUpload() {
+    HTTPRaw& raw = webServer.raw();
+
+    if (raw.status == RAW_START) {
+        uploadDiscard(&pluginUpload);
+        pluginUploadError = MODULE_SIGNING_PUBKEY[0] == '\0' ? "plugin uploads disabled (no signing key)" :
+                            FILTER_PLUGIN_SLOTS == 0 ? "plugin uploads disabled (no PSRAM)" : NULL;
+    } else if (raw.status == RAW_WRITE) {
+        if (pluginUploadError) return;
+        pluginUploadError = uploadAppend(&pluginUpload, raw.buf, raw.currentSize, PLUGIN_UPLOAD_MAX);
+        if (pluginUploadError) uploadDiscard(&pluginUpload);
+    } else if (raw.status == RAW_ABORTED) {
+        uploadDiscard(&pluginUpload);
+        pluginUploadError = "upload aborted";
+    }
+}
+
+void handlePluginDone() {
+    const char* error = pluginUploadError;
+    pluginUploadError = "no plugin received";  // Until the next RAW_START
+
+    int slot = webServer.arg("slot").toInt();
+    String name = webServer.arg("name");
+    if (!error && (!webServer.hasArg("slot") || slot < 0 || slot >= FILTER_PLUGIN_SLOTS)) {
+        error = "slot out of range";
+    }
+    if (!error && (name.length() == 0 || name.length() >= FILTER_NAME_LEN)) {
+        error = "name must be 1-15 characters";
+    }
+
+    uint8_t* buf = NULL;
+    size_t len = 0;
+    char buildId[WASM_IMAGE_BUILD_ID_LEN * 2 + 1];
+    if (!error) error = unpackSignedImage(&pluginUpload, FILTER_MODULE_MAX, &buf, &len, buildId, sizeof(buildId));
+    uploadDiscard(&pluginUpload);
+    if (error) {
+        int code = strncmp(error, "plugin uploads disabled", 23) == 0 ? 403 : 400;
+        webServer.send(code, "application/json", String("{\"error\":\"") + error + "\"}");
+        return;
+    }
+
+    uint32_t cycles = webServer.hasArg("cycles") ? webServer.arg("cycles").toInt() : FILTER_DEFAULT_CYCLES;
+    uint32_t memory = webServer.hasArg("memory") ? webServer.arg("memory").toInt() : FILTER_DEFAULT_MEMORY;
+    if (memory > FILTER_MEMORY_MAX) memory = FILTER_MEMORY_MAX;
+
+    char key[4];
+    preferences.begin("plugins", false);
+    snprintf(key, sizeof(key), "w%d", slot);
+    size_t stored = preferences.putBytes(key, buf, len);
+    snprintf(key, sizeof(key), "n%d", slot);
+    preferences.putString(key, name);
+    snprintf(key, sizeof(key), "c%d", slot);
+    preferences.putUInt(key, cycles);
+    snprintf(key, sizeof(key), "m%d", slot);
+    preferences.putUInt(key, memory);
+    preferences.end();
+    free(buf);
+
+    loadFilterPlugins();
+    error = stored == len ? filterLoadErrors[slot] : "failed to store plugin";
+    if (error) {
+        removePluginSlot(slot);
+        loadFilterPlugins();
+        webServer.send(400, "application/json", String("{\"error\":\"") + error + "\"}");
+        return;
+    }
+
+    Serial.printf("[FILTER] Installed %s (build %s) in slot %d\n", name.c_str(), buildId, slot);
+    webServer.send(200, "application/json",
+                   "{\"slot\":" + String(slot) + ",\"name\":\"" + name + "\",\"buildId\":\"" + buildId + "\"}");
+}
+
+void handlePluginRemove() {
+    int slot = webServer.arg("slot").toInt();
+    if (!webServer.hasArg("slot") || slot < 0 || slot >= FILTER_PLUGIN_SLOTS) {
+        webServer.send(400, "application/json", "{\"error\":\"slot out of range\"}");
+        return;
+    }
+    removePluginSlot(slot);
+    loadFilterPlugins();
+    webServer.send(200, "application/json", "{\"removed\":" + String(slot) + "}");
+}
+
+void handlePluginStatus() {
+    String json = "{\"plugins\":[";
+    for (int i = 0; i < filters.count; i++) {
+        FilterPlugin* plugin = &filters.plugins[i];
+        if (i > 0) json += ",";
+        json += "{\"slot\":" + String(filterSlots[i]) + ",";
+        json += "\"name\":\"" + String(plugin->name) + "\",";
+        json += "\"enabled\":" + String(plugin->enabled ? "true" : "false") + ",";
+        json += "\"calls\":" + String(plugin->calls) + ",";
+        json += "\"drops\":" + String(plugin->drops) + ",";
+        json += "\"avgCycles\":" + String(plugin->calls ? (uint32_t)(plugin->cycles / plugin->calls) : 0) + ",";
+        json += "\"maxCycles\":" + String(plugin->maxCycles) + ",";
+        json += "\"cycleBudget\":" + String(plugin->cycleBudget) + ",";
+        json += "\"overruns\":" + String(plugin->overruns) + ",";
+        json += "\"errors\":" + String(plugin->errors) + ",";
+        json += "\"memoryBytes\":" + String(plugin->memoryBytes) + ",";
+        json += "\"memoryBudget\":" + String(plugin->memoryBudget);
+        if (plugin->lastError) json += ",\"lastError\":\"" + String(plugin->lastError) + "\"";
+        json += "}";
+    }
+    json += "],\"failed\":[";
+    bool first = true;
+    for (int slot = 0; slot < FILTER_PLUGIN_SLOTS; slot++) {
+        if (!filterLoadErrors[slot]) continue;
+        if (!first) json += ",";
+        json += "{\"slot\":" + String(slot) + ",\"error\":\"" + String(filterLoadErrors[slot]) + "\"}";
+        first = false;
+    }
+    json += "]}";
+    webServer.send(200, "application/json", json);
 }
 
 // ============================================================================
-// WASM Module Loading
+// Streaming Relay
 // ============================================================================
+//
+// The WebSocket library hands over fragmented messages one frame at a time.
+// The routing fields are read from the first fragment (wirePeek) and each
+// fragment is passed straight on as a fragment of the same message, so a
+// large SDP costs one WebSocket frame of buffering instead of the whole
+// message. Messages that need converting, or whose routing fields are not
+// in the first fragment, are reassembled (up to STREAM_REASSEMBLY_MAX) and
+// routed like any other frame.
 
-M3Result linkWasmImports(IM3Module module) {
-    M3Result result = m3Err_none;
-    const char* env = "env";
-    
-    _(m3_LinkRawFunction(module, env, "ws_server_start", "i(i)", &m3_ws_server_start));
-    _(m3_LinkRawFunction(module, env, "ws_server_stop", "v()", &m3_ws_server_stop));
-    _(m3_LinkRawFunction(module, env, "ws_send_to_peer", "i(iii)", &m3_ws_send_to_peer));
-    _(m3_LinkRawFunction(module, env, "ws_broadcast", "i(iii)", &m3_ws_broadcast));
-    _(m3_LinkRawFunction(module, env, "log_message", "v(ii)", &m3_log_message));
-    _(m3_LinkRawFunction(module, env, "get_device_id", "v(ii)", &m3_get_device_id));
-    _(m3_LinkRawFunction(module, env, "millis", "i()", &m3_millis));
-    
-_catch:
-    return result;
+void streamSend(StreamRelay* st, WSopcode_t opcode, uint8_t* data, size_t len, bool fin) {
+    if (st->dest == STREAM_UPLINK) {
+        bootstrapHub.sendFragment(opcode, data, len, fin);
+    } else if (st->dest != STREAM_NOWHERE) {
+        webSocket.sendFragment(st->dest, opcode, data, len, fin);
+    }
+    wireStats.streamBytes += len;
 }
 
-bool loadWasmModule() {
-    M3Result result = m3Err_none;
-    
-    Serial.println("Initializing WASM3 runtime...");
-    Serial.printf("WASM binary size: %d bytes\n", pigeonhub_wasm_size);
-    
-    // Create environment
-    wasm_env = m3_NewEnvironment();
-    if (!wasm_env) {
-        Serial.println("Failed to create WASM environment");
-        return false;
-    }
-    
-    // Create runtime with 32KB stack (reduced for ESP32-C3)
-    wasm_runtime = m3_NewRuntime(wasm_env, 32 * 1024, NULL);
-    if (!wasm_runtime) {
-        Serial.println("Failed to create WASM runtime");
-        return false;
-    }
-    
-    // Parse module
-    result = m3_ParseModule(wasm_env, &wasm_module, pigeonhub_wasm_data, pigeonhub_wasm_size);
-    if (result) {
-        Serial.printf("Failed to parse WASM module: %s\n", result);
-        return false;
-    }
-    
-    // Load module
-    result = m3_LoadModule(wasm_runtime, wasm_module);
-    if (result) {
-        Serial.printf("Failed to load WASM module: %s\n", result);
-        return false;
+void streamEnd(StreamRelay* st) {
+    st->active = false;
+    uploadDiscard(&st->buf);
+    if (st->cut) releaseHeld(st->dest, true);
+}
+
+// Sender left or stalled: close the receiver's message (it will fail to
+// parse there) rather than leave it waiting for fragments that never come
+void streamAbort(uint8_t num) {
+    StreamRelay* st = &streams[num];
+    if (!st->active) return;
+    if (st->cut) streamSend(st, WSop_continuation, NULL, 0, true);
+    streamEnd(st);
+    wireStats.streamsAborted++;
+}
+
+// Receiver left: the rest of its streams goes nowhere
+void streamReceiverGone(uint8_t dest) {
+    for (int i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+        if (streams[i].active && streams[i].cut && streams[i].dest == dest) {
+            streams[i].dest = STREAM_NOWHERE;
+        }
     }
-    
-    // Link imports
-    result = linkWasmImports(wasm_module);
-    if (result) {
-        Serial.printf("Failed to link imports: %s\n", result);
-        return false;
+    releaseHeld(dest, false);
+}
+
+// First fragment of a message from a local peer
+void streamStart(Connection* conn, uint8_t wire, uint8_t* payload, size_t length) {
+    StreamRelay* st = &streams[conn->num];
+    streamAbort(conn->num);  // A new message before the last one finished
+    memset(st, 0, sizeof(*st));
+    st->active = true;
+    st->wire = wire;
+    st->startedMs = millis();
+
+    WireMsg msg;
+    Connection* target = NULL;
+    bool routable = wirePeek(payload, length, wire, &msg) && (msg.flags & WIRE_FLAG_TARGET) &&
+                    (msg.type == WIRE_OFFER || msg.type == WIRE_ANSWER || msg.type == WIRE_ICE_CANDIDATE);
+    if (routable) {
+        target = findConnectionByRawId(msg.target);
+        if (target && target->wire == wire && !streamingTo(target->num)) {
+            st->cut = true;
+            st->dest = target->num;
+        } else if (!target && uplinkState == UPLINK_READY && wire == WIRE_V1 && !streamingTo(STREAM_UPLINK)) {
+            st->cut = true;
+            st->dest = STREAM_UPLINK;
+        }
     }
-    
-    // Find functions
-    result = m3_FindFunction(&wasm_init, wasm_runtime, "init");
-    if (result) {
-        Serial.printf("Failed to find init: %s\n", result);
-        return false;
+
+    if (!st->cut) {
+        wireStats.streamsReassembled++;
+        if (uploadAppend(&st->buf, payload, length, STREAM_REASSEMBLY_MAX)) streamAbort(conn->num);
+        return;
     }
-    
-    result = m3_FindFunction(&wasm_start_server, wasm_runtime, "start_server");
-    if (result) {
-        Serial.printf("Failed to find start_server: %s\n", result);
-        return false;
+
+    wireStats.streamsCut++;
+    hubLog("[STREAM] %s from %.8s streamed to %s\n", wireTypeName(msg.type),
+                  conn->clientPeerId.c_str(), target ? "local peer" : "bootstrap hub");
+    st->destNs = target ? target->nsId : conn->nsId;
+    nsUsageFrame(&nsUsage, conn->nsId, NS_FROM_PEER, msg.type, length);
+    if (filterFrame(FILTER_FROM_PEER, conn->num, conn->nsId, &msg, payload, length)) {
+        st->dest = STREAM_NOWHERE;  // Swallow the remaining fragments
+        return;
     }
-    
-    result = m3_FindFunction(&wasm_on_peer_connected, wasm_runtime, "on_peer_connected");
-    if (result) {
-        Serial.printf("Failed to find on_peer_connected: %s\n", result);
-        return false;
+
+    // Stamp the sender: v2 in the header we already have (wirePeek() dropped
+    // the hub-only flags the client set), v1 at the end
+    if (!(msg.flags & (WIRE_FLAG_FROM | WIRE_FLAG_SYSTEM))) {
+        if (wire == WIRE_V2) {
+            payload[2] = msg.flags | WIRE_FLAG_FROM;
+            memcpy(payload + 12, conn->rawPeerId, WIRE_PEER_ID_LEN);
+        } else {
+            st->stamp = true;
+        }
     }
-    
-    result = m3_FindFunction(&wasm_on_peer_disconnected, wasm_runtime, "on_peer_disconnected");
-    if (result) {
-        Serial.printf("Failed to find on_peer_disconnected: %s\n", result);
-        return false;
+
+    if (target) {
+        if (target->iceBatch) iceCoalescerFlush(&iceCoalescer, target->num, conn->rawPeerId);
+        hubCounters.framesRelayed++;
+    } else {
+        hubCounters.framesUplinked++;
     }
-    
-    result = m3_FindFunction(&wasm_on_message, wasm_runtime, "on_message");
-    if (result) {
-        Serial.printf("Failed to find on_message: %s\n", result);
-        return false;
+    nsUsageFrame(&nsUsage, st->destNs, target ? NS_TO_PEER : NS_TO_UPLINK, msg.type, length);
+    streamSend(st, wire == WIRE_V2 ? WSop_binary : WSop_text, payload, length, false);
+}
+
+// Later fragments. Returns true when a reassembled message is complete in
+// streams[num].buf; the caller routes it and then calls streamEnd().
+bool streamContinue(Connection* conn, uint8_t* payload, size_t length, bool fin) {
+    StreamRelay* st = &streams[conn->num];
+    if (!st->active) return false;  // Aborted, or started before we saw it
+
+    if (!st->cut) {
+        if (uploadAppend(&st->buf, payload, length, STREAM_REASSEMBLY_MAX)) {
+            hubLog("[STREAM] Message from client %u too large, dropped\n", conn->num);
+            streamAbort(conn->num);
+            return false;
+        }
+        return fin;
     }
-    
-    result = m3_FindFunction(&wasm_loop, wasm_runtime, "loop");
-    if (result) {
-        Serial.printf("Failed to find loop: %s\n", result);
-        return false;
+
+    nsUsageBytes(&nsUsage, conn->nsId, NS_FROM_PEER, length);
+    if (st->dest != STREAM_NOWHERE) {
+        nsUsageBytes(&nsUsage, st->destNs, st->dest == STREAM_UPLINK ? NS_TO_UPLINK : NS_TO_PEER, length);
     }
-    
-    Serial.println("WASM module loaded successfully!");
-    
-    // Call init
-    result = m3_CallV(wasm_init);
-    if (result) {
-        Serial.printf("Failed to call init: %s\n", result);
-        return false;
+
+    size_t brace = length;
+    while (fin && st->stamp && brace > 0 && payload[brace - 1] != '}') brace--;
+    if (fin && st->stamp && brace > 0) {
+        char tail[WIRE_PEER_ID_LEN * 2 + 20];
+        int n = snprintf(tail, sizeof(tail), ",\"fromPeerId\":\"%s\"}", conn->clientPeerId.c_str());
+        if (brace > 1) streamSend(st, WSop_continuation, payload, brace - 1, false);
+        streamSend(st, WSop_continuation, (uint8_t*)tail, n, true);
+    } else {
+        streamSend(st, WSop_continuation, payload, length, fin);
     }
-    
-    // Call start_server
-    result = m3_CallV(wasm_start_server, SERVER_PORT);
-    if (result) {
-        Serial.printf("Failed to call start_server: %s\n", result);
-        return false;
+    if (fin) streamEnd(st);
+    return false;
+}
+
+void streamPoll() {
+    for (int i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+        if (streams[i].active && millis() - streams[i].startedMs > STREAM_TIMEOUT_MS) {
+            hubLog("[STREAM] Client %d stalled mid-message, aborting\n", i);
+            streamAbort(i);
+        }
     }
-    
-    return true;
 }
 
 // ============================================================================
-// WebSocket Event Handler
+// Uplink
 // ============================================================================
+//
+// The connection to the bootstrap hub is a small state machine (UplinkState)
+// so the event handler, the WiFi watcher and the retry timer can't disagree
+// about whether the uplink is usable. Retries back off exponentially with
+// jitter, so a bootstrap hub that restarts isn't hit by every hub at once.
 
-// Helper to send JSON message
-void sendJSON(uint8_t num, String json) {
-    webSocket.sendTXT(num, json);
-    Serial.printf("[WS] Sent: %s\n", json.c_str());
+void uplinkEnter(UplinkState state) {
+    if (state != uplinkState) {
+        hubLog("[BOOTSTRAP] Uplink %s -> %s\n", UPLINK_STATE_NAMES[uplinkState], UPLINK_STATE_NAMES[state]);
+    }
+    uplinkState = state;
+    uplinkSince = millis();
+}
+
+// The connection failed or dropped: schedule a retry
+void uplinkLost() {
+    bool wasReady = uplinkState == UPLINK_READY;
+    if (wasReady) {
+        uplinkDrops++;
+        streamReceiverGone(STREAM_UPLINK);
+        uplinkMuxClear(&uplinkMux);
+    }
+
+    uplinkBackoffFailed(&uplinkBackoff, wasReady, millis() - uplinkSince, esp_random());
+    uplinkEnter(UPLINK_BACKOFF);
+    bootstrapHub.disconnect();
 }
 
 // ============================================================================
@@ -663,130 +2686,385 @@ void sendJSON(uint8_t num, String json) {
 // ============================================================================
 
 void bootstrapHubEvent(WStype_t type, uint8_t* payload, size_t length) {
+    EventScope scope;
     switch(type) {
         case WStype_DISCONNECTED:
             Serial.println("[BOOTSTRAP] Disconnected from bootstrap hub");
-            bootstrapConnected = false;
+            if (uplinkState == UPLINK_CONNECTING || uplinkState == UPLINK_READY) uplinkLost();
             break;
             
         case WStype_CONNECTED:
             Serial.println("[BOOTSTRAP] ✅ Connected to bootstrap hub!");
-            bootstrapConnected = true;
+            uplinkHandshakeMsLast = millis() - uplinkSince;
+            uplinkHandshakeMsTotal += uplinkHandshakeMsLast;
+            if (uplinkHandshakeMsLast > uplinkHandshakeMsMax) uplinkHandshakeMsMax = uplinkHandshakeMsLast;
+            uplinkEnter(UPLINK_READY);
+            uplinkConnects++;
+            saveWarmState();  // Remember this uplink as the last good one
             
             // Announce this hub to the bootstrap hub
             {
-                String announce = "{\"type\":\"announce\"," +
-                                String("\"data\":{\"peerId\":\"") + hubPeerId + 
-                                "\",\"isHub\":true,\"port\":" + String(SERVER_PORT) + 
-                                ",\"ip\":\"" + WiFi.localIP().toString() + 
-                                "\",\"capabilities\":[\"signaling\",\"relay\"]" +
-                                "},\"networkName\":\"" + String(HUB_MESH_NAMESPACE) + 
-                                "\",\"maxPeers\":" + String(MAX_CONNECTIONS) + "}";
-                bootstrapHub.sendTXT(announce);
-                Serial.printf("[BOOTSTRAP] 📢 Announced as hub with peerId: %s\n", hubPeerId.substring(0, 8).c_str());
-                Serial.printf("[BOOTSTRAP] 📢 Network namespace: %s\n", HUB_MESH_NAMESPACE);
+                IPAddress ip = WiFi.localIP();
+                size_t announceLen = 0;
+                char* announce = arenaPrintf(&eventArena, &announceLen,
+                    "{\"type\":\"announce\",\"data\":{\"peerId\":\"%s\",\"isHub\":true,\"port\":%d,"
+                    "\"ip\":\"%u.%u.%u.%u\",\"capabilities\":[\"signaling\",\"relay\"%s],\"stunPort\":%d},"
+                    "\"networkName\":\"%s\",\"maxPeers\":%d}",
+                    hubPeerId.c_str(), SERVER_PORT, ip[0], ip[1], ip[2], ip[3],
+                    stunSocket >= 0 ? ",\"stun\",\"turn\"" : "", STUN_PORT,
+                    HUB_MESH_NAMESPACE, MAX_CONNECTIONS);
+                if (announce) sendUplinkFrame((const uint8_t*)announce, announceLen);
+                hubLog("[BOOTSTRAP] 📢 Announced as hub with peerId: %.8s\n", hubPeerId.c_str());
+                hubLog("[BOOTSTRAP] 📢 Network namespace: %s\n", HUB_MESH_NAMESPACE);
             }
             break;
             
         case WStype_TEXT:
             {
-                String msg = String((char*)payload);
-                Serial.printf("[BOOTSTRAP] <<< Received %d bytes\n", length);
+                hubLog("[BOOTSTRAP] <<< Received %d bytes\n", length);
                 
-                // Parse message type
-                int typeStart = msg.indexOf("\"type\":\"") + 8;
-                int typeEnd = msg.indexOf("\"", typeStart);
-                if (typeStart < 8 || typeEnd <= typeStart) {
-                    Serial.printf("[BOOTSTRAP] ⚠️ Could not parse message type: %s\n", msg.substring(0, 100).c_str());
+                // The uplink speaks v1 JSON
+                WireMsg msg;
+                if (!decodeFrame(WIRE_V1, payload, length, &msg)) {
+                    hubLog("[BOOTSTRAP] ⚠️ Could not parse message type: %.*s\n", 
+                                 (int)(length < 100 ? length : 100), payload);
                     return;
                 }
-                String msgType = msg.substring(typeStart, typeEnd);
-                Serial.printf("[BOOTSTRAP] Message type: %s\n", msgType.c_str());
+                const char* msgType = wireTypeName(msg.type);
+                hubLog("[BOOTSTRAP] Message type: %s\n", msgType);
                 
-                if (msgType == "connected") {
+                if (msg.type == WIRE_CONNECTED) {
                     Serial.println("[BOOTSTRAP] ✅ Server confirmed connection");
                     return;
                 }
                 
-                if (msgType == "peer-discovered") {
+                if (filterFrame(FILTER_FROM_UPLINK, 0xFF, NAMESPACE_NONE, &msg, payload, length)) {
+                    return;
+                }
+                
+                if (msg.type == WIRE_PEER_DISCOVERED) {
                     // A peer on another hub was discovered
-                    // Extract peerId and networkName
-                    int peerIdStart = msg.indexOf("\"peerId\":\"") + 10;
-                    int peerIdEnd = msg.indexOf("\"", peerIdStart);
-                    int networkStart = msg.indexOf("\"networkName\":\"") + 15;
-                    int networkEnd = msg.indexOf("\"", networkStart);
-                    
-                    if (peerIdStart > 9 && networkStart > 14) {
-                        String remotePeerId = msg.substring(peerIdStart, peerIdEnd);
-                        String remoteNetwork = msg.substring(networkStart, networkEnd);
-                        
-                        Serial.printf("[BOOTSTRAP] 📥 Remote peer discovered: %s in network: %s\n", 
-                                     remotePeerId.substring(0, 8).c_str(), remoteNetwork.c_str());
+                    if (msg.nsLen > 0) {
+                        hubLog("[BOOTSTRAP] 📥 Remote peer discovered in network: %.*s\n", 
+                                     (int)msg.nsLen, msg.ns);
                         
                         // Forward to all LOCAL peers in the same network
+                        int remoteNs = nsFind(&namespaces, msg.ns, msg.nsLen);
+                        nsUsageFrame(&nsUsage, remoteNs, NS_FROM_UPLINK, msg.type, length);
+                        FanOut fan = fanOutBegin(&msg, payload, length, WIRE_V1);
                         for (int i = 0; i < MAX_CONNECTIONS; i++) {
-                            if (connections[i].active && connections[i].networkName == remoteNetwork) {
-                                webSocket.sendTXT(connections[i].num, payload, length);
-                                Serial.printf("[BOOTSTRAP] Forwarded to local peer %s\n", 
-                                            connections[i].clientPeerId.substring(0, 8).c_str());
+                            if (remoteNs != NAMESPACE_NONE && connections[i].active && connections[i].nsId == remoteNs) {
+                                fanOutSend(&fan, &connections[i]);
+                                hubCounters.framesRelayed++;
+                                hubLog("[BOOTSTRAP] Forwarded to local peer %.8s\n", 
+                                            connections[i].clientPeerId.c_str());
                             }
                         }
+
+                        // Remembered for peers that join this network later
+                        uint8_t remoteId[WIRE_PEER_ID_LEN];
+                        if (blobPeerId(&msg, remoteId)) {
+                            remoteCachePut(&remotePeers, msg.ns, msg.nsLen, remoteId, msg.flags & WIRE_FLAG_HUB,
+                                           (const char*)msg.blob, msg.blobLen, millis());
+                        }
                     }
                     
-                } else if (msgType == "offer" || msgType == "answer" || msgType == "ice-candidate") {
+                } else if (msg.type == WIRE_PEER_DISCONNECTED) {
+                    uint8_t remoteId[WIRE_PEER_ID_LEN];
+                    if (blobPeerId(&msg, remoteId)) remoteCacheRemove(&remotePeers, remoteId);
+
+                } else if (msg.type == WIRE_OFFER || msg.type == WIRE_ANSWER || msg.type == WIRE_ICE_CANDIDATE) {
                     // WebRTC signaling from a remote peer
-                    int targetStart = msg.indexOf("\"targetPeerId\":\"") + 16;
-                    int targetEnd = msg.indexOf("\"", targetStart);
-                    
-                    if (targetStart > 15) {
-                        String targetPeerId = msg.substring(targetStart, targetEnd);
-                        Serial.printf("[BOOTSTRAP] 📥 Signaling %s for %s\n", 
-                                     msgType.c_str(), targetPeerId.substring(0, 8).c_str());
+                    if (msg.flags & WIRE_FLAG_TARGET) {
+                        char targetHex[WIRE_PEER_ID_LEN * 2 + 1];
+                        wireIdToHex(msg.target, targetHex);
+                        hubLog("[BOOTSTRAP] 📥 Signaling %s for %.8s\n", msgType, targetHex);
                         
                         // Check if target is a local peer
-                        for (int i = 0; i < MAX_CONNECTIONS; i++) {
-                            if (connections[i].active && connections[i].clientPeerId == targetPeerId) {
-                                webSocket.sendTXT(connections[i].num, payload, length);
-                                Serial.printf("[BOOTSTRAP] ✅ Forwarded %s to local peer\n", msgType.c_str());
-                                return;
-                            }
+                        Connection* target = findConnectionByRawId(msg.target);
+                        if (target) {
+                            nsUsageFrame(&nsUsage, target->nsId, NS_FROM_UPLINK, msg.type, length);
+                            relaySignal(target, &msg, payload, length, WIRE_V1, true);
+                            hubCounters.framesRelayed++;
+                            hubLog("[BOOTSTRAP] ✅ Forwarded %s to local peer\n", msgType);
+                            return;
                         }
-                        Serial.printf("[BOOTSTRAP] ⚠️ Target peer %s not local\n", targetPeerId.substring(0, 8).c_str());
+                        hubCounters.relayMisses++;
+                        hubLog("[BOOTSTRAP] ⚠️ Target peer %.8s not local\n", targetHex);
                     }
                 } else {
-                    Serial.printf("[BOOTSTRAP] ℹ️ Unhandled message type: %s\n", msgType.c_str());
+                    hubLog("[BOOTSTRAP] ℹ️ Unhandled message type: %s\n", msgType);
                 }
             }
             break;
             
         case WStype_ERROR:
+            // A lost connection is reported by WStype_DISCONNECTED as well
             Serial.println("[BOOTSTRAP] ❌ WebSocket error");
-            bootstrapConnected = false;
             break;
     }
 }
 
+void connectBootstrap() {
+    String path = "/?peerId=" + hubPeerId;
+    bootstrapHub.beginSSL(bootstrapHost, bootstrapPort, path);
+    bootstrapHub.onEvent(bootstrapHubEvent);
+    // Retries are driven by uplinkStep(), not the library
+    bootstrapHub.setReconnectInterval(UPLINK_CONNECT_TIMEOUT_MS);
+}
+
+// Runs every loop: starts, times out and retries the uplink. Events from the
+// library only move it between CONNECTING, READY and BACKOFF.
+void uplinkStep(bool wifiUp) {
+    if (!wifiUp) {
+        if (uplinkState != UPLINK_IDLE) {
+            bool wasReady = uplinkState == UPLINK_READY;
+            uplinkEnter(UPLINK_IDLE);  // Before disconnect(), whose event then finds nothing to do
+            bootstrapHub.disconnect();
+            if (wasReady) streamReceiverGone(STREAM_UPLINK);
+            uplinkMuxClear(&uplinkMux);
+            uplinkBackoffReset(&uplinkBackoff);
+        }
+        return;
+    }
+
+    unsigned long elapsed = millis() - uplinkSince;
+    switch (uplinkState) {
+        case UPLINK_IDLE:
+            Serial.println("🔗 Initiating bootstrap hub connection...");
+            connectBootstrap();
+            uplinkEnter(UPLINK_CONNECTING);
+            break;
+        case UPLINK_BACKOFF:
+            if (elapsed >= uplinkBackoff.retryMs) {
+                Serial.println("[BOOTSTRAP] Retrying bootstrap hub connection");
+                connectBootstrap();
+                uplinkEnter(UPLINK_CONNECTING);
+            }
+            break;
+        case UPLINK_CONNECTING:
+            if (elapsed >= UPLINK_CONNECT_TIMEOUT_MS) {
+                Serial.println("[BOOTSTRAP] Connect timed out");
+                uplinkLost();
+            }
+            break;
+        case UPLINK_READY:
+            uplinkMuxPoll(&uplinkMux, millis(), sendUplinkFrame);
+            break;
+    }
+
+    if (uplinkState == UPLINK_CONNECTING || uplinkState == UPLINK_READY) {
+        bootstrapHub.loop();
+    }
+}
+
 // ============================================================================
 // Local Peer WebSocket Event Handler
 // ============================================================================
 
+// Introduces a newcomer to the remote peers cached for its network (all,
+// or its K closest), skipping local peers the bootstrap hub echoed back
+void introduceRemotePeers(Connection* conn, const char* network) {
+    unsigned long now = millis();
+    RemotePeer* cached[REMOTE_CACHE_SLOTS];
+    int count = remoteCacheCollect(&remotePeers, network, strlen(network), now, cached, REMOTE_CACHE_SLOTS);
+
+    XorCandidate candidates[REMOTE_CACHE_SLOTS];
+    int remote = 0;
+    for (int i = 0; i < count; i++) {
+        if (!findConnectionByRawId(cached[i]->id)) candidates[remote++] = {cached[i]->id, i};
+    }
+    if (conn->discoveryK > 0) remote = xorClosest(conn->rawPeerId, candidates, remote, conn->discoveryK);
+
+    RemotePeer* served[REMOTE_CACHE_SLOTS];
+    for (int i = 0; i < remote; i++) {
+        served[i] = cached[candidates[i].index];
+        WireMsg peer = systemMessage(WIRE_PEER_DISCOVERED, network, served[i]->data);
+        peer.flags |= served[i]->flags;
+        sendWire(conn, &peer, NULL, 0, 0);
+    }
+    remoteCacheServed(&remotePeers, served, remote, now);
+    nsUsageIntroductions(&nsUsage, conn->nsId, remote);
+}
+
+// Routes one decoded frame from a local peer. `payload` is the frame as
+// received, in encoding `frameWire`.
+void handlePeerFrame(Connection* conn, WireMsg* msg, const uint8_t* payload, size_t length, uint8_t frameWire) {
+    const char* msgType = wireTypeName(msg->type);
+    
+    if (msg->type == WIRE_ANNOUNCE) {
+        // Peer announces itself
+        hubLog("[WS] Peer %s announced\n", conn->clientPeerId.c_str());
+        
+        nsRelease(&namespaces, conn->nsId);  // Re-announce may switch namespace
+        conn->nsId = NAMESPACE_NONE;
+        if (msg->nsLen > 0) {
+            conn->nsId = acquireNamespace(msg->ns, msg->nsLen);
+        }
+        if (conn->nsId == NAMESPACE_NONE) {
+            conn->nsId = acquireNamespace("global", 6);  // Default fallback
+        }
+        nsUsageJoin(&nsUsage, conn->nsId, namespaces.refs[conn->nsId]);
+        const char* network = nsName(&namespaces, conn->nsId);
+        hubLog("[WS] Network: %s\n", network);
+        conn->iceBatch = blobContains(msg, "\"ice-candidates\"");
+        conn->hopStamps = blobContains(msg, "\"hop-timestamps\"");
+        long k = blobNumber(msg, "\"discoveryK\":");
+        conn->discoveryK = k <= 0 ? 0 : k < DISCOVERY_K_MIN ? DISCOVERY_K_MIN : k < MAX_CONNECTIONS ? k : MAX_CONNECTIONS;
+        conn->announced = true;
+        
+        // Check if this is a hub announcing (has isHub in data)
+        bool peerIsHub = msg->flags & WIRE_FLAG_HUB;
+        if (peerIsHub) {
+            hubLog("[HUB] Hub peer detected: %s\n", conn->clientPeerId.c_str());
+        }
+        
+        // Peers IN THE SAME NETWORK (all of them, or the K closest) learn
+        // about the newcomer, and it about them
+        int peers[MAX_CONNECTIONS];
+        int peerCount = discoveryPeers(conn, peers);
+        const char* announced = arenaPrintf(&eventArena, NULL, "{\"peerId\":\"%s\",\"isHub\":%s}",
+                                            conn->clientPeerId.c_str(), peerIsHub ? "true" : "false");
+        WireMsg discovered = systemMessage(WIRE_PEER_DISCOVERED, network, announced);
+        FanOut fan = fanOutBegin(&discovered, NULL, 0, 0);
+        for (int i = 0; i < peerCount; i++) {
+            fanOutSend(&fan, &connections[peers[i]]);
+        }
+        
+        for (int i = 0; i < peerCount; i++) {
+            const char* existing = arenaPrintf(&eventArena, NULL, "{\"peerId\":\"%s\",\"isHub\":false}",
+                                               connections[peers[i]].clientPeerId.c_str());
+            WireMsg peer = systemMessage(WIRE_PEER_DISCOVERED, network, existing);
+            sendWire(conn, &peer, NULL, 0, 0);
+        }
+        introduceRemotePeers(conn, network);
+        notifyTurnCredentials(conn);
+        
+        // If connected to bootstrap hub and this is a CLIENT peer (not another hub),
+        // forward their announce to the bootstrap hub so it can relay to other hubs
+        if (uplinkState == UPLINK_READY && !peerIsHub) {
+            if (frameWire == WIRE_V2 && !(msg->flags & WIRE_FLAG_FROM)) {
+                // wireDecode() dropped any FROM the client set; name it ourselves
+                memcpy(msg->from, conn->rawPeerId, WIRE_PEER_ID_LEN);
+                msg->flags |= WIRE_FLAG_FROM;
+            }
+            sendUplink(msg, payload, length, frameWire, conn->nsId);
+            hubCounters.framesUplinked++;
+            hubLog("[BOOTSTRAP] 📡 Forwarded announce for peer %.8s to bootstrap\n", 
+                         conn->clientPeerId.c_str());
+        }
+        
+    } else if (msg->type == WIRE_OFFER || msg->type == WIRE_ANSWER || msg->type == WIRE_ICE_CANDIDATE) {
+        // WebRTC signaling - route on targetPeerId and forward WITH fromPeerId
+        if (!(msg->flags & WIRE_FLAG_TARGET)) {
+            Serial.println("[SIGNAL] ❌ No targetPeerId in signaling message");
+            return;
+        }
+        char targetHex[WIRE_PEER_ID_LEN * 2 + 1];
+        wireIdToHex(msg->target, targetHex);
+        hubLog("[SIGNAL] Received %s for %.8s\n", msgType, targetHex);
+        
+        // Stamp the sender if the message doesn't name it. Verbatim (raw)
+        // messages carry their JSON, so that has to be stamped too.
+        const uint8_t* frame = payload;
+        size_t frameLen = length;
+        char* stamped = NULL;  // Event arena
+        if (!(msg->flags & (WIRE_FLAG_FROM | WIRE_FLAG_SYSTEM))) {
+            memcpy(msg->from, conn->rawPeerId, WIRE_PEER_ID_LEN);
+            msg->flags |= WIRE_FLAG_FROM;
+            frame = NULL;  // Header changed: re-encode
+
+            const char* json = NULL;
+            size_t jsonLen = 0;
+            if (frameWire == WIRE_V1) {
+                json = (const char*)payload;
+                jsonLen = length;
+            } else if (msg->flags & WIRE_FLAG_RAW) {
+                json = (const char*)msg->blob;
+                jsonLen = msg->blobLen;
+            }
+            size_t stampedLen = 0;
+            if (json) stamped = stampFromPeerId(json, jsonLen, conn->clientPeerId, &stampedLen);
+            if (stamped) {
+                if (msg->flags & WIRE_FLAG_RAW) wireParseJson(stamped, stampedLen, msg);
+                if (frameWire == WIRE_V1) {
+                    frame = (const uint8_t*)stamped;
+                    frameLen = stampedLen;
+                }
+            } else if (frameWire == WIRE_V1) {
+                frame = payload;  // No closing brace: send as-is
+            }
+        }
+        
+        Connection* target = findConnectionByRawId(msg->target);
+        if (target) {
+            // Target is LOCAL - forward directly
+            hubLog("[SIGNAL] ✅ Forwarding %s from %.8s to LOCAL peer %.8s\n", 
+                         msgType, conn->clientPeerId.c_str(), targetHex);
+            hubCounters.framesRelayed++;
+            relaySignal(target, msg, frame, frameLen, frameWire, false);
+        } else if (uplinkState == UPLINK_READY) {
+            // Target NOT local - relay through bootstrap hub
+            hubLog("[SIGNAL] 🔄 Target %.8s not local, relaying %s to bootstrap hub\n", targetHex, msgType);
+            hubCounters.framesUplinked++;
+            sendUplink(msg, frame, frameLen, frameWire, conn->nsId);
+            timeSignal(msg, true);
+        } else {
+            hubCounters.relayMisses++;
+            nsUsageRelayMiss(&nsUsage, conn->nsId);
+            hubLog("[SIGNAL] ❌ Target %.8s not local and bootstrap hub not connected, cannot relay\n", targetHex);
+            Serial.println("[SIGNAL] Active LOCAL peers:");
+            for (int i = 0; i < MAX_CONNECTIONS; i++) {
+                if (connections[i].active) {
+                    hubLog("  - %s\n", connections[i].clientPeerId.c_str());
+                }
+            }
+        }
+        
+    } else if (msg->type == WIRE_GOODBYE) {
+        hubLog("[WS] Peer %.8s said goodbye\n", conn->clientPeerId.c_str());
+        // Let disconnection handler take care of cleanup
+        
+    } else {
+        hubLog("[WS] Unknown message type: %s\n", msgType[0] ? msgType : "(raw)");
+    }
+}
+
+// Decodes, filters and routes one complete message from a local peer
+void handlePeerMessage(Connection* conn, uint8_t frameWire, uint8_t* payload, size_t length) {
+    WireMsg msg;
+    if (!decodeFrame(frameWire, payload, length, &msg)) {
+        Serial.println("[WS] Invalid message format");
+        return;
+    }
+    hubLog("[WS] Message type: %s\n", wireTypeName(msg.type));
+    
+    if (!filterFrame(FILTER_FROM_PEER, conn->num, conn->nsId, &msg, payload, length)) {
+        handlePeerFrame(conn, &msg, payload, length, frameWire);
+    }
+    // After routing, so an announce counts toward the namespace it joined
+    nsUsageFrame(&nsUsage, conn->nsId, NS_FROM_PEER, msg.type, length);
+}
+
 void webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length) {
-    Serial.printf("[WS EVENT] Client %u, Type: %d, Length: %d\n", num, type, length);
+    EventScope scope;
+    hubLog("[WS EVENT] Client %u, Type: %d, Length: %d\n", num, type, length);
     
     switch(type) {
         case WStype_DISCONNECTED: {
-            Serial.printf("[WS] Client %u disconnected\n", num);
+            hubLog("[WS] Client %u disconnected\n", num);
             Connection* conn = findConnectionByNum(num);
             if (conn) {
-                Serial.printf("[WS] Peer left: %s\n", conn->clientPeerId.substring(0, 8).c_str());
+                hubLog("[WS] Peer left: %.8s\n", conn->clientPeerId.c_str());
                 
                 // Broadcast peer departure to others
-                String goodbye = "{\"type\":\"peer-disconnected\",\"data\":{\"peerId\":\"" + 
-                                conn->clientPeerId + "\"},\"fromPeerId\":\"system\",\"timestamp\":" + 
-                                String(millis()) + "}";
+                const char* departed = arenaPrintf(&eventArena, NULL, "{\"peerId\":\"%s\"}",
+                                                   conn->clientPeerId.c_str());
+                WireMsg goodbye = systemMessage(WIRE_PEER_DISCONNECTED, "", departed);
+                FanOut fan = fanOutBegin(&goodbye, NULL, 0, 0);
                 for (int i = 0; i < MAX_CONNECTIONS; i++) {
                     if (connections[i].active && connections[i].num != num) {
-                        webSocket.sendTXT(connections[i].num, goodbye);
+                        fanOutSend(&fan, &connections[i]);
                     }
                 }
                 
@@ -798,7 +3076,24 @@ void webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length)
         case WStype_CONNECTED: {
             IPAddress ip = webSocket.remoteIP(num);
             String url = String((char*)payload);
-            Serial.printf("[WS] Client %u connected from %s, URL: %s\n", num, ip.toString().c_str(), url.c_str());
+            hubLog("[WS] Client %u connected from %s, URL: %s\n", num, ip.toString().c_str(), url.c_str());
+
+            uint32_t retryAfterMs = 0;
+            const char* refusal = NULL;
+            if (drain.active) {
+                retryAfterMs = drainRefuse(&drain, millis(), esp_random());
+                refusal = "hub draining";
+            } else if (!admissionTry(&admission, millis(), pendingAdmissions(), esp_random(), &retryAfterMs)) {
+                refusal = "hub busy";
+            }
+            if (refusal) {
+                hubLog("[WS] Refused (%s), client %u told to retry in %u ms\n", refusal, num, retryAfterMs);
+                char busy[80];
+                snprintf(busy, sizeof(busy), "{\"type\":\"error\",\"error\":\"%s\",\"retryAfterMs\":%u}", refusal, retryAfterMs);
+                webSocket.sendTXT(num, busy);
+                webSocket.disconnect(num);
+                return;
+            }
             
             // Extract peerId from URL query parameter (?peerId=...)
             String clientPeerId = "";
@@ -808,11 +3103,12 @@ void webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length)
                 int peerIdEnd = url.indexOf("&", peerIdStart);
                 if (peerIdEnd < 0) peerIdEnd = url.length();
                 clientPeerId = url.substring(peerIdStart, peerIdEnd);
-                Serial.printf("[WS] Client peerId: %s\n", clientPeerId.c_str());
+                hubLog("[WS] Client peerId: %s\n", clientPeerId.c_str());
                 
                 // Validate peerId format (40 hex characters)
-                if (clientPeerId.length() != 40) {
-                    Serial.printf("[WS] Invalid peerId length: %d (expected 40)\n", clientPeerId.length());
+                uint8_t rawPeerId[WIRE_PEER_ID_LEN];
+                if (!wireHexToId(clientPeerId.c_str(), clientPeerId.length(), rawPeerId)) {
+                    hubLog("[WS] Invalid peerId: %s (expected 40 hex characters)\n", clientPeerId.c_str());
                     webSocket.sendTXT(num, "{\"type\":\"error\",\"error\":\"Invalid peerId format\"}");
                     webSocket.disconnect(num);
                     return;
@@ -826,8 +3122,10 @@ void webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length)
             
             Connection* conn = addConnection(num, clientPeerId);
             if (conn) {
-                Serial.printf("[WS] Assigned internal ID: %d for peerId: %s\n", conn->peer_id, clientPeerId.c_str());
-                Serial.printf("[WS] Free heap before send: %d\n", ESP.getFreeHeap());
+                conn->wire = webSocket.clientRequested(num, WIRE_V2_PROTOCOL) ? WIRE_V2 : WIRE_V1;
+                hubLog("[WS] Wire protocol: %s\n", conn->wire == WIRE_V2 ? WIRE_V2_PROTOCOL : "JSON (v1)");
+                hubLog("[WS] Assigned internal ID: %d for peerId: %s\n", conn->peer_id, clientPeerId.c_str());
+                hubLog("[WS] Free heap before send: %d\n", ESP.getFreeHeap());
                 
                 // IMPORTANT: Don't send connected message immediately!
                 // The WebSocket connection event fires BEFORE the client's onopen handler
@@ -840,180 +3138,53 @@ void webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length)
             break;
         }
             
-        case WStype_TEXT: {
-            Serial.printf("[WS] Received: %.*s\n", (int)length, payload);
-            
+        case WStype_TEXT:
+        case WStype_BIN:
+        case WStype_FRAGMENT_TEXT_START:
+        case WStype_FRAGMENT_BIN_START: {
             Connection* conn = findConnectionByNum(num);
             if (!conn) {
-                Serial.printf("[WS] ERROR: Connection %u not found!\n", num);
+                hubLog("[WS] ERROR: Connection %u not found!\n", num);
                 return;
             }
             
             conn->last_seen = millis();
+            hubCounters.framesIn++;
             
-            // Parse message type (PeerPigeon protocol)
-            String msg = String((char*)payload);
-            int typeStart = msg.indexOf("\"type\":\"") + 8;
-            int typeEnd = msg.indexOf("\"", typeStart);
-            if (typeStart == -1 || typeEnd == -1) {
-                Serial.println("[WS] Invalid message format");
+            // Text frames are PeerPigeon JSON; binary frames need the v2 subprotocol
+            bool binary = type == WStype_BIN || type == WStype_FRAGMENT_BIN_START;
+            uint8_t frameWire = binary ? WIRE_V2 : WIRE_V1;
+            if (frameWire == WIRE_V1) {
+                hubLog("[WS] Received: %.*s\n", (int)length, payload);
+            } else if (conn->wire != WIRE_V2) {
+                hubLog("[WS] Binary message from non-v2 client %u ignored\n", num);
                 return;
             }
             
-            String msgType = msg.substring(typeStart, typeEnd);
-            Serial.printf("[WS] Message type: %s\n", msgType.c_str());
-            
-            if (msgType == "announce") {
-                // Peer announces itself
-                Serial.printf("[WS] Peer %s announced\n", conn->clientPeerId.c_str());
-                
-                // Extract networkName from announce message
-                int networkStart = msg.indexOf("\"networkName\":\"") + 15;
-                int networkEnd = msg.indexOf("\"", networkStart);
-                if (networkStart > 14 && networkEnd > networkStart) {
-                    conn->networkName = msg.substring(networkStart, networkEnd);
-                    Serial.printf("[WS] Network: %s\n", conn->networkName.c_str());
-                } else {
-                    conn->networkName = "global";  // Default fallback
-                }
-                
-                // Check if this is a hub announcing (has isHub in data)
-                bool peerIsHub = msg.indexOf("\"isHub\":true") > 0;
-                if (peerIsHub) {
-                    Serial.printf("[HUB] Hub peer detected: %s\n", conn->clientPeerId.c_str());
-                }
-                
-                // Send peer-discovered to all other connected peers IN THE SAME NETWORK
-                for (int i = 0; i < MAX_CONNECTIONS; i++) {
-                    if (connections[i].active && connections[i].num != num && 
-                        connections[i].networkName == conn->networkName) {
-                        String discovered = "{\"type\":\"peer-discovered\",\"data\":{\"peerId\":\"" + 
-                                          conn->clientPeerId + "\",\"isHub\":" + 
-                                          (peerIsHub ? "true" : "false") + 
-                                          "},\"networkName\":\"" + conn->networkName + 
-                                          "\",\"fromPeerId\":\"system\",\"timestamp\":" + 
-                                          String(millis()) + "}";
-                        sendJSON(connections[i].num, discovered);
-                    }
-                }
-                
-                // Send existing peers IN THE SAME NETWORK to new peer
-                for (int i = 0; i < MAX_CONNECTIONS; i++) {
-                    if (connections[i].active && connections[i].num != num &&
-                        connections[i].networkName == conn->networkName) {
-                        String discovered = "{\"type\":\"peer-discovered\",\"data\":{\"peerId\":\"" + 
-                                          connections[i].clientPeerId + "\",\"isHub\":false" +
-                                          "},\"networkName\":\"" + conn->networkName + 
-                                          "\",\"fromPeerId\":\"system\",\"timestamp\":" + 
-                                          String(millis()) + "}";
-                        sendJSON(num, discovered);
-                    }
-                }
-                
-                // If connected to bootstrap hub and this is a CLIENT peer (not another hub),
-                // forward their announce to the bootstrap hub so it can relay to other hubs
-                if (bootstrapConnected && !peerIsHub) {
-                    // Forward the peer's announce message to bootstrap hub
-                    // Bootstrap will handle sending peer-discovered to other hubs
-                    bootstrapHub.sendTXT(payload, length);
-                    Serial.printf("[BOOTSTRAP] 📡 Forwarded announce for peer %s to bootstrap\n", 
-                                 conn->clientPeerId.substring(0, 8).c_str());
-                }
-                
-            } else if (msgType == "offer" || msgType == "answer" || msgType == "ice-candidate") {
-                // WebRTC signaling - extract targetPeerId and forward WITH fromPeerId
-                Serial.printf("[SIGNAL] Received %s message\n", msgType.c_str());
-                int targetStart = msg.indexOf("\"targetPeerId\":\"") + 16;
-                int targetEnd = msg.indexOf("\"", targetStart);
-                
-                if (targetStart > 15 && targetEnd > targetStart) {
-                    String targetPeerId = msg.substring(targetStart, targetEnd);
-                    Serial.printf("[SIGNAL] Looking for target: %s\n", targetPeerId.c_str());
-                    
-                    // Find target connection by clientPeerId
-                    Connection* targetConn = nullptr;
-                    for (int i = 0; i < MAX_CONNECTIONS; i++) {
-                        if (connections[i].active && connections[i].clientPeerId == targetPeerId) {
-                            targetConn = &connections[i];
-                            break;
-                        }
-                    }
-                    
-                    if (targetConn) {
-                        // Target is LOCAL - forward directly
-                        Serial.printf("[SIGNAL] ✅ Forwarding %s from %s to LOCAL peer %s\n", 
-                                     msgType.c_str(), 
-                                     conn->clientPeerId.substring(0, 8).c_str(), 
-                                     targetPeerId.substring(0, 8).c_str());
-                        
-                        // Check if message already has fromPeerId
-                        int fromPeerIdPos = msg.indexOf("\"fromPeerId\":");
-                        if (fromPeerIdPos == -1) {
-                            // Add fromPeerId to the message
-                            int closingBrace = msg.lastIndexOf("}");
-                            if (closingBrace > 0) {
-                                String modifiedMsg = msg.substring(0, closingBrace) + 
-                                                   ",\"fromPeerId\":\"" + conn->clientPeerId + "\"}";
-                                webSocket.sendTXT(targetConn->num, modifiedMsg);
-                            } else {
-                                webSocket.sendTXT(targetConn->num, payload, length);
-                            }
-                        } else {
-                            // Already has fromPeerId, send as-is
-                            webSocket.sendTXT(targetConn->num, payload, length);
-                        }
-                    } else {
-                        // Target NOT local - relay through bootstrap hub if connected
-                        Serial.printf("[SIGNAL] ⚠️  Target peer %s not local\n", targetPeerId.substring(0, 8).c_str());
-                        
-                        if (bootstrapConnected) {
-                            Serial.printf("[SIGNAL] 🔄 Relaying %s to bootstrap hub\n", msgType.c_str());
-                            
-                            // Ensure fromPeerId is set before relaying
-                            int fromPeerIdPos = msg.indexOf("\"fromPeerId\":");
-                            if (fromPeerIdPos == -1) {
-                                int closingBrace = msg.lastIndexOf("}");
-                                if (closingBrace > 0) {
-                                    String modifiedMsg = msg.substring(0, closingBrace) + 
-                                                       ",\"fromPeerId\":\"" + conn->clientPeerId + "\"}";
-                                    bootstrapHub.sendTXT(modifiedMsg);
-                                } else {
-                                    bootstrapHub.sendTXT(payload, length);
-                                }
-                            } else {
-                                bootstrapHub.sendTXT(payload, length);
-                            }
-                        } else {
-                            Serial.println("[SIGNAL] ❌ Bootstrap hub not connected, cannot relay");
-                            Serial.println("[SIGNAL] Active LOCAL peers:");
-                            for (int i = 0; i < MAX_CONNECTIONS; i++) {
-                                if (connections[i].active) {
-                                    Serial.printf("  - %s\n", connections[i].clientPeerId.c_str());
-                                }
-                            }
-                        }
-                    }
-                } else {
-                    Serial.println("[SIGNAL] ❌ No targetPeerId in signaling message");
-                    Serial.printf("[SIGNAL] Message: %s\n", msg.c_str());
-                }
-                
-            } else if (msgType == "goodbye") {
-                Serial.printf("[WS] Peer %s said goodbye\n", conn->clientPeerId.substring(0, 8).c_str());
-                // Let disconnection handler take care of cleanup
-                
+            if (type == WStype_FRAGMENT_TEXT_START || type == WStype_FRAGMENT_BIN_START) {
+                streamStart(conn, frameWire, payload, length);
             } else {
-                Serial.printf("[WS] Unknown message type: %s\n", msgType.c_str());
+                handlePeerMessage(conn, frameWire, payload, length);
             }
             break;
         }
             
-        case WStype_BIN:
-            Serial.printf("[WS] Binary messages not supported\n");
+        case WStype_FRAGMENT:
+        case WStype_FRAGMENT_FIN: {
+            Connection* conn = findConnectionByNum(num);
+            if (!conn) return;
+            conn->last_seen = millis();
+            
+            StreamRelay* st = &streams[num];
+            if (streamContinue(conn, payload, length, type == WStype_FRAGMENT_FIN)) {
+                handlePeerMessage(conn, st->wire, st->buf.data, st->buf.len);
+                streamEnd(st);
+            }
             break;
+        }
             
         case WStype_ERROR:
-            Serial.printf("[WS] Error from %u\n", num);
+            hubLog("[WS] Error from %u\n", num);
             break;
             
         case WStype_PING:
@@ -1031,6 +3202,7 @@ void webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length)
 
 void setup() {
     Serial.begin(115200);
+    initMemoryPlacement();
     
     // Wait for USB CDC to be ready (ESP32-C3 USB JTAG)
     unsigned long start = millis();
@@ -1047,21 +3219,43 @@ void setup() {
     Serial.printf("Chip: %s\n", ESP.getChipModel());
     Serial.printf("CPU Freq: %d MHz\n", ESP.getCpuFreqMHz());
     
-    // Generate Hub Peer ID from SHA-1 hash of MAC address
+    // Restore state kept in RTC memory across the last reset, if any
+    nsInit(&namespaces);
+    nsUsageInit(&nsUsage);
+    remoteCacheInit(&remotePeers, REMOTE_PEER_TTL_MS);
     uint8_t mac[6];
     esp_efuse_mac_get_default(mac);
+    warmBoot = restoreWarmState();
+    hubCounters.boots++;
+    if (warmBoot) {
+        hubCounters.warmBoots++;
+        Serial.printf("♻️  Warm restart (reset reason %d): restored hub state, uplink %s:%u, boot #%u\n",
+                      esp_reset_reason(), bootstrapHost.c_str(), bootstrapPort, hubCounters.boots);
+    } else {
+        // Cold start: generate Hub Peer ID from SHA-1 hash of MAC address
+        memset(&hubCounters, 0, sizeof(hubCounters));
+        hubCounters.boots = 1;
+        
+        // Compute SHA-1 hash of MAC address
+        uint8_t sha1Hash[20];
+        mbedtls_sha1(mac, 6, sha1Hash);
+        
+        // Convert hash to 40-character hex string (PeerPigeon format)
+        char hashStr[41];
+        for (int i = 0; i < 20; i++) {
+            sprintf(&hashStr[i * 2], "%02x", sha1Hash[i]);
+        }
+        hashStr[40] = '\0';
+        hubPeerId = String(hashStr);
+    }
+    saveWarmState();
     
-    // Compute SHA-1 hash of MAC address
-    uint8_t sha1Hash[20];
-    mbedtls_sha1(mac, 6, sha1Hash);
+    // Site-specific message filters stored in NVS
+    filterPipelineInit(&filters, filterClock);
+    loadFilterPlugins();
     
-    // Convert hash to 40-character hex string (PeerPigeon format)
-    char hashStr[41];
-    for (int i = 0; i < 20; i++) {
-        sprintf(&hashStr[i * 2], "%02x", sha1Hash[i]);
-    }
-    hashStr[40] = '\0';
-    hubPeerId = String(hashStr);
+    iceCoalescerInit(&iceCoalescer, ICE_BATCH_WINDOW_MS, flushIceBatch);
+    arenaInit(&eventArena, eventArenaBuf, sizeof(eventArenaBuf));
     
     Serial.printf("MAC: %02x:%02x:%02x:%02x:%02x:%02x\n", 
                   mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
@@ -1073,6 +3267,13 @@ void setup() {
     for (int i = 0; i < MAX_CONNECTIONS; i++) {
         connections[i].active = false;
     }
+    peerDirInit(&peerDirectory);
+    signalTimingInit(&signalTiming, SIGNAL_PAIR_IDLE_MS);
+    uplinkMuxInit(&uplinkMux, &memPolicy, UPLINK_MUX_RATE, UPLINK_MUX_BURST, UPLINK_MUX_QUANTUM,
+                  UPLINK_QUEUE_MAX, millis());
+    admissionInit(&admission, ADMIT_RATE, ADMIT_BURST, ADMIT_PENDING_MAX, ADMIT_JITTER_MS, millis());
+    uplinkBackoffInit(&uplinkBackoff, UPLINK_BACKOFF_MIN_MS, UPLINK_BACKOFF_MAX_MS, UPLINK_STABLE_MS);
+    drainInit(&drain);
     Serial.println("Connections array initialized");
     
     // ALWAYS start Access Point (for configuration/management)
@@ -1145,6 +3346,7 @@ void setup() {
     Serial.println("\nStarting DNS server...");
     dnsServer.start(DNS_PORT, "*", apIP);
     Serial.printf("DNS server started on port %d\n", DNS_PORT);
+    startStun();
     Serial.printf("Free heap after DNS: %d bytes\n", ESP.getFreeHeap());
     
     // Set up web server routes (works for both AP and STA)
@@ -1165,6 +3367,15 @@ void setup() {
     webServer.on("/api/scan", handleScan);
     webServer.on("/api/save", HTTP_POST, handleSave);
     webServer.on("/api/reset", handleReset);
+    webServer.on("/api/module", HTTP_GET, handleModuleStatus);
+    webServer.on("/api/module", HTTP_POST, handleModuleDone, handleModuleUpload);
+    webServer.on("/api/plugins", HTTP_GET, handlePluginStatus);
+    webServer.on("/api/plugins", HTTP_POST, handlePluginDone, handlePluginUpload);
+    webServer.on("/api/plugins/remove", HTTP_POST, handlePluginRemove);
+    webServer.on("/api/wire", HTTP_GET, handleWireStats);
+    webServer.on("/api/namespaces", HTTP_GET, handleNamespaceUsage);
+    webServer.on("/api/latency", HTTP_GET, handleSignalLatency);
+    webServer.on("/api/memory", HTTP_GET, handleMemoryStats);
     webServer.onNotFound(handleRoot);
     webServer.begin();
     Serial.println("HTTP server started on port 80");
@@ -1183,6 +3394,7 @@ void setup() {
     Serial.printf("Max Peers: %d\n", MAX_CONNECTIONS);
     Serial.printf("Network: %s\n", HUB_MESH_NAMESPACE);
     Serial.printf("Free heap: %d bytes\n", ESP.getFreeHeap());
+    printRamBudget();
     
     // Start WebSocket server (binds to all interfaces)
     Serial.println("\n🚀 Starting WebSocket server...");
@@ -1206,15 +3418,8 @@ void setup() {
         Serial.println("\n🔗 Connecting to bootstrap hub...");
         Serial.printf("Bootstrap: %s\n", BOOTSTRAP_HUB);
         
-        // Parse bootstrap hub URL
-        String bootstrapUrl = String(BOOTSTRAP_HUB);
-        String host = "pigeonhub.fly.dev";
-        uint16_t port = 443;  // WSS uses 443
-        String path = "/?peerId=" + hubPeerId;
-        
-        bootstrapHub.beginSSL(host, port, path);
-        bootstrapHub.onEvent(bootstrapHubEvent);
-        bootstrapHub.setReconnectInterval(BOOTSTRAP_RETRY_INTERVAL);
+        connectBootstrap();
+        uplinkEnter(UPLINK_CONNECTING);
         Serial.println("✅ Bootstrap hub connection initiated");
     }
     Serial.printf("\nFree heap: %d bytes\n", ESP.getFreeHeap());
@@ -1224,6 +3429,7 @@ void loop() {
     // Always handle DNS and web server (for AP configuration)
     dnsServer.processNextRequest();
     webServer.handleClient();
+    stunPoll();
     
     // Track WiFi connection state changes
     static bool was_connected = is_sta_connected;
@@ -1238,32 +3444,30 @@ void loop() {
         Serial.printf("  - AP: ws://%s:%d/\n", WiFi.softAPIP().toString().c_str(), SERVER_PORT);
         Serial.printf("  - WiFi: ws://%s:%d/\n", WiFi.localIP().toString().c_str(), SERVER_PORT);
         Serial.println("====================================\n");
-        
-        // Connect to bootstrap hub when WiFi comes up
-        if (!bootstrapConnected) {
-            Serial.println("🔗 Initiating bootstrap hub connection...");
-            String host = "pigeonhub.fly.dev";
-            uint16_t port = 443;
-            String path = "/?peerId=" + hubPeerId;
-            bootstrapHub.beginSSL(host, port, path);
-            bootstrapHub.onEvent(bootstrapHubEvent);
-            bootstrapHub.setReconnectInterval(BOOTSTRAP_RETRY_INTERVAL);
-        }
     } else if (!now_connected && was_connected) {
         Serial.println("\n⚠️  WiFi Disconnected! (AP still active)\n");
-        bootstrapConnected = false;
     }
     
     was_connected = now_connected;
     is_sta_connected = now_connected;
     
+    // Hand over to a freshly prepared protocol module between events
+    if (swapState == SWAP_READY) {
+        completeModuleSwap();
+    }
+    
     // Always run WebSocket server (available on both AP and WiFi)
     webSocket.loop();
-    
-    // Handle bootstrap hub connection if WiFi is connected
-    if (is_sta_connected) {
-        bootstrapHub.loop();
+    {
+        EventScope scope;
+        iceCoalescerPoll(&iceCoalescer, millis());
+        signalTimingPoll(&signalTiming, millis());
+        streamPoll();
     }
+    drainPoll();
+    
+    // Bootstrap hub connection (needs WiFi)
+    uplinkStep(is_sta_connected);
     
     // Periodic status update with WebSocket loop confirmation
     static unsigned long lastStatus = 0;
@@ -1291,15 +3495,24 @@ void loop() {
             }
         }
         Serial.printf("Bootstrap: %s %s\n", 
-                     bootstrapConnected ? "CONNECTED ✅" : "DISCONNECTED ❌",
+                     uplinkState == UPLINK_READY ? "CONNECTED ✅" : "DISCONNECTED ❌",
                      !now_connected ? "(requires WiFi)" : "");
         Serial.printf("Free Heap: %d bytes\n", ESP.getFreeHeap());
         Serial.printf("WS Loops: %lu\n", loopCount);
+        Serial.printf("Frames: in %u, relayed %u, uplinked %u, missed %u\n",
+                     hubCounters.framesIn, hubCounters.framesRelayed,
+                     hubCounters.framesUplinked, hubCounters.relayMisses);
+        Serial.printf("Boots: %u (%u warm)\n", hubCounters.boots, hubCounters.warmBoots);
         Serial.println("===================================\n");
         
         lastStatus = millis();
         loopCount = 0;
     }
     
+    // Keep the warm-restart snapshot current
+    if (millis() - lastWarmSave > WARM_SAVE_INTERVAL) {
+        saveWarmState();
+    }
+    
     delay(10);
 }
@@ -0,0 +1,102 @@
+/*
+ * PigeonHub Memory Placement
+ */
+
+#include "mem_policy.h"
+#include <string.h>
+
+// Keeps the block behind it 8-byte aligned
+struct MemHeader {
+    uint32_t size;
+    uint8_t tier;
+    uint8_t pad[3];
+};
+
+static_assert(sizeof(MemHeader) == 8, "MemHeader must preserve 8-byte alignment");
+
+static MemHeader* headerOf(const void* p) {
+    return (MemHeader*)((uint8_t*)p - sizeof(MemHeader));
+}
+
+static void bump(uint32_t* counter) {
+    __atomic_add_fetch(counter, 1, __ATOMIC_RELAXED);
+}
+
+static void placed(MemTierStats* stats, size_t size) {
+    bump(&stats->allocs);
+    size_t bytes = __atomic_add_fetch(&stats->bytes, size, __ATOMIC_RELAXED);
+    size_t high = __atomic_load_n(&stats->highWater, __ATOMIC_RELAXED);
+    while (bytes > high &&
+           !__atomic_compare_exchange_n(&stats->highWater, &high, bytes, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+static void* tryTier(MemPolicy* policy, uint8_t tier, size_t size) {
+    MemHeader* h = (MemHeader*)policy->backend->alloc(tier, sizeof(MemHeader) + size);
+    if (!h) {
+        bump(&policy->tiers[tier].failures);
+        return NULL;
+    }
+    h->size = (uint32_t)size;
+    h->tier = tier;
+    placed(&policy->tiers[tier], size);
+    return h + 1;
+}
+
+void memPolicyInit(MemPolicy* policy, const MemBackend* backend, bool psram, size_t bulkMin) {
+    memset(policy, 0, sizeof(*policy));
+    policy->backend = backend;
+    policy->psram = psram;
+    policy->bulkMin = bulkMin;
+}
+
+void* memAlloc(MemPolicy* policy, uint8_t use, size_t size) {
+    if (size > UINT32_MAX - sizeof(MemHeader)) return NULL;
+
+    if (use == MEM_BULK && policy->psram && size >= policy->bulkMin) {
+        void* p = tryTier(policy, MEM_PSRAM, size);
+        if (p) return p;
+        bump(&policy->fallbacks);
+    }
+    return tryTier(policy, MEM_INTERNAL, size);
+}
+
+void* memCalloc(MemPolicy* policy, uint8_t use, size_t count, size_t size) {
+    if (size && count > SIZE_MAX / size) return NULL;
+    void* p = memAlloc(policy, use, count * size);
+    if (p) memset(p, 0, count * size);
+    return p;
+}
+
+void* memRealloc(MemPolicy* policy, void* p, uint8_t use, size_t size) {
+    if (!p) return memAlloc(policy, use, size);
+    if (size == 0) {
+        memFree(policy, p);
+        return NULL;
+    }
+
+    // The backend has no realloc, and the block may belong in the other tier
+    // now anyway; callers grow geometrically, so the copies stay cheap
+    MemHeader* h = headerOf(p);
+    if (size <= h->size && (size_t)h->size - size < policy->bulkMin) return p;
+
+    void* moved = memAlloc(policy, use, size);
+    if (!moved) return NULL;
+    memcpy(moved, p, size < h->size ? size : h->size);
+    memFree(policy, p);
+    return moved;
+}
+
+void memFree(MemPolicy* policy, void* p) {
+    if (!p) return;
+    MemHeader* h = headerOf(p);
+    MemTierStats* stats = &policy->tiers[h->tier];
+    bump(&stats->frees);
+    __atomic_sub_fetch(&stats->bytes, (size_t)h->size, __ATOMIC_RELAXED);
+    policy->backend->release(h);
+}
+
+uint8_t memTierOf(const void* p) {
+    return headerOf(p)->tier;
+}
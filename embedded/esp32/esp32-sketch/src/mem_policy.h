@@ -0,0 +1,73 @@
+/*
+ * PigeonHub Memory Placement
+ *
+ * Two-tier allocation policy for boards with PSRAM. HOT memory (touched on
+ * every frame: connection records, parse state) always comes from internal
+ * RAM. BULK memory (TLS record buffers, frames waiting to be sent, upload and
+ * reassembly buffers) is large and latency tolerant, so blocks of at least
+ * bulkMin bytes go to PSRAM, falling back to internal RAM when PSRAM is
+ * missing or full.
+ *
+ * The tiers are provided by a MemBackend (heap_caps on the ESP32), so the
+ * policy can be run against a simulated two-tier heap on Linux. Each block
+ * carries a small header recording its tier and size, which is what lets
+ * memFree() keep per-tier statistics. Counters are updated atomically:
+ * mbedTLS allocates from other tasks too.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_MEM_POLICY_H
+#define PIGEONHUB_MEM_POLICY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+enum MemTier {
+    MEM_INTERNAL = 0,
+    MEM_PSRAM,
+    MEM_TIER_COUNT
+};
+
+enum MemUse {
+    MEM_HOT = 0,
+    MEM_BULK
+};
+
+struct MemBackend {
+    void* (*alloc)(uint8_t tier, size_t size);  // NULL when the tier is exhausted
+    void (*release)(void* p);
+};
+
+struct MemTierStats {
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t failures;  // Requests this tier couldn't serve
+    size_t bytes;       // Live bytes placed in this tier (without headers)
+    size_t highWater;
+};
+
+struct MemPolicy {
+    const MemBackend* backend;
+    bool psram;
+    size_t bulkMin;
+    MemTierStats tiers[MEM_TIER_COUNT];
+    uint32_t fallbacks;  // BULK blocks that ended up in internal RAM because PSRAM was full
+};
+
+void memPolicyInit(MemPolicy* policy, const MemBackend* backend, bool psram, size_t bulkMin);
+
+// NULL if neither tier can serve the request
+void* memAlloc(MemPolicy* policy, uint8_t use, size_t size);
+void* memCalloc(MemPolicy* policy, uint8_t use, size_t count, size_t size);
+
+// realloc() semantics; a block that grows past bulkMin may move to PSRAM
+void* memRealloc(MemPolicy* policy, void* p, uint8_t use, size_t size);
+
+// p must come from this policy (or be NULL)
+void memFree(MemPolicy* policy, void* p);
+
+// Tier a block was placed in
+uint8_t memTierOf(const void* p);
+
+#endif // PIGEONHUB_MEM_POLICY_H
@@ -0,0 +1,14 @@
+// Protocol module signing key
+//
+// Modules uploaded to POST /api/module must be signed with the private half
+// of this ECDSA P-256 key (see `make signed` in embedded/esp32). Paste the
+// PEM public key below; while it is empty, module uploads are refused.
+//
+//   openssl ecparam -name prime256v1 -genkey -noout -out module_signing_key.pem
+//   openssl ec -in module_signing_key.pem -pubout
+#ifndef PIGEONHUB_MODULE_KEY_H
+#define PIGEONHUB_MODULE_KEY_H
+
+static const char MODULE_SIGNING_PUBKEY[] = "";
+
+#endif // PIGEONHUB_MODULE_KEY_H
@@ -0,0 +1,61 @@
+/*
+ * PigeonHub Namespace Table
+ */
+
+#include "namespace_table.h"
+#include <string.h>
+
+void nsInit(NamespaceTable* table) {
+    memset(table, 0, sizeof(*table));
+}
+
+int nsFind(const NamespaceTable* table, const char* name, size_t len) {
+    if (len == 0 || len >= NAMESPACE_NAME_LEN) return NAMESPACE_NONE;
+    for (int i = 0; i < NAMESPACE_MAX; i++) {
+        if (table->names[i][0] != '\0' &&
+            strncmp(table->names[i], name, len) == 0 && table->names[i][len] == '\0') {
+            return i;
+        }
+    }
+    return NAMESPACE_NONE;
+}
+
+int nsAcquire(NamespaceTable* table, const char* name, size_t len, uint32_t now) {
+    int id = nsFind(table, name, len);
+
+    if (id == NAMESPACE_NONE) {
+        if (len == 0 || len >= NAMESPACE_NAME_LEN) return NAMESPACE_NONE;
+
+        // Prefer an empty slot, otherwise evict the least recently used
+        // unreferenced name
+        for (int i = 0; i < NAMESPACE_MAX; i++) {
+            if (table->names[i][0] == '\0') {
+                id = i;
+                break;
+            }
+            if (table->refs[i] == 0 &&
+                (id == NAMESPACE_NONE || table->lastUsed[i] < table->lastUsed[id])) {
+                id = i;
+            }
+        }
+        if (id == NAMESPACE_NONE) return NAMESPACE_NONE;
+
+        memcpy(table->names[id], name, len);
+        table->names[id][len] = '\0';
+        table->refs[id] = 0;
+    }
+
+    table->refs[id]++;
+    table->lastUsed[id] = now;
+    return id;
+}
+
+void nsRelease(NamespaceTable* table, int id) {
+    if (id < 0 || id >= NAMESPACE_MAX) return;
+    if (table->refs[id] > 0) table->refs[id]--;
+}
+
+const char* nsName(const NamespaceTable* table, int id) {
+    if (id < 0 || id >= NAMESPACE_MAX) return "";
+    return table->names[id];
+}
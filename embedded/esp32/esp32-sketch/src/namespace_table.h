@@ -0,0 +1,42 @@
+/*
+ * PigeonHub Namespace Table
+ *
+ * Interns network namespace names so connections carry a small index
+ * instead of a heap String, and namespace comparisons are integer compares.
+ * Slots are reference counted by active connections; unreferenced names
+ * stay cached (and survive warm restarts) until the slot is needed again.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_NAMESPACE_TABLE_H
+#define PIGEONHUB_NAMESPACE_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define NAMESPACE_MAX       20   // One per connection is the worst case
+#define NAMESPACE_NAME_LEN  32   // Including terminator; longer names are rejected
+#define NAMESPACE_NONE      -1
+
+struct NamespaceTable {
+    char names[NAMESPACE_MAX][NAMESPACE_NAME_LEN];
+    uint8_t refs[NAMESPACE_MAX];
+    uint32_t lastUsed[NAMESPACE_MAX];  // For evicting unreferenced names
+};
+
+void nsInit(NamespaceTable* table);
+
+// Returns the index of name, or NAMESPACE_NONE
+int nsFind(const NamespaceTable* table, const char* name, size_t len);
+
+// Finds or adds name and takes a reference. Returns NAMESPACE_NONE if the
+// name is too long or every slot is referenced.
+int nsAcquire(NamespaceTable* table, const char* name, size_t len, uint32_t now);
+
+void nsRelease(NamespaceTable* table, int id);
+
+// Returns the name for id, or "" for NAMESPACE_NONE
+const char* nsName(const NamespaceTable* table, int id);
+
+#endif // PIGEONHUB_NAMESPACE_TABLE_H
@@ -0,0 +1,92 @@
+/*
+ * PigeonHub Namespace Usage
+ */
+
+#include "namespace_usage.h"
+#include <string.h>
+
+static NsUsage* slot(NamespaceUsage* usage, int id) {
+    return id >= 0 && id < NAMESPACE_MAX ? &usage->ns[id] : NULL;
+}
+
+void nsUsageInit(NamespaceUsage* usage) {
+    memset(usage, 0, sizeof(*usage));
+}
+
+void nsUsageReset(NamespaceUsage* usage, int id, uint32_t now) {
+    NsUsage* ns = slot(usage, id);
+    if (!ns) return;
+    memset(ns, 0, sizeof(*ns));
+    ns->sinceMs = now;
+}
+
+void nsUsageFrame(NamespaceUsage* usage, int id, uint8_t direction, uint8_t type, size_t len) {
+    NsUsage* ns = slot(usage, id);
+    if (!ns || direction >= NS_DIRECTION_COUNT) return;
+    if (type >= WIRE_TYPE_COUNT) type = WIRE_OTHER;
+    ns->frames[direction][type]++;
+    ns->bytes[direction] += len;
+}
+
+void nsUsageBytes(NamespaceUsage* usage, int id, uint8_t direction, size_t len) {
+    NsUsage* ns = slot(usage, id);
+    if (ns && direction < NS_DIRECTION_COUNT) ns->bytes[direction] += len;
+}
+
+void nsUsageJoin(NamespaceUsage* usage, int id, uint32_t peers) {
+    NsUsage* ns = slot(usage, id);
+    if (!ns) return;
+    ns->joins++;
+    if (peers > ns->peersMax) ns->peersMax = peers;
+}
+
+void nsUsageRelayMiss(NamespaceUsage* usage, int id) {
+    NsUsage* ns = slot(usage, id);
+    if (ns) ns->relayMisses++;
+}
+
+void nsUsageIntroductions(NamespaceUsage* usage, int id, uint32_t count) {
+    NsUsage* ns = slot(usage, id);
+    if (ns) ns->introductions += count;
+}
+
+uint32_t nsUsageFrames(const NsUsage* ns, uint8_t direction) {
+    uint32_t total = 0;
+    for (int t = 0; t < WIRE_TYPE_COUNT; t++) total += ns->frames[direction][t];
+    return total;
+}
+
+static uint64_t rankValue(const NamespaceUsage* usage, const NamespaceTable* table, int id, uint8_t rank) {
+    const NsUsage* ns = &usage->ns[id];
+    uint64_t value = 0;
+    if (rank == NS_RANK_PEERS) return table->refs[id];
+    for (uint8_t d = 0; d < NS_DIRECTION_COUNT; d++) {
+        value += rank == NS_RANK_FRAMES ? nsUsageFrames(ns, d) : ns->bytes[d];
+    }
+    return value;
+}
+
+int nsUsageTop(const NamespaceUsage* usage, const NamespaceTable* table, uint8_t rank, int* ids, int max) {
+    int ranked[NAMESPACE_MAX];
+    uint64_t values[NAMESPACE_MAX];
+    int count = 0;
+    for (int i = 0; i < NAMESPACE_MAX; i++) {
+        if (table->names[i][0] == '\0') continue;
+        ranked[count] = i;
+        values[count] = rankValue(usage, table, i, rank);
+        count++;
+    }
+
+    if (max > count) max = count;
+    // Partial selection sort: max is small next to NAMESPACE_MAX
+    for (int i = 0; i < max; i++) {
+        int best = i;
+        for (int j = i + 1; j < count; j++) {
+            if (values[j] > values[best]) best = j;
+        }
+        ids[i] = ranked[best];
+        ranked[best] = ranked[i];
+        values[best] = values[i];
+    }
+    return max;
+}
@@ -0,0 +1,75 @@
+/*
+ * PigeonHub Namespace Usage
+ *
+ * Per-namespace traffic accounting for capacity planning: which networks
+ * bring the peers, frames and bytes a hub carries. There is one record per
+ * namespace table slot, so memory is fixed and counting a frame is an
+ * array index. Frames are counted by direction and wire type, and bytes by
+ * direction. Relay misses and discovery fan-out are counted as well. A
+ * record is reset when its slot is handed to a new name; peer counts come
+ * from the table's reference counts.
+ *
+ * Ranking (top-N by bytes, frames or peers) runs only when asked for, over
+ * NAMESPACE_MAX records.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_NAMESPACE_USAGE_H
+#define PIGEONHUB_NAMESPACE_USAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "namespace_table.h"
+#include "wire_codec.h"
+
+enum NsUsageDirection {
+    NS_FROM_PEER,     // Local peer to hub
+    NS_TO_PEER,       // Hub to local peer
+    NS_TO_UPLINK,     // On behalf of a local peer, to the bootstrap hub
+    NS_FROM_UPLINK,   // From the bootstrap hub, for the namespace's peers
+    NS_DIRECTION_COUNT
+};
+
+enum NsUsageRank {
+    NS_RANK_BYTES,
+    NS_RANK_FRAMES,
+    NS_RANK_PEERS
+};
+
+struct NsUsage {
+    uint32_t frames[NS_DIRECTION_COUNT][WIRE_TYPE_COUNT];
+    uint32_t bytes[NS_DIRECTION_COUNT];
+    uint32_t joins;           // Announces into the namespace
+    uint32_t peersMax;
+    uint32_t relayMisses;     // Signaling with nowhere to go
+    uint32_t introductions;   // peer-discovered messages sent to newcomers and their peers
+    uint32_t sinceMs;         // When counting started
+};
+
+struct NamespaceUsage {
+    NsUsage ns[NAMESPACE_MAX];
+};
+
+void nsUsageInit(NamespaceUsage* usage);
+
+// Slot id now holds a different name
+void nsUsageReset(NamespaceUsage* usage, int id, uint32_t now);
+
+// One frame of len bytes; ignored for NAMESPACE_NONE
+void nsUsageFrame(NamespaceUsage* usage, int id, uint8_t direction, uint8_t type, size_t len);
+
+// More bytes of a frame already counted (a streamed message)
+void nsUsageBytes(NamespaceUsage* usage, int id, uint8_t direction, size_t len);
+
+void nsUsageJoin(NamespaceUsage* usage, int id, uint32_t peers);
+void nsUsageRelayMiss(NamespaceUsage* usage, int id);
+void nsUsageIntroductions(NamespaceUsage* usage, int id, uint32_t count);
+
+uint32_t nsUsageFrames(const NsUsage* ns, uint8_t direction);
+
+// Fills ids with up to max named slots, highest first by `rank`; returns
+// how many
+int nsUsageTop(const NamespaceUsage* usage, const NamespaceTable* table, uint8_t rank, int* ids, int max);
+
+#endif // PIGEONHUB_NAMESPACE_USAGE_H
@@ -0,0 +1,73 @@
+/*
+ * PigeonHub Peer Directory
+ */
+
+#include "peer_directory.h"
+#include <string.h>
+
+static const unsigned MASK = PEER_DIR_SLOTS - 1;
+
+static_assert((PEER_DIR_SLOTS & MASK) == 0, "PEER_DIR_SLOTS must be a power of two");
+
+static unsigned home(const uint8_t* id) {
+    return (id[0] | (id[1] << 8) | (id[2] << 16) | ((unsigned)id[3] << 24)) & MASK;
+}
+
+// Slot holding id, or the empty slot ending its probe run
+static unsigned probe(const PeerDirectory* dir, const uint8_t* id, uint32_t* probes) {
+    unsigned i = home(id);
+    for (unsigned n = 0; n < PEER_DIR_SLOTS; n++, i = (i + 1) & MASK) {
+        if (probes) (*probes)++;
+        if (dir->owners[i] == PEER_DIR_NONE ||
+            memcmp(dir->ids[i], id, WIRE_PEER_ID_LEN) == 0) {
+            return i;
+        }
+    }
+    return PEER_DIR_SLOTS;  // Full and absent; put() never lets this happen
+}
+
+void peerDirInit(PeerDirectory* dir) {
+    memset(dir, 0, sizeof(*dir));
+    memset(dir->owners, PEER_DIR_NONE, sizeof(dir->owners));
+}
+
+bool peerDirPut(PeerDirectory* dir, const uint8_t id[WIRE_PEER_ID_LEN], uint8_t owner) {
+    unsigned i = probe(dir, id, NULL);
+    if (i == PEER_DIR_SLOTS) return false;
+    if (dir->owners[i] == PEER_DIR_NONE) {
+        if (dir->count >= PEER_DIR_SLOTS - 1) return false;  // Keep one slot empty to end probes
+        memcpy(dir->ids[i], id, WIRE_PEER_ID_LEN);
+        dir->count++;
+    }
+    dir->owners[i] = owner;
+    return true;
+}
+
+uint8_t peerDirGet(PeerDirectory* dir, const uint8_t id[WIRE_PEER_ID_LEN]) {
+    dir->lookups++;
+    unsigned i = probe(dir, id, &dir->probes);
+    if (i == PEER_DIR_SLOTS || dir->owners[i] == PEER_DIR_NONE) return PEER_DIR_NONE;
+    dir->hits++;
+    return dir->owners[i];
+}
+
+void peerDirRemove(PeerDirectory* dir, const uint8_t id[WIRE_PEER_ID_LEN], uint8_t owner) {
+    unsigned i = probe(dir, id, NULL);
+    if (i == PEER_DIR_SLOTS || dir->owners[i] != owner) return;
+
+    // Backward shift: pull later entries of the run into the hole unless
+    // that would move them before their home slot
+    unsigned j = i;
+    for (;;) {
+        j = (j + 1) & MASK;
+        if (dir->owners[j] == PEER_DIR_NONE) break;
+        unsigned k = home(dir->ids[j]);
+        bool movable = (i <= j) ? (k <= i || k > j) : (k <= i && k > j);
+        if (!movable) continue;
+        memcpy(dir->ids[i], dir->ids[j], WIRE_PEER_ID_LEN);
+        dir->owners[i] = dir->owners[j];
+        i = j;
+    }
+    dir->owners[i] = PEER_DIR_NONE;
+    dir->count--;
+}
@@ -0,0 +1,50 @@
+/*
+ * PigeonHub Peer Directory
+ *
+ * Maps binary peer IDs to the connection that owns them, so a targeted
+ * signaling frame is routed with one hash probe instead of a scan of the
+ * connection table comparing 20-byte IDs. Read on every such frame,
+ * written only when a peer connects or disconnects.
+ *
+ * Open addressing with linear probing. Removal shifts the rest of the probe
+ * run back instead of leaving tombstones, so lookups stay short however much
+ * peers churn. Peer IDs are SHA-1 output, so their first bytes are already
+ * a good hash; a client that picks colliding IDs only lengthens probe runs,
+ * which PEER_DIR_SLOTS bounds.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_PEER_DIRECTORY_H
+#define PIGEONHUB_PEER_DIRECTORY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "wire_codec.h"
+
+#define PEER_DIR_SLOTS  32    // Power of two; keep entries at or under 3/4 of it
+#define PEER_DIR_NONE   0xFF  // Empty slot / not found
+
+struct PeerDirectory {
+    uint8_t ids[PEER_DIR_SLOTS][WIRE_PEER_ID_LEN];
+    uint8_t owners[PEER_DIR_SLOTS];
+    uint8_t count;
+
+    uint32_t lookups;
+    uint32_t hits;
+    uint32_t probes;  // Slots examined by lookups; probes / lookups is the mean run
+};
+
+void peerDirInit(PeerDirectory* dir);
+
+// Maps id to owner, replacing any existing mapping. Returns false if full.
+bool peerDirPut(PeerDirectory* dir, const uint8_t id[WIRE_PEER_ID_LEN], uint8_t owner);
+
+// Returns the owner of id, or PEER_DIR_NONE
+uint8_t peerDirGet(PeerDirectory* dir, const uint8_t id[WIRE_PEER_ID_LEN]);
+
+// Removes id only if it still maps to owner (a newer connection may have
+// taken the ID over)
+void peerDirRemove(PeerDirectory* dir, const uint8_t id[WIRE_PEER_ID_LEN], uint8_t owner);
+
+#endif // PIGEONHUB_PEER_DIRECTORY_H
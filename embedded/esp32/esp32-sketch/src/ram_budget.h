@@ -0,0 +1,71 @@
+/*
+ * PigeonHub RAM Budget
+ *
+ * Compile-time model of the hub's worst-case memory use. main.cpp lists
+ * every sizeable consumer as a RamItem computed from its configuration, and
+ * static_asserts that the total fits the board selected by PlatformIO; the
+ * breakdown is printed at boot.
+ *
+ * Items marked `movable` are large, latency-tolerant heap blocks that the
+ * placement policy (mem_policy.h) or the heap's own PSRAM threshold puts in
+ * PSRAM, so they count against PSRAM; without PSRAM they count against
+ * internal RAM like everything else.
+ *
+ * Board figures are the heap left to the sketch once the core and WiFi
+ * (AP + STA) are up, with some margin; they are estimates, not datasheet
+ * values. Keep them conservative.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_RAM_BUDGET_H
+#define PIGEONHUB_RAM_BUDGET_H
+
+#include <stddef.h>
+
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+#define BOARD_NAME          "esp32-s3"
+#define BOARD_INTERNAL_RAM  (280 * 1024)
+#elif defined(CONFIG_IDF_TARGET_ESP32C3)
+#define BOARD_NAME          "esp32-c3"
+#define BOARD_INTERNAL_RAM  (250 * 1024)
+#else
+#define BOARD_NAME          "esp32"
+#define BOARD_INTERNAL_RAM  (200 * 1024)
+#endif
+
+#ifdef BOARD_HAS_PSRAM
+#define BOARD_PSRAM         (2 * 1024 * 1024)  // Smallest PSRAM fitted to our boards
+#else
+#define BOARD_PSRAM         0
+#endif
+
+// Estimates for memory owned by libraries
+#define RAM_TLS_SESSION     (16 * 1024)  // mbedTLS uplink: contexts, handshake state
+#define RAM_TLS_RECORDS     (20 * 1024)  // mbedTLS uplink: 16 KB in + 4 KB out record buffers
+#define RAM_WEB_PORTAL      (8 * 1024)   // WebServer, DNSServer, request strings
+#define RAM_WS_CLIENT       (3 * 1024)   // Per socket: lwIP PCB, client record, in-flight segments
+#define RAM_WASM_CODE_FACTOR 1          // wasm3 compiled code per byte of module
+
+struct RamItem {
+    const char* name;
+    size_t bytes;
+    bool movable;
+};
+
+constexpr size_t ramSum(const RamItem* items, size_t count, bool movable) {
+    return count == 0 ? 0 :
+           (items[0].movable == movable ? items[0].bytes : 0) + ramSum(items + 1, count - 1, movable);
+}
+
+// Bytes the items need from internal RAM and from PSRAM on a board with
+// `psram` bytes of PSRAM
+constexpr size_t ramInternal(const RamItem* items, size_t count, size_t psram) {
+    return ramSum(items, count, false) + (psram ? 0 : ramSum(items, count, true));
+}
+
+constexpr size_t ramPsram(const RamItem* items, size_t count, size_t psram) {
+    return psram ? ramSum(items, count, true) : 0;
+}
+
+#endif // PIGEONHUB_RAM_BUDGET_H
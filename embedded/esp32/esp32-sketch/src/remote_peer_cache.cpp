@@ -0,0 +1,122 @@
+/*
+ * PigeonHub Remote Peer Cache
+ */
+
+#include "remote_peer_cache.h"
+#include <string.h>
+
+// FNV-1a
+static uint32_t nsHash(const char* ns, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (uint8_t)ns[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool expiredAt(const RemotePeerCache* cache, const RemotePeer* peer, uint32_t now) {
+    return now - peer->seenMs >= cache->ttlMs;
+}
+
+void remoteCacheInit(RemotePeerCache* cache, uint32_t ttlMs) {
+    memset(cache, 0, sizeof(*cache));
+    cache->ttlMs = ttlMs;
+}
+
+// Finds the entry for (hash, id), else a free slot, else the oldest entry
+static RemotePeer* slotFor(RemotePeerCache* cache, uint32_t hash, const uint8_t* id, uint32_t now) {
+    RemotePeer* slot = NULL;
+    RemotePeer* oldest = NULL;
+    for (int i = 0; i < REMOTE_CACHE_SLOTS; i++) {
+        RemotePeer* peer = &cache->peers[i];
+        if (peer->used && peer->nsHash == hash && memcmp(peer->id, id, REMOTE_CACHE_ID_LEN) == 0) {
+            cache->refreshed++;
+            return peer;
+        }
+        if (!peer->used) {
+            if (!slot) slot = peer;
+        } else if (!oldest || now - peer->seenMs > now - oldest->seenMs) {
+            oldest = peer;
+        }
+    }
+    if (!slot) {
+        slot = oldest;
+        cache->evicted++;
+    }
+    cache->stored++;
+    return slot;
+}
+
+static void fill(RemotePeer* slot, uint32_t hash, const uint8_t* id, uint8_t flags,
+                 const char* data, size_t dataLen, uint32_t seenMs) {
+    slot->used = true;
+    slot->nsHash = hash;
+    memcpy(slot->id, id, REMOTE_CACHE_ID_LEN);
+    slot->flags = flags;
+    slot->seenMs = seenMs;
+    memcpy(slot->data, data, dataLen);
+    slot->data[dataLen] = '\0';
+}
+
+bool remoteCachePut(RemotePeerCache* cache, const char* ns, size_t nsLen, const uint8_t* id,
+                    uint8_t flags, const char* data, size_t dataLen, uint32_t now) {
+    if (dataLen >= REMOTE_CACHE_DATA_MAX) return false;
+    uint32_t hash = nsHash(ns, nsLen);
+    fill(slotFor(cache, hash, id, now), hash, id, flags, data, dataLen, now);
+    return true;
+}
+
+bool remoteCacheRestore(RemotePeerCache* cache, uint32_t hash, const uint8_t* id, uint8_t flags,
+                        const char* data, uint32_t ageMs, uint32_t now) {
+    size_t dataLen = strnlen(data, REMOTE_CACHE_DATA_MAX);
+    if (dataLen >= REMOTE_CACHE_DATA_MAX || ageMs >= cache->ttlMs) return false;
+    fill(slotFor(cache, hash, id, now), hash, id, flags, data, dataLen, now - ageMs);
+    return true;
+}
+
+void remoteCacheRemove(RemotePeerCache* cache, const uint8_t* id) {
+    for (int i = 0; i < REMOTE_CACHE_SLOTS; i++) {
+        RemotePeer* peer = &cache->peers[i];
+        if (peer->used && memcmp(peer->id, id, REMOTE_CACHE_ID_LEN) == 0) {
+            peer->used = false;
+            cache->removed++;
+        }
+    }
+}
+
+int remoteCacheCollect(RemotePeerCache* cache, const char* ns, size_t nsLen, uint32_t now,
+                       RemotePeer** out, int max) {
+    uint32_t hash = nsHash(ns, nsLen);
+    int count = 0;
+    for (int i = 0; i < REMOTE_CACHE_SLOTS; i++) {
+        RemotePeer* peer = &cache->peers[i];
+        if (!peer->used) continue;
+        if (expiredAt(cache, peer, now)) {
+            peer->used = false;
+            cache->expired++;
+        } else if (peer->nsHash == hash && count < max) {
+            out[count++] = peer;
+        }
+    }
+    return count;
+}
+
+void remoteCacheServed(RemotePeerCache* cache, RemotePeer* const* peers, int count, uint32_t now) {
+    cache->lookups++;
+    if (count > 0) cache->hits++;
+    cache->served += count;
+    for (int i = 0; i < count; i++) {
+        uint32_t age = now - peers[i]->seenMs;
+        cache->staleMsTotal += age;
+        if (age > cache->staleMsMax) cache->staleMsMax = age;
+    }
+}
+
+int remoteCacheSize(const RemotePeerCache* cache) {
+    int size = 0;
+    for (int i = 0; i < REMOTE_CACHE_SLOTS; i++) {
+        if (cache->peers[i].used) size++;
+    }
+    return size;
+}
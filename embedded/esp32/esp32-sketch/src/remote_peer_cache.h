@@ -0,0 +1,80 @@
+/*
+ * PigeonHub Remote Peer Cache
+ *
+ * Peers on other hubs reach local peers only as peer-discovered messages the
+ * bootstrap hub pushes when they announce. A local peer that joins later
+ * would never hear of them. The cache keeps the last peer-discovered data
+ * per remote peer and namespace, so a newcomer is introduced to remote peers
+ * at once, along with local ones.
+ *
+ * Entries expire after a TTL. The bootstrap hub doesn't reliably report
+ * remote departures, so the TTL bounds how stale an introduction can be. A
+ * full cache evicts its oldest entry. Namespaces are keyed by a hash of the
+ * name, because remote namespaces need not have a local peer (or a slot in
+ * the namespace table). Two names with the same hash share their entries.
+ *
+ * The cache is carried across warm restarts (warm_state.h).
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_REMOTE_PEER_CACHE_H
+#define PIGEONHUB_REMOTE_PEER_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define REMOTE_CACHE_SLOTS     24
+#define REMOTE_CACHE_DATA_MAX  96  // peer-discovered "data" with terminator; longer isn't cached
+#define REMOTE_CACHE_ID_LEN    20
+
+struct RemotePeer {
+    bool used;
+    uint32_t nsHash;
+    uint8_t id[REMOTE_CACHE_ID_LEN];
+    uint8_t flags;        // Wire flags of the original message (WIRE_FLAG_HUB)
+    uint32_t seenMs;
+    char data[REMOTE_CACHE_DATA_MAX];
+};
+
+struct RemotePeerCache {
+    RemotePeer peers[REMOTE_CACHE_SLOTS];
+    uint32_t ttlMs;
+
+    uint32_t stored;      // New entries
+    uint32_t refreshed;   // Seen again before expiring
+    uint32_t evicted;     // Oldest dropped to make room
+    uint32_t expired;
+    uint32_t removed;     // Reported gone
+    uint32_t lookups;     // Joins that consulted the cache
+    uint32_t hits;        // ...and were introduced to at least one remote peer
+    uint32_t served;      // Remote introductions made from the cache
+    uint64_t staleMsTotal;  // Sum of entry ages when served
+    uint32_t staleMsMax;
+};
+
+void remoteCacheInit(RemotePeerCache* cache, uint32_t ttlMs);
+
+// Stores or refreshes a peer. Returns false if data (NUL-free, dataLen
+// bytes) is too long to cache.
+bool remoteCachePut(RemotePeerCache* cache, const char* ns, size_t nsLen, const uint8_t* id,
+                    uint8_t flags, const char* data, size_t dataLen, uint32_t now);
+
+// Puts back an entry saved across a warm restart (warm_state.h), ageMs old
+// at `now`. Returns false if it has expired meanwhile or data is too long.
+bool remoteCacheRestore(RemotePeerCache* cache, uint32_t nsHash, const uint8_t* id, uint8_t flags,
+                        const char* data, uint32_t ageMs, uint32_t now);
+
+void remoteCacheRemove(RemotePeerCache* cache, const uint8_t* id);
+
+// Live entries for ns, at most max; expired entries are dropped on the way
+int remoteCacheCollect(RemotePeerCache* cache, const char* ns, size_t nsLen, uint32_t now,
+                       RemotePeer** out, int max);
+
+// Records a join: the count peers (from remoteCacheCollect) that it was
+// actually introduced to
+void remoteCacheServed(RemotePeerCache* cache, RemotePeer* const* peers, int count, uint32_t now);
+
+int remoteCacheSize(const RemotePeerCache* cache);
+
+#endif // PIGEONHUB_REMOTE_PEER_CACHE_H
@@ -0,0 +1,123 @@
+/*
+ * PigeonHub Signal Timing
+ */
+
+#include "signal_timing.h"
+#include <string.h>
+
+void signalTimingInit(SignalTiming* timing, uint32_t idleMs) {
+    memset(timing, 0, sizeof(*timing));
+    timing->idleMs = idleMs;
+}
+
+void signalHistRecord(SignalHistogram* hist, uint32_t value) {
+    int bucket = 0;
+    while (bucket < SIGNAL_HIST_BUCKETS - 1 && value >= (1u << bucket)) bucket++;
+    hist->buckets[bucket]++;
+    hist->count++;
+    hist->total += value;
+    if (value > hist->max) hist->max = value;
+}
+
+uint32_t signalHistPercentile(const SignalHistogram* hist, uint32_t p) {
+    if (hist->count == 0) return 0;
+    uint64_t rank = ((uint64_t)hist->count * p + 99) / 100;
+    if (rank == 0) rank = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < SIGNAL_HIST_BUCKETS - 1; i++) {
+        seen += hist->buckets[i];
+        if (seen >= rank) return (1u << i) < hist->max ? (1u << i) : hist->max;
+    }
+    return hist->max;
+}
+
+// Records the candidate spans of a finished pair and frees it
+static void finish(SignalTiming* timing, SignalPair* pair) {
+    if (pair->candidates > 0) {
+        signalHistRecord(&timing->hists[SIGNAL_ICE_SPAN_MS], pair->lastIceMs - pair->firstIceMs);
+        if (pair->offerMs) signalHistRecord(&timing->hists[SIGNAL_SETUP_MS], pair->lastIceMs - pair->offerMs);
+    }
+    pair->used = false;
+}
+
+static SignalPair* findPair(SignalTiming* timing, const uint8_t* offerer, const uint8_t* answerer) {
+    for (int i = 0; i < SIGNAL_PAIRS; i++) {
+        SignalPair* pair = &timing->pairs[i];
+        if (pair->used && memcmp(pair->offerer, offerer, SIGNAL_ID_LEN) == 0 &&
+            memcmp(pair->answerer, answerer, SIGNAL_ID_LEN) == 0) {
+            return pair;
+        }
+    }
+    return NULL;
+}
+
+// A free slot, or the least recently active pair
+static SignalPair* newPair(SignalTiming* timing, const uint8_t* offerer, const uint8_t* answerer) {
+    SignalPair* pair = NULL;
+    for (int i = 0; i < SIGNAL_PAIRS; i++) {
+        SignalPair* p = &timing->pairs[i];
+        if (!p->used) {
+            pair = p;
+            break;
+        }
+        if (!pair || p->lastMs < pair->lastMs) pair = p;
+    }
+    if (pair->used) {
+        timing->evicted++;
+        finish(timing, pair);
+    }
+    memset(pair, 0, sizeof(*pair));
+    pair->used = true;
+    memcpy(pair->offerer, offerer, SIGNAL_ID_LEN);
+    memcpy(pair->answerer, answerer, SIGNAL_ID_LEN);
+    return pair;
+}
+
+void signalForwarded(SignalTiming* timing, uint8_t kind, const uint8_t* from, const uint8_t* to,
+                     bool viaUplink, uint32_t residenceUs, uint32_t now) {
+    signalHistRecord(&timing->hists[SIGNAL_RESIDENCE_US], residenceUs);
+
+    SignalPair* pair = NULL;
+    if (kind == SIGNAL_OFFER) {
+        // A new offer (or renegotiation) restarts the pair
+        pair = findPair(timing, from, to);
+        if (pair) finish(timing, pair);
+        pair = newPair(timing, from, to);
+        pair->offerMs = now ? now : 1;
+    } else if (kind == SIGNAL_ANSWER) {
+        pair = findPair(timing, to, from);
+        if (!pair || !pair->offerMs || pair->answered) {
+            timing->unmatched++;
+            if (!pair) return;
+        } else {
+            pair->answered = true;
+            pair->viaUplink |= viaUplink;
+            signalHistRecord(&timing->hists[pair->viaUplink ? SIGNAL_ANSWER_UPLINK_MS : SIGNAL_ANSWER_LOCAL_MS],
+                             now - pair->offerMs);
+        }
+    } else {
+        pair = findPair(timing, from, to);
+        if (!pair) pair = findPair(timing, to, from);
+        if (!pair) pair = newPair(timing, from, to);
+        if (pair->candidates == 0) pair->firstIceMs = now;
+        pair->lastIceMs = now;
+        pair->candidates++;
+    }
+    pair->viaUplink |= viaUplink;
+    pair->lastMs = now;
+}
+
+void signalTimingPoll(SignalTiming* timing, uint32_t now) {
+    for (int i = 0; i < SIGNAL_PAIRS; i++) {
+        SignalPair* pair = &timing->pairs[i];
+        if (pair->used && now - pair->lastMs >= timing->idleMs) finish(timing, pair);
+    }
+}
+
+int signalActivePairs(const SignalTiming* timing) {
+    int active = 0;
+    for (int i = 0; i < SIGNAL_PAIRS; i++) {
+        if (timing->pairs[i].used) active++;
+    }
+    return active;
+}
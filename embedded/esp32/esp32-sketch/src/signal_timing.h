@@ -0,0 +1,92 @@
+/*
+ * PigeonHub Signal Timing
+ *
+ * How long connection setup takes as seen from the hub. Every signaling
+ * frame is timed from receipt to forwarding, which is its residence in the
+ * hub. Offers, answers and candidates are also tracked per peer pair: the
+ * pair is keyed by the offerer and answerer IDs, and candidates in either
+ * direction belong to it. From that the hub derives:
+ *
+ *   offer -> answer  split by path: both peers local, or one behind the
+ *                    uplink (the difference is what the uplink costs)
+ *   first -> last candidate, and offer -> last candidate (setup)
+ *
+ * Candidate spans are recorded when a pair goes quiet, because the last
+ * candidate is only known in hindsight. Histograms use log2 buckets, so
+ * recording is a bit scan and memory is fixed.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_SIGNAL_TIMING_H
+#define PIGEONHUB_SIGNAL_TIMING_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SIGNAL_HIST_BUCKETS  20  // Bucket i counts values below 2^i; the last is open-ended
+#define SIGNAL_PAIRS         16
+#define SIGNAL_ID_LEN        20
+
+struct SignalHistogram {
+    uint32_t buckets[SIGNAL_HIST_BUCKETS];
+    uint32_t count;
+    uint64_t total;
+    uint32_t max;
+};
+
+struct SignalPair {
+    bool used;
+    uint8_t offerer[SIGNAL_ID_LEN];
+    uint8_t answerer[SIGNAL_ID_LEN];
+    bool viaUplink;       // Some frame of the pair crossed the uplink
+    bool answered;
+    uint32_t offerMs;     // 0 = candidates seen without an offer
+    uint32_t firstIceMs;
+    uint32_t lastIceMs;
+    uint32_t candidates;
+    uint32_t lastMs;
+};
+
+enum SignalHist {
+    SIGNAL_RESIDENCE_US,      // Per frame, receipt to forwarding
+    SIGNAL_ANSWER_LOCAL_MS,   // Offer to answer, both peers local
+    SIGNAL_ANSWER_UPLINK_MS,  // Offer to answer, one peer behind the uplink
+    SIGNAL_ICE_SPAN_MS,       // First to last candidate
+    SIGNAL_SETUP_MS,          // Offer to last candidate
+    SIGNAL_HIST_COUNT
+};
+
+enum SignalKind {
+    SIGNAL_OFFER,
+    SIGNAL_ANSWER,
+    SIGNAL_CANDIDATE      // Single or merged
+};
+
+struct SignalTiming {
+    SignalPair pairs[SIGNAL_PAIRS];
+    SignalHistogram hists[SIGNAL_HIST_COUNT];
+    uint32_t idleMs;      // A pair without frames this long is finished
+
+    uint32_t unmatched;   // Answers without a tracked offer
+    uint32_t evicted;     // Pairs dropped for a new one before going quiet
+};
+
+void signalTimingInit(SignalTiming* timing, uint32_t idleMs);
+
+void signalHistRecord(SignalHistogram* hist, uint32_t value);
+
+// Upper bound of the bucket holding the p-th percentile (0-100), or 0
+uint32_t signalHistPercentile(const SignalHistogram* hist, uint32_t p);
+
+// A signaling frame from `from` to `to` was forwarded, residenceUs after
+// the hub received it
+void signalForwarded(SignalTiming* timing, uint8_t kind, const uint8_t* from, const uint8_t* to,
+                     bool viaUplink, uint32_t residenceUs, uint32_t now);
+
+// Finishes pairs that went quiet
+void signalTimingPoll(SignalTiming* timing, uint32_t now);
+
+int signalActivePairs(const SignalTiming* timing);
+
+#endif // PIGEONHUB_SIGNAL_TIMING_H
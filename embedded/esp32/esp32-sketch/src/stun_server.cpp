@@ -0,0 +1,58 @@
+/*
+ * PigeonHub STUN Responder
+ */
+
+#include "stun_server.h"
+#include <string.h>
+
+#define STUN_BINDING_REQUEST   0x0001
+#define STUN_BINDING_SUCCESS   0x0101
+#define STUN_MAGIC_COOKIE      0x2112A442
+#define STUN_XOR_MAPPED_ADDR   0x0020
+#define STUN_FAMILY_IPV4       0x01
+
+static uint16_t get16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t get32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void put16(uint8_t* p, uint16_t v) {
+    p[0] = v >> 8;
+    p[1] = v & 0xFF;
+}
+
+static void put32(uint8_t* p, uint32_t v) {
+    p[0] = v >> 24;
+    p[1] = (v >> 16) & 0xFF;
+    p[2] = (v >> 8) & 0xFF;
+    p[3] = v & 0xFF;
+}
+
+size_t stunRespond(StunStats* stats, const uint8_t* packet, size_t len,
+                   uint32_t addr, uint16_t port, uint8_t out[STUN_RESPONSE_SIZE]) {
+    // Top two bits zero, attributes padded to 4 bytes and filling the datagram
+    if (len < STUN_HEADER_SIZE || get16(packet) != STUN_BINDING_REQUEST ||
+        get32(packet + 4) != STUN_MAGIC_COOKIE ||
+        get16(packet + 2) % 4 != 0 || (size_t)get16(packet + 2) + STUN_HEADER_SIZE != len) {
+        stats->dropped++;
+        return 0;
+    }
+
+    put16(out, STUN_BINDING_SUCCESS);
+    put16(out + 2, STUN_RESPONSE_SIZE - STUN_HEADER_SIZE);
+    memcpy(out + 4, packet + 4, 16);  // Cookie and transaction ID
+
+    uint8_t* attr = out + STUN_HEADER_SIZE;
+    put16(attr, STUN_XOR_MAPPED_ADDR);
+    put16(attr + 2, 8);
+    attr[4] = 0;
+    attr[5] = STUN_FAMILY_IPV4;
+    put16(attr + 6, port ^ (STUN_MAGIC_COOKIE >> 16));
+    put32(attr + 8, addr ^ STUN_MAGIC_COOKIE);
+
+    stats->requests++;
+    return STUN_RESPONSE_SIZE;
+}
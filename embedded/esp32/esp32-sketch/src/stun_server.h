@@ -0,0 +1,38 @@
+/*
+ * PigeonHub STUN Responder
+ *
+ * Answers RFC 5389 Binding requests so clients can gather server-reflexive
+ * candidates from the hub itself instead of a public STUN server: no extra
+ * round trips on a LAN, and candidates at all on an AP-only network with no
+ * internet. Only the request header is examined (attributes are ignored),
+ * and the success response carries a single XOR-MAPPED-ADDRESS built in the
+ * caller's buffer, so a request costs nothing beyond the stack.
+ *
+ * Only IPv4 is answered. Requests without the magic cookie (RFC 3489) and
+ * anything that isn't a Binding request are dropped silently.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_STUN_SERVER_H
+#define PIGEONHUB_STUN_SERVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define STUN_PORT_DEFAULT   3478
+#define STUN_HEADER_SIZE    20
+#define STUN_RESPONSE_SIZE  32  // Header + XOR-MAPPED-ADDRESS (IPv4)
+
+struct StunStats {
+    uint32_t requests;   // Binding requests answered
+    uint32_t dropped;    // Datagrams that weren't one
+};
+
+// Builds the Binding success response to a `len` byte datagram from IPv4
+// `addr`:`port`, both in host byte order. Returns the response length, or
+// 0 to drop the datagram.
+size_t stunRespond(StunStats* stats, const uint8_t* packet, size_t len,
+                   uint32_t addr, uint16_t port, uint8_t out[STUN_RESPONSE_SIZE]);
+
+#endif // PIGEONHUB_STUN_SERVER_H
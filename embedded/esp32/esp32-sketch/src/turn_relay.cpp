@@ -0,0 +1,600 @@
+/*
+ * PigeonHub TURN Relay
+ */
+
+#include "turn_relay.h"
+#include <string.h>
+
+#define STUN_MAGIC_COOKIE       0x2112A442
+
+#define TURN_ALLOCATE           0x0003
+#define TURN_REFRESH            0x0004
+#define TURN_SEND               0x0006
+#define TURN_DATA               0x0007
+#define TURN_CREATE_PERMISSION  0x0008
+#define TURN_CHANNEL_BIND       0x0009
+
+#define CLASS_REQUEST           0x0000
+#define CLASS_INDICATION        0x0010
+#define CLASS_SUCCESS           0x0100
+#define CLASS_ERROR             0x0110
+
+#define ATTR_USERNAME           0x0006
+#define ATTR_MESSAGE_INTEGRITY  0x0008
+#define ATTR_ERROR_CODE         0x0009
+#define ATTR_CHANNEL_NUMBER     0x000C
+#define ATTR_LIFETIME           0x000D
+#define ATTR_XOR_PEER_ADDRESS   0x0012
+#define ATTR_DATA               0x0013
+#define ATTR_REALM              0x0014
+#define ATTR_NONCE              0x0015
+#define ATTR_XOR_RELAYED_ADDR   0x0016
+#define ATTR_REQUESTED_TRANSPORT 0x0019
+#define ATTR_XOR_MAPPED_ADDR    0x0020
+#define ATTR_FINGERPRINT        0x8028
+
+#define TRANSPORT_UDP           17
+#define LIFETIME_DEFAULT_S      600
+#define LIFETIME_MAX_S          3600
+#define PERMISSION_LIFETIME_MS  300000
+#define CHANNEL_LIFETIME_MS     600000
+
+static uint16_t get16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t get32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void put16(uint8_t* p, uint16_t v) {
+    p[0] = v >> 8;
+    p[1] = v & 0xFF;
+}
+
+static void put32(uint8_t* p, uint32_t v) {
+    p[0] = v >> 24;
+    p[1] = (v >> 16) & 0xFF;
+    p[2] = (v >> 8) & 0xFF;
+    p[3] = v & 0xFF;
+}
+
+static size_t pad4(size_t len) {
+    return (len + 3) & ~(size_t)3;
+}
+
+static bool live(uint32_t expires, uint32_t now) {
+    return (int32_t)(expires - now) > 0;
+}
+
+// ============================================================================
+// Messages
+// ============================================================================
+
+struct Attrs {
+    const uint8_t* username;
+    size_t usernameLen;
+    const uint8_t* nonce;
+    size_t nonceLen;
+    size_t integrity;        // Offset of MESSAGE-INTEGRITY, 0 = absent
+    bool hasLifetime;
+    uint32_t lifetime;
+    int transport;           // -1 = absent
+    bool hasPeer;            // First XOR-PEER-ADDRESS only
+    uint32_t peerAddr;
+    uint16_t peerPort;
+    int channel;             // -1 = absent
+    const uint8_t* data;
+    size_t dataLen;
+};
+
+static bool parseAttrs(const uint8_t* packet, size_t len, Attrs* a) {
+    memset(a, 0, sizeof(*a));
+    a->transport = -1;
+    a->channel = -1;
+
+    size_t pos = 20;
+    while (pos + 4 <= len) {
+        uint16_t type = get16(packet + pos);
+        size_t attrLen = get16(packet + pos + 2);
+        const uint8_t* value = packet + pos + 4;
+        if (pos + 4 + attrLen > len) return false;
+
+        // Only FINGERPRINT may follow MESSAGE-INTEGRITY
+        if (a->integrity) {
+            if (type != ATTR_FINGERPRINT) return false;
+            break;
+        }
+
+        switch (type) {
+            case ATTR_USERNAME:
+                a->username = value;
+                a->usernameLen = attrLen;
+                break;
+            case ATTR_NONCE:
+                a->nonce = value;
+                a->nonceLen = attrLen;
+                break;
+            case ATTR_MESSAGE_INTEGRITY:
+                if (attrLen != 20) return false;
+                a->integrity = pos;
+                break;
+            case ATTR_LIFETIME:
+                if (attrLen != 4) return false;
+                a->hasLifetime = true;
+                a->lifetime = get32(value);
+                break;
+            case ATTR_REQUESTED_TRANSPORT:
+                if (attrLen != 4) return false;
+                a->transport = value[0];
+                break;
+            case ATTR_XOR_PEER_ADDRESS:
+                if (a->hasPeer) break;
+                if (attrLen != 8 || value[1] != 0x01) return false;  // IPv4 only
+                a->hasPeer = true;
+                a->peerPort = get16(value + 2) ^ (STUN_MAGIC_COOKIE >> 16);
+                a->peerAddr = get32(value + 4) ^ STUN_MAGIC_COOKIE;
+                break;
+            case ATTR_CHANNEL_NUMBER:
+                if (attrLen != 4) return false;
+                a->channel = get16(value);
+                break;
+            case ATTR_DATA:
+                a->data = value;
+                a->dataLen = attrLen;
+                break;
+            default:
+                break;  // Including DONT-FRAGMENT and SOFTWARE
+        }
+        pos += 4 + pad4(attrLen);
+    }
+    return true;
+}
+
+struct Msg {
+    uint8_t* buf;
+    size_t len;
+};
+
+static void beginMessage(Msg* msg, uint8_t* buf, uint16_t type, const uint8_t* transaction) {
+    msg->buf = buf;
+    msg->len = 20;
+    put16(buf, type);
+    put16(buf + 2, 0);
+    put32(buf + 4, STUN_MAGIC_COOKIE);
+    memcpy(buf + 8, transaction, 12);
+}
+
+static uint8_t* addAttr(Msg* msg, uint16_t type, size_t len) {
+    uint8_t* attr = msg->buf + msg->len;
+    put16(attr, type);
+    put16(attr + 2, (uint16_t)len);
+    memset(attr + 4, 0, pad4(len));
+    msg->len += 4 + pad4(len);
+    put16(msg->buf + 2, (uint16_t)(msg->len - 20));
+    return attr + 4;
+}
+
+static void addXorAddress(Msg* msg, uint16_t type, uint32_t addr, uint16_t port) {
+    uint8_t* value = addAttr(msg, type, 8);
+    value[1] = 0x01;
+    put16(value + 2, port ^ (STUN_MAGIC_COOKIE >> 16));
+    put32(value + 4, addr ^ STUN_MAGIC_COOKIE);
+}
+
+static void addBytes(Msg* msg, uint16_t type, const void* data, size_t len) {
+    memcpy(addAttr(msg, type, len), data, len);
+}
+
+static void addIntegrity(Msg* msg, const TurnRelay* relay, const uint8_t key[16]) {
+    // The length field covers MESSAGE-INTEGRITY before it is computed
+    size_t covered = msg->len;
+    uint8_t* value = addAttr(msg, ATTR_MESSAGE_INTEGRITY, 20);
+    relay->backend->hmacSha1(key, 16, msg->buf, covered, value);
+}
+
+static void respondError(TurnRelay* relay, const uint8_t* request, uint16_t method, int code,
+                         const char* reason, const uint8_t* key, uint8_t* out, TurnSend* send) {
+    Msg msg;
+    beginMessage(&msg, out, method | CLASS_ERROR, request + 8);
+    size_t reasonLen = strlen(reason);
+    uint8_t* value = addAttr(&msg, ATTR_ERROR_CODE, 4 + reasonLen);
+    value[2] = code / 100;
+    value[3] = code % 100;
+    memcpy(value + 4, reason, reasonLen);
+    if (code == 401 || code == 438) {
+        addBytes(&msg, ATTR_REALM, TURN_REALM, strlen(TURN_REALM));
+        addBytes(&msg, ATTR_NONCE, relay->nonce, TURN_NONCE_LEN);
+    }
+    if (key) addIntegrity(&msg, relay, key);
+    send->data = out;
+    send->len = msg.len;
+}
+
+// ============================================================================
+// Allocations
+// ============================================================================
+
+static TurnAllocation* findAllocation(TurnRelay* relay, uint32_t addr, uint16_t port) {
+    for (int i = 0; i < TURN_MAX_ALLOCATIONS; i++) {
+        TurnAllocation* alloc = &relay->allocations[i];
+        if (alloc->active && alloc->clientAddr == addr && alloc->clientPort == port) return alloc;
+    }
+    return NULL;
+}
+
+static void freeAllocation(TurnRelay* relay, TurnAllocation* alloc) {
+    int slot = alloc - relay->allocations;
+    relay->backend->closeRelay(slot);
+    alloc->active = false;
+
+    for (int i = 0; i < TURN_MAX_ALLOCATIONS; i++) {
+        if (relay->allocations[i].active && relay->allocations[i].quota == alloc->quota) return;
+    }
+    relay->quotas[alloc->quota].ns = -1;
+}
+
+static uint32_t grantedLifetime(const Attrs* a) {
+    if (!a->hasLifetime) return LIFETIME_DEFAULT_S;
+    if (a->lifetime == 0) return 0;
+    if (a->lifetime < LIFETIME_DEFAULT_S) return LIFETIME_DEFAULT_S;
+    return a->lifetime > LIFETIME_MAX_S ? LIFETIME_MAX_S : a->lifetime;
+}
+
+static bool permitted(const TurnAllocation* alloc, uint32_t addr, uint32_t now) {
+    for (int i = 0; i < TURN_MAX_PERMISSIONS; i++) {
+        const TurnPermission* perm = &alloc->permissions[i];
+        if (perm->addr == addr && live(perm->expires, now)) return true;
+    }
+    return false;
+}
+
+// Loopback, "this network", multicast, broadcast and the hub's addresses
+static bool peerAllowed(const TurnRelay* relay, uint32_t addr) {
+    uint8_t top = addr >> 24;
+    if (top == 0 || top == 127 || top >= 224) return false;
+    return !relay->backend->localAddress(addr);
+}
+
+static bool permit(TurnAllocation* alloc, uint32_t addr, uint32_t now) {
+    TurnPermission* free = NULL;
+    for (int i = 0; i < TURN_MAX_PERMISSIONS; i++) {
+        TurnPermission* perm = &alloc->permissions[i];
+        if (perm->addr == addr) {
+            free = perm;
+            break;
+        }
+        if (!free && (perm->addr == 0 || !live(perm->expires, now))) free = perm;
+    }
+    if (!free) return false;
+    free->addr = addr;
+    free->expires = now + PERMISSION_LIFETIME_MS;
+    return true;
+}
+
+// Takes len bytes from the namespace's bucket
+static bool spend(TurnRelay* relay, const TurnAllocation* alloc, size_t len, uint32_t now) {
+    TurnQuota* quota = &relay->quotas[alloc->quota];
+    uint64_t credit = quota->credit + (uint64_t)(now - quota->lastMs) * relay->bytesPerSec / 1000;
+    quota->credit = credit > relay->burst ? relay->burst : (uint32_t)credit;
+    quota->lastMs = now;
+    if (quota->credit < len) {
+        relay->rateDropped++;
+        return false;
+    }
+    quota->credit -= len;
+    relay->relayedPackets++;
+    relay->relayedBytes += len;
+    return true;
+}
+
+static void allocate(TurnRelay* relay, const uint8_t* request, const Attrs* a, int ns, const uint8_t key[16],
+                     uint32_t addr, uint16_t port, uint32_t localAddr, uint32_t now,
+                     uint8_t* out, TurnSend* send) {
+    if (findAllocation(relay, addr, port)) {
+        respondError(relay, request, TURN_ALLOCATE, 437, "Allocation Mismatch", key, out, send);
+        return;
+    }
+    if (a->transport < 0) {
+        respondError(relay, request, TURN_ALLOCATE, 400, "Bad Request", key, out, send);
+        return;
+    }
+    if (a->transport != TRANSPORT_UDP) {
+        respondError(relay, request, TURN_ALLOCATE, 442, "Unsupported Transport", key, out, send);
+        return;
+    }
+
+    int active = 0, inNamespace = 0, slot = -1, quota = -1, freeQuota = -1;
+    for (int i = 0; i < TURN_MAX_ALLOCATIONS; i++) {
+        if (relay->allocations[i].active) {
+            active++;
+            if (relay->quotas[relay->allocations[i].quota].ns == ns) inNamespace++;
+        } else if (slot < 0) {
+            slot = i;
+        }
+        if (relay->quotas[i].ns == ns) quota = i;
+        if (relay->quotas[i].ns < 0 && freeQuota < 0) freeQuota = i;
+    }
+    if (active >= relay->maxAllocations || inNamespace >= relay->perNamespace || slot < 0) {
+        relay->refused++;
+        respondError(relay, request, TURN_ALLOCATE, 486, "Allocation Quota Reached", key, out, send);
+        return;
+    }
+
+    uint16_t relayPort = relay->backend->openRelay(slot);
+    if (relayPort == 0) {
+        relay->refused++;
+        respondError(relay, request, TURN_ALLOCATE, 508, "Insufficient Capacity", key, out, send);
+        return;
+    }
+
+    // There is always a free quota slot when there is a free allocation slot
+    if (quota < 0) {
+        quota = freeQuota;
+        relay->quotas[quota].ns = ns;
+        relay->quotas[quota].credit = relay->burst;
+        relay->quotas[quota].lastMs = now;
+    }
+
+    uint32_t lifetime = grantedLifetime(a);
+    if (lifetime == 0) lifetime = LIFETIME_DEFAULT_S;
+
+    TurnAllocation* alloc = &relay->allocations[slot];
+    memset(alloc, 0, sizeof(*alloc));
+    alloc->active = true;
+    alloc->clientAddr = addr;
+    alloc->clientPort = port;
+    alloc->relayAddr = localAddr;
+    alloc->relayPort = relayPort;
+    alloc->quota = quota;
+    memcpy(alloc->key, key, 16);
+    alloc->expires = now + lifetime * 1000;
+    relay->allocated++;
+
+    Msg msg;
+    beginMessage(&msg, out, TURN_ALLOCATE | CLASS_SUCCESS, request + 8);
+    addXorAddress(&msg, ATTR_XOR_RELAYED_ADDR, localAddr, relayPort);
+    put32(addAttr(&msg, ATTR_LIFETIME, 4), lifetime);
+    addXorAddress(&msg, ATTR_XOR_MAPPED_ADDR, addr, port);
+    addIntegrity(&msg, relay, key);
+    send->data = out;
+    send->len = msg.len;
+}
+
+static bool bindChannel(TurnAllocation* alloc, const Attrs* a, uint32_t now) {
+    TurnChannel* slot = NULL;
+    for (int i = 0; i < TURN_MAX_CHANNELS; i++) {
+        TurnChannel* ch = &alloc->channels[i];
+        bool used = ch->number != 0 && live(ch->expires, now);
+        bool samePeer = used && ch->addr == a->peerAddr && ch->port == a->peerPort;
+        // A channel stays with one peer, and a peer keeps one channel
+        if (used && (ch->number == a->channel) != samePeer) return false;
+        if (samePeer) slot = ch;
+        if (!slot && !used) slot = ch;
+    }
+    if (!slot) return false;
+    slot->number = a->channel;
+    slot->addr = a->peerAddr;
+    slot->port = a->peerPort;
+    slot->expires = now + CHANNEL_LIFETIME_MS;
+    return true;
+}
+
+static void respondSuccess(TurnRelay* relay, const uint8_t* request, uint16_t method, const uint8_t key[16],
+                           int lifetime, uint8_t* out, TurnSend* send) {
+    Msg msg;
+    beginMessage(&msg, out, method | CLASS_SUCCESS, request + 8);
+    if (lifetime >= 0) put32(addAttr(&msg, ATTR_LIFETIME, 4), lifetime);
+    addIntegrity(&msg, relay, key);
+    send->data = out;
+    send->len = msg.len;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void turnInit(TurnRelay* relay, const TurnBackend* backend, const char* nonce, int maxAllocations,
+              int perNamespace, uint32_t bytesPerSec, uint32_t burst) {
+    memset(relay, 0, sizeof(*relay));
+    relay->backend = backend;
+    memcpy(relay->nonce, nonce, TURN_NONCE_LEN);
+    relay->maxAllocations = maxAllocations < TURN_MAX_ALLOCATIONS ? maxAllocations : TURN_MAX_ALLOCATIONS;
+    relay->perNamespace = perNamespace;
+    relay->bytesPerSec = bytesPerSec;
+    relay->burst = burst;
+    for (int i = 0; i < TURN_MAX_ALLOCATIONS; i++) relay->quotas[i].ns = -1;
+}
+
+bool turnFromClient(TurnRelay* relay, uint8_t* packet, size_t len, uint32_t addr, uint16_t port,
+                    uint32_t localAddr, uint32_t now, uint8_t* out, TurnSend* send) {
+    memset(send, 0, sizeof(*send));
+    send->relay = TURN_VIA_SERVER;
+    send->addr = addr;
+    send->port = port;
+
+    // ChannelData: 0b01 in the top bits, where STUN messages have 0b00
+    if (len >= 4 && (packet[0] & 0xC0) == 0x40) {
+        uint16_t number = get16(packet);
+        size_t dataLen = get16(packet + 2);
+        TurnAllocation* alloc = findAllocation(relay, addr, port);
+        if (!alloc || 4 + dataLen > len) return true;
+        for (int i = 0; i < TURN_MAX_CHANNELS; i++) {
+            TurnChannel* ch = &alloc->channels[i];
+            if (ch->number != number || !live(ch->expires, now)) continue;
+            if (!permitted(alloc, ch->addr, now)) {
+                relay->noPermission++;
+            } else if (spend(relay, alloc, dataLen, now)) {
+                *send = {(int)(alloc - relay->allocations), ch->addr, ch->port, packet + 4, dataLen};
+            }
+            break;
+        }
+        return true;
+    }
+
+    if (len < 20 || (packet[0] & 0xC0) != 0 || get32(packet + 4) != STUN_MAGIC_COOKIE ||
+        (size_t)get16(packet + 2) + 20 != len) return false;
+    uint16_t type = get16(packet);
+    uint16_t method = type & ~CLASS_ERROR;
+    uint16_t cls = type & CLASS_ERROR;
+    if (method != TURN_ALLOCATE && method != TURN_REFRESH && method != TURN_SEND &&
+        method != TURN_CREATE_PERMISSION && method != TURN_CHANNEL_BIND) return false;
+
+    Attrs a;
+    if (!parseAttrs(packet, len, &a)) return true;
+
+    // Send indications aren't authenticated; the 5-tuple is
+    if (cls == CLASS_INDICATION) {
+        TurnAllocation* alloc = findAllocation(relay, addr, port);
+        if (method != TURN_SEND || !alloc || !a.hasPeer || !a.data) return true;
+        if (!peerAllowed(relay, a.peerAddr)) {
+            relay->forbidden++;
+        } else if (!permitted(alloc, a.peerAddr, now)) {
+            relay->noPermission++;
+        } else if (spend(relay, alloc, a.dataLen, now)) {
+            *send = {(int)(alloc - relay->allocations), a.peerAddr, a.peerPort, a.data, a.dataLen};
+        }
+        return true;
+    }
+    if (cls != CLASS_REQUEST || method == TURN_SEND) return true;
+
+    // Long-term credentials: challenge, then check the nonce, user and integrity
+    if (!a.integrity || !a.username) {
+        respondError(relay, packet, method, 401, "Unauthorized", NULL, out, send);
+        return true;
+    }
+    if (a.nonceLen != TURN_NONCE_LEN || memcmp(a.nonce, relay->nonce, TURN_NONCE_LEN) != 0) {
+        respondError(relay, packet, method, 438, "Stale Nonce", NULL, out, send);
+        return true;
+    }
+    uint8_t key[16];
+    int ns = a.usernameLen < TURN_USERNAME_MAX
+        ? relay->backend->key((const char*)a.username, a.usernameLen, key) : -1;
+    bool verified = false;
+    if (ns >= 0) {
+        // Integrity covers the message up to itself, with the length field
+        // counting up to its end
+        uint8_t mac[20];
+        uint16_t length = get16(packet + 2);
+        put16(packet + 2, (uint16_t)(a.integrity + 24 - 20));
+        relay->backend->hmacSha1(key, 16, packet, a.integrity, mac);
+        put16(packet + 2, length);
+        verified = memcmp(mac, packet + a.integrity + 4, 20) == 0;
+    }
+    if (!verified) {
+        relay->authFailures++;
+        respondError(relay, packet, method, 401, "Unauthorized", NULL, out, send);
+        return true;
+    }
+
+    if (method == TURN_ALLOCATE) {
+        allocate(relay, packet, &a, ns, key, addr, port, localAddr, now, out, send);
+        return true;
+    }
+
+    TurnAllocation* alloc = findAllocation(relay, addr, port);
+    if (!alloc) {
+        respondError(relay, packet, method, 437, "Allocation Mismatch", key, out, send);
+        return true;
+    }
+    if (memcmp(alloc->key, key, 16) != 0) {
+        respondError(relay, packet, method, 441, "Wrong Credentials", key, out, send);
+        return true;
+    }
+
+    if (method == TURN_REFRESH) {
+        uint32_t lifetime = grantedLifetime(&a);
+        if (lifetime == 0) {
+            freeAllocation(relay, alloc);
+        } else {
+            alloc->expires = now + lifetime * 1000;
+        }
+        respondSuccess(relay, packet, method, key, lifetime, out, send);
+    } else if (method == TURN_CREATE_PERMISSION) {
+        // Only the first XOR-PEER-ADDRESS; browsers send one per request
+        if (!a.hasPeer) {
+            respondError(relay, packet, method, 400, "Bad Request", key, out, send);
+        } else if (!peerAllowed(relay, a.peerAddr)) {
+            relay->forbidden++;
+            respondError(relay, packet, method, 403, "Forbidden", key, out, send);
+        } else if (!permit(alloc, a.peerAddr, now)) {
+            respondError(relay, packet, method, 508, "Insufficient Capacity", key, out, send);
+        } else {
+            respondSuccess(relay, packet, method, key, -1, out, send);
+        }
+    } else {
+        if (!a.hasPeer || a.channel < 0x4000 || a.channel > 0x7FFF) {
+            respondError(relay, packet, method, 400, "Bad Request", key, out, send);
+        } else if (!peerAllowed(relay, a.peerAddr)) {
+            relay->forbidden++;
+            respondError(relay, packet, method, 403, "Forbidden", key, out, send);
+        } else if (!bindChannel(alloc, &a, now)) {
+            respondError(relay, packet, method, 400, "Bad Request", key, out, send);
+        } else if (!permit(alloc, a.peerAddr, now)) {
+            respondError(relay, packet, method, 508, "Insufficient Capacity", key, out, send);
+        } else {
+            respondSuccess(relay, packet, method, key, -1, out, send);
+        }
+    }
+    return true;
+}
+
+void turnFromPeer(TurnRelay* relay, int slot, uint8_t* packet, size_t len, uint32_t addr, uint16_t port,
+                  uint32_t now, TurnSend* send) {
+    memset(send, 0, sizeof(*send));
+    TurnAllocation* alloc = &relay->allocations[slot];
+    if (!alloc->active) return;
+    if (!permitted(alloc, addr, now)) {
+        relay->noPermission++;
+        return;
+    }
+    if (!spend(relay, alloc, len, now)) return;
+
+    send->relay = TURN_VIA_SERVER;
+    send->addr = alloc->clientAddr;
+    send->port = alloc->clientPort;
+
+    for (int i = 0; i < TURN_MAX_CHANNELS; i++) {
+        TurnChannel* ch = &alloc->channels[i];
+        if (ch->number != 0 && ch->addr == addr && ch->port == port && live(ch->expires, now)) {
+            uint8_t* frame = packet - 4;
+            put16(frame, ch->number);
+            put16(frame + 2, (uint16_t)len);
+            send->data = frame;
+            send->len = 4 + len;
+            return;
+        }
+    }
+
+    // Data indication; the transaction ID only has to be unique
+    uint8_t transaction[12];
+    memcpy(transaction, relay->nonce, 8);
+    put32(transaction + 8, relay->relayedPackets);
+    Msg msg;
+    beginMessage(&msg, packet - TURN_HEADROOM, TURN_DATA | CLASS_INDICATION, transaction);
+    addXorAddress(&msg, ATTR_XOR_PEER_ADDRESS, addr, port);
+
+    // DATA header lands just in front of the payload
+    put16(msg.buf + msg.len, ATTR_DATA);
+    put16(msg.buf + msg.len + 2, (uint16_t)len);
+    memset(packet + len, 0, pad4(len) - len);
+    msg.len += 4 + pad4(len);
+    put16(msg.buf + 2, (uint16_t)(msg.len - 20));
+    send->data = msg.buf;
+    send->len = msg.len;
+}
+
+void turnPoll(TurnRelay* relay, uint32_t now) {
+    for (int i = 0; i < TURN_MAX_ALLOCATIONS; i++) {
+        TurnAllocation* alloc = &relay->allocations[i];
+        if (alloc->active && !live(alloc->expires, now)) freeAllocation(relay, alloc);
+    }
+}
+
+int turnActiveAllocations(const TurnRelay* relay) {
+    int active = 0;
+    for (int i = 0; i < TURN_MAX_ALLOCATIONS; i++) {
+        if (relay->allocations[i].active) active++;
+    }
+    return active;
+}
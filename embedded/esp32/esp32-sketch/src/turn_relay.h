@@ -0,0 +1,141 @@
+/*
+ * PigeonHub TURN Relay
+ *
+ * A small subset of TURN (RFC 5766) for peer pairs that can't reach each
+ * other directly, such as symmetric NATs, or one peer on the hub's AP and
+ * one on its WiFi network. It runs on the STUN port. It supports UDP
+ * allocations with long-term credentials, Refresh, CreatePermission,
+ * ChannelBind, Send/Data indications and ChannelData. There is no TCP
+ * relaying, no EVEN-PORT or reservations, and no IPv6.
+ *
+ * Credentials: the username is a network namespace the hub knows. The key
+ * comes from the TurnBackend, which also opens and closes the relay socket
+ * of each allocation slot. Allocations are capped per namespace, and each
+ * namespace shares one token bucket for the bytes it relays.
+ *
+ * Peers can't be the hub itself. Permissions and channel bindings toward
+ * loopback, 0.0.0.0/8, multicast and broadcast, or any address the backend
+ * reports as its own, get 403, and Send indications toward them are
+ * dropped. Otherwise a client could reach services on the hub through it.
+ *
+ * The relay never copies payloads. Data from a client is forwarded from its
+ * position in the received datagram. Data from a peer gets its Data
+ * indication or ChannelData header written in front of it, so the caller
+ * reads peer datagrams TURN_HEADROOM bytes into its buffer (and leaves 3
+ * bytes spare at the end for padding).
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_TURN_RELAY_H
+#define PIGEONHUB_TURN_RELAY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TURN_MAX_ALLOCATIONS   4
+#define TURN_MAX_PERMISSIONS   4   // Peer IPs per allocation
+#define TURN_MAX_CHANNELS      4   // Per allocation
+#define TURN_REALM             "pigeonhub"
+#define TURN_NONCE_LEN         16
+#define TURN_USERNAME_MAX      32
+#define TURN_HEADROOM          36  // Data indication: header, XOR-PEER-ADDRESS, DATA header
+#define TURN_RESPONSE_MAX      160
+#define TURN_VIA_SERVER        -1
+
+struct TurnBackend {
+    // Long-term credential key, MD5(username ":" realm ":" password).
+    // Returns the quota group (network namespace) for the user, or -1 to
+    // reject it.
+    int (*key)(const char* username, size_t len, uint8_t key[16]);
+    void (*hmacSha1)(const uint8_t* key, size_t keyLen, const uint8_t* data, size_t len, uint8_t out[20]);
+    // Binds the relay socket for an allocation slot; returns its port, or 0
+    uint16_t (*openRelay)(int slot);
+    void (*closeRelay)(int slot);
+    // True for the hub's own addresses, which may not be peers
+    bool (*localAddress)(uint32_t addr);
+};
+
+struct TurnPermission {
+    uint32_t addr;      // 0 = unused
+    uint32_t expires;   // ms
+};
+
+struct TurnChannel {
+    uint16_t number;    // 0 = unused
+    uint32_t addr;
+    uint16_t port;
+    uint32_t expires;
+};
+
+struct TurnAllocation {
+    bool active;
+    uint32_t clientAddr;    // 5-tuple on the server port
+    uint16_t clientPort;
+    uint32_t relayAddr;     // Hub address the client reached us on
+    uint16_t relayPort;
+    int quota;              // Index into TurnRelay::quotas
+    uint8_t key[16];
+    uint32_t expires;
+    TurnPermission permissions[TURN_MAX_PERMISSIONS];
+    TurnChannel channels[TURN_MAX_CHANNELS];
+};
+
+// Per namespace; a slot is in use while an allocation refers to it
+struct TurnQuota {
+    int ns;                 // -1 = unused
+    uint32_t credit;        // Bytes
+    uint32_t lastMs;
+};
+
+struct TurnSend {
+    int relay;              // TURN_VIA_SERVER, or the slot whose relay socket sends
+    uint32_t addr;
+    uint16_t port;
+    const uint8_t* data;
+    size_t len;             // 0 = nothing to send
+};
+
+struct TurnRelay {
+    const TurnBackend* backend;
+    char nonce[TURN_NONCE_LEN + 1];
+    int maxAllocations;     // At most TURN_MAX_ALLOCATIONS
+    int perNamespace;
+    uint32_t bytesPerSec;   // Per namespace
+    uint32_t burst;
+
+    TurnAllocation allocations[TURN_MAX_ALLOCATIONS];
+    TurnQuota quotas[TURN_MAX_ALLOCATIONS];
+
+    uint32_t allocated;
+    uint32_t refused;       // Over a quota or out of sockets
+    uint32_t authFailures;  // Bad key or integrity; 401 challenges aren't counted
+    uint32_t relayedPackets;
+    uint32_t relayedBytes;
+    uint32_t rateDropped;   // Over the namespace byte rate
+    uint32_t noPermission;  // Data to or from a peer without a permission
+    uint32_t forbidden;     // Permissions, channels or sends toward the hub itself
+};
+
+// nonce: TURN_NONCE_LEN random characters, fixed for the hub's uptime
+void turnInit(TurnRelay* relay, const TurnBackend* backend, const char* nonce, int maxAllocations,
+              int perNamespace, uint32_t bytesPerSec, uint32_t burst);
+
+// A datagram on the server port from addr:port (host byte order), which
+// reached the hub at localAddr. Returns false if it isn't TURN (a Binding
+// request, say), for the STUN responder to handle. Responses are built in
+// out (TURN_RESPONSE_MAX bytes); relayed data points into packet.
+bool turnFromClient(TurnRelay* relay, uint8_t* packet, size_t len, uint32_t addr, uint16_t port,
+                    uint32_t localAddr, uint32_t now, uint8_t* out, TurnSend* send);
+
+// A datagram from a peer on the relay socket of slot. packet has
+// TURN_HEADROOM writable bytes in front of it and 3 behind.
+void turnFromPeer(TurnRelay* relay, int slot, uint8_t* packet, size_t len, uint32_t addr, uint16_t port,
+                  uint32_t now, TurnSend* send);
+
+// Expires allocations whose lifetime ran out
+void turnPoll(TurnRelay* relay, uint32_t now);
+
+int turnActiveAllocations(const TurnRelay* relay);
+
+#endif // PIGEONHUB_TURN_RELAY_H
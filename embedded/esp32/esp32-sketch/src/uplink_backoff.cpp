@@ -0,0 +1,31 @@
+/*
+ * PigeonHub Uplink Backoff
+ */
+
+#include "uplink_backoff.h"
+#include <string.h>
+
+void uplinkBackoffInit(UplinkBackoff* backoff, uint32_t minMs, uint32_t maxMs, uint32_t stableMs) {
+    memset(backoff, 0, sizeof(*backoff));
+    backoff->minMs = minMs ? minMs : 1;
+    backoff->maxMs = maxMs > backoff->minMs ? maxMs : backoff->minMs;
+    backoff->stableMs = stableMs;
+}
+
+uint32_t uplinkBackoffFailed(UplinkBackoff* backoff, bool wasReady, uint32_t upMs, uint32_t random) {
+    if (wasReady && upMs >= backoff->stableMs) {
+        backoff->backoffMs = backoff->minMs;
+    } else if (!backoff->backoffMs) {
+        backoff->backoffMs = backoff->minMs;
+    } else {
+        backoff->backoffMs = backoff->backoffMs > backoff->maxMs / 2 ? backoff->maxMs : backoff->backoffMs * 2;
+    }
+
+    uint32_t half = backoff->backoffMs / 2;
+    backoff->retryMs = backoff->backoffMs - half + random % (half + 1);  // 50-100%
+    return backoff->retryMs;
+}
+
+void uplinkBackoffReset(UplinkBackoff* backoff) {
+    backoff->backoffMs = 0;
+}
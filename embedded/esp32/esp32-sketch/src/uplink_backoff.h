@@ -0,0 +1,39 @@
+/*
+ * PigeonHub Uplink Backoff
+ *
+ * Retry timing for the bootstrap-hub uplink state machine in main.cpp. Each
+ * failed connect or lost uplink doubles the backoff from minMs up to maxMs,
+ * and the actual wait is drawn from 50-100% of it, so hubs that lost the
+ * same bootstrap hub don't come back in lockstep. An uplink that stayed up
+ * for stableMs starts over from minMs.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_UPLINK_BACKOFF_H
+#define PIGEONHUB_UPLINK_BACKOFF_H
+
+#include <stdint.h>
+
+#define UPLINK_BACKOFF_MIN_MS  1000
+#define UPLINK_BACKOFF_MAX_MS  60000
+#define UPLINK_STABLE_MS       30000  // Up this long: the next drop retries from the minimum
+
+struct UplinkBackoff {
+    uint32_t minMs;
+    uint32_t maxMs;
+    uint32_t stableMs;
+    uint32_t backoffMs;  // 0 until the first failure
+    uint32_t retryMs;    // Jittered wait before the next attempt
+};
+
+void uplinkBackoffInit(UplinkBackoff* backoff, uint32_t minMs, uint32_t maxMs, uint32_t stableMs);
+
+// A connect failed (wasReady false) or an uplink that had been up for upMs
+// dropped. Returns the new retryMs; `random` is any 32-bit random value.
+uint32_t uplinkBackoffFailed(UplinkBackoff* backoff, bool wasReady, uint32_t upMs, uint32_t random);
+
+// WiFi went away: the next failure starts from minMs again
+void uplinkBackoffReset(UplinkBackoff* backoff);
+
+#endif // PIGEONHUB_UPLINK_BACKOFF_H
@@ -0,0 +1,133 @@
+/*
+ * PigeonHub Uplink Multiplexer
+ */
+
+#include "uplink_mux.h"
+#include <string.h>
+
+// Rounds per poll before giving up on a priority; a frame of
+// quantum * this many bytes still gets its turn
+#define UPLINK_MUX_MAX_ROUNDS 64
+
+static void refill(UplinkMux* mux, uint32_t now) {
+    int64_t credit = mux->credit + (int64_t)((uint64_t)(now - mux->lastMs) * mux->bytesPerSec / 1000);
+    mux->credit = credit > (int64_t)mux->burst ? mux->burst : (int32_t)credit;
+    mux->lastMs = now;
+}
+
+static void popFrame(UplinkMux* mux, UplinkStream* stream) {
+    UplinkQueued* frame = &stream->frames[stream->head];
+    mux->bytes -= frame->len;
+    mux->pending[stream->priority]--;
+    memFree(mux->mem, frame->data);
+    stream->head = (stream->head + 1) % UPLINK_MUX_DEPTH;
+    if (--stream->count == 0) stream->active = false;
+}
+
+void uplinkMuxInit(UplinkMux* mux, MemPolicy* mem, uint32_t bytesPerSec, uint32_t burst,
+                   uint32_t quantum, size_t maxBytes, uint32_t now) {
+    memset(mux, 0, sizeof(*mux));
+    mux->mem = mem;
+    mux->bytesPerSec = bytesPerSec;
+    mux->burst = burst;
+    mux->quantum = quantum;
+    mux->maxBytes = maxBytes;
+    mux->credit = burst;
+    mux->lastMs = now;
+}
+
+bool uplinkMuxDirect(UplinkMux* mux, uint8_t priority, size_t len, uint32_t now) {
+    for (int p = 0; p <= priority; p++) {
+        if (mux->pending[p]) return false;
+    }
+    refill(mux, now);
+    if (mux->credit <= 0) return false;
+    mux->credit -= len;
+    mux->stats[priority].direct++;
+    return true;
+}
+
+bool uplinkMuxPush(UplinkMux* mux, uint32_t key, uint8_t priority, const uint8_t* data, size_t len,
+                   uint32_t now) {
+    UplinkStream* stream = NULL;
+    UplinkStream* free = NULL;
+    for (int i = 0; i < UPLINK_MUX_STREAMS; i++) {
+        UplinkStream* s = &mux->streams[i];
+        if (s->active && s->key == key && s->priority == priority) {
+            stream = s;
+            break;
+        }
+        if (!s->active && !free) free = s;
+    }
+    if (!stream && free) {
+        stream = free;
+        stream->active = true;
+        stream->key = key;
+        stream->priority = priority;
+        stream->head = 0;
+        stream->count = 0;
+        stream->deficit = 0;
+    }
+
+    uint8_t* copy = NULL;
+    if (stream && stream->count < UPLINK_MUX_DEPTH && mux->bytes + len <= mux->maxBytes) {
+        copy = (uint8_t*)memAlloc(mux->mem, MEM_BULK, len);
+    }
+    if (!copy) {
+        if (stream && stream->count == 0) stream->active = false;
+        mux->stats[priority].dropped++;
+        return false;
+    }
+
+    memcpy(copy, data, len);
+    stream->frames[(stream->head + stream->count) % UPLINK_MUX_DEPTH] = {copy, len, now};
+    stream->count++;
+    mux->bytes += len;
+    mux->pending[priority]++;
+    mux->stats[priority].queued++;
+    return true;
+}
+
+void uplinkMuxPoll(UplinkMux* mux, uint32_t now, void (*send)(const uint8_t* data, size_t len)) {
+    refill(mux, now);
+    uint8_t start = mux->next;
+    mux->next = (mux->next + 1) % UPLINK_MUX_STREAMS;
+
+    for (uint8_t priority = 0; priority < UPLINK_PRIO_COUNT; priority++) {
+        UplinkPrioStats* stats = &mux->stats[priority];
+        for (int round = 0; round < UPLINK_MUX_MAX_ROUNDS && mux->pending[priority]; round++) {
+            for (int i = 0; i < UPLINK_MUX_STREAMS; i++) {
+                UplinkStream* stream = &mux->streams[(start + i) % UPLINK_MUX_STREAMS];
+                if (!stream->active || stream->priority != priority) continue;
+                if (mux->credit <= 0) return;  // Lower priorities wait too
+
+                stream->deficit += mux->quantum;
+                while (stream->active) {
+                    UplinkQueued* frame = &stream->frames[stream->head];
+                    if ((int32_t)frame->len > stream->deficit) break;
+                    if (mux->credit <= 0) return;
+
+                    send(frame->data, frame->len);
+                    mux->credit -= frame->len;
+                    stream->deficit -= frame->len;
+                    uint32_t wait = now - frame->queuedMs;
+                    stats->sent++;
+                    stats->waitMsTotal += wait;
+                    if (wait > stats->waitMsMax) stats->waitMsMax = wait;
+                    popFrame(mux, stream);
+                }
+                if (!stream->active) stream->deficit = 0;
+            }
+        }
+    }
+}
+
+void uplinkMuxClear(UplinkMux* mux) {
+    for (int i = 0; i < UPLINK_MUX_STREAMS; i++) {
+        UplinkStream* stream = &mux->streams[i];
+        while (stream->active) {
+            mux->stats[stream->priority].dropped++;
+            popFrame(mux, stream);
+        }
+    }
+}
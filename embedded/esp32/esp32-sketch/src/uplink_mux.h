@@ -0,0 +1,103 @@
+/*
+ * PigeonHub Uplink Multiplexer
+ *
+ * Everything bound for the bootstrap hub shares one WebSocket, and each
+ * write costs the loop a TLS record. Sent first come, first served, one
+ * namespace's announce storm would sit in front of another's ICE
+ * candidates. Frames that can't go out at once are queued instead in
+ * logical streams, one per (namespace, priority), and drained by:
+ *
+ *   - strict priority: signaling (offers, answers, candidates) before bulk
+ *     (announces and the rest);
+ *   - deficit round robin among the streams of a priority, quantum bytes
+ *     per round, so a busy namespace gets its share and no more;
+ *   - a byte credit (token bucket) for the whole link, which bounds how
+ *     long the loop spends writing to the uplink.
+ *
+ * A frame goes straight out when nothing of its priority or higher is
+ * queued and credit is left; only a backlog pays for the copy. Head-of-line
+ * blocking is confined to a stream. The bootstrap hub's protocol is
+ * unchanged: streams only exist on this side of the link.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_UPLINK_MUX_H
+#define PIGEONHUB_UPLINK_MUX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "mem_policy.h"
+
+#define UPLINK_MUX_STREAMS  8
+#define UPLINK_MUX_DEPTH    16  // Frames per stream
+#define UPLINK_MUX_RATE     (64 * 1024)  // Bytes per second written to the uplink
+#define UPLINK_MUX_BURST    (8 * 1024)
+#define UPLINK_MUX_QUANTUM  512          // Per stream per round
+
+enum UplinkPriority {
+    UPLINK_PRIO_SIGNAL = 0,
+    UPLINK_PRIO_BULK,
+    UPLINK_PRIO_COUNT
+};
+
+struct UplinkQueued {
+    uint8_t* data;      // From the MemPolicy, BULK
+    size_t len;
+    uint32_t queuedMs;
+};
+
+struct UplinkStream {
+    bool active;
+    uint32_t key;       // Caller's namespace key
+    uint8_t priority;
+    uint8_t head;
+    uint8_t count;
+    int32_t deficit;    // Bytes this stream may still send in the current round
+    UplinkQueued frames[UPLINK_MUX_DEPTH];
+};
+
+struct UplinkPrioStats {
+    uint32_t direct;    // Sent without queueing
+    uint32_t queued;
+    uint32_t sent;      // From the queue
+    uint32_t dropped;   // Stream full, out of streams, over maxBytes or out of memory
+    uint32_t waitMsTotal;
+    uint32_t waitMsMax;
+};
+
+struct UplinkMux {
+    MemPolicy* mem;
+    uint32_t bytesPerSec;
+    uint32_t burst;
+    uint32_t quantum;
+    size_t maxBytes;    // All queued frames together
+
+    int32_t credit;     // May go negative: a frame bigger than the burst still goes out
+    uint32_t lastMs;
+    size_t bytes;
+    uint16_t pending[UPLINK_PRIO_COUNT];
+    uint8_t next;       // Stream the next round starts at
+
+    UplinkStream streams[UPLINK_MUX_STREAMS];
+    UplinkPrioStats stats[UPLINK_PRIO_COUNT];
+};
+
+void uplinkMuxInit(UplinkMux* mux, MemPolicy* mem, uint32_t bytesPerSec, uint32_t burst,
+                   uint32_t quantum, size_t maxBytes, uint32_t now);
+
+// True if a frame may be sent right away, in which case its bytes are
+// charged. Otherwise queue it with uplinkMuxPush().
+bool uplinkMuxDirect(UplinkMux* mux, uint8_t priority, size_t len, uint32_t now);
+
+// Queues a copy of the frame; false if it was dropped
+bool uplinkMuxPush(UplinkMux* mux, uint32_t key, uint8_t priority, const uint8_t* data, size_t len,
+                   uint32_t now);
+
+// Sends what the credit allows, in priority and round-robin order
+void uplinkMuxPoll(UplinkMux* mux, uint32_t now, void (*send)(const uint8_t* data, size_t len));
+
+// Drops everything queued (the uplink went away)
+void uplinkMuxClear(UplinkMux* mux);
+
+#endif // PIGEONHUB_UPLINK_MUX_H
@@ -0,0 +1,172 @@
+/*
+ * PigeonHub Warm-Restart State - encoding
+ */
+
+#include "warm_state.h"
+#include <string.h>
+
+// Bounded little-endian writer/reader over a byte buffer
+struct BlobCursor {
+    uint8_t* buf;
+    const uint8_t* in;
+    size_t pos;
+    size_t cap;
+    bool ok;
+};
+
+static void putBytes(BlobCursor* c, const void* data, size_t len) {
+    if (!c->ok || c->pos + len > c->cap) { c->ok = false; return; }
+    memcpy(c->buf + c->pos, data, len);
+    c->pos += len;
+}
+
+static void putU16(BlobCursor* c, uint16_t v) {
+    uint8_t b[2] = { (uint8_t)v, (uint8_t)(v >> 8) };
+    putBytes(c, b, 2);
+}
+
+static void putU32(BlobCursor* c, uint32_t v) {
+    uint8_t b[4] = { (uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24) };
+    putBytes(c, b, 4);
+}
+
+static void getBytes(BlobCursor* c, void* out, size_t len) {
+    if (!c->ok || c->pos + len > c->cap) { c->ok = false; return; }
+    memcpy(out, c->in + c->pos, len);
+    c->pos += len;
+}
+
+static void putU8(BlobCursor* c, uint8_t v) {
+    putBytes(c, &v, 1);
+}
+
+static uint8_t getU8(BlobCursor* c) {
+    uint8_t v = 0;
+    getBytes(c, &v, 1);
+    return v;
+}
+
+static uint16_t getU16(BlobCursor* c) {
+    uint8_t b[2] = {0};
+    getBytes(c, b, 2);
+    return (uint16_t)(b[0] | (b[1] << 8));
+}
+
+static uint32_t getU32(BlobCursor* c) {
+    uint8_t b[4] = {0};
+    getBytes(c, b, 4);
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+// Fixed-size string fields are always re-terminated on decode
+static void getString(BlobCursor* c, char* out, size_t len) {
+    getBytes(c, out, len);
+    out[len - 1] = '\0';
+}
+
+uint32_t warmStateCrc32(const uint8_t* data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+size_t warmStateEncode(const WarmState* state, uint8_t* buf, size_t cap) {
+    BlobCursor c = { buf, NULL, WARM_STATE_HEADER_SIZE, cap, cap >= WARM_STATE_HEADER_SIZE };
+
+    putBytes(&c, state->hubPeerId, sizeof(state->hubPeerId));
+    putBytes(&c, state->uplinkHost, sizeof(state->uplinkHost));
+    putU16(&c, state->uplinkPort);
+    putBytes(&c, state->namespaces, sizeof(state->namespaces));
+    putU32(&c, state->counters.boots);
+    putU32(&c, state->counters.warmBoots);
+    putU32(&c, state->counters.framesIn);
+    putU32(&c, state->counters.framesRelayed);
+    putU32(&c, state->counters.framesUplinked);
+    putU32(&c, state->counters.relayMisses);
+    const RemotePeerCache* cache = state->remotePeers;
+    uint8_t saved = 0;
+    for (int i = 0; cache && i < REMOTE_CACHE_SLOTS; i++) {
+        const RemotePeer* peer = &cache->peers[i];
+        if (peer->used && state->nowMs - peer->seenMs < cache->ttlMs) saved++;
+    }
+    putU8(&c, saved);
+    for (int i = 0; saved && i < REMOTE_CACHE_SLOTS; i++) {
+        const RemotePeer* peer = &cache->peers[i];
+        if (!peer->used || state->nowMs - peer->seenMs >= cache->ttlMs) continue;
+        size_t dataLen = strnlen(peer->data, REMOTE_CACHE_DATA_MAX - 1);
+        putU32(&c, peer->nsHash);
+        putBytes(&c, peer->id, REMOTE_CACHE_ID_LEN);
+        putU8(&c, peer->flags);
+        putU32(&c, state->nowMs - peer->seenMs);
+        putU8(&c, (uint8_t)dataLen);
+        putBytes(&c, peer->data, dataLen);
+    }
+    if (!c.ok) return 0;
+
+    size_t payloadLen = c.pos - WARM_STATE_HEADER_SIZE;
+    c.pos = 0;
+    putU32(&c, WARM_STATE_MAGIC);
+    putU16(&c, WARM_STATE_VERSION);
+    putU16(&c, (uint16_t)payloadLen);
+    putU32(&c, warmStateCrc32(buf + WARM_STATE_HEADER_SIZE, payloadLen));
+
+    return WARM_STATE_HEADER_SIZE + payloadLen;
+}
+
+bool warmStateDecode(const uint8_t* buf, size_t len, WarmState* state) {
+    BlobCursor c = { NULL, buf, 0, len, true };
+
+    if (getU32(&c) != WARM_STATE_MAGIC) return false;
+    if (getU16(&c) != WARM_STATE_VERSION) return false;
+    size_t payloadLen = getU16(&c);
+    uint32_t crc = getU32(&c);
+    if (!c.ok || WARM_STATE_HEADER_SIZE + payloadLen > len) return false;
+    if (warmStateCrc32(buf + WARM_STATE_HEADER_SIZE, payloadLen) != crc) return false;
+
+    WarmState decoded;
+    c.cap = WARM_STATE_HEADER_SIZE + payloadLen;
+    getString(&c, decoded.hubPeerId, sizeof(decoded.hubPeerId));
+    getString(&c, decoded.uplinkHost, sizeof(decoded.uplinkHost));
+    decoded.uplinkPort = getU16(&c);
+    for (int i = 0; i < NAMESPACE_MAX; i++) {
+        getString(&c, decoded.namespaces[i], NAMESPACE_NAME_LEN);
+    }
+    decoded.counters.boots = getU32(&c);
+    decoded.counters.warmBoots = getU32(&c);
+    decoded.counters.framesIn = getU32(&c);
+    decoded.counters.framesRelayed = getU32(&c);
+    decoded.counters.framesUplinked = getU32(&c);
+    decoded.counters.relayMisses = getU32(&c);
+    decoded.remotePeers = state->remotePeers;
+    decoded.nowMs = state->nowMs;
+
+    int peers = getU8(&c);
+    if (peers > REMOTE_CACHE_SLOTS) return false;
+    for (int i = 0; i < peers; i++) {
+        uint32_t hash = getU32(&c);
+        uint8_t id[REMOTE_CACHE_ID_LEN];
+        getBytes(&c, id, REMOTE_CACHE_ID_LEN);
+        uint8_t flags = getU8(&c);
+        uint32_t ageMs = getU32(&c);
+        size_t dataLen = getU8(&c);
+        char data[REMOTE_CACHE_DATA_MAX];
+        if (dataLen >= REMOTE_CACHE_DATA_MAX) return false;
+        getBytes(&c, data, dataLen);
+        data[dataLen] = '\0';
+        // Entries that expired meanwhile are dropped
+        if (c.ok && decoded.remotePeers) {
+            remoteCacheRestore(decoded.remotePeers, hash, id, flags, data, ageMs, decoded.nowMs);
+        }
+    }
+
+    // Payload must be consumed exactly; anything else is a layout mismatch
+    if (!c.ok || c.pos != c.cap) return false;
+
+    *state = decoded;
+    return true;
+}
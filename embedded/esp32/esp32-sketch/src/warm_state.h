@@ -0,0 +1,73 @@
+/*
+ * PigeonHub Warm-Restart State
+ *
+ * Hub state that is worth keeping across a watchdog reset, panic or OTA
+ * reboot. The sketch encodes it into a blob in RTC slow memory
+ * (RTC_NOINIT_ATTR), which survives every reset except power loss, and
+ * decodes it at the next boot.
+ *
+ * Blob layout (little endian):
+ *    0  4  magic "PHWS"
+ *    4  2  layout version
+ *    6  2  payload length
+ *    8  4  CRC-32 of the payload
+ *   12  n  payload (fields in WarmState order; remote peers as a count and
+ *          then hash, ID, flags, age and length-prefixed data per entry)
+ *
+ * A blob with the wrong magic, version, length or checksum (power-on garbage
+ * or an older firmware's layout) is rejected and the hub cold-starts.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_WARM_STATE_H
+#define PIGEONHUB_WARM_STATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "namespace_table.h"
+#include "remote_peer_cache.h"
+
+#define WARM_STATE_MAGIC        0x53574850u  // "PHWS"
+#define WARM_STATE_VERSION      2
+#define WARM_STATE_HEADER_SIZE  12
+#define WARM_STATE_BLOB_SIZE    4096         // Reserved RTC bytes; fits a full remote peer cache
+
+#define WARM_PEER_ID_LEN        41           // 40 hex chars + terminator
+#define WARM_UPLINK_HOST_LEN    64
+
+// Cumulative hub counters (carried across warm restarts)
+struct HubCounters {
+    uint32_t boots;            // All boots since the last cold start
+    uint32_t warmBoots;        // Boots that restored this state
+    uint32_t framesIn;         // Frames received from local peers
+    uint32_t framesRelayed;    // Frames forwarded to local peers
+    uint32_t framesUplinked;   // Frames forwarded to the bootstrap hub
+    uint32_t relayMisses;      // Signaling with no reachable target
+};
+
+struct WarmState {
+    char hubPeerId[WARM_PEER_ID_LEN];
+    char uplinkHost[WARM_UPLINK_HOST_LEN];  // Last bootstrap hub that accepted us
+    uint16_t uplinkPort;
+    char namespaces[NAMESPACE_MAX][NAMESPACE_NAME_LEN];
+    HubCounters counters;
+
+    // Live entries are saved from and restored into the cache itself rather
+    // than copied here (24 entries of up to 96 bytes of data). The clock
+    // starts over with the hub, so entries travel with their age at nowMs.
+    RemotePeerCache* remotePeers;  // NULL: none saved, or restore skipped
+    uint32_t nowMs;
+};
+
+// Returns the encoded size, or 0 if cap is too small
+size_t warmStateEncode(const WarmState* state, uint8_t* buf, size_t cap);
+
+// Returns true and fills state only for an intact blob of this version.
+// Remote peers go into state->remotePeers as they are decoded, so on a
+// false return the caller re-initialises that cache.
+bool warmStateDecode(const uint8_t* buf, size_t len, WarmState* state);
+
+uint32_t warmStateCrc32(const uint8_t* data, size_t len);
+
+#endif // PIGEONHUB_WARM_STATE_H
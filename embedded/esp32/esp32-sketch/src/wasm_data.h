@@ -1,668 +1,14 @@
-// Auto-generated from pigeonhub_client.wasm
-#include <Arduino.h>
-const uint8_t pigeonhub_wasm_data[] PROGMEM = {
-    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x31, 0x09, 0x60,
-    0x02, 0x7f, 0x7f, 0x00, 0x60, 0x01, 0x7f, 0x01, 0x7f, 0x60, 0x04, 0x7f,
-    0x7f, 0x7f, 0x7f, 0x01, 0x7f, 0x60, 0x00, 0x01, 0x7f, 0x60, 0x03, 0x7f,
-    0x7f, 0x7f, 0x01, 0x7f, 0x60, 0x00, 0x00, 0x60, 0x02, 0x7f, 0x7f, 0x01,
-    0x7f, 0x60, 0x01, 0x7f, 0x00, 0x60, 0x03, 0x7f, 0x7f, 0x7f, 0x00, 0x02,
-    0xfe, 0x01, 0x10, 0x03, 0x65, 0x6e, 0x76, 0x0b, 0x6c, 0x6f, 0x67, 0x5f,
-    0x6d, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x00, 0x00, 0x03, 0x65, 0x6e,
-    0x76, 0x06, 0x73, 0x74, 0x72, 0x6c, 0x65, 0x6e, 0x00, 0x01, 0x03, 0x65,
-    0x6e, 0x76, 0x0d, 0x67, 0x65, 0x74, 0x5f, 0x64, 0x65, 0x76, 0x69, 0x63,
-    0x65, 0x5f, 0x69, 0x64, 0x00, 0x00, 0x03, 0x65, 0x6e, 0x76, 0x08, 0x73,
-    0x6e, 0x70, 0x72, 0x69, 0x6e, 0x74, 0x66, 0x00, 0x02, 0x03, 0x65, 0x6e,
-    0x76, 0x06, 0x6d, 0x69, 0x6c, 0x6c, 0x69, 0x73, 0x00, 0x03, 0x03, 0x65,
-    0x6e, 0x76, 0x0f, 0x77, 0x73, 0x5f, 0x73, 0x65, 0x6e, 0x64, 0x5f, 0x74,
-    0x6f, 0x5f, 0x70, 0x65, 0x65, 0x72, 0x00, 0x04, 0x03, 0x65, 0x6e, 0x76,
-    0x0c, 0x77, 0x73, 0x5f, 0x62, 0x72, 0x6f, 0x61, 0x64, 0x63, 0x61, 0x73,
-    0x74, 0x00, 0x04, 0x03, 0x65, 0x6e, 0x76, 0x0f, 0x77, 0x73, 0x5f, 0x73,
-    0x65, 0x72, 0x76, 0x65, 0x72, 0x5f, 0x73, 0x74, 0x61, 0x72, 0x74, 0x00,
-    0x01, 0x03, 0x65, 0x6e, 0x76, 0x0e, 0x77, 0x73, 0x5f, 0x73, 0x65, 0x72,
-    0x76, 0x65, 0x72, 0x5f, 0x73, 0x74, 0x6f, 0x70, 0x00, 0x05, 0x03, 0x65,
-    0x6e, 0x76, 0x06, 0x73, 0x74, 0x72, 0x73, 0x74, 0x72, 0x00, 0x06, 0x03,
-    0x65, 0x6e, 0x76, 0x06, 0x73, 0x74, 0x72, 0x63, 0x68, 0x72, 0x00, 0x06,
-    0x03, 0x65, 0x6e, 0x76, 0x07, 0x73, 0x74, 0x72, 0x6e, 0x63, 0x70, 0x79,
-    0x00, 0x04, 0x03, 0x65, 0x6e, 0x76, 0x06, 0x73, 0x74, 0x72, 0x63, 0x6d,
-    0x70, 0x00, 0x06, 0x03, 0x65, 0x6e, 0x76, 0x06, 0x6d, 0x61, 0x6c, 0x6c,
-    0x6f, 0x63, 0x00, 0x01, 0x03, 0x65, 0x6e, 0x76, 0x04, 0x66, 0x72, 0x65,
-    0x65, 0x00, 0x07, 0x03, 0x65, 0x6e, 0x76, 0x06, 0x6d, 0x65, 0x6d, 0x63,
-    0x6d, 0x70, 0x00, 0x04, 0x03, 0x17, 0x16, 0x05, 0x03, 0x03, 0x00, 0x03,
-    0x03, 0x05, 0x07, 0x08, 0x01, 0x07, 0x07, 0x03, 0x01, 0x05, 0x07, 0x01,
-    0x07, 0x05, 0x03, 0x02, 0x08, 0x04, 0x05, 0x01, 0x70, 0x01, 0x01, 0x01,
-    0x05, 0x04, 0x01, 0x01, 0x02, 0x04, 0x06, 0x3f, 0x0a, 0x7f, 0x01, 0x41,
-    0xf0, 0xa9, 0x04, 0x0b, 0x7f, 0x00, 0x41, 0x80, 0x08, 0x0b, 0x7f, 0x00,
-    0x41, 0xf0, 0x29, 0x0b, 0x7f, 0x00, 0x41, 0xf0, 0x29, 0x0b, 0x7f, 0x00,
-    0x41, 0xf0, 0xa9, 0x04, 0x0b, 0x7f, 0x00, 0x41, 0x80, 0x08, 0x0b, 0x7f,
-    0x00, 0x41, 0xf0, 0xa9, 0x04, 0x0b, 0x7f, 0x00, 0x41, 0x80, 0x80, 0x08,
-    0x0b, 0x7f, 0x00, 0x41, 0x00, 0x0b, 0x7f, 0x00, 0x41, 0x01, 0x0b, 0x07,
-    0xf4, 0x03, 0x21, 0x06, 0x6d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x02, 0x00,
-    0x11, 0x5f, 0x5f, 0x77, 0x61, 0x73, 0x6d, 0x5f, 0x63, 0x61, 0x6c, 0x6c,
-    0x5f, 0x63, 0x74, 0x6f, 0x72, 0x73, 0x00, 0x10, 0x07, 0x6c, 0x6f, 0x67,
-    0x5f, 0x73, 0x74, 0x72, 0x00, 0x21, 0x0f, 0x67, 0x65, 0x6e, 0x65, 0x72,
-    0x61, 0x74, 0x65, 0x5f, 0x68, 0x75, 0x62, 0x5f, 0x69, 0x64, 0x00, 0x22,
-    0x09, 0x66, 0x69, 0x6e, 0x64, 0x5f, 0x70, 0x65, 0x65, 0x72, 0x00, 0x19,
-    0x0f, 0x66, 0x69, 0x6e, 0x64, 0x5f, 0x65, 0x6d, 0x70, 0x74, 0x79, 0x5f,
-    0x73, 0x6c, 0x6f, 0x74, 0x00, 0x1c, 0x12, 0x63, 0x6f, 0x75, 0x6e, 0x74,
-    0x5f, 0x61, 0x63, 0x74, 0x69, 0x76, 0x65, 0x5f, 0x70, 0x65, 0x65, 0x72,
-    0x73, 0x00, 0x23, 0x13, 0x63, 0x72, 0x65, 0x61, 0x74, 0x65, 0x5f, 0x6a,
-    0x73, 0x6f, 0x6e, 0x5f, 0x6d, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x00,
-    0x24, 0x0e, 0x73, 0x65, 0x6e, 0x64, 0x5f, 0x70, 0x65, 0x65, 0x72, 0x5f,
-    0x6c, 0x69, 0x73, 0x74, 0x00, 0x1a, 0x14, 0x62, 0x72, 0x6f, 0x61, 0x64,
-    0x63, 0x61, 0x73, 0x74, 0x5f, 0x70, 0x65, 0x65, 0x72, 0x5f, 0x65, 0x76,
-    0x65, 0x6e, 0x74, 0x00, 0x25, 0x04, 0x69, 0x6e, 0x69, 0x74, 0x00, 0x14,
-    0x0c, 0x73, 0x74, 0x61, 0x72, 0x74, 0x5f, 0x73, 0x65, 0x72, 0x76, 0x65,
-    0x72, 0x00, 0x1d, 0x0b, 0x73, 0x74, 0x6f, 0x70, 0x5f, 0x73, 0x65, 0x72,
-    0x76, 0x65, 0x72, 0x00, 0x1e, 0x11, 0x6f, 0x6e, 0x5f, 0x70, 0x65, 0x65,
-    0x72, 0x5f, 0x63, 0x6f, 0x6e, 0x6e, 0x65, 0x63, 0x74, 0x65, 0x64, 0x00,
-    0x1b, 0x14, 0x6f, 0x6e, 0x5f, 0x70, 0x65, 0x65, 0x72, 0x5f, 0x64, 0x69,
-    0x73, 0x63, 0x6f, 0x6e, 0x6e, 0x65, 0x63, 0x74, 0x65, 0x64, 0x00, 0x17,
-    0x0a, 0x6f, 0x6e, 0x5f, 0x6d, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x00,
-    0x18, 0x04, 0x6c, 0x6f, 0x6f, 0x70, 0x00, 0x16, 0x0a, 0x69, 0x73, 0x5f,
-    0x72, 0x75, 0x6e, 0x6e, 0x69, 0x6e, 0x67, 0x00, 0x15, 0x0e, 0x67, 0x65,
-    0x74, 0x5f, 0x70, 0x65, 0x65, 0x72, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 0x74,
-    0x00, 0x12, 0x09, 0x67, 0x65, 0x74, 0x5f, 0x73, 0x74, 0x61, 0x74, 0x73,
-    0x00, 0x13, 0x0a, 0x67, 0x65, 0x74, 0x5f, 0x68, 0x75, 0x62, 0x5f, 0x69,
-    0x64, 0x00, 0x11, 0x06, 0x6d, 0x61, 0x6c, 0x6c, 0x6f, 0x63, 0x00, 0x20,
-    0x04, 0x66, 0x72, 0x65, 0x65, 0x00, 0x1f, 0x19, 0x5f, 0x5f, 0x69, 0x6e,
-    0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x5f, 0x66, 0x75, 0x6e, 0x63, 0x74,
-    0x69, 0x6f, 0x6e, 0x5f, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x01, 0x00, 0x0c,
-    0x5f, 0x5f, 0x64, 0x73, 0x6f, 0x5f, 0x68, 0x61, 0x6e, 0x64, 0x6c, 0x65,
-    0x03, 0x01, 0x0a, 0x5f, 0x5f, 0x64, 0x61, 0x74, 0x61, 0x5f, 0x65, 0x6e,
-    0x64, 0x03, 0x02, 0x0b, 0x5f, 0x5f, 0x73, 0x74, 0x61, 0x63, 0x6b, 0x5f,
-    0x6c, 0x6f, 0x77, 0x03, 0x03, 0x0c, 0x5f, 0x5f, 0x73, 0x74, 0x61, 0x63,
-    0x6b, 0x5f, 0x68, 0x69, 0x67, 0x68, 0x03, 0x04, 0x0d, 0x5f, 0x5f, 0x67,
-    0x6c, 0x6f, 0x62, 0x61, 0x6c, 0x5f, 0x62, 0x61, 0x73, 0x65, 0x03, 0x05,
-    0x0b, 0x5f, 0x5f, 0x68, 0x65, 0x61, 0x70, 0x5f, 0x62, 0x61, 0x73, 0x65,
-    0x03, 0x06, 0x0a, 0x5f, 0x5f, 0x68, 0x65, 0x61, 0x70, 0x5f, 0x65, 0x6e,
-    0x64, 0x03, 0x07, 0x0d, 0x5f, 0x5f, 0x6d, 0x65, 0x6d, 0x6f, 0x72, 0x79,
-    0x5f, 0x62, 0x61, 0x73, 0x65, 0x03, 0x08, 0x0c, 0x5f, 0x5f, 0x74, 0x61,
-    0x62, 0x6c, 0x65, 0x5f, 0x62, 0x61, 0x73, 0x65, 0x03, 0x09, 0x0a, 0xd0,
-    0x31, 0x16, 0x02, 0x00, 0x0b, 0x08, 0x00, 0x41, 0xa0, 0x8d, 0x80, 0x80,
-    0x00, 0x0b, 0x0b, 0x00, 0x41, 0x00, 0x28, 0x02, 0xec, 0x8d, 0x80, 0x80,
-    0x00, 0x0b, 0x99, 0x01, 0x01, 0x02, 0x7f, 0x23, 0x80, 0x80, 0x80, 0x80,
-    0x00, 0x41, 0x20, 0x6b, 0x22, 0x02, 0x24, 0x80, 0x80, 0x80, 0x80, 0x00,
-    0x10, 0x84, 0x80, 0x80, 0x80, 0x00, 0x21, 0x03, 0x20, 0x02, 0x41, 0x10,
-    0x6a, 0x41, 0x00, 0x29, 0x03, 0xe0, 0x99, 0x80, 0x80, 0x00, 0x37, 0x03,
-    0x00, 0x20, 0x02, 0x41, 0x18, 0x6a, 0x41, 0x00, 0x29, 0x03, 0xe8, 0x99,
-    0x80, 0x80, 0x00, 0x37, 0x03, 0x00, 0x20, 0x02, 0x41, 0xa0, 0x8d, 0x80,
-    0x80, 0x00, 0x36, 0x02, 0x00, 0x20, 0x02, 0x41, 0x00, 0x28, 0x02, 0xe4,
-    0x8d, 0x80, 0x80, 0x00, 0x36, 0x02, 0x04, 0x20, 0x02, 0x41, 0x00, 0x28,
-    0x02, 0xec, 0x8d, 0x80, 0x80, 0x00, 0x36, 0x02, 0x08, 0x20, 0x02, 0x20,
-    0x03, 0x41, 0x00, 0x28, 0x02, 0xe8, 0x8d, 0x80, 0x80, 0x00, 0x6b, 0x41,
-    0xe8, 0x07, 0x6e, 0x36, 0x02, 0x0c, 0x20, 0x00, 0x20, 0x01, 0x41, 0x80,
-    0x88, 0x80, 0x80, 0x00, 0x20, 0x02, 0x10, 0x83, 0x80, 0x80, 0x80, 0x00,
-    0x1a, 0x20, 0x02, 0x41, 0x20, 0x6a, 0x24, 0x80, 0x80, 0x80, 0x80, 0x00,
-    0x0b, 0x9c, 0x04, 0x01, 0x02, 0x7f, 0x23, 0x80, 0x80, 0x80, 0x80, 0x00,
-    0x41, 0x90, 0x01, 0x6b, 0x22, 0x00, 0x24, 0x80, 0x80, 0x80, 0x80, 0x00,
-    0x41, 0xf1, 0x8a, 0x80, 0x80, 0x00, 0x41, 0x25, 0x10, 0x80, 0x80, 0x80,
-    0x80, 0x00, 0x41, 0xa0, 0x8d, 0x80, 0x80, 0x00, 0x41, 0xc0, 0x00, 0x10,
-    0x82, 0x80, 0x80, 0x80, 0x00, 0x41, 0x00, 0x42, 0x00, 0x37, 0x03, 0xe0,
-    0x8d, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02, 0xec, 0x8d,
-    0x80, 0x80, 0x00, 0x10, 0x84, 0x80, 0x80, 0x80, 0x00, 0x21, 0x01, 0x41,
-    0x00, 0x42, 0x00, 0x37, 0x03, 0xe0, 0x99, 0x80, 0x80, 0x00, 0x41, 0x00,
-    0x20, 0x01, 0x36, 0x02, 0xe8, 0x8d, 0x80, 0x80, 0x00, 0x41, 0x00, 0x42,
-    0x00, 0x37, 0x03, 0xe8, 0x99, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x7f,
-    0x36, 0x02, 0xf0, 0x8d, 0x80, 0x80, 0x00, 0x41, 0x00, 0x42, 0x80, 0x80,
-    0x80, 0x80, 0x70, 0x37, 0x03, 0xb8, 0x8e, 0x80, 0x80, 0x00, 0x41, 0x00,
-    0x42, 0x80, 0x80, 0x80, 0x80, 0x70, 0x37, 0x02, 0x84, 0x8f, 0x80, 0x80,
-    0x00, 0x41, 0x00, 0x42, 0x80, 0x80, 0x80, 0x80, 0x70, 0x37, 0x03, 0xd0,
-    0x8f, 0x80, 0x80, 0x00, 0x41, 0x00, 0x42, 0x80, 0x80, 0x80, 0x80, 0x70,
-    0x37, 0x02, 0x9c, 0x90, 0x80, 0x80, 0x00, 0x41, 0x00, 0x42, 0x80, 0x80,
-    0x80, 0x80, 0x70, 0x37, 0x03, 0xe8, 0x90, 0x80, 0x80, 0x00, 0x41, 0x00,
-    0x42, 0x80, 0x80, 0x80, 0x80, 0x70, 0x37, 0x02, 0xb4, 0x91, 0x80, 0x80,
-    0x00, 0x41, 0x00, 0x42, 0x80, 0x80, 0x80, 0x80, 0x70, 0x37, 0x03, 0x98,
-    0x93, 0x80, 0x80, 0x00, 0x41, 0x00, 0x42, 0x80, 0x80, 0x80, 0x80, 0x70,
-    0x37, 0x03, 0x80, 0x92, 0x80, 0x80, 0x00, 0x41, 0x00, 0x42, 0x80, 0x80,
-    0x80, 0x80, 0x70, 0x37, 0x02, 0xcc, 0x92, 0x80, 0x80, 0x00, 0x41, 0x00,
-    0x42, 0x80, 0x80, 0x80, 0x80, 0x70, 0x37, 0x02, 0xe4, 0x93, 0x80, 0x80,
-    0x00, 0x41, 0x00, 0x42, 0x80, 0x80, 0x80, 0x80, 0x70, 0x37, 0x03, 0xb0,
-    0x94, 0x80, 0x80, 0x00, 0x41, 0x00, 0x42, 0x80, 0x80, 0x80, 0x80, 0x70,
-    0x37, 0x02, 0xfc, 0x94, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36,
-    0x02, 0xc8, 0x95, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02,
-    0x94, 0x96, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x7f, 0x36, 0x02, 0xcc,
-    0x95, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x7f, 0x36, 0x02, 0x98, 0x96,
-    0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x7f, 0x36, 0x02, 0xe4, 0x96, 0x80,
-    0x80, 0x00, 0x41, 0x00, 0x41, 0x7f, 0x36, 0x02, 0xb0, 0x97, 0x80, 0x80,
-    0x00, 0x41, 0x00, 0x41, 0x7f, 0x36, 0x02, 0xfc, 0x97, 0x80, 0x80, 0x00,
-    0x41, 0x00, 0x41, 0x7f, 0x36, 0x02, 0xc8, 0x98, 0x80, 0x80, 0x00, 0x41,
-    0x00, 0x41, 0x7f, 0x36, 0x02, 0x94, 0x99, 0x80, 0x80, 0x00, 0x41, 0x00,
-    0x41, 0x00, 0x36, 0x02, 0xe0, 0x96, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41,
-    0x00, 0x36, 0x02, 0xac, 0x97, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00,
-    0x36, 0x02, 0xf8, 0x97, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36,
-    0x02, 0xc4, 0x98, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02,
-    0x90, 0x99, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02, 0xdc,
-    0x99, 0x80, 0x80, 0x00, 0x20, 0x00, 0x41, 0xa0, 0x8d, 0x80, 0x80, 0x00,
-    0x36, 0x02, 0x00, 0x20, 0x00, 0x41, 0x10, 0x6a, 0x41, 0x80, 0x01, 0x41,
-    0xbd, 0x89, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x83, 0x80, 0x80, 0x80,
-    0x00, 0x1a, 0x20, 0x00, 0x41, 0x10, 0x6a, 0x20, 0x00, 0x41, 0x10, 0x6a,
-    0x10, 0x81, 0x80, 0x80, 0x80, 0x00, 0x10, 0x80, 0x80, 0x80, 0x80, 0x00,
-    0x20, 0x00, 0x41, 0x90, 0x01, 0x6a, 0x24, 0x80, 0x80, 0x80, 0x80, 0x00,
-    0x41, 0x00, 0x0b, 0x0b, 0x00, 0x41, 0x00, 0x28, 0x02, 0xe0, 0x8d, 0x80,
-    0x80, 0x00, 0x0b, 0xbe, 0x01, 0x01, 0x04, 0x7f, 0x23, 0x80, 0x80, 0x80,
-    0x80, 0x00, 0x41, 0x90, 0x01, 0x6b, 0x22, 0x00, 0x24, 0x80, 0x80, 0x80,
-    0x80, 0x00, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xe0, 0x8d, 0x80, 0x80,
-    0x00, 0x45, 0x0d, 0x00, 0x41, 0x90, 0x74, 0x21, 0x01, 0x10, 0x84, 0x80,
-    0x80, 0x80, 0x00, 0x21, 0x02, 0x03, 0x40, 0x02, 0x40, 0x20, 0x01, 0x41,
-    0xa8, 0x9a, 0x80, 0x80, 0x00, 0x6a, 0x28, 0x02, 0x00, 0x45, 0x0d, 0x00,
-    0x20, 0x02, 0x20, 0x01, 0x41, 0xa4, 0x9a, 0x80, 0x80, 0x00, 0x6a, 0x28,
-    0x02, 0x00, 0x6b, 0x41, 0xe1, 0xd4, 0x03, 0x49, 0x0d, 0x00, 0x20, 0x00,
-    0x20, 0x01, 0x41, 0xe0, 0x99, 0x80, 0x80, 0x00, 0x6a, 0x22, 0x03, 0x28,
-    0x02, 0x00, 0x36, 0x02, 0x00, 0x20, 0x00, 0x41, 0x10, 0x6a, 0x41, 0x80,
-    0x01, 0x41, 0xa7, 0x8a, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x83, 0x80,
-    0x80, 0x80, 0x00, 0x1a, 0x20, 0x00, 0x41, 0x10, 0x6a, 0x20, 0x00, 0x41,
-    0x10, 0x6a, 0x10, 0x81, 0x80, 0x80, 0x80, 0x00, 0x10, 0x80, 0x80, 0x80,
-    0x80, 0x00, 0x20, 0x03, 0x28, 0x02, 0x00, 0x10, 0x97, 0x80, 0x80, 0x80,
-    0x00, 0x0b, 0x20, 0x01, 0x41, 0xcc, 0x00, 0x6a, 0x22, 0x01, 0x0d, 0x00,
-    0x0b, 0x0b, 0x20, 0x00, 0x41, 0x90, 0x01, 0x6a, 0x24, 0x80, 0x80, 0x80,
-    0x80, 0x00, 0x0b, 0xe8, 0x04, 0x01, 0x03, 0x7f, 0x23, 0x80, 0x80, 0x80,
-    0x80, 0x00, 0x41, 0xd0, 0x03, 0x6b, 0x22, 0x01, 0x24, 0x80, 0x80, 0x80,
-    0x80, 0x00, 0x02, 0x40, 0x20, 0x00, 0x10, 0x99, 0x80, 0x80, 0x80, 0x00,
-    0x22, 0x02, 0x45, 0x0d, 0x00, 0x20, 0x01, 0x20, 0x00, 0x36, 0x02, 0x40,
-    0x20, 0x01, 0x20, 0x02, 0x41, 0x04, 0x6a, 0x22, 0x03, 0x36, 0x02, 0x44,
-    0x20, 0x01, 0x41, 0xd0, 0x00, 0x6a, 0x41, 0x80, 0x01, 0x41, 0xc1, 0x8b,
-    0x80, 0x80, 0x00, 0x20, 0x01, 0x41, 0xc0, 0x00, 0x6a, 0x10, 0x83, 0x80,
-    0x80, 0x80, 0x00, 0x1a, 0x20, 0x01, 0x41, 0xd0, 0x00, 0x6a, 0x20, 0x01,
-    0x41, 0xd0, 0x00, 0x6a, 0x10, 0x81, 0x80, 0x80, 0x80, 0x00, 0x10, 0x80,
-    0x80, 0x80, 0x80, 0x00, 0x20, 0x01, 0x20, 0x03, 0x36, 0x02, 0x30, 0x20,
-    0x01, 0x41, 0xd0, 0x01, 0x6a, 0x41, 0x80, 0x02, 0x41, 0x82, 0x8c, 0x80,
-    0x80, 0x00, 0x20, 0x01, 0x41, 0x30, 0x6a, 0x10, 0x83, 0x80, 0x80, 0x80,
-    0x00, 0x1a, 0x10, 0x84, 0x80, 0x80, 0x80, 0x00, 0x21, 0x03, 0x20, 0x01,
-    0x41, 0xd7, 0x89, 0x80, 0x80, 0x00, 0x36, 0x02, 0x10, 0x20, 0x01, 0x41,
-    0xa0, 0x8d, 0x80, 0x80, 0x00, 0x36, 0x02, 0x14, 0x20, 0x01, 0x20, 0x03,
-    0x36, 0x02, 0x18, 0x20, 0x01, 0x41, 0x20, 0x6a, 0x20, 0x01, 0x41, 0xd0,
-    0x01, 0x6a, 0x36, 0x02, 0x00, 0x20, 0x01, 0x41, 0xbf, 0x8b, 0x80, 0x80,
-    0x00, 0x41, 0x96, 0x8d, 0x80, 0x80, 0x00, 0x20, 0x01, 0x2d, 0x00, 0xd0,
-    0x01, 0x1b, 0x36, 0x02, 0x1c, 0x41, 0xf0, 0x99, 0x80, 0x80, 0x00, 0x41,
-    0x80, 0x10, 0x41, 0xdc, 0x88, 0x80, 0x80, 0x00, 0x20, 0x01, 0x41, 0x10,
-    0x6a, 0x10, 0x83, 0x80, 0x80, 0x80, 0x00, 0x1a, 0x41, 0xf0, 0x99, 0x80,
-    0x80, 0x00, 0x41, 0xf0, 0x99, 0x80, 0x80, 0x00, 0x10, 0x81, 0x80, 0x80,
-    0x80, 0x00, 0x20, 0x00, 0x10, 0x86, 0x80, 0x80, 0x80, 0x00, 0x1a, 0x20,
-    0x02, 0x41, 0x00, 0x36, 0x02, 0x48, 0x41, 0x00, 0x41, 0x00, 0x28, 0x02,
-    0x84, 0x8f, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x41, 0x00, 0x28, 0x02,
-    0xb8, 0x8e, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28,
-    0x02, 0xd0, 0x8f, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00,
-    0x28, 0x02, 0x9c, 0x90, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41,
-    0x00, 0x28, 0x02, 0xe8, 0x90, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a,
-    0x41, 0x00, 0x28, 0x02, 0xb4, 0x91, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47,
-    0x6a, 0x41, 0x00, 0x28, 0x02, 0x80, 0x92, 0x80, 0x80, 0x00, 0x41, 0x00,
-    0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xcc, 0x92, 0x80, 0x80, 0x00, 0x41,
-    0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0x98, 0x93, 0x80, 0x80, 0x00,
-    0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xe4, 0x93, 0x80, 0x80,
-    0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xb0, 0x94, 0x80,
-    0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xfc, 0x94,
-    0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xc8,
-    0x95, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02,
-    0x94, 0x96, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28,
-    0x02, 0xe0, 0x96, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00,
-    0x28, 0x02, 0xac, 0x97, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41,
-    0x00, 0x28, 0x02, 0xf8, 0x97, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a,
-    0x41, 0x00, 0x28, 0x02, 0xc4, 0x98, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47,
-    0x6a, 0x41, 0x00, 0x28, 0x02, 0x90, 0x99, 0x80, 0x80, 0x00, 0x41, 0x00,
-    0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xdc, 0x99, 0x80, 0x80, 0x00, 0x41,
-    0x00, 0x47, 0x6a, 0x22, 0x00, 0x36, 0x02, 0xec, 0x8d, 0x80, 0x80, 0x00,
-    0x20, 0x01, 0x20, 0x00, 0x36, 0x02, 0x00, 0x20, 0x01, 0x41, 0xd0, 0x00,
-    0x6a, 0x41, 0x80, 0x01, 0x41, 0xb8, 0x8a, 0x80, 0x80, 0x00, 0x20, 0x01,
-    0x10, 0x83, 0x80, 0x80, 0x80, 0x00, 0x1a, 0x20, 0x01, 0x41, 0xd0, 0x00,
-    0x6a, 0x20, 0x01, 0x41, 0xd0, 0x00, 0x6a, 0x10, 0x81, 0x80, 0x80, 0x80,
-    0x00, 0x10, 0x80, 0x80, 0x80, 0x80, 0x00, 0x0b, 0x20, 0x01, 0x41, 0xd0,
-    0x03, 0x6a, 0x24, 0x80, 0x80, 0x80, 0x80, 0x00, 0x0b, 0xb0, 0x0c, 0x01,
-    0x05, 0x7f, 0x23, 0x80, 0x80, 0x80, 0x80, 0x00, 0x41, 0xe0, 0x02, 0x6b,
-    0x22, 0x03, 0x24, 0x80, 0x80, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00,
-    0x29, 0x03, 0xe0, 0x99, 0x80, 0x80, 0x00, 0x42, 0x01, 0x7c, 0x37, 0x03,
-    0xe0, 0x99, 0x80, 0x80, 0x00, 0x02, 0x40, 0x02, 0x40, 0x20, 0x00, 0x10,
-    0x99, 0x80, 0x80, 0x80, 0x00, 0x22, 0x04, 0x0d, 0x00, 0x41, 0xe4, 0x8c,
-    0x80, 0x80, 0x00, 0x41, 0x1a, 0x10, 0x80, 0x80, 0x80, 0x80, 0x00, 0x0c,
-    0x01, 0x0b, 0x20, 0x04, 0x10, 0x84, 0x80, 0x80, 0x80, 0x00, 0x36, 0x02,
-    0x44, 0x20, 0x03, 0x41, 0xd8, 0x00, 0x6a, 0x42, 0x00, 0x37, 0x03, 0x00,
-    0x20, 0x03, 0x41, 0xd0, 0x00, 0x6a, 0x42, 0x00, 0x37, 0x03, 0x00, 0x20,
-    0x03, 0x42, 0x00, 0x37, 0x03, 0x48, 0x20, 0x03, 0x42, 0x00, 0x37, 0x03,
-    0x40, 0x02, 0x40, 0x20, 0x01, 0x41, 0x9f, 0x8c, 0x80, 0x80, 0x00, 0x10,
-    0x89, 0x80, 0x80, 0x80, 0x00, 0x22, 0x05, 0x45, 0x0d, 0x00, 0x20, 0x05,
-    0x41, 0x08, 0x6a, 0x22, 0x05, 0x41, 0x22, 0x10, 0x8a, 0x80, 0x80, 0x80,
-    0x00, 0x22, 0x06, 0x45, 0x0d, 0x00, 0x20, 0x06, 0x20, 0x05, 0x6b, 0x22,
-    0x06, 0x41, 0x1f, 0x4b, 0x0d, 0x00, 0x20, 0x03, 0x41, 0xc0, 0x00, 0x6a,
-    0x20, 0x05, 0x20, 0x06, 0x10, 0x8b, 0x80, 0x80, 0x80, 0x00, 0x1a, 0x0b,
-    0x02, 0x40, 0x20, 0x01, 0x41, 0xa8, 0x8c, 0x80, 0x80, 0x00, 0x10, 0x89,
-    0x80, 0x80, 0x80, 0x00, 0x22, 0x05, 0x45, 0x0d, 0x00, 0x20, 0x05, 0x41,
-    0x0a, 0x6a, 0x22, 0x05, 0x41, 0x22, 0x10, 0x8a, 0x80, 0x80, 0x80, 0x00,
-    0x22, 0x06, 0x45, 0x0d, 0x00, 0x20, 0x06, 0x20, 0x05, 0x6b, 0x22, 0x06,
-    0x41, 0x3f, 0x4b, 0x0d, 0x00, 0x20, 0x04, 0x41, 0x04, 0x6a, 0x22, 0x07,
-    0x20, 0x05, 0x20, 0x06, 0x10, 0x8b, 0x80, 0x80, 0x80, 0x00, 0x1a, 0x20,
-    0x07, 0x20, 0x06, 0x6a, 0x41, 0x00, 0x3a, 0x00, 0x00, 0x0b, 0x02, 0x40,
-    0x02, 0x40, 0x20, 0x03, 0x41, 0xc0, 0x00, 0x6a, 0x41, 0xc8, 0x89, 0x80,
-    0x80, 0x00, 0x41, 0x05, 0x10, 0x8f, 0x80, 0x80, 0x80, 0x00, 0x45, 0x0d,
-    0x00, 0x20, 0x03, 0x41, 0xc0, 0x00, 0x6a, 0x41, 0xcd, 0x89, 0x80, 0x80,
-    0x00, 0x41, 0x0a, 0x10, 0x8f, 0x80, 0x80, 0x80, 0x00, 0x0d, 0x01, 0x0b,
-    0x20, 0x00, 0x10, 0x9a, 0x80, 0x80, 0x80, 0x00, 0x20, 0x03, 0x20, 0x04,
-    0x41, 0x04, 0x6a, 0x36, 0x02, 0x20, 0x20, 0x03, 0x41, 0xe0, 0x00, 0x6a,
-    0x41, 0x80, 0x02, 0x41, 0x82, 0x8c, 0x80, 0x80, 0x00, 0x20, 0x03, 0x41,
-    0x20, 0x6a, 0x10, 0x83, 0x80, 0x80, 0x80, 0x00, 0x1a, 0x10, 0x84, 0x80,
-    0x80, 0x80, 0x00, 0x21, 0x01, 0x20, 0x03, 0x41, 0xe9, 0x89, 0x80, 0x80,
-    0x00, 0x36, 0x02, 0x00, 0x20, 0x03, 0x41, 0xa0, 0x8d, 0x80, 0x80, 0x00,
-    0x36, 0x02, 0x04, 0x20, 0x03, 0x20, 0x01, 0x36, 0x02, 0x08, 0x20, 0x03,
-    0x41, 0x10, 0x6a, 0x20, 0x03, 0x41, 0xe0, 0x00, 0x6a, 0x36, 0x02, 0x00,
-    0x20, 0x03, 0x41, 0xbf, 0x8b, 0x80, 0x80, 0x00, 0x41, 0x96, 0x8d, 0x80,
-    0x80, 0x00, 0x20, 0x03, 0x2d, 0x00, 0x60, 0x1b, 0x36, 0x02, 0x0c, 0x41,
-    0xf0, 0x99, 0x80, 0x80, 0x00, 0x41, 0x80, 0x10, 0x41, 0xdc, 0x88, 0x80,
-    0x80, 0x00, 0x20, 0x03, 0x10, 0x83, 0x80, 0x80, 0x80, 0x00, 0x1a, 0x41,
-    0xf0, 0x99, 0x80, 0x80, 0x00, 0x41, 0xf0, 0x99, 0x80, 0x80, 0x00, 0x10,
-    0x81, 0x80, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x86, 0x80, 0x80, 0x80,
-    0x00, 0x1a, 0x0c, 0x01, 0x0b, 0x02, 0x40, 0x20, 0x03, 0x41, 0xc0, 0x00,
-    0x6a, 0x41, 0x8a, 0x89, 0x80, 0x80, 0x00, 0x41, 0x0a, 0x10, 0x8f, 0x80,
-    0x80, 0x80, 0x00, 0x0d, 0x00, 0x20, 0x03, 0x20, 0x04, 0x41, 0x04, 0x6a,
-    0x36, 0x02, 0x30, 0x20, 0x03, 0x41, 0xe0, 0x00, 0x6a, 0x41, 0x80, 0x01,
-    0x41, 0xa8, 0x89, 0x80, 0x80, 0x00, 0x20, 0x03, 0x41, 0x30, 0x6a, 0x10,
-    0x83, 0x80, 0x80, 0x80, 0x00, 0x1a, 0x20, 0x03, 0x41, 0xe0, 0x00, 0x6a,
-    0x20, 0x03, 0x41, 0xe0, 0x00, 0x6a, 0x10, 0x81, 0x80, 0x80, 0x80, 0x00,
-    0x10, 0x80, 0x80, 0x80, 0x80, 0x00, 0x20, 0x01, 0x20, 0x02, 0x20, 0x00,
-    0x10, 0x86, 0x80, 0x80, 0x80, 0x00, 0x1a, 0x41, 0x00, 0x41, 0x00, 0x29,
-    0x03, 0xe8, 0x99, 0x80, 0x80, 0x00, 0x41, 0x00, 0x28, 0x02, 0xec, 0x8d,
-    0x80, 0x80, 0x00, 0x41, 0x7f, 0x6a, 0xac, 0x7c, 0x37, 0x03, 0xe8, 0x99,
-    0x80, 0x80, 0x00, 0x0c, 0x01, 0x0b, 0x02, 0x40, 0x02, 0x40, 0x20, 0x03,
-    0x29, 0x03, 0x40, 0x42, 0xed, 0xca, 0xcd, 0x9b, 0x97, 0xec, 0xd9, 0x32,
-    0x52, 0x0d, 0x00, 0x20, 0x01, 0x41, 0x90, 0x8c, 0x80, 0x80, 0x00, 0x10,
-    0x89, 0x80, 0x80, 0x80, 0x00, 0x22, 0x00, 0x45, 0x0d, 0x02, 0x20, 0x00,
-    0x41, 0x0e, 0x6a, 0x22, 0x00, 0x41, 0x22, 0x10, 0x8a, 0x80, 0x80, 0x80,
-    0x00, 0x22, 0x04, 0x45, 0x0d, 0x02, 0x20, 0x04, 0x20, 0x00, 0x6b, 0x22,
-    0x04, 0x41, 0x3f, 0x4b, 0x0d, 0x02, 0x41, 0x00, 0x21, 0x05, 0x20, 0x03,
-    0x41, 0xe0, 0x00, 0x6a, 0x20, 0x00, 0x20, 0x04, 0x10, 0x8b, 0x80, 0x80,
-    0x80, 0x00, 0x22, 0x00, 0x20, 0x04, 0x6a, 0x41, 0x00, 0x3a, 0x00, 0x00,
-    0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xb8, 0x8e, 0x80, 0x80, 0x00, 0x45,
-    0x0d, 0x00, 0x41, 0xf4, 0x8d, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x8c,
-    0x80, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x02, 0x0b, 0x02, 0x40, 0x41, 0x00,
-    0x28, 0x02, 0x84, 0x8f, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0xc0,
-    0x8e, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x8c, 0x80, 0x80, 0x80, 0x00,
-    0x0d, 0x00, 0x41, 0x01, 0x21, 0x05, 0x0c, 0x02, 0x0b, 0x02, 0x40, 0x41,
-    0x00, 0x28, 0x02, 0xd0, 0x8f, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41,
-    0x8c, 0x8f, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x8c, 0x80, 0x80, 0x80,
-    0x00, 0x0d, 0x00, 0x41, 0x02, 0x21, 0x05, 0x0c, 0x02, 0x0b, 0x02, 0x40,
-    0x41, 0x00, 0x28, 0x02, 0x9c, 0x90, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00,
-    0x41, 0xd8, 0x8f, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x8c, 0x80, 0x80,
-    0x80, 0x00, 0x0d, 0x00, 0x41, 0x03, 0x21, 0x05, 0x0c, 0x02, 0x0b, 0x02,
-    0x40, 0x41, 0x00, 0x28, 0x02, 0xe8, 0x90, 0x80, 0x80, 0x00, 0x45, 0x0d,
-    0x00, 0x41, 0xa4, 0x90, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x8c, 0x80,
-    0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x04, 0x21, 0x05, 0x0c, 0x02, 0x0b,
-    0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xb4, 0x91, 0x80, 0x80, 0x00, 0x45,
-    0x0d, 0x00, 0x41, 0xf0, 0x90, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x8c,
-    0x80, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x05, 0x21, 0x05, 0x0c, 0x02,
-    0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0x80, 0x92, 0x80, 0x80, 0x00,
-    0x45, 0x0d, 0x00, 0x41, 0xbc, 0x91, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10,
-    0x8c, 0x80, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x06, 0x21, 0x05, 0x0c,
-    0x02, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xcc, 0x92, 0x80, 0x80,
-    0x00, 0x45, 0x0d, 0x00, 0x41, 0x88, 0x92, 0x80, 0x80, 0x00, 0x20, 0x00,
-    0x10, 0x8c, 0x80, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x07, 0x21, 0x05,
-    0x0c, 0x02, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0x98, 0x93, 0x80,
-    0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0xd4, 0x92, 0x80, 0x80, 0x00, 0x20,
-    0x00, 0x10, 0x8c, 0x80, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x08, 0x21,
-    0x05, 0x0c, 0x02, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xe4, 0x93,
-    0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0xa0, 0x93, 0x80, 0x80, 0x00,
-    0x20, 0x00, 0x10, 0x8c, 0x80, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x09,
-    0x21, 0x05, 0x0c, 0x02, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xb0,
-    0x94, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0xec, 0x93, 0x80, 0x80,
-    0x00, 0x20, 0x00, 0x10, 0x8c, 0x80, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41,
-    0x0a, 0x21, 0x05, 0x0c, 0x02, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02,
-    0xfc, 0x94, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0xb8, 0x94, 0x80,
-    0x80, 0x00, 0x20, 0x00, 0x10, 0x8c, 0x80, 0x80, 0x80, 0x00, 0x0d, 0x00,
-    0x41, 0x0b, 0x21, 0x05, 0x0c, 0x02, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28,
-    0x02, 0xc8, 0x95, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0x84, 0x95,
-    0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x8c, 0x80, 0x80, 0x80, 0x00, 0x0d,
-    0x00, 0x41, 0x0c, 0x21, 0x05, 0x0c, 0x02, 0x0b, 0x02, 0x40, 0x41, 0x00,
-    0x28, 0x02, 0x94, 0x96, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0xd0,
-    0x95, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x8c, 0x80, 0x80, 0x80, 0x00,
-    0x0d, 0x00, 0x41, 0x0d, 0x21, 0x05, 0x0c, 0x02, 0x0b, 0x02, 0x40, 0x41,
-    0x00, 0x28, 0x02, 0xe0, 0x96, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41,
-    0x9c, 0x96, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x8c, 0x80, 0x80, 0x80,
-    0x00, 0x0d, 0x00, 0x41, 0x0e, 0x21, 0x05, 0x0c, 0x02, 0x0b, 0x02, 0x40,
-    0x41, 0x00, 0x28, 0x02, 0xac, 0x97, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00,
-    0x41, 0xe8, 0x96, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x8c, 0x80, 0x80,
-    0x80, 0x00, 0x0d, 0x00, 0x41, 0x0f, 0x21, 0x05, 0x0c, 0x02, 0x0b, 0x02,
-    0x40, 0x41, 0x00, 0x28, 0x02, 0xf8, 0x97, 0x80, 0x80, 0x00, 0x45, 0x0d,
-    0x00, 0x41, 0xb4, 0x97, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x8c, 0x80,
-    0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x10, 0x21, 0x05, 0x0c, 0x02, 0x0b,
-    0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xc4, 0x98, 0x80, 0x80, 0x00, 0x45,
-    0x0d, 0x00, 0x41, 0x80, 0x98, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x8c,
-    0x80, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x11, 0x21, 0x05, 0x0c, 0x02,
-    0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0x90, 0x99, 0x80, 0x80, 0x00,
-    0x45, 0x0d, 0x00, 0x41, 0xcc, 0x98, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10,
-    0x8c, 0x80, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x12, 0x21, 0x05, 0x0c,
-    0x02, 0x0b, 0x41, 0x00, 0x28, 0x02, 0xdc, 0x99, 0x80, 0x80, 0x00, 0x45,
-    0x0d, 0x02, 0x41, 0x98, 0x99, 0x80, 0x80, 0x00, 0x20, 0x00, 0x10, 0x8c,
-    0x80, 0x80, 0x80, 0x00, 0x0d, 0x02, 0x41, 0x13, 0x21, 0x05, 0x0c, 0x01,
-    0x0b, 0x20, 0x03, 0x41, 0xc0, 0x00, 0x6a, 0x41, 0x94, 0x89, 0x80, 0x80,
-    0x00, 0x41, 0x0a, 0x10, 0x8f, 0x80, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x01,
-    0x20, 0x03, 0x41, 0xc0, 0x00, 0x6a, 0x41, 0x9e, 0x89, 0x80, 0x80, 0x00,
-    0x41, 0x0a, 0x10, 0x8f, 0x80, 0x80, 0x80, 0x00, 0x0d, 0x01, 0x20, 0x00,
-    0x10, 0x9a, 0x80, 0x80, 0x80, 0x00, 0x0c, 0x01, 0x0b, 0x20, 0x05, 0x41,
-    0xcc, 0x00, 0x6c, 0x41, 0xf0, 0x8d, 0x80, 0x80, 0x00, 0x6a, 0x28, 0x02,
-    0x00, 0x20, 0x01, 0x20, 0x02, 0x10, 0x85, 0x80, 0x80, 0x80, 0x00, 0x1a,
-    0x41, 0x00, 0x41, 0x00, 0x29, 0x03, 0xe8, 0x99, 0x80, 0x80, 0x00, 0x42,
-    0x01, 0x7c, 0x37, 0x03, 0xe8, 0x99, 0x80, 0x80, 0x00, 0x0b, 0x20, 0x03,
-    0x41, 0xe0, 0x02, 0x6a, 0x24, 0x80, 0x80, 0x80, 0x80, 0x00, 0x0b, 0xeb,
-    0x05, 0x01, 0x01, 0x7f, 0x02, 0x40, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02,
-    0xb8, 0x8e, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0xf0, 0x8d, 0x80,
-    0x80, 0x00, 0x21, 0x01, 0x41, 0x00, 0x28, 0x02, 0xf0, 0x8d, 0x80, 0x80,
-    0x00, 0x20, 0x00, 0x46, 0x0d, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28,
-    0x02, 0x84, 0x8f, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0xbc, 0x8e,
-    0x80, 0x80, 0x00, 0x21, 0x01, 0x41, 0x00, 0x28, 0x02, 0xbc, 0x8e, 0x80,
-    0x80, 0x00, 0x20, 0x00, 0x46, 0x0d, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00,
-    0x28, 0x02, 0xd0, 0x8f, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0x88,
-    0x8f, 0x80, 0x80, 0x00, 0x21, 0x01, 0x41, 0x00, 0x28, 0x02, 0x88, 0x8f,
-    0x80, 0x80, 0x00, 0x20, 0x00, 0x46, 0x0d, 0x01, 0x0b, 0x02, 0x40, 0x41,
-    0x00, 0x28, 0x02, 0x9c, 0x90, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41,
-    0xd4, 0x8f, 0x80, 0x80, 0x00, 0x21, 0x01, 0x41, 0x00, 0x28, 0x02, 0xd4,
-    0x8f, 0x80, 0x80, 0x00, 0x20, 0x00, 0x46, 0x0d, 0x01, 0x0b, 0x02, 0x40,
-    0x41, 0x00, 0x28, 0x02, 0xe8, 0x90, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00,
-    0x41, 0xa0, 0x90, 0x80, 0x80, 0x00, 0x21, 0x01, 0x41, 0x00, 0x28, 0x02,
-    0xa0, 0x90, 0x80, 0x80, 0x00, 0x20, 0x00, 0x46, 0x0d, 0x01, 0x0b, 0x02,
-    0x40, 0x41, 0x00, 0x28, 0x02, 0xb4, 0x91, 0x80, 0x80, 0x00, 0x45, 0x0d,
-    0x00, 0x41, 0xec, 0x90, 0x80, 0x80, 0x00, 0x21, 0x01, 0x41, 0x00, 0x28,
-    0x02, 0xec, 0x90, 0x80, 0x80, 0x00, 0x20, 0x00, 0x46, 0x0d, 0x01, 0x0b,
-    0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0x80, 0x92, 0x80, 0x80, 0x00, 0x45,
-    0x0d, 0x00, 0x41, 0xb8, 0x91, 0x80, 0x80, 0x00, 0x21, 0x01, 0x41, 0x00,
-    0x28, 0x02, 0xb8, 0x91, 0x80, 0x80, 0x00, 0x20, 0x00, 0x46, 0x0d, 0x01,
-    0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xcc, 0x92, 0x80, 0x80, 0x00,
-    0x45, 0x0d, 0x00, 0x41, 0x84, 0x92, 0x80, 0x80, 0x00, 0x21, 0x01, 0x41,
-    0x00, 0x28, 0x02, 0x84, 0x92, 0x80, 0x80, 0x00, 0x20, 0x00, 0x46, 0x0d,
-    0x01, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0x98, 0x93, 0x80, 0x80,
-    0x00, 0x45, 0x0d, 0x00, 0x41, 0xd0, 0x92, 0x80, 0x80, 0x00, 0x21, 0x01,
-    0x41, 0x00, 0x28, 0x02, 0xd0, 0x92, 0x80, 0x80, 0x00, 0x20, 0x00, 0x46,
-    0x0d, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xe4, 0x93, 0x80,
-    0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0x9c, 0x93, 0x80, 0x80, 0x00, 0x21,
-    0x01, 0x41, 0x00, 0x28, 0x02, 0x9c, 0x93, 0x80, 0x80, 0x00, 0x20, 0x00,
-    0x46, 0x0d, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xb0, 0x94,
-    0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0xe8, 0x93, 0x80, 0x80, 0x00,
-    0x21, 0x01, 0x41, 0x00, 0x28, 0x02, 0xe8, 0x93, 0x80, 0x80, 0x00, 0x20,
-    0x00, 0x46, 0x0d, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xfc,
-    0x94, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0xb4, 0x94, 0x80, 0x80,
-    0x00, 0x21, 0x01, 0x41, 0x00, 0x28, 0x02, 0xb4, 0x94, 0x80, 0x80, 0x00,
-    0x20, 0x00, 0x46, 0x0d, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02,
-    0xc8, 0x95, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0x80, 0x95, 0x80,
-    0x80, 0x00, 0x21, 0x01, 0x41, 0x00, 0x28, 0x02, 0x80, 0x95, 0x80, 0x80,
-    0x00, 0x20, 0x00, 0x46, 0x0d, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28,
-    0x02, 0x94, 0x96, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0xcc, 0x95,
-    0x80, 0x80, 0x00, 0x21, 0x01, 0x41, 0x00, 0x28, 0x02, 0xcc, 0x95, 0x80,
-    0x80, 0x00, 0x20, 0x00, 0x46, 0x0d, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00,
-    0x28, 0x02, 0xe0, 0x96, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0x98,
-    0x96, 0x80, 0x80, 0x00, 0x21, 0x01, 0x41, 0x00, 0x28, 0x02, 0x98, 0x96,
-    0x80, 0x80, 0x00, 0x20, 0x00, 0x46, 0x0d, 0x01, 0x0b, 0x02, 0x40, 0x41,
-    0x00, 0x28, 0x02, 0xac, 0x97, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41,
-    0xe4, 0x96, 0x80, 0x80, 0x00, 0x21, 0x01, 0x41, 0x00, 0x28, 0x02, 0xe4,
-    0x96, 0x80, 0x80, 0x00, 0x20, 0x00, 0x46, 0x0d, 0x01, 0x0b, 0x02, 0x40,
-    0x41, 0x00, 0x28, 0x02, 0xf8, 0x97, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00,
-    0x41, 0xb0, 0x97, 0x80, 0x80, 0x00, 0x21, 0x01, 0x41, 0x00, 0x28, 0x02,
-    0xb0, 0x97, 0x80, 0x80, 0x00, 0x20, 0x00, 0x46, 0x0d, 0x01, 0x0b, 0x02,
-    0x40, 0x41, 0x00, 0x28, 0x02, 0xc4, 0x98, 0x80, 0x80, 0x00, 0x45, 0x0d,
-    0x00, 0x41, 0xfc, 0x97, 0x80, 0x80, 0x00, 0x21, 0x01, 0x41, 0x00, 0x28,
-    0x02, 0xfc, 0x97, 0x80, 0x80, 0x00, 0x20, 0x00, 0x46, 0x0d, 0x01, 0x0b,
-    0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0x90, 0x99, 0x80, 0x80, 0x00, 0x45,
-    0x0d, 0x00, 0x41, 0xc8, 0x98, 0x80, 0x80, 0x00, 0x21, 0x01, 0x41, 0x00,
-    0x28, 0x02, 0xc8, 0x98, 0x80, 0x80, 0x00, 0x20, 0x00, 0x46, 0x0d, 0x01,
-    0x0b, 0x41, 0x94, 0x99, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x28,
-    0x02, 0x94, 0x99, 0x80, 0x80, 0x00, 0x20, 0x00, 0x46, 0x1b, 0x41, 0x00,
-    0x41, 0x00, 0x28, 0x02, 0xdc, 0x99, 0x80, 0x80, 0x00, 0x1b, 0x21, 0x01,
-    0x0b, 0x20, 0x01, 0x0b, 0xfe, 0x02, 0x01, 0x06, 0x7f, 0x23, 0x80, 0x80,
-    0x80, 0x80, 0x00, 0x41, 0xb0, 0x08, 0x6b, 0x22, 0x01, 0x24, 0x80, 0x80,
-    0x80, 0x80, 0x00, 0x20, 0x01, 0x41, 0x30, 0x6a, 0x41, 0x0a, 0x72, 0x41,
-    0x00, 0x41, 0xf6, 0x07, 0xfc, 0x0b, 0x00, 0x20, 0x01, 0x41, 0x00, 0x2f,
-    0x00, 0xd2, 0x8a, 0x80, 0x80, 0x00, 0x3b, 0x01, 0x38, 0x20, 0x01, 0x41,
-    0x00, 0x29, 0x00, 0xca, 0x8a, 0x80, 0x80, 0x00, 0x37, 0x03, 0x30, 0x20,
-    0x01, 0x41, 0x30, 0x6a, 0x41, 0x09, 0x72, 0x21, 0x02, 0x41, 0xf7, 0x07,
-    0x21, 0x03, 0x41, 0xb8, 0x8e, 0x80, 0x80, 0x00, 0x21, 0x04, 0x41, 0x00,
-    0x21, 0x05, 0x41, 0x01, 0x21, 0x06, 0x03, 0x40, 0x02, 0x40, 0x20, 0x04,
-    0x28, 0x02, 0x00, 0x45, 0x0d, 0x00, 0x20, 0x04, 0x41, 0xb8, 0x7f, 0x6a,
-    0x28, 0x02, 0x00, 0x20, 0x00, 0x46, 0x0d, 0x00, 0x20, 0x01, 0x20, 0x04,
-    0x41, 0xbc, 0x7f, 0x6a, 0x36, 0x02, 0x24, 0x20, 0x01, 0x41, 0x96, 0x8d,
-    0x80, 0x80, 0x00, 0x41, 0xbf, 0x8b, 0x80, 0x80, 0x00, 0x20, 0x06, 0x1b,
-    0x36, 0x02, 0x20, 0x20, 0x03, 0x20, 0x02, 0x20, 0x03, 0x41, 0xfb, 0x8b,
-    0x80, 0x80, 0x00, 0x20, 0x01, 0x41, 0x20, 0x6a, 0x10, 0x83, 0x80, 0x80,
-    0x80, 0x00, 0x22, 0x06, 0x6b, 0x21, 0x03, 0x20, 0x02, 0x20, 0x06, 0x6a,
-    0x21, 0x02, 0x41, 0x00, 0x21, 0x06, 0x0b, 0x02, 0x40, 0x20, 0x05, 0x41,
-    0x12, 0x4b, 0x0d, 0x00, 0x20, 0x04, 0x41, 0xcc, 0x00, 0x6a, 0x21, 0x04,
-    0x20, 0x05, 0x41, 0x01, 0x6a, 0x21, 0x05, 0x20, 0x03, 0x41, 0x00, 0x4a,
-    0x0d, 0x01, 0x0b, 0x0b, 0x20, 0x02, 0x20, 0x03, 0x41, 0xc8, 0x8a, 0x80,
-    0x80, 0x00, 0x41, 0x00, 0x10, 0x83, 0x80, 0x80, 0x80, 0x00, 0x1a, 0x10,
-    0x84, 0x80, 0x80, 0x80, 0x00, 0x21, 0x04, 0x20, 0x01, 0x41, 0xa2, 0x89,
-    0x80, 0x80, 0x00, 0x36, 0x02, 0x00, 0x20, 0x01, 0x41, 0xa0, 0x8d, 0x80,
-    0x80, 0x00, 0x36, 0x02, 0x04, 0x20, 0x01, 0x20, 0x04, 0x36, 0x02, 0x08,
-    0x20, 0x01, 0x41, 0x10, 0x6a, 0x20, 0x01, 0x41, 0x30, 0x6a, 0x36, 0x02,
-    0x00, 0x20, 0x01, 0x41, 0xbf, 0x8b, 0x80, 0x80, 0x00, 0x41, 0x96, 0x8d,
-    0x80, 0x80, 0x00, 0x20, 0x01, 0x2d, 0x00, 0x30, 0x1b, 0x36, 0x02, 0x0c,
-    0x41, 0xf0, 0x99, 0x80, 0x80, 0x00, 0x41, 0x80, 0x10, 0x41, 0xdc, 0x88,
-    0x80, 0x80, 0x00, 0x20, 0x01, 0x10, 0x83, 0x80, 0x80, 0x80, 0x00, 0x1a,
-    0x20, 0x00, 0x41, 0xf0, 0x99, 0x80, 0x80, 0x00, 0x41, 0xf0, 0x99, 0x80,
-    0x80, 0x00, 0x10, 0x81, 0x80, 0x80, 0x80, 0x00, 0x10, 0x85, 0x80, 0x80,
-    0x80, 0x00, 0x1a, 0x20, 0x01, 0x41, 0xb0, 0x08, 0x6a, 0x24, 0x80, 0x80,
-    0x80, 0x80, 0x00, 0x0b, 0xcd, 0x03, 0x01, 0x02, 0x7f, 0x23, 0x80, 0x80,
-    0x80, 0x80, 0x00, 0x41, 0xa0, 0x01, 0x6b, 0x22, 0x01, 0x24, 0x80, 0x80,
-    0x80, 0x80, 0x00, 0x02, 0x40, 0x02, 0x40, 0x10, 0x9c, 0x80, 0x80, 0x80,
-    0x00, 0x22, 0x02, 0x0d, 0x00, 0x41, 0xb3, 0x8c, 0x80, 0x80, 0x00, 0x41,
-    0x18, 0x10, 0x80, 0x80, 0x80, 0x80, 0x00, 0x0c, 0x01, 0x0b, 0x20, 0x02,
-    0x41, 0x01, 0x36, 0x02, 0x48, 0x20, 0x02, 0x20, 0x00, 0x36, 0x02, 0x00,
-    0x20, 0x02, 0x10, 0x84, 0x80, 0x80, 0x80, 0x00, 0x36, 0x02, 0x44, 0x20,
-    0x01, 0x20, 0x00, 0x36, 0x02, 0x10, 0x20, 0x02, 0x41, 0x04, 0x6a, 0x41,
-    0xc0, 0x00, 0x41, 0xf8, 0x89, 0x80, 0x80, 0x00, 0x20, 0x01, 0x41, 0x10,
-    0x6a, 0x10, 0x83, 0x80, 0x80, 0x80, 0x00, 0x1a, 0x41, 0x00, 0x41, 0x00,
-    0x28, 0x02, 0x84, 0x8f, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x41, 0x00,
-    0x28, 0x02, 0xb8, 0x8e, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41,
-    0x00, 0x28, 0x02, 0xd0, 0x8f, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a,
-    0x41, 0x00, 0x28, 0x02, 0x9c, 0x90, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47,
-    0x6a, 0x41, 0x00, 0x28, 0x02, 0xe8, 0x90, 0x80, 0x80, 0x00, 0x41, 0x00,
-    0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xb4, 0x91, 0x80, 0x80, 0x00, 0x41,
-    0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0x80, 0x92, 0x80, 0x80, 0x00,
-    0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xcc, 0x92, 0x80, 0x80,
-    0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0x98, 0x93, 0x80,
-    0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xe4, 0x93,
-    0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xb0,
-    0x94, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02,
-    0xfc, 0x94, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28,
-    0x02, 0xc8, 0x95, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00,
-    0x28, 0x02, 0x94, 0x96, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41,
-    0x00, 0x28, 0x02, 0xe0, 0x96, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a,
-    0x41, 0x00, 0x28, 0x02, 0xac, 0x97, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47,
-    0x6a, 0x41, 0x00, 0x28, 0x02, 0xf8, 0x97, 0x80, 0x80, 0x00, 0x41, 0x00,
-    0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xc4, 0x98, 0x80, 0x80, 0x00, 0x41,
-    0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0x90, 0x99, 0x80, 0x80, 0x00,
-    0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xdc, 0x99, 0x80, 0x80,
-    0x00, 0x41, 0x00, 0x47, 0x6a, 0x22, 0x02, 0x36, 0x02, 0xec, 0x8d, 0x80,
-    0x80, 0x00, 0x20, 0x01, 0x20, 0x00, 0x36, 0x02, 0x00, 0x20, 0x01, 0x20,
-    0x02, 0x36, 0x02, 0x04, 0x20, 0x01, 0x41, 0x20, 0x6a, 0x41, 0x80, 0x01,
-    0x41, 0xdc, 0x8b, 0x80, 0x80, 0x00, 0x20, 0x01, 0x10, 0x83, 0x80, 0x80,
-    0x80, 0x00, 0x1a, 0x20, 0x01, 0x41, 0x20, 0x6a, 0x20, 0x01, 0x41, 0x20,
-    0x6a, 0x10, 0x81, 0x80, 0x80, 0x80, 0x00, 0x10, 0x80, 0x80, 0x80, 0x80,
-    0x00, 0x20, 0x00, 0x10, 0x9a, 0x80, 0x80, 0x80, 0x00, 0x0b, 0x20, 0x01,
-    0x41, 0xa0, 0x01, 0x6a, 0x24, 0x80, 0x80, 0x80, 0x80, 0x00, 0x0b, 0xa6,
-    0x03, 0x01, 0x01, 0x7f, 0x41, 0x00, 0x21, 0x00, 0x02, 0x40, 0x02, 0x40,
-    0x41, 0x00, 0x28, 0x02, 0xb8, 0x8e, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00,
-    0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0x84, 0x8f, 0x80, 0x80, 0x00, 0x0d,
-    0x00, 0x41, 0x01, 0x21, 0x00, 0x0c, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00,
-    0x28, 0x02, 0xd0, 0x8f, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x02, 0x21,
-    0x00, 0x0c, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0x9c, 0x90,
-    0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x03, 0x21, 0x00, 0x0c, 0x01, 0x0b,
-    0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xe8, 0x90, 0x80, 0x80, 0x00, 0x0d,
-    0x00, 0x41, 0x04, 0x21, 0x00, 0x0c, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00,
-    0x28, 0x02, 0xb4, 0x91, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x05, 0x21,
-    0x00, 0x0c, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0x80, 0x92,
-    0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x06, 0x21, 0x00, 0x0c, 0x01, 0x0b,
-    0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xcc, 0x92, 0x80, 0x80, 0x00, 0x0d,
-    0x00, 0x41, 0x07, 0x21, 0x00, 0x0c, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00,
-    0x28, 0x02, 0x98, 0x93, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x08, 0x21,
-    0x00, 0x0c, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xe4, 0x93,
-    0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x09, 0x21, 0x00, 0x0c, 0x01, 0x0b,
-    0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xb0, 0x94, 0x80, 0x80, 0x00, 0x0d,
-    0x00, 0x41, 0x0a, 0x21, 0x00, 0x0c, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00,
-    0x28, 0x02, 0xfc, 0x94, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x0b, 0x21,
-    0x00, 0x0c, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xc8, 0x95,
-    0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x0c, 0x21, 0x00, 0x0c, 0x01, 0x0b,
-    0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0x94, 0x96, 0x80, 0x80, 0x00, 0x0d,
-    0x00, 0x41, 0x0d, 0x21, 0x00, 0x0c, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00,
-    0x28, 0x02, 0xe0, 0x96, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x0e, 0x21,
-    0x00, 0x0c, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xac, 0x97,
-    0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x0f, 0x21, 0x00, 0x0c, 0x01, 0x0b,
-    0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0xf8, 0x97, 0x80, 0x80, 0x00, 0x0d,
-    0x00, 0x41, 0x10, 0x21, 0x00, 0x0c, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00,
-    0x28, 0x02, 0xc4, 0x98, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x11, 0x21,
-    0x00, 0x0c, 0x01, 0x0b, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02, 0x90, 0x99,
-    0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x12, 0x21, 0x00, 0x0c, 0x01, 0x0b,
-    0x41, 0x00, 0x21, 0x00, 0x41, 0x00, 0x28, 0x02, 0xdc, 0x99, 0x80, 0x80,
-    0x00, 0x0d, 0x01, 0x41, 0x13, 0x21, 0x00, 0x0b, 0x20, 0x00, 0x41, 0xcc,
-    0x00, 0x6c, 0x41, 0xf0, 0x8d, 0x80, 0x80, 0x00, 0x6a, 0x21, 0x00, 0x0b,
-    0x20, 0x00, 0x0b, 0xfe, 0x01, 0x01, 0x02, 0x7f, 0x23, 0x80, 0x80, 0x80,
-    0x80, 0x00, 0x41, 0xa0, 0x01, 0x6b, 0x22, 0x01, 0x24, 0x80, 0x80, 0x80,
-    0x80, 0x00, 0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x41, 0x00, 0x28, 0x02,
-    0xe0, 0x8d, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00, 0x41, 0xff, 0x8c, 0x80,
-    0x80, 0x00, 0x41, 0x17, 0x10, 0x80, 0x80, 0x80, 0x80, 0x00, 0x0c, 0x01,
-    0x0b, 0x20, 0x01, 0x20, 0x00, 0x36, 0x02, 0x10, 0x20, 0x01, 0x41, 0x20,
-    0x6a, 0x41, 0x80, 0x01, 0x41, 0x97, 0x8b, 0x80, 0x80, 0x00, 0x20, 0x01,
-    0x41, 0x10, 0x6a, 0x10, 0x83, 0x80, 0x80, 0x80, 0x00, 0x1a, 0x20, 0x01,
-    0x41, 0x20, 0x6a, 0x20, 0x01, 0x41, 0x20, 0x6a, 0x10, 0x81, 0x80, 0x80,
-    0x80, 0x00, 0x10, 0x80, 0x80, 0x80, 0x80, 0x00, 0x02, 0x40, 0x20, 0x00,
-    0x10, 0x87, 0x80, 0x80, 0x80, 0x00, 0x0d, 0x00, 0x41, 0x00, 0x21, 0x02,
-    0x41, 0x00, 0x20, 0x00, 0x36, 0x02, 0xe4, 0x8d, 0x80, 0x80, 0x00, 0x41,
-    0x00, 0x41, 0x01, 0x36, 0x02, 0xe0, 0x8d, 0x80, 0x80, 0x00, 0x41, 0x00,
-    0x10, 0x84, 0x80, 0x80, 0x80, 0x00, 0x36, 0x02, 0xe8, 0x8d, 0x80, 0x80,
-    0x00, 0x20, 0x01, 0x20, 0x00, 0x36, 0x02, 0x00, 0x20, 0x01, 0x41, 0x20,
-    0x6a, 0x41, 0x80, 0x01, 0x41, 0x80, 0x8a, 0x80, 0x80, 0x00, 0x20, 0x01,
-    0x10, 0x83, 0x80, 0x80, 0x80, 0x00, 0x1a, 0x20, 0x01, 0x41, 0x20, 0x6a,
-    0x20, 0x01, 0x41, 0x20, 0x6a, 0x10, 0x81, 0x80, 0x80, 0x80, 0x00, 0x10,
-    0x80, 0x80, 0x80, 0x80, 0x00, 0x0c, 0x02, 0x0b, 0x41, 0xcc, 0x8c, 0x80,
-    0x80, 0x00, 0x41, 0x17, 0x10, 0x80, 0x80, 0x80, 0x80, 0x00, 0x0b, 0x41,
-    0x7f, 0x21, 0x02, 0x0b, 0x20, 0x01, 0x41, 0xa0, 0x01, 0x6a, 0x24, 0x80,
-    0x80, 0x80, 0x80, 0x00, 0x20, 0x02, 0x0b, 0x97, 0x02, 0x00, 0x02, 0x40,
-    0x41, 0x00, 0x28, 0x02, 0xe0, 0x8d, 0x80, 0x80, 0x00, 0x45, 0x0d, 0x00,
-    0x41, 0xd4, 0x8a, 0x80, 0x80, 0x00, 0x41, 0x1c, 0x10, 0x80, 0x80, 0x80,
-    0x80, 0x00, 0x10, 0x88, 0x80, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00,
-    0x36, 0x02, 0xdc, 0x99, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36,
-    0x02, 0x90, 0x99, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02,
-    0xc4, 0x98, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02, 0xf8,
-    0x97, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02, 0xac, 0x97,
-    0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02, 0xe0, 0x96, 0x80,
-    0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02, 0x94, 0x96, 0x80, 0x80,
-    0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02, 0xc8, 0x95, 0x80, 0x80, 0x00,
-    0x41, 0x00, 0x41, 0x00, 0x36, 0x02, 0xfc, 0x94, 0x80, 0x80, 0x00, 0x41,
-    0x00, 0x41, 0x00, 0x36, 0x02, 0xb0, 0x94, 0x80, 0x80, 0x00, 0x41, 0x00,
-    0x41, 0x00, 0x36, 0x02, 0xe4, 0x93, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41,
-    0x00, 0x36, 0x02, 0x98, 0x93, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00,
-    0x36, 0x02, 0xcc, 0x92, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36,
-    0x02, 0x80, 0x92, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02,
-    0xb4, 0x91, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02, 0xe8,
-    0x90, 0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02, 0x9c, 0x90,
-    0x80, 0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02, 0xd0, 0x8f, 0x80,
-    0x80, 0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02, 0x84, 0x8f, 0x80, 0x80,
-    0x00, 0x41, 0x00, 0x41, 0x00, 0x36, 0x02, 0xb8, 0x8e, 0x80, 0x80, 0x00,
-    0x41, 0x00, 0x41, 0x00, 0x36, 0x02, 0xe0, 0x8d, 0x80, 0x80, 0x00, 0x41,
-    0x00, 0x41, 0x00, 0x36, 0x02, 0xec, 0x8d, 0x80, 0x80, 0x00, 0x0b, 0x0b,
-    0x0a, 0x00, 0x20, 0x00, 0x10, 0x8e, 0x80, 0x80, 0x80, 0x00, 0x0b, 0x0a,
-    0x00, 0x20, 0x00, 0x10, 0x8d, 0x80, 0x80, 0x80, 0x00, 0x0b, 0x12, 0x00,
-    0x20, 0x00, 0x20, 0x00, 0x10, 0x81, 0x80, 0x80, 0x80, 0x00, 0x10, 0x80,
-    0x80, 0x80, 0x80, 0x00, 0x0b, 0x11, 0x00, 0x41, 0xa0, 0x8d, 0x80, 0x80,
-    0x00, 0x41, 0xc0, 0x00, 0x10, 0x82, 0x80, 0x80, 0x80, 0x00, 0x0b, 0x85,
-    0x02, 0x00, 0x41, 0x00, 0x28, 0x02, 0xb8, 0x8e, 0x80, 0x80, 0x00, 0x41,
-    0x00, 0x47, 0x41, 0x00, 0x28, 0x02, 0x84, 0x8f, 0x80, 0x80, 0x00, 0x41,
-    0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xd0, 0x8f, 0x80, 0x80, 0x00,
-    0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0x9c, 0x90, 0x80, 0x80,
-    0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xe8, 0x90, 0x80,
-    0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xb4, 0x91,
-    0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0x80,
-    0x92, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02,
-    0xcc, 0x92, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28,
-    0x02, 0x98, 0x93, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00,
-    0x28, 0x02, 0xe4, 0x93, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41,
-    0x00, 0x28, 0x02, 0xb0, 0x94, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a,
-    0x41, 0x00, 0x28, 0x02, 0xfc, 0x94, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47,
-    0x6a, 0x41, 0x00, 0x28, 0x02, 0xc8, 0x95, 0x80, 0x80, 0x00, 0x41, 0x00,
-    0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0x94, 0x96, 0x80, 0x80, 0x00, 0x41,
-    0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xe0, 0x96, 0x80, 0x80, 0x00,
-    0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xac, 0x97, 0x80, 0x80,
-    0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xf8, 0x97, 0x80,
-    0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0xc4, 0x98,
-    0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02, 0x90,
-    0x99, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x41, 0x00, 0x28, 0x02,
-    0xdc, 0x99, 0x80, 0x80, 0x00, 0x41, 0x00, 0x47, 0x6a, 0x0b, 0x98, 0x01,
-    0x01, 0x03, 0x7f, 0x23, 0x80, 0x80, 0x80, 0x80, 0x00, 0x41, 0x20, 0x6b,
-    0x22, 0x04, 0x24, 0x80, 0x80, 0x80, 0x80, 0x00, 0x10, 0x84, 0x80, 0x80,
-    0x80, 0x00, 0x21, 0x05, 0x02, 0x40, 0x02, 0x40, 0x20, 0x03, 0x0d, 0x00,
-    0x41, 0x96, 0x8d, 0x80, 0x80, 0x00, 0x21, 0x03, 0x41, 0x96, 0x8d, 0x80,
-    0x80, 0x00, 0x21, 0x06, 0x0c, 0x01, 0x0b, 0x41, 0xbf, 0x8b, 0x80, 0x80,
-    0x00, 0x41, 0x96, 0x8d, 0x80, 0x80, 0x00, 0x20, 0x03, 0x2d, 0x00, 0x00,
-    0x1b, 0x21, 0x06, 0x0b, 0x20, 0x04, 0x41, 0x10, 0x6a, 0x20, 0x03, 0x36,
-    0x02, 0x00, 0x20, 0x04, 0x20, 0x06, 0x36, 0x02, 0x0c, 0x20, 0x04, 0x20,
-    0x05, 0x36, 0x02, 0x08, 0x20, 0x04, 0x41, 0xa0, 0x8d, 0x80, 0x80, 0x00,
-    0x36, 0x02, 0x04, 0x20, 0x04, 0x20, 0x02, 0x36, 0x02, 0x00, 0x20, 0x00,
-    0x20, 0x01, 0x41, 0xdc, 0x88, 0x80, 0x80, 0x00, 0x20, 0x04, 0x10, 0x83,
-    0x80, 0x80, 0x80, 0x00, 0x21, 0x03, 0x20, 0x04, 0x41, 0x20, 0x6a, 0x24,
-    0x80, 0x80, 0x80, 0x80, 0x00, 0x20, 0x03, 0x0b, 0xbb, 0x01, 0x01, 0x01,
-    0x7f, 0x23, 0x80, 0x80, 0x80, 0x80, 0x00, 0x41, 0xb0, 0x02, 0x6b, 0x22,
-    0x03, 0x24, 0x80, 0x80, 0x80, 0x80, 0x00, 0x20, 0x03, 0x20, 0x01, 0x36,
-    0x02, 0x20, 0x20, 0x03, 0x41, 0x30, 0x6a, 0x41, 0x80, 0x02, 0x41, 0x82,
-    0x8c, 0x80, 0x80, 0x00, 0x20, 0x03, 0x41, 0x20, 0x6a, 0x10, 0x83, 0x80,
-    0x80, 0x80, 0x00, 0x1a, 0x10, 0x84, 0x80, 0x80, 0x80, 0x00, 0x21, 0x01,
-    0x20, 0x03, 0x20, 0x00, 0x36, 0x02, 0x00, 0x20, 0x03, 0x41, 0xa0, 0x8d,
-    0x80, 0x80, 0x00, 0x36, 0x02, 0x04, 0x20, 0x03, 0x20, 0x01, 0x36, 0x02,
-    0x08, 0x20, 0x03, 0x41, 0x10, 0x6a, 0x20, 0x03, 0x41, 0x30, 0x6a, 0x36,
-    0x02, 0x00, 0x20, 0x03, 0x41, 0xbf, 0x8b, 0x80, 0x80, 0x00, 0x41, 0x96,
-    0x8d, 0x80, 0x80, 0x00, 0x20, 0x03, 0x2d, 0x00, 0x30, 0x1b, 0x36, 0x02,
-    0x0c, 0x41, 0xf0, 0x99, 0x80, 0x80, 0x00, 0x41, 0x80, 0x10, 0x41, 0xdc,
-    0x88, 0x80, 0x80, 0x00, 0x20, 0x03, 0x10, 0x83, 0x80, 0x80, 0x80, 0x00,
-    0x1a, 0x41, 0xf0, 0x99, 0x80, 0x80, 0x00, 0x41, 0xf0, 0x99, 0x80, 0x80,
-    0x00, 0x10, 0x81, 0x80, 0x80, 0x80, 0x00, 0x20, 0x02, 0x10, 0x86, 0x80,
-    0x80, 0x80, 0x00, 0x1a, 0x20, 0x03, 0x41, 0xb0, 0x02, 0x6a, 0x24, 0x80,
-    0x80, 0x80, 0x80, 0x00, 0x0b, 0x0b, 0x9f, 0x05, 0x01, 0x00, 0x41, 0x80,
-    0x08, 0x0b, 0x97, 0x05, 0x7b, 0x22, 0x68, 0x75, 0x62, 0x49, 0x64, 0x22,
-    0x3a, 0x22, 0x25, 0x73, 0x22, 0x2c, 0x22, 0x70, 0x6f, 0x72, 0x74, 0x22,
-    0x3a, 0x25, 0x64, 0x2c, 0x22, 0x70, 0x65, 0x65, 0x72, 0x73, 0x22, 0x3a,
-    0x25, 0x64, 0x2c, 0x22, 0x75, 0x70, 0x74, 0x69, 0x6d, 0x65, 0x22, 0x3a,
-    0x25, 0x75, 0x2c, 0x22, 0x6d, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x73,
-    0x52, 0x65, 0x63, 0x65, 0x69, 0x76, 0x65, 0x64, 0x22, 0x3a, 0x25, 0x6c,
-    0x6c, 0x75, 0x2c, 0x22, 0x6d, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x73,
-    0x53, 0x65, 0x6e, 0x74, 0x22, 0x3a, 0x25, 0x6c, 0x6c, 0x75, 0x7d, 0x00,
-    0x7b, 0x22, 0x74, 0x79, 0x70, 0x65, 0x22, 0x3a, 0x22, 0x25, 0x73, 0x22,
-    0x2c, 0x22, 0x68, 0x75, 0x62, 0x49, 0x64, 0x22, 0x3a, 0x22, 0x25, 0x73,
-    0x22, 0x2c, 0x22, 0x74, 0x69, 0x6d, 0x65, 0x73, 0x74, 0x61, 0x6d, 0x70,
-    0x22, 0x3a, 0x25, 0x75, 0x25, 0x73, 0x25, 0x73, 0x7d, 0x00, 0x62, 0x72,
-    0x6f, 0x61, 0x64, 0x63, 0x61, 0x73, 0x74, 0x00, 0x68, 0x65, 0x61, 0x72,
-    0x74, 0x62, 0x65, 0x61, 0x74, 0x00, 0x67, 0x65, 0x74, 0x2d, 0x70, 0x65,
-    0x65, 0x72, 0x73, 0x00, 0x42, 0x72, 0x6f, 0x61, 0x64, 0x63, 0x61, 0x73,
-    0x74, 0x69, 0x6e, 0x67, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x25, 0x73,
-    0x00, 0x48, 0x75, 0x62, 0x20, 0x49, 0x44, 0x3a, 0x20, 0x25, 0x73, 0x00,
-    0x6a, 0x6f, 0x69, 0x6e, 0x00, 0x68, 0x61, 0x6e, 0x64, 0x73, 0x68, 0x61,
-    0x6b, 0x65, 0x00, 0x70, 0x65, 0x65, 0x72, 0x2d, 0x64, 0x69, 0x73, 0x63,
-    0x6f, 0x6e, 0x6e, 0x65, 0x63, 0x74, 0x65, 0x64, 0x00, 0x70, 0x65, 0x65,
-    0x72, 0x2d, 0x63, 0x6f, 0x6e, 0x6e, 0x65, 0x63, 0x74, 0x65, 0x64, 0x00,
-    0x70, 0x65, 0x65, 0x72, 0x2d, 0x25, 0x64, 0x00, 0x53, 0x65, 0x72, 0x76,
-    0x65, 0x72, 0x20, 0x73, 0x74, 0x61, 0x72, 0x74, 0x65, 0x64, 0x20, 0x73,
-    0x75, 0x63, 0x63, 0x65, 0x73, 0x73, 0x66, 0x75, 0x6c, 0x6c, 0x79, 0x20,
-    0x6f, 0x6e, 0x20, 0x70, 0x6f, 0x72, 0x74, 0x20, 0x25, 0x64, 0x00, 0x50,
-    0x65, 0x65, 0x72, 0x20, 0x74, 0x69, 0x6d, 0x65, 0x6f, 0x75, 0x74, 0x3a,
-    0x20, 0x25, 0x64, 0x00, 0x54, 0x6f, 0x74, 0x61, 0x6c, 0x20, 0x70, 0x65,
-    0x65, 0x72, 0x73, 0x3a, 0x20, 0x25, 0x64, 0x00, 0x5d, 0x00, 0x22, 0x70,
-    0x65, 0x65, 0x72, 0x73, 0x22, 0x3a, 0x5b, 0x00, 0x53, 0x74, 0x6f, 0x70,
-    0x70, 0x69, 0x6e, 0x67, 0x20, 0x50, 0x69, 0x67, 0x65, 0x6f, 0x6e, 0x48,
-    0x75, 0x62, 0x20, 0x73, 0x65, 0x72, 0x76, 0x65, 0x72, 0x2e, 0x2e, 0x2e,
-    0x00, 0x49, 0x6e, 0x69, 0x74, 0x69, 0x61, 0x6c, 0x69, 0x7a, 0x69, 0x6e,
-    0x67, 0x20, 0x50, 0x69, 0x67, 0x65, 0x6f, 0x6e, 0x48, 0x75, 0x62, 0x20,
-    0x57, 0x41, 0x53, 0x4d, 0x20, 0x73, 0x65, 0x72, 0x76, 0x65, 0x72, 0x2e,
-    0x2e, 0x2e, 0x00, 0x53, 0x74, 0x61, 0x72, 0x74, 0x69, 0x6e, 0x67, 0x20,
-    0x50, 0x69, 0x67, 0x65, 0x6f, 0x6e, 0x48, 0x75, 0x62, 0x20, 0x73, 0x65,
-    0x72, 0x76, 0x65, 0x72, 0x20, 0x6f, 0x6e, 0x20, 0x70, 0x6f, 0x72, 0x74,
-    0x20, 0x25, 0x64, 0x2e, 0x2e, 0x2e, 0x00, 0x2c, 0x00, 0x50, 0x65, 0x65,
-    0x72, 0x20, 0x64, 0x69, 0x73, 0x63, 0x6f, 0x6e, 0x6e, 0x65, 0x63, 0x74,
-    0x65, 0x64, 0x3a, 0x20, 0x25, 0x64, 0x20, 0x28, 0x25, 0x73, 0x29, 0x00,
-    0x50, 0x65, 0x65, 0x72, 0x20, 0x63, 0x6f, 0x6e, 0x6e, 0x65, 0x63, 0x74,
-    0x65, 0x64, 0x3a, 0x20, 0x25, 0x64, 0x20, 0x28, 0x74, 0x6f, 0x74, 0x61,
-    0x6c, 0x3a, 0x20, 0x25, 0x64, 0x29, 0x00, 0x25, 0x73, 0x22, 0x25, 0x73,
-    0x22, 0x00, 0x22, 0x70, 0x65, 0x65, 0x72, 0x49, 0x64, 0x22, 0x3a, 0x22,
-    0x25, 0x73, 0x22, 0x00, 0x22, 0x74, 0x61, 0x72, 0x67, 0x65, 0x74, 0x50,
-    0x65, 0x65, 0x72, 0x22, 0x3a, 0x22, 0x00, 0x22, 0x74, 0x79, 0x70, 0x65,
-    0x22, 0x3a, 0x22, 0x00, 0x22, 0x70, 0x65, 0x65, 0x72, 0x49, 0x64, 0x22,
-    0x3a, 0x22, 0x00, 0x4e, 0x6f, 0x20, 0x61, 0x76, 0x61, 0x69, 0x6c, 0x61,
-    0x62, 0x6c, 0x65, 0x20, 0x70, 0x65, 0x65, 0x72, 0x20, 0x73, 0x6c, 0x6f,
-    0x74, 0x73, 0x21, 0x00, 0x46, 0x61, 0x69, 0x6c, 0x65, 0x64, 0x20, 0x74,
-    0x6f, 0x20, 0x73, 0x74, 0x61, 0x72, 0x74, 0x20, 0x73, 0x65, 0x72, 0x76,
-    0x65, 0x72, 0x21, 0x00, 0x4d, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x20,
-    0x66, 0x72, 0x6f, 0x6d, 0x20, 0x75, 0x6e, 0x6b, 0x6e, 0x6f, 0x77, 0x6e,
-    0x20, 0x70, 0x65, 0x65, 0x72, 0x21, 0x00, 0x53, 0x65, 0x72, 0x76, 0x65,
-    0x72, 0x20, 0x61, 0x6c, 0x72, 0x65, 0x61, 0x64, 0x79, 0x20, 0x72, 0x75,
-    0x6e, 0x6e, 0x69, 0x6e, 0x67, 0x21, 0x00,
-};
-const size_t pigeonhub_wasm_size = sizeof(pigeonhub_wasm_data);
+// Embedded PigeonHub WASM image
+//
+// The LZ4-compressed module is generated by embed_wasm.py and linked in via
+// board_build.embed_files (see platformio.ini). Do not edit the image by hand;
+// rebuild the module with `make install` in embedded/esp32 instead.
+#ifndef PIGEONHUB_WASM_DATA_H
+#define PIGEONHUB_WASM_DATA_H
+
+#include <stdint.h>
+
+extern const uint8_t pigeonhub_wasm_image_start[] asm("_binary_embed_pigeonhub_client_wasm_lz4_start");
+extern const uint8_t pigeonhub_wasm_image_end[] asm("_binary_embed_pigeonhub_client_wasm_lz4_end");
+
+#endif // PIGEONHUB_WASM_DATA_H
@@ -0,0 +1,90 @@
+/*
+ * PigeonHub WASM Image - LZ4 block inflate
+ */
+
+#include "wasm_image.h"
+#include <string.h>
+
+static uint32_t readLE32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Reads an LZ4 length extension (runs of 255 terminated by a smaller byte)
+static bool readLength(const uint8_t** ip, const uint8_t* iend, size_t* length) {
+    uint8_t b;
+    do {
+        if (*ip >= iend) return false;
+        b = *(*ip)++;
+        *length += b;
+    } while (b == 255);
+    return true;
+}
+
+int lz4DecodeBlock(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen) {
+    const uint8_t* ip = src;
+    const uint8_t* iend = src + srcLen;
+    uint8_t* op = dst;
+    uint8_t* oend = dst + dstLen;
+
+    while (ip < iend) {
+        uint8_t token = *ip++;
+
+        // Literals
+        size_t litLen = token >> 4;
+        if (litLen == 15 && !readLength(&ip, iend, &litLen)) return -1;
+        if (litLen > (size_t)(iend - ip) || litLen > (size_t)(oend - op)) return -1;
+        memcpy(op, ip, litLen);
+        ip += litLen;
+        op += litLen;
+
+        // Last sequence carries literals only
+        if (ip >= iend) break;
+
+        // Match
+        if (iend - ip < 2) return -1;
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - dst)) return -1;
+
+        size_t matchLen = token & 0x0F;
+        if (matchLen == 15 && !readLength(&ip, iend, &matchLen)) return -1;
+        matchLen += 4;
+        if (matchLen > (size_t)(oend - op)) return -1;
+
+        // Byte copy: matches may overlap their own output
+        const uint8_t* match = op - offset;
+        while (matchLen--) *op++ = *match++;
+    }
+
+    return (int)(op - dst);
+}
+
+size_t wasmImageRawSize(const uint8_t* image, size_t imageLen) {
+    if (!image || imageLen < WASM_IMAGE_HEADER_SIZE) return 0;
+    if (memcmp(image, WASM_IMAGE_MAGIC, 4) != 0) return 0;
+    return readLE32(image + 4);
+}
+
+bool wasmImageBuildId(const uint8_t* image, size_t imageLen, char* out, size_t outLen) {
+    static const char hex[] = "0123456789abcdef";
+    if (wasmImageRawSize(image, imageLen) == 0) return false;
+    if (outLen < WASM_IMAGE_BUILD_ID_LEN * 2 + 1) return false;
+
+    for (int i = 0; i < WASM_IMAGE_BUILD_ID_LEN; i++) {
+        out[i * 2] = hex[image[8 + i] >> 4];
+        out[i * 2 + 1] = hex[image[8 + i] & 0x0F];
+    }
+    out[WASM_IMAGE_BUILD_ID_LEN * 2] = '\0';
+    return true;
+}
+
+size_t wasmImageInflate(const uint8_t* image, size_t imageLen, uint8_t* dst, size_t dstLen) {
+    size_t rawSize = wasmImageRawSize(image, imageLen);
+    if (rawSize == 0 || rawSize > dstLen) return 0;
+
+    int written = lz4DecodeBlock(image + WASM_IMAGE_HEADER_SIZE,
+                                 imageLen - WASM_IMAGE_HEADER_SIZE, dst, rawSize);
+    if (written < 0 || (size_t)written != rawSize) return 0;
+    return rawSize;
+}
@@ -0,0 +1,38 @@
+/*
+ * PigeonHub WASM Image
+ *
+ * The protocol module is embedded in flash as an LZ4-compressed image
+ * produced by embed_wasm.py. At boot it is inflated directly into the
+ * buffer handed to m3_ParseModule, with no staging copy of the raw module.
+ * That buffer stays allocated for the module's lifetime (wasm3 keeps
+ * pointers into it), next to the code wasm3 compiles from it.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_WASM_IMAGE_H
+#define PIGEONHUB_WASM_IMAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Image header (must match embed_wasm.py)
+#define WASM_IMAGE_MAGIC        "PHW2"
+#define WASM_IMAGE_BUILD_ID_LEN 8
+#define WASM_IMAGE_HEADER_SIZE  (8 + WASM_IMAGE_BUILD_ID_LEN)
+
+// Returns the uncompressed module size, or 0 if the image is malformed
+size_t wasmImageRawSize(const uint8_t* image, size_t imageLen);
+
+// Writes the build ID (truncated SHA-256 of the module) as a hex string.
+// out must hold at least WASM_IMAGE_BUILD_ID_LEN * 2 + 1 bytes.
+bool wasmImageBuildId(const uint8_t* image, size_t imageLen, char* out, size_t outLen);
+
+// Inflates the image into dst (exactly wasmImageRawSize() bytes).
+// Returns the number of bytes written, or 0 on a corrupt image.
+size_t wasmImageInflate(const uint8_t* image, size_t imageLen, uint8_t* dst, size_t dstLen);
+
+// Decodes one raw LZ4 block. Returns bytes written or -1 on error.
+int lz4DecodeBlock(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen);
+
+#endif // PIGEONHUB_WASM_IMAGE_H
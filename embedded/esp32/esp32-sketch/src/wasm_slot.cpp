@@ -0,0 +1,141 @@
+/*
+ * PigeonHub WASM Slot
+ */
+
+#include "wasm_slot.h"
+#include "m3_env.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void findOptional(IM3Function* fn, IM3Runtime runtime, const char* name) {
+    if (m3_FindFunction(fn, runtime, name)) *fn = NULL;
+}
+
+M3Result wasmSlotLoad(WasmSlot* slot, uint8_t* buf, size_t len,
+                      uint32_t stackSize, uint32_t memoryLimit, WasmLinkFn link) {
+    M3Result result = m3Err_none;
+    memset(slot, 0, sizeof(*slot));
+    slot->buf = buf;
+
+    slot->env = m3_NewEnvironment();
+    if (!slot->env) {
+        wasmSlotFree(slot);
+        return "failed to create WASM environment";
+    }
+
+    slot->runtime = m3_NewRuntime(slot->env, stackSize, slot);
+    if (!slot->runtime) {
+        wasmSlotFree(slot);
+        return "failed to create WASM runtime";
+    }
+    slot->runtime->memoryLimit = memoryLimit;
+
+    result = m3_ParseModule(slot->env, &slot->module, buf, len);
+    if (result) {
+        wasmSlotFree(slot);
+        return result;
+    }
+
+    // Once loaded, the runtime owns the module
+    result = m3_LoadModule(slot->runtime, slot->module);
+    if (result) {
+        m3_FreeModule(slot->module);
+        slot->module = NULL;
+        wasmSlotFree(slot);
+        return result;
+    }
+
+    if (link) result = link(slot->module);
+    if (!result) result = m3_FindFunction(&slot->init, slot->runtime, "init");
+    if (!result) result = m3_FindFunction(&slot->startServer, slot->runtime, "start_server");
+    if (!result) result = m3_FindFunction(&slot->onPeerConnected, slot->runtime, "on_peer_connected");
+    if (!result) result = m3_FindFunction(&slot->onPeerDisconnected, slot->runtime, "on_peer_disconnected");
+    if (!result) result = m3_FindFunction(&slot->onMessage, slot->runtime, "on_message");
+    if (!result) result = m3_FindFunction(&slot->loop, slot->runtime, "loop");
+    if (result) {
+        wasmSlotFree(slot);
+        return result;
+    }
+
+    findOptional(&slot->snapshot, slot->runtime, "snapshot");
+    findOptional(&slot->restore, slot->runtime, "restore");
+    findOptional(&slot->wasmMalloc, slot->runtime, "malloc");
+    findOptional(&slot->wasmFree, slot->runtime, "free");
+
+    return m3Err_none;
+}
+
+void wasmSlotFree(WasmSlot* slot) {
+    if (slot->runtime) m3_FreeRuntime(slot->runtime);
+    if (slot->env) m3_FreeEnvironment(slot->env);
+    free(slot->buf);
+    memset(slot, 0, sizeof(*slot));
+}
+
+// Calls malloc(size) inside the module; returns 0 on failure
+static uint32_t wasmAlloc(WasmSlot* slot, uint32_t size) {
+    uint32_t ptr = 0;
+    if (m3_CallV(slot->wasmMalloc, size)) return 0;
+    if (m3_GetResultsV(slot->wasmMalloc, &ptr)) return 0;
+    return ptr;
+}
+
+static void wasmRelease(WasmSlot* slot, uint32_t ptr) {
+    if (slot->wasmFree && ptr) m3_CallV(slot->wasmFree, ptr);
+}
+
+// Returns host memory for [ptr, ptr + len) in the module, or NULL if out of bounds
+static uint8_t* wasmMemory(WasmSlot* slot, uint32_t ptr, uint32_t len) {
+    uint32_t memSize = 0;
+    uint8_t* mem = m3_GetMemory(slot->runtime, &memSize, 0);
+    if (!mem || ptr > memSize || len > memSize - ptr) return NULL;
+    return mem + ptr;
+}
+
+M3Result wasmSlotMigrate(WasmSlot* from, WasmSlot* to) {
+    if (!from->snapshot || !from->wasmMalloc) return "active module does not export snapshot";
+    if (!to->restore || !to->wasmMalloc) return "new module does not export restore";
+
+    // Snapshot into the old module's memory
+    uint32_t src = wasmAlloc(from, WASM_SNAPSHOT_MAX);
+    if (!src) return "snapshot allocation failed";
+
+    int32_t len = -1;
+    M3Result result = m3_CallV(from->snapshot, src, (int32_t)WASM_SNAPSHOT_MAX);
+    if (!result) result = m3_GetResultsV(from->snapshot, &len);
+    if (!result && (len < 0 || len > WASM_SNAPSHOT_MAX)) result = "snapshot failed";
+
+    // Copy across runtimes; the new module's memory may move on malloc, so
+    // stage through host memory
+    uint8_t* staged = NULL;
+    if (!result) {
+        uint8_t* mem = wasmMemory(from, src, (uint32_t)len);
+        staged = (uint8_t*)malloc(len > 0 ? len : 1);
+        if (!mem) result = "snapshot out of bounds";
+        else if (!staged) result = "snapshot staging allocation failed";
+        else memcpy(staged, mem, len);
+    }
+    wasmRelease(from, src);
+    if (result) {
+        free(staged);
+        return result;
+    }
+
+    // Restore into the new module
+    uint32_t dst = wasmAlloc(to, (uint32_t)(len > 0 ? len : 1));
+    uint8_t* mem = dst ? wasmMemory(to, dst, (uint32_t)len) : NULL;
+    if (!mem) {
+        free(staged);
+        wasmRelease(to, dst);
+        return "restore allocation failed";
+    }
+    memcpy(mem, staged, len);
+    free(staged);
+
+    int32_t rc = -1;
+    result = m3_CallV(to->restore, dst, len);
+    if (!result) result = m3_GetResultsV(to->restore, &rc);
+    if (!result && rc != 0) result = "restore rejected snapshot";
+    wasmRelease(to, dst);
+    return result;
+}
@@ -0,0 +1,58 @@
+/*
+ * PigeonHub WASM Slot
+ *
+ * One wasm3 environment + runtime + module with its resolved exports.
+ * The hub keeps two slots so a new protocol module can be parsed and
+ * initialized while the active one keeps serving; the switch itself is a
+ * snapshot/restore of peer state followed by a pointer swap.
+ *
+ * Depends only on wasm3 - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_WASM_SLOT_H
+#define PIGEONHUB_WASM_SLOT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "wasm3.h"
+
+#define WASM_SNAPSHOT_MAX  4096  // Largest peer-state snapshot we migrate
+
+typedef M3Result (*WasmLinkFn)(IM3Module module);
+
+struct WasmSlot {
+    IM3Environment env;
+    IM3Runtime runtime;
+    IM3Module module;
+    uint8_t* buf;  // Module bytes; wasm3 keeps pointers into them
+    char buildId[20];  // Set by the caller; host imports find the slot via m3_GetUserData()
+
+    // Required exports
+    IM3Function init;
+    IM3Function startServer;
+    IM3Function onPeerConnected;
+    IM3Function onPeerDisconnected;
+    IM3Function onMessage;
+    IM3Function loop;
+
+    // Optional exports (state migration)
+    IM3Function snapshot;
+    IM3Function restore;
+    IM3Function wasmMalloc;
+    IM3Function wasmFree;
+};
+
+// Parses, loads and links the module in buf and resolves its exports.
+// Linear memory is capped at memoryLimit bytes (0 = as declared by the module).
+// The slot takes ownership of buf (malloc'd) on success and on failure.
+M3Result wasmSlotLoad(WasmSlot* slot, uint8_t* buf, size_t len,
+                      uint32_t stackSize, uint32_t memoryLimit, WasmLinkFn link);
+
+// Releases the runtime, environment and module bytes
+void wasmSlotFree(WasmSlot* slot);
+
+// Copies peer state out of `from` (snapshot export) into `to` (restore
+// export). Both modules keep running if this fails.
+M3Result wasmSlotMigrate(WasmSlot* from, WasmSlot* to);
+
+#endif // PIGEONHUB_WASM_SLOT_H
@@ -0,0 +1,372 @@
+/*
+ * PigeonHub Wire Codec
+ */
+
+#include "wire_codec.h"
+#include <string.h>
+#include <stdio.h>
+
+static const char* const TYPE_NAMES[WIRE_TYPE_COUNT] = {
+    "", "announce", "peer-discovered", "peer-disconnected",
+    "offer", "answer", "ice-candidate", "goodbye", "connected",
+    "ice-candidates"
+};
+
+const char* wireTypeName(uint8_t type) {
+    return type < WIRE_TYPE_COUNT ? TYPE_NAMES[type] : "";
+}
+
+static uint8_t typeFromName(const char* name, size_t len) {
+    for (uint8_t t = 1; t < WIRE_TYPE_COUNT; t++) {
+        if (strlen(TYPE_NAMES[t]) == len && memcmp(TYPE_NAMES[t], name, len) == 0) return t;
+    }
+    return WIRE_OTHER;
+}
+
+static int hexNibble(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool wireHexToId(const char* hex, size_t len, uint8_t id[WIRE_PEER_ID_LEN]) {
+    if (len != WIRE_PEER_ID_LEN * 2) return false;
+    for (size_t i = 0; i < WIRE_PEER_ID_LEN; i++) {
+        int hi = hexNibble(hex[i * 2]);
+        int lo = hexNibble(hex[i * 2 + 1]);
+        if (hi < 0 || lo < 0) return false;
+        id[i] = (uint8_t)((hi << 4) | lo);
+    }
+    return true;
+}
+
+void wireIdToHex(const uint8_t id[WIRE_PEER_ID_LEN], char hex[WIRE_PEER_ID_LEN * 2 + 1]) {
+    static const char digits[] = "0123456789abcdef";
+    for (size_t i = 0; i < WIRE_PEER_ID_LEN; i++) {
+        hex[i * 2] = digits[id[i] >> 4];
+        hex[i * 2 + 1] = digits[id[i] & 0x0F];
+    }
+    hex[WIRE_PEER_ID_LEN * 2] = '\0';
+}
+
+// ---------------------------------------------------------------------------
+// v1 JSON
+// ---------------------------------------------------------------------------
+
+static const char* skipWs(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+    return p;
+}
+
+// p at the opening quote; returns the position after the closing quote
+static const char* skipString(const char* p, const char* end) {
+    for (p++; p < end; p++) {
+        if (*p == '\\') p++;
+        else if (*p == '"') return p + 1;
+    }
+    return NULL;
+}
+
+static const char* skipValue(const char* p, const char* end) {
+    if (p >= end) return NULL;
+    if (*p == '"') return skipString(p, end);
+    if (*p == '{' || *p == '[') {
+        int depth = 0;
+        while (p < end) {
+            if (*p == '"') {
+                p = skipString(p, end);
+                if (!p) return NULL;
+                continue;
+            }
+            if (*p == '{' || *p == '[') depth++;
+            else if ((*p == '}' || *p == ']') && --depth == 0) return p + 1;
+            p++;
+        }
+        return NULL;
+    }
+    while (p < end && *p != ',' && *p != '}' && *p != ']' &&
+           *p != ' ' && *p != '\n' && *p != '\r' && *p != '\t') p++;
+    return p;
+}
+
+static bool keyIs(const char* key, size_t len, const char* name) {
+    return strlen(name) == len && memcmp(key, name, len) == 0;
+}
+
+// Contents of a string value (without quotes), or false if not a string
+static bool stringContents(const char* start, const char* end, const char** s, size_t* len) {
+    if (end - start < 2 || *start != '"') return false;
+    *s = start + 1;
+    *len = end - start - 2;
+    return true;
+}
+
+static bool containsIsHub(const uint8_t* blob, size_t len) {
+    static const char needle[] = "\"isHub\":true";
+    size_t n = sizeof(needle) - 1;
+    for (size_t i = 0; i + n <= len; i++) {
+        if (memcmp(blob + i, needle, n) == 0) return true;
+    }
+    return false;
+}
+
+bool wireParseJson(const char* json, size_t len, WireMsg* msg) {
+    memset(msg, 0, sizeof(*msg));
+    const char* end = json + len;
+    const char* p = skipWs(json, end);
+    if (p >= end || *p != '{') return false;
+    p++;
+
+    bool lossy = false;  // Fields v2 has no slot for
+    const char* typeName = NULL;
+    size_t typeLen = 0;
+
+    while (true) {
+        p = skipWs(p, end);
+        if (p < end && *p == '}') break;
+        if (p >= end || *p != '"') return false;
+
+        const char* keyEnd = skipString(p, end);
+        if (!keyEnd) return false;
+        const char* key = p + 1;
+        size_t keyLen = keyEnd - p - 2;
+
+        p = skipWs(keyEnd, end);
+        if (p >= end || *p != ':') return false;
+        const char* val = skipWs(p + 1, end);
+        const char* valEnd = skipValue(val, end);
+        if (!valEnd) return false;
+
+        const char* s;
+        size_t sLen;
+        if (keyIs(key, keyLen, "type")) {
+            if (!stringContents(val, valEnd, &typeName, &typeLen)) lossy = true;
+        } else if (keyIs(key, keyLen, "data")) {
+            msg->blob = (const uint8_t*)val;
+            msg->blobLen = valEnd - val;
+        } else if (keyIs(key, keyLen, "networkName")) {
+            if (stringContents(val, valEnd, &s, &sLen) && sLen <= 255) {
+                msg->ns = s;
+                msg->nsLen = sLen;
+            } else {
+                lossy = true;
+            }
+        } else if (keyIs(key, keyLen, "fromPeerId")) {
+            if (stringContents(val, valEnd, &s, &sLen) && keyIs(s, sLen, "system")) {
+                msg->flags |= WIRE_FLAG_SYSTEM;
+            } else if (stringContents(val, valEnd, &s, &sLen) && wireHexToId(s, sLen, msg->from)) {
+                msg->flags |= WIRE_FLAG_FROM;
+            } else {
+                lossy = true;
+            }
+        } else if (keyIs(key, keyLen, "targetPeerId")) {
+            if (stringContents(val, valEnd, &s, &sLen) && wireHexToId(s, sLen, msg->target)) {
+                msg->flags |= WIRE_FLAG_TARGET;
+            } else {
+                lossy = true;
+            }
+        } else if (keyIs(key, keyLen, "timestamp")) {
+            uint64_t ts = 0;
+            for (const char* d = val; d < valEnd; d++) {
+                if (*d < '0' || *d > '9') {
+                    lossy = true;
+                    break;
+                }
+                ts = ts * 10 + (*d - '0');
+            }
+            msg->timestamp = ts;
+        } else {
+            lossy = true;
+        }
+
+        p = skipWs(valEnd, end);
+        if (p < end && *p == ',') {
+            p++;
+            continue;
+        }
+        if (p < end && *p == '}') break;
+        return false;
+    }
+
+    msg->type = typeName ? typeFromName(typeName, typeLen) : (uint8_t)WIRE_OTHER;
+    if (containsIsHub(msg->blob, msg->blobLen)) msg->flags |= WIRE_FLAG_HUB;
+    if (lossy || msg->type == WIRE_OTHER) {
+        // Carry the message verbatim; keep the routing fields we did parse
+        msg->flags |= WIRE_FLAG_RAW;
+        msg->blob = (const uint8_t*)json;
+        msg->blobLen = len;
+    }
+    return true;
+}
+
+size_t wireJsonSize(const WireMsg* msg) {
+    if (msg->flags & WIRE_FLAG_RAW) return msg->blobLen;
+
+    size_t n = strlen("{\"type\":\"\"}") + strlen(wireTypeName(msg->type));
+    if (msg->blobLen) n += strlen(",\"data\":") + msg->blobLen;
+    if (msg->nsLen) n += strlen(",\"networkName\":\"\"") + msg->nsLen;
+    if (msg->flags & WIRE_FLAG_SYSTEM) n += strlen(",\"fromPeerId\":\"system\"");
+    else if (msg->flags & WIRE_FLAG_FROM) n += strlen(",\"fromPeerId\":\"\"") + WIRE_PEER_ID_LEN * 2;
+    if (msg->flags & WIRE_FLAG_TARGET) n += strlen(",\"targetPeerId\":\"\"") + WIRE_PEER_ID_LEN * 2;
+    if (msg->timestamp) {
+        n += strlen(",\"timestamp\":");
+        for (uint64_t ts = msg->timestamp; ts; ts /= 10) n++;
+    }
+    return n;
+}
+
+size_t wireRenderJson(const WireMsg* msg, char* out, size_t cap) {
+    if (msg->flags & WIRE_FLAG_RAW) {
+        if (msg->blobLen > cap) return 0;
+        memcpy(out, msg->blob, msg->blobLen);
+        return msg->blobLen;
+    }
+    if (wireJsonSize(msg) >= cap) return 0;  // snprintf needs room for the terminator
+
+    size_t n = snprintf(out, cap, "{\"type\":\"%s\"", wireTypeName(msg->type));
+    if (msg->blobLen) {
+        n += snprintf(out + n, cap - n, ",\"data\":");
+        memcpy(out + n, msg->blob, msg->blobLen);
+        n += msg->blobLen;
+    }
+    if (msg->nsLen) {
+        n += snprintf(out + n, cap - n, ",\"networkName\":\"%.*s\"", (int)msg->nsLen, msg->ns);
+    }
+    char hex[WIRE_PEER_ID_LEN * 2 + 1];
+    if (msg->flags & WIRE_FLAG_SYSTEM) {
+        n += snprintf(out + n, cap - n, ",\"fromPeerId\":\"system\"");
+    } else if (msg->flags & WIRE_FLAG_FROM) {
+        wireIdToHex(msg->from, hex);
+        n += snprintf(out + n, cap - n, ",\"fromPeerId\":\"%s\"", hex);
+    }
+    if (msg->flags & WIRE_FLAG_TARGET) {
+        wireIdToHex(msg->target, hex);
+        n += snprintf(out + n, cap - n, ",\"targetPeerId\":\"%s\"", hex);
+    }
+    if (msg->timestamp) {
+        n += snprintf(out + n, cap - n, ",\"timestamp\":%llu", (unsigned long long)msg->timestamp);
+    }
+    n += snprintf(out + n, cap - n, "}");
+    return n;
+}
+
+// ---------------------------------------------------------------------------
+// v2 binary
+// ---------------------------------------------------------------------------
+
+size_t wireEncodedSize(const WireMsg* msg) {
+    return WIRE_HEADER_SIZE + msg->nsLen + msg->blobLen;
+}
+
+size_t wireEncode(const WireMsg* msg, uint8_t* out, size_t cap) {
+    size_t total = wireEncodedSize(msg);
+    if (msg->nsLen > 255 || total > cap) return 0;
+
+    out[0] = WIRE_V2_VERSION;
+    out[1] = msg->type;
+    out[2] = msg->flags;
+    out[3] = (uint8_t)msg->nsLen;
+    for (int i = 0; i < 8; i++) out[4 + i] = (uint8_t)(msg->timestamp >> (8 * i));
+    memcpy(out + 12, msg->from, WIRE_PEER_ID_LEN);
+    memcpy(out + 32, msg->target, WIRE_PEER_ID_LEN);
+    memcpy(out + WIRE_HEADER_SIZE, msg->ns, msg->nsLen);
+    memcpy(out + WIRE_HEADER_SIZE + msg->nsLen, msg->blob, msg->blobLen);
+    return total;
+}
+
+// v1 renders the namespace between quotes as is, so it can't hold bytes
+// JSON would need escaped
+static bool nsJsonSafe(const uint8_t* ns, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (ns[i] < 0x20 || ns[i] == '"' || ns[i] == '\\') return false;
+    }
+    return true;
+}
+
+bool wireDecode(const uint8_t* frame, size_t len, WireMsg* msg) {
+    if (len < WIRE_HEADER_SIZE || frame[0] != WIRE_V2_VERSION || frame[1] >= WIRE_TYPE_COUNT) {
+        return false;
+    }
+    size_t nsLen = frame[3];
+    if (nsLen > len - WIRE_HEADER_SIZE || !nsJsonSafe(frame + WIRE_HEADER_SIZE, nsLen)) return false;
+
+    memset(msg, 0, sizeof(*msg));
+    msg->type = frame[1];
+    msg->flags = frame[2] & ~WIRE_FLAGS_HUB_SET;
+    for (int i = 0; i < 8; i++) msg->timestamp |= (uint64_t)frame[4 + i] << (8 * i);
+    memcpy(msg->target, frame + 32, WIRE_PEER_ID_LEN);
+    msg->ns = (const char*)frame + WIRE_HEADER_SIZE;
+    msg->nsLen = nsLen;
+    msg->blob = frame + WIRE_HEADER_SIZE + nsLen;
+    msg->blobLen = len - WIRE_HEADER_SIZE - nsLen;
+    if (msg->type == WIRE_OTHER && !(msg->flags & WIRE_FLAG_RAW)) return false;
+    return !(msg->flags & WIRE_FLAG_RAW) || msg->blobLen > 0;
+}
+
+// ---------------------------------------------------------------------------
+// Leading bytes of a streamed message
+// ---------------------------------------------------------------------------
+
+bool wirePeek(const uint8_t* data, size_t len, uint8_t wire, WireMsg* msg) {
+    memset(msg, 0, sizeof(*msg));
+
+    if (wire == WIRE_V2) {
+        if (len < WIRE_HEADER_SIZE || data[0] != WIRE_V2_VERSION || data[1] >= WIRE_TYPE_COUNT) {
+            return false;
+        }
+        if (data[3] > len - WIRE_HEADER_SIZE || !nsJsonSafe(data + WIRE_HEADER_SIZE, data[3])) return false;
+        msg->type = data[1];
+        msg->flags = data[2] & ~WIRE_FLAGS_HUB_SET;
+        for (int i = 0; i < 8; i++) msg->timestamp |= (uint64_t)data[4 + i] << (8 * i);
+        memcpy(msg->target, data + 32, WIRE_PEER_ID_LEN);
+        msg->ns = (const char*)data + WIRE_HEADER_SIZE;
+        msg->nsLen = data[3];
+        return msg->type != WIRE_OTHER;
+    }
+
+    // Same key walk as wireParseJson, stopping at the first value that
+    // runs past the bytes we have (typically the SDP in "data")
+    const char* json = (const char*)data;
+    const char* end = json + len;
+    const char* p = skipWs(json, end);
+    if (p >= end || *p != '{') return false;
+    p++;
+
+    while (true) {
+        p = skipWs(p, end);
+        if (p >= end || *p != '"') break;
+
+        const char* keyEnd = skipString(p, end);
+        if (!keyEnd) break;
+        const char* key = p + 1;
+        size_t keyLen = keyEnd - p - 2;
+
+        p = skipWs(keyEnd, end);
+        if (p >= end || *p != ':') break;
+        const char* val = skipWs(p + 1, end);
+        const char* valEnd = skipValue(val, end);
+        if (!valEnd || valEnd >= end) break;  // A bare value may be cut short
+
+        const char* s;
+        size_t sLen;
+        if (!stringContents(val, valEnd, &s, &sLen)) {
+            // Not a routing field
+        } else if (keyIs(key, keyLen, "type")) {
+            msg->type = typeFromName(s, sLen);
+        } else if (keyIs(key, keyLen, "networkName") && sLen <= 255) {
+            msg->ns = s;
+            msg->nsLen = sLen;
+        } else if (keyIs(key, keyLen, "fromPeerId")) {
+            if (keyIs(s, sLen, "system")) msg->flags |= WIRE_FLAG_SYSTEM;
+            else if (wireHexToId(s, sLen, msg->from)) msg->flags |= WIRE_FLAG_FROM;
+        } else if (keyIs(key, keyLen, "targetPeerId")) {
+            if (wireHexToId(s, sLen, msg->target)) msg->flags |= WIRE_FLAG_TARGET;
+        }
+
+        p = skipWs(valEnd, end);
+        if (p >= end || *p != ',') break;
+        p++;
+    }
+    return msg->type != WIRE_OTHER;
+}
@@ -0,0 +1,107 @@
+/*
+ * PigeonHub Wire Codec
+ *
+ * v1 is the PeerPigeon JSON text protocol. v2 is a compact binary encoding
+ * that clients opt into with the WebSocket subprotocol WIRE_V2_PROTOCOL.
+ * Both decode into the same WireMsg view so routing never re-parses text;
+ * the hub only converts when sender and receiver speak different versions.
+ *
+ * v2 frame (binary WebSocket message, little endian):
+ *   0   u8   version (WIRE_V2_VERSION)
+ *   1   u8   type (WireType)
+ *   2   u8   flags (WIRE_FLAG_*)
+ *   3   u8   namespace length
+ *   4   u64  timestamp (ms, 0 = none)
+ *  12   20   from peer ID (raw, valid with WIRE_FLAG_FROM)
+ *  32   20   target peer ID (raw, valid with WIRE_FLAG_TARGET)
+ *  52   n    namespace
+ *  52+n ...  blob: the v1 "data" value (SDP, ICE, peer info) as opaque bytes.
+ *            With WIRE_FLAG_RAW the blob is instead the complete v1 JSON
+ *            message (unknown types or extra fields v2 has no slot for); the
+ *            header still carries whatever routing fields could be parsed.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_WIRE_CODEC_H
+#define PIGEONHUB_WIRE_CODEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define WIRE_V2_PROTOCOL   "pigeonhub.v2"
+#define WIRE_V2_VERSION    2
+#define WIRE_HEADER_SIZE   52
+#define WIRE_PEER_ID_LEN   20
+
+#define WIRE_V1  1
+#define WIRE_V2  2
+
+#define WIRE_FLAG_HUB     0x01  // Sender is a hub (announce/peer-discovered)
+#define WIRE_FLAG_FROM    0x02
+#define WIRE_FLAG_TARGET  0x04
+#define WIRE_FLAG_SYSTEM  0x08  // Hub-generated; v1 "fromPeerId":"system"
+#define WIRE_FLAG_RAW     0x10  // Blob is the verbatim v1 message
+
+// Only the hub sets these. wireDecode() and wirePeek() clear them (and the
+// from ID) in v2 frames, which come from clients; the hub stamps FROM with
+// the connection's own peer ID.
+#define WIRE_FLAGS_HUB_SET  (WIRE_FLAG_SYSTEM | WIRE_FLAG_FROM)
+
+enum WireType {
+    WIRE_OTHER = 0,  // Unknown type name; always WIRE_FLAG_RAW
+    WIRE_ANNOUNCE,
+    WIRE_PEER_DISCOVERED,
+    WIRE_PEER_DISCONNECTED,
+    WIRE_OFFER,
+    WIRE_ANSWER,
+    WIRE_ICE_CANDIDATE,
+    WIRE_GOODBYE,
+    WIRE_CONNECTED,
+    WIRE_ICE_CANDIDATES,  // Merged candidates; data is an array (ice_coalescer.h)
+    WIRE_TYPE_COUNT
+};
+
+// Fields point into the buffer the message was parsed from
+struct WireMsg {
+    uint8_t type;
+    uint8_t flags;
+    uint64_t timestamp;
+    uint8_t from[WIRE_PEER_ID_LEN];
+    uint8_t target[WIRE_PEER_ID_LEN];
+    const char* ns;
+    size_t nsLen;
+    const uint8_t* blob;
+    size_t blobLen;
+};
+
+// "announce" etc.; "" for WIRE_OTHER
+const char* wireTypeName(uint8_t type);
+
+// Parses a v1 JSON message. Messages v2 can't represent field by field
+// (peer IDs that are not 40 hex digits, extra fields...) get WIRE_FLAG_RAW.
+bool wireParseJson(const char* json, size_t len, WireMsg* msg);
+
+// Decodes a v2 frame from a client. Fails if the namespace holds bytes v1
+// would have to escape (quote, backslash, control characters).
+bool wireDecode(const uint8_t* frame, size_t len, WireMsg* msg);
+
+// Returns the encoded size, or 0 if it doesn't fit. Rendering needs one
+// byte beyond wireJsonSize() for the terminator.
+size_t wireEncode(const WireMsg* msg, uint8_t* out, size_t cap);
+size_t wireRenderJson(const WireMsg* msg, char* out, size_t cap);
+
+// Exact sizes of the two encodings
+size_t wireEncodedSize(const WireMsg* msg);
+size_t wireJsonSize(const WireMsg* msg);
+
+// Reads the routing fields (type, flags, peer IDs, namespace) from the
+// first bytes of a message whose remainder hasn't arrived yet. blob is left
+// empty. Returns false if the type isn't among those bytes; the caller checks
+// the flags for the IDs it needs.
+bool wirePeek(const uint8_t* data, size_t len, uint8_t wire, WireMsg* msg);
+
+bool wireHexToId(const char* hex, size_t len, uint8_t id[WIRE_PEER_ID_LEN]);
+void wireIdToHex(const uint8_t id[WIRE_PEER_ID_LEN], char hex[WIRE_PEER_ID_LEN * 2 + 1]);
+
+#endif // PIGEONHUB_WIRE_CODEC_H
@@ -0,0 +1,29 @@
+/*
+ * PigeonHub XOR Distance
+ */
+
+#include "xor_distance.h"
+
+int xorCompare(const uint8_t* target, const uint8_t* a, const uint8_t* b) {
+    for (int i = 0; i < XOR_ID_LEN; i++) {
+        uint8_t da = a[i] ^ target[i];
+        uint8_t db = b[i] ^ target[i];
+        if (da != db) return da < db ? -1 : 1;
+    }
+    return 0;
+}
+
+size_t xorClosest(const uint8_t* target, XorCandidate* candidates, size_t count, size_t k) {
+    if (k > count) k = count;
+    // Partial selection sort: k is small next to count
+    for (size_t i = 0; i < k; i++) {
+        size_t best = i;
+        for (size_t j = i + 1; j < count; j++) {
+            if (xorCompare(target, candidates[j].id, candidates[best].id) < 0) best = j;
+        }
+        XorCandidate swap = candidates[i];
+        candidates[i] = candidates[best];
+        candidates[best] = swap;
+    }
+    return k;
+}
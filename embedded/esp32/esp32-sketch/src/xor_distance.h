@@ -0,0 +1,40 @@
+/*
+ * PigeonHub XOR Distance
+ *
+ * Kademlia's metric on 160-bit peer IDs: the distance between two IDs is
+ * their XOR, read as a big-endian integer. It is symmetric and every ID has
+ * one distance to each other, so "the K peers closest to a newcomer" is
+ * well defined and spreads introductions evenly over the ID space instead
+ * of handing every peer to every other.
+ *
+ * No Arduino dependencies - this compiles on Linux as well.
+ */
+
+#ifndef PIGEONHUB_XOR_DISTANCE_H
+#define PIGEONHUB_XOR_DISTANCE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define XOR_ID_LEN 20
+
+// Top-K discovery requests are raised to DISCOVERY_K_MIN. It is the smallest
+// K that leaves under 0.5% of a namespace of DISCOVERY_K_MESH peers cut off
+// after a fifth of them leave (tests/test_xor_distance.cpp); a hub holding
+// more peers than that needs it re-checked.
+#define DISCOVERY_K_MIN   4
+#define DISCOVERY_K_MESH  20
+
+struct XorCandidate {
+    const uint8_t* id;  // XOR_ID_LEN bytes
+    int index;          // Caller's
+};
+
+// <0 if a is closer to target than b, >0 if farther, 0 if a == b
+int xorCompare(const uint8_t* target, const uint8_t* a, const uint8_t* b);
+
+// Moves the k candidates closest to target to the front, nearest first.
+// Returns how many that is (k, or count if smaller). O(count * k).
+size_t xorClosest(const uint8_t* target, XorCandidate* candidates, size_t count, size_t k);
+
+#endif // PIGEONHUB_XOR_DISTANCE_H
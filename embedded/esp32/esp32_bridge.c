@@ -18,6 +18,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
+#include "mbedtls/sha256.h"
 #include "wasm3.h"
 #include "m3_env.h"
 
@@ -42,6 +43,9 @@ static IM3Environment wasm_env = NULL;
 static IM3Runtime wasm_runtime = NULL;
 static IM3Module wasm_module = NULL;
 
+// Build ID: first 8 bytes of the module's SHA-256 (matches embed_wasm.py)
+static char wasm_build_id[17] = "unknown";
+
 // WASM function pointers
 static IM3Function wasm_init = NULL;
 static IM3Function wasm_start_server = NULL;
@@ -305,7 +309,8 @@ m3ApiRawFunction(m3_ws_send_to_peer) {
     memset(&ws_pkt, 0, sizeof(httpd_ws_frame_t));
     ws_pkt.payload = (uint8_t*)data;
     ws_pkt.len = data_len;
-    ws_pkt.type = HTTPD_WS_TYPE_TEXT;
+    // v2 frames (first byte 2) go out binary; JSON never starts with it
+    ws_pkt.type = (data_len > 0 && (uint8_t)data[0] == 2) ? HTTPD_WS_TYPE_BINARY : HTTPD_WS_TYPE_TEXT;
     
     esp_err_t ret = httpd_ws_send_frame_async(http_server, conn->fd, &ws_pkt);
     if (ret != ESP_OK) {
@@ -330,7 +335,8 @@ m3ApiRawFunction(m3_ws_broadcast) {
     memset(&ws_pkt, 0, sizeof(httpd_ws_frame_t));
     ws_pkt.payload = (uint8_t*)data;
     ws_pkt.len = data_len;
-    ws_pkt.type = HTTPD_WS_TYPE_TEXT;
+    // v2 frames (first byte 2) go out binary; JSON never starts with it
+    ws_pkt.type = (data_len > 0 && (uint8_t)data[0] == 2) ? HTTPD_WS_TYPE_BINARY : HTTPD_WS_TYPE_TEXT;
     
     int sent_count = 0;
     for (int i = 0; i < MAX_WS_CONNECTIONS; i++) {
@@ -396,6 +402,20 @@ m3ApiRawFunction(m3_millis) {
     m3ApiReturn(ms);
 }
 
+/**
+ * Get the module build ID
+ * Called by WASM: get_build_id(buffer, buffer_len)
+ */
+m3ApiRawFunction(m3_get_build_id) {
+    m3ApiReturnType(void);
+    m3ApiGetArgMem(char*, buffer);
+    m3ApiGetArg(int32_t, buffer_len);
+    
+    snprintf(buffer, buffer_len, "%s", wasm_build_id);
+    
+    m3ApiSuccess();
+}
+
 // ============================================================================
 // WASM Module Management
 // ============================================================================
@@ -417,6 +437,12 @@ M3Result link_wasm_imports(IM3Module module) {
     _(m3_LinkRawFunction(module, env, "get_device_id", "v(ii)", &m3_get_device_id));
     _(m3_LinkRawFunction(module, env, "millis", "i()", &m3_millis));
     
+    // Optional: older modules don't import get_build_id
+    result = m3_LinkRawFunction(module, env, "get_build_id", "v(ii)", &m3_get_build_id);
+    if (result == m3Err_functionLookupFailed) {
+        result = m3Err_none;
+    }
+    
 _catch:
     return result;
 }
@@ -429,6 +455,14 @@ esp_err_t load_wasm_module(const uint8_t* wasm_binary, size_t wasm_size) {
     
     ESP_LOGI(TAG, "Initializing WASM3 runtime...");
     
+    // Identify the module the same way the build pipeline does
+    uint8_t digest[32];
+    mbedtls_sha256(wasm_binary, wasm_size, digest, 0);
+    for (int i = 0; i < 8; i++) {
+        sprintf(&wasm_build_id[i * 2], "%02x", digest[i]);
+    }
+    ESP_LOGI(TAG, "WASM build ID: %s", wasm_build_id);
+    
     // Create WASM environment
     wasm_env = m3_NewEnvironment();
     if (!wasm_env) {
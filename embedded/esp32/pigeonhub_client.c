@@ -35,12 +35,24 @@ extern void get_device_id(char* buffer, int buffer_len);
 __attribute__((import_module("env"), import_name("millis")))
 extern uint32_t millis();
 
+__attribute__((import_module("env"), import_name("get_build_id")))
+extern void get_build_id(char* buffer, int buffer_len);
+
 // Configuration
 #define MAX_MESSAGE_SIZE 2048
 #define MAX_PEERS 20
 #define HEARTBEAT_INTERVAL 30000  // 30 seconds
 #define PEER_TIMEOUT 60000        // 60 seconds
 
+// Binary v2 frames (see esp32-sketch/src/wire_codec.h)
+#define WIRE_V2_VERSION     2
+#define WIRE_HEADER_SIZE    52
+#define WIRE_ANNOUNCE       1
+#define WIRE_OFFER          4
+#define WIRE_ICE_CANDIDATE  6
+#define WIRE_FLAG_FROM      0x02
+#define WIRE_FLAG_TARGET    0x04
+
 // Peer connection state
 typedef struct {
     int peer_id;              // Unique connection ID from ESP32
@@ -52,6 +64,7 @@ typedef struct {
 // Server state management
 typedef struct {
     char hub_id[64];
+    char build_id[20];        // Host-reported module hash (see embed_wasm.py)
     int server_running;
     int port;
     uint32_t start_time;
@@ -159,6 +172,7 @@ int init() {
     
     // Generate unique hub ID
     generate_hub_id();
+    get_build_id(state.build_id, sizeof(state.build_id));
     
     state.server_running = 0;
     state.port = 0;
@@ -174,7 +188,7 @@ int init() {
     }
     
     char log_buf[128];
-    snprintf(log_buf, sizeof(log_buf), "Hub ID: %s", state.hub_id);
+    snprintf(log_buf, sizeof(log_buf), "Hub ID: %s (build %s)", state.hub_id, state.build_id);
     log_str(log_buf);
     
     return 0;
@@ -269,6 +283,43 @@ void on_peer_disconnected(int peer_id) {
     log_str(log_buf);
 }
 
+// Hex form of a raw 20-byte v2 peer ID
+static void wire_id_to_hex(const uint8_t* id, char* hex) {
+    static const char digits[] = "0123456789abcdef";
+    for (int i = 0; i < 20; i++) {
+        hex[i * 2] = digits[id[i] >> 4];
+        hex[i * 2 + 1] = digits[id[i] & 0x0F];
+    }
+    hex[40] = '\0';
+}
+
+// v2 frames carry type and peer IDs in a fixed header, so no text scanning
+static void on_wire_frame(PeerConnection* peer, const uint8_t* frame, int frame_len) {
+    uint8_t type = frame[1];
+    uint8_t flags = frame[2];
+
+    if (flags & WIRE_FLAG_FROM) {
+        wire_id_to_hex(frame + 12, peer->client_peer_id);
+    }
+
+    if (type == WIRE_ANNOUNCE) {
+        send_peer_list(peer->peer_id);
+        broadcast_peer_event("peer-connected", peer->client_peer_id, peer->peer_id);
+
+    } else if (type >= WIRE_OFFER && type <= WIRE_ICE_CANDIDATE && (flags & WIRE_FLAG_TARGET)) {
+        char target_peer_id[41];
+        wire_id_to_hex(frame + 32, target_peer_id);
+        for (int i = 0; i < MAX_PEERS; i++) {
+            if (state.peers[i].connected &&
+                strcmp(state.peers[i].client_peer_id, target_peer_id) == 0) {
+                ws_send_to_peer(state.peers[i].peer_id, (const char*)frame, frame_len);
+                state.messages_sent++;
+                break;
+            }
+        }
+    }
+}
+
 // Process incoming message from a peer
 __attribute__((export_name("on_message")))
 void on_message(int peer_id, const char* message, int message_len) {
@@ -281,6 +332,11 @@ void on_message(int peer_id, const char* message, int message_len) {
     }
     
     peer->last_seen = millis();
+
+    if (message_len >= WIRE_HEADER_SIZE && (uint8_t)message[0] == WIRE_V2_VERSION) {
+        on_wire_frame(peer, (const uint8_t*)message, message_len);
+        return;
+    }
     
     // Parse message type (simple JSON parsing)
     char type[32] = {0};
@@ -400,9 +456,9 @@ __attribute__((export_name("get_stats")))
 void get_stats(char* buffer, int buffer_size) {
     uint32_t uptime = (millis() - state.start_time) / 1000;
     snprintf(buffer, buffer_size,
-            "{\"hubId\":\"%s\",\"port\":%d,\"peers\":%d,\"uptime\":%u,"
+            "{\"hubId\":\"%s\",\"buildId\":\"%s\",\"port\":%d,\"peers\":%d,\"uptime\":%u,"
             "\"messagesReceived\":%llu,\"messagesSent\":%llu}",
-            state.hub_id, state.port, state.peer_count, uptime,
+            state.hub_id, state.build_id, state.port, state.peer_count, uptime,
             state.messages_received, state.messages_sent);
 }
 
@@ -412,6 +468,95 @@ const char* get_hub_id() {
     return state.hub_id;
 }
 
+// State migration for hot-swapping the module. The layout is versioned and
+// independent of ServerState so a newer module can restore an older snapshot.
+#define SNAPSHOT_VERSION 1
+
+typedef struct {
+    uint32_t version;
+    int32_t server_running;
+    int32_t port;
+    uint32_t start_time;
+    uint64_t messages_received;
+    uint64_t messages_sent;
+    int32_t peer_count;       // Number of SnapshotPeer records that follow
+} SnapshotHeader;
+
+typedef struct {
+    int32_t peer_id;
+    uint32_t last_seen;
+    char client_peer_id[64];
+} SnapshotPeer;
+
+// Serialize server state into buffer; returns bytes written or -1
+__attribute__((export_name("snapshot")))
+int snapshot(char* buffer, int buffer_size) {
+    SnapshotHeader header = {0};
+    header.version = SNAPSHOT_VERSION;
+    header.server_running = state.server_running;
+    header.port = state.port;
+    header.start_time = state.start_time;
+    header.messages_received = state.messages_received;
+    header.messages_sent = state.messages_sent;
+    header.peer_count = count_active_peers();
+
+    int needed = sizeof(header) + header.peer_count * sizeof(SnapshotPeer);
+    if (needed > buffer_size) {
+        return -1;
+    }
+
+    memcpy(buffer, &header, sizeof(header));
+    SnapshotPeer* out = (SnapshotPeer*)(buffer + sizeof(header));
+    for (int i = 0; i < MAX_PEERS; i++) {
+        if (state.peers[i].connected) {
+            out->peer_id = state.peers[i].peer_id;
+            out->last_seen = state.peers[i].last_seen;
+            memcpy(out->client_peer_id, state.peers[i].client_peer_id, sizeof(out->client_peer_id));
+            out++;
+        }
+    }
+
+    return needed;
+}
+
+// Restore server state from a snapshot taken by this or an older module.
+// Called after init() instead of start_server(). Returns 0 on success.
+__attribute__((export_name("restore")))
+int restore(const char* buffer, int buffer_size) {
+    SnapshotHeader header;
+    if (buffer_size < (int)sizeof(header)) {
+        return -1;
+    }
+    memcpy(&header, buffer, sizeof(header));
+
+    if (header.version != SNAPSHOT_VERSION || header.peer_count < 0 || header.peer_count > MAX_PEERS ||
+        buffer_size < (int)(sizeof(header) + header.peer_count * sizeof(SnapshotPeer))) {
+        log_str("Rejected incompatible state snapshot");
+        return -1;
+    }
+
+    state.server_running = header.server_running;
+    state.port = header.port;
+    state.start_time = header.start_time;
+    state.messages_received = header.messages_received;
+    state.messages_sent = header.messages_sent;
+
+    const SnapshotPeer* in = (const SnapshotPeer*)(buffer + sizeof(header));
+    for (int i = 0; i < header.peer_count; i++) {
+        state.peers[i].peer_id = in[i].peer_id;
+        state.peers[i].last_seen = in[i].last_seen;
+        memcpy(state.peers[i].client_peer_id, in[i].client_peer_id, sizeof(state.peers[i].client_peer_id));
+        state.peers[i].client_peer_id[sizeof(state.peers[i].client_peer_id) - 1] = '\0';
+        state.peers[i].connected = 1;
+    }
+    state.peer_count = count_active_peers();
+
+    char log_buf[128];
+    snprintf(log_buf, sizeof(log_buf), "Restored %d peers from snapshot", state.peer_count);
+    log_str(log_buf);
+    return 0;
+}
+
 // Memory allocation exports (required for WASM)
 __attribute__((export_name("malloc")))
 void* wasm_malloc(size_t size) {
@@ -0,0 +1,44 @@
+/**
+ * PigeonHub filter plugin: payload cap
+ *
+ * Drops frames from local peers that are larger than MAX_FRAME bytes.
+ * Frames from the uplink are always passed.
+ *
+ * Build and sign with `make plugins SIGNING_KEY=...`, then install with
+ *   curl -H 'Content-Type: application/octet-stream' \
+ *        --data-binary @plugins/payload_cap.signed.bin \
+ *        'http://<hub>/api/plugins?slot=0&name=payload_cap'
+ */
+
+#include <stdint.h>
+
+#define MAX_FRAME 2048
+
+#define FILTER_VIEW_SIZE 512
+#define FILTER_FROM_PEER 0
+
+// Filled in by the hub before each filter() call (see filter_pipeline.h)
+struct FilterView {
+    uint32_t direction;
+    uint32_t peer;
+    uint32_t length;
+    uint32_t ns_len;
+    uint32_t type_len;
+    uint32_t copied;
+    uint8_t bytes[FILTER_VIEW_SIZE - 24];
+};
+
+static struct FilterView view;
+
+__attribute__((export_name("filter_view")))
+struct FilterView* filter_view() {
+    return &view;
+}
+
+__attribute__((export_name("filter")))
+int filter(struct FilterView* v) {
+    if (v->direction == FILTER_FROM_PEER && v->length > MAX_FRAME) {
+        return 1;
+    }
+    return 0;
+}
@@ -11,23 +11,10 @@ Set-Location $esp32Dir
 # Set WASI_SDK_PATH
 $env:WASI_SDK_PATH = "C:\wasi-sdk"
 
-# Clean previous build
-Write-Host "Cleaning..." -ForegroundColor Gray
-make clean
-
-# Build WASM
-Write-Host "Building WASM..." -ForegroundColor Gray
-make wasm
-
-# Optimize if wasm-opt is available
-if (Get-Command wasm-opt -ErrorAction SilentlyContinue) {
-    Write-Host "Optimizing..." -ForegroundColor Gray
-    make wasm-opt
-}
-
-# Install to esp32-sketch
-Write-Host "Installing to esp32-sketch..." -ForegroundColor Gray
-make install
+# Build, optimize (if wasm-opt is available), install and compress.
+# Unchanged modules are not rebuilt or re-embedded.
+Write-Host "Building and embedding WASM..." -ForegroundColor Gray
+make embed
 
 # Show file size
 $wasmSize = (Get-Item "pigeonhub_client.wasm").Length
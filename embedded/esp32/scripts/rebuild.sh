@@ -16,23 +16,10 @@ SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
 ESP32_DIR="$(dirname "$SCRIPT_DIR")"
 cd "$ESP32_DIR"
 
-# Clean previous build
-echo "Cleaning..."
-make clean
-
-# Build WASM
-echo "Building WASM..."
-make wasm
-
-# Optimize if wasm-opt is available
-if command -v wasm-opt &> /dev/null; then
-    echo "Optimizing..."
-    make wasm-opt
-fi
-
-# Install to esp32-sketch
-echo "Installing to esp32-sketch..."
-make install
+# Build, optimize (if wasm-opt is available), install and compress.
+# Unchanged modules are not rebuilt or re-embedded.
+echo "Building and embedding WASM..."
+make embed
 
 # Show file size
 WASM_SIZE=$(du -h pigeonhub_client.wasm | cut -f1)
@@ -0,0 +1,49 @@
+/*
+ * PigeonHub host tests - shared checks
+ *
+ * Every test is a standalone executable built from tests/CMakeLists.txt and
+ * run by CTest. Failed checks are printed and make main() return non-zero.
+ * Benchmarks print their numbers with BENCH() and only fail on a broken
+ * result, never on a slow machine.
+ */
+
+#ifndef PIGEONHUB_HOST_TEST_H
+#define PIGEONHUB_HOST_TEST_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+static int testFailures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        testFailures++; \
+    } \
+} while (0)
+
+#define CHECK_EQ(a, b) do { \
+    long long _a = (long long)(a), _b = (long long)(b); \
+    if (_a != _b) { \
+        printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__, __LINE__, #a, #b, _a, _b); \
+        testFailures++; \
+    } \
+} while (0)
+
+#define BENCH(...) printf("bench: " __VA_ARGS__)
+
+static inline int testResult(const char* name) {
+    if (testFailures) printf("%s: %d check(s) failed\n", name, testFailures);
+    else printf("%s: ok\n", name);
+    return testFailures ? 1 : 0;
+}
+
+// Monotonic wall clock for benchmarks
+static inline uint64_t testNowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+#endif // PIGEONHUB_HOST_TEST_H
@@ -0,0 +1,185 @@
+/*
+ * PigeonHub host test - admission_throttle.cpp
+ *
+ * Token bucket and backlog checks, then the first minute of a 5000-client
+ * reconnect storm against a hub with WebSocket slots for 10 clients. It
+ * runs as an event simulation, once with the throttle and once admitting
+ * whenever a slot is free. Reported per run:
+ * - peak admissions in any one second
+ * - peak peers between handshake and announce, the work that stalls
+ *   relaying
+ * - peak connection attempts in any one second
+ * - how long until every slot holds an announced peer
+ */
+
+#include "host_test.h"
+#include "admission_throttle.h"
+#include <queue>
+#include <random>
+#include <vector>
+
+// WEBSOCKETS_SERVER_CLIENT_MAX, which main.cpp also uses as the burst
+#define HUB_SLOTS    10
+#define ADMIT_BURST  HUB_SLOTS
+
+static void testBucket() {
+    AdmissionThrottle t;
+    uint32_t retry = 0;
+    admissionInit(&t, ADMIT_RATE, ADMIT_BURST, ADMIT_PENDING_MAX, 0, 1000);
+
+    // A full bucket admits a burst, then one peer per 1000 / rate ms
+    for (int i = 0; i < ADMIT_BURST; i++) CHECK(admissionTry(&t, 1000, 0, 0, &retry));
+    CHECK(!admissionTry(&t, 1000, 0, 0, &retry));
+    CHECK_EQ(retry, 1000 / ADMIT_RATE);
+    CHECK(!admissionTry(&t, 1000 + 249, 0, 0, &retry));
+    CHECK_EQ(retry, 1);
+    CHECK(admissionTry(&t, 1000 + 250, 0, 0, &retry));
+    CHECK_EQ(t.admitted, ADMIT_BURST + 1);
+    CHECK_EQ(t.deferred, 2);
+
+    // The bucket never holds more than burst, however long the gap
+    admissionTry(&t, 1000 + 3600 * 1000, 0, 0, &retry);
+    CHECK_EQ(t.credit, (ADMIT_BURST - 1) * 1000);
+
+    // Too many unannounced peers defer even with tokens left
+    CHECK(!admissionTry(&t, 1000 + 3600 * 1000, ADMIT_PENDING_MAX + 1, 0, &retry));
+    CHECK_EQ(retry, 2 * 1000 / ADMIT_RATE);
+    CHECK_EQ(t.backlogged, 1);
+    CHECK_EQ(t.credit, (ADMIT_BURST - 1) * 1000);
+
+    // Millisecond clock wrap
+    admissionInit(&t, ADMIT_RATE, 1, ADMIT_PENDING_MAX, 0, 0xFFFFFF80u);
+    CHECK(admissionTry(&t, 0xFFFFFF80u, 0, 0, &retry));
+    CHECK(!admissionTry(&t, 0x00000010u, 0, 0, &retry));  // 144 ms later
+    CHECK_EQ(retry, 106);
+    CHECK(admissionTry(&t, 0x00000010u + 106, 0, 0, &retry));
+
+    // Jitter stays within jitterMs
+    admissionInit(&t, ADMIT_RATE, 1, ADMIT_PENDING_MAX, ADMIT_JITTER_MS, 0);
+    admissionTry(&t, 0, 0, 0, &retry);
+    uint32_t lo = UINT32_MAX, hi = 0;
+    for (uint32_t r = 0; r < 10000; r++) {
+        admissionTry(&t, 0, 0, r * 2654435761u, &retry);
+        lo = retry < lo ? retry : lo;
+        hi = retry > hi ? retry : hi;
+    }
+    CHECK_EQ(lo, 250);
+    CHECK(hi < 250 + ADMIT_JITTER_MS && hi > 250 + ADMIT_JITTER_MS * 9 / 10);
+}
+
+#define STORM_MS 60000
+
+struct StormResult {
+    uint32_t peakAdmitsPerSec;
+    uint32_t peakPending;
+    uint32_t peakAttemptsPerSec;
+    uint32_t attempts;
+    uint32_t admits;
+    uint32_t firstFullMs;   // Until every slot held an announced peer
+};
+
+// Largest number of times in any 1000 ms window; times are in order
+static uint32_t peakPerSecond(const std::vector<uint32_t>& times) {
+    uint32_t peak = 0;
+    size_t start = 0;
+    for (size_t i = 0; i < times.size(); i++) {
+        while (times[start] + 1000 <= times[i]) start++;
+        if (i - start + 1 > peak) peak = (uint32_t)(i - start + 1);
+    }
+    return peak;
+}
+
+enum EventKind { EV_ATTEMPT, EV_ANNOUNCE, EV_LEAVE };
+
+struct Event {
+    uint32_t at;
+    uint8_t kind;
+    uint32_t client;
+    bool operator<(const Event& o) const { return at > o.at; }
+};
+
+// Clients come back within 500 ms of the outage, stay for ~30 s and take
+// 100-600 ms from upgrade to announce. A refused client waits for the hub's
+// retryAfterMs; a full hub gives no hint, so it backs off 1-2 s.
+static StormResult storm(bool throttled, int clients) {
+    std::mt19937 rng(42);
+    std::priority_queue<Event> events;
+    for (int c = 0; c < clients; c++) events.push({ (uint32_t)(rng() % 500), EV_ATTEMPT, (uint32_t)c });
+
+    AdmissionThrottle t;
+    admissionInit(&t, ADMIT_RATE, ADMIT_BURST, ADMIT_PENDING_MAX, ADMIT_JITTER_MS, 0);
+    std::exponential_distribution<double> session(1.0 / 30000);
+
+    StormResult r = {};
+    uint32_t connected = 0, pending = 0, announced = 0;
+    std::vector<uint32_t> admitTimes, attemptTimes;
+
+    while (!events.empty() && events.top().at < STORM_MS) {
+        Event e = events.top();
+        events.pop();
+
+        if (e.kind == EV_ANNOUNCE) {
+            pending--;
+            announced++;
+            if (announced == HUB_SLOTS && !r.firstFullMs) r.firstFullMs = e.at;
+            events.push({ e.at + (uint32_t)session(rng), EV_LEAVE, e.client });
+            continue;
+        }
+        if (e.kind == EV_LEAVE) {
+            connected--;
+            announced--;
+            continue;
+        }
+
+        attemptTimes.push_back(e.at);
+        if (connected >= HUB_SLOTS) {
+            events.push({ e.at + 1000 + (uint32_t)(rng() % 1000), EV_ATTEMPT, e.client });
+            continue;
+        }
+        uint32_t retry = 0;
+        if (throttled && !admissionTry(&t, e.at, pending, rng(), &retry)) {
+            events.push({ e.at + retry, EV_ATTEMPT, e.client });
+            continue;
+        }
+
+        connected++;
+        pending++;
+        if (pending > r.peakPending) r.peakPending = pending;
+        admitTimes.push_back(e.at);
+        events.push({ e.at + 100 + (uint32_t)(rng() % 500), EV_ANNOUNCE, e.client });
+    }
+
+    r.peakAdmitsPerSec = peakPerSecond(admitTimes);
+    r.peakAttemptsPerSec = peakPerSecond(attemptTimes);
+    r.attempts = (uint32_t)attemptTimes.size();
+    r.admits = (uint32_t)admitTimes.size();
+    return r;
+}
+
+static void testStorm() {
+    const int clients = 5000;
+    StormResult with = storm(true, clients);
+    StormResult without = storm(false, clients);
+
+    BENCH("%d-client storm, %d slots, first %d s:\n", clients, HUB_SLOTS, STORM_MS / 1000);
+    const StormResult* runs[2] = { &with, &without };
+    for (int i = 0; i < 2; i++) {
+        const StormResult* r = runs[i];
+        BENCH("  %-11s peak %2u admits/s, peak %2u pending, peak %4u attempts/s, "
+              "%6u attempts, %3u admits, slots full after %u ms\n",
+              i == 0 ? "throttled:" : "unthrottled:", r->peakAdmitsPerSec, r->peakPending,
+              r->peakAttemptsPerSec, r->attempts, r->admits, r->firstFullMs);
+    }
+
+    // The bucket bounds any one-second window; pending never passes pendingMax
+    CHECK(with.peakAdmitsPerSec <= ADMIT_BURST + ADMIT_RATE);
+    CHECK(with.peakPending <= ADMIT_PENDING_MAX);
+    CHECK(without.peakPending > ADMIT_PENDING_MAX);
+    CHECK(with.firstFullMs > 0 && with.firstFullMs < 5000);
+}
+
+int main() {
+    testBucket();
+    testStorm();
+    return testResult("test_admission_throttle");
+}
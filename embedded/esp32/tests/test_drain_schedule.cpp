@@ -0,0 +1,116 @@
+/*
+ * PigeonHub host test - drain_schedule.cpp
+ *
+ * Bounds of the close times, retry hints and refusals handed out while
+ * draining, including the ends of the window and a millis() wrap. Then 200
+ * connected peers reconnecting after a restart: all dropped at once (each
+ * client retrying within its own second of jitter) against a drain with
+ * the defaults in drain_schedule.h. Reported: peak reconnects per second.
+ */
+
+#include "host_test.h"
+#include "drain_schedule.h"
+#include <random>
+
+static void testCloseIn() {
+    DrainSchedule drain;
+    drainInit(&drain);
+    CHECK(!drain.active);
+    drainStart(&drain, 1000, DRAIN_WINDOW_MS, DRAIN_RETRY_SPREAD_MS, DRAIN_GRACE_MS);
+
+    // Inside the window: up to its last millisecond, never past it
+    CHECK_EQ(drainCloseIn(&drain, 1000, 0), 0u);
+    CHECK_EQ(drainCloseIn(&drain, 1000, DRAIN_WINDOW_MS - 1), (uint32_t)DRAIN_WINDOW_MS - 1);
+    CHECK_EQ(drainCloseIn(&drain, 1000, DRAIN_WINDOW_MS), 0u);
+    CHECK_EQ(drainCloseIn(&drain, 4000, 0xFFFFFFFF), 0xFFFFFFFFu % (DRAIN_WINDOW_MS - 3000));
+    CHECK_EQ(drainCloseIn(&drain, 1000 + DRAIN_WINDOW_MS - 1, 0xFFFFFFFF), 0u);
+    std::mt19937 rng(3);
+    for (uint32_t elapsed = 0; elapsed < DRAIN_WINDOW_MS; elapsed += 7) {
+        uint32_t closeIn = drainCloseIn(&drain, 1000 + elapsed, rng());
+        CHECK(elapsed + closeIn < DRAIN_WINDOW_MS);
+    }
+
+    // At and past the end of the window: close now
+    CHECK_EQ(drainCloseIn(&drain, 1000 + DRAIN_WINDOW_MS, 12345), 0u);
+    CHECK_EQ(drainCloseIn(&drain, 1000 + DRAIN_WINDOW_MS + 1, 12345), 0u);
+    CHECK_EQ(drainCloseIn(&drain, 1000 + DRAIN_WINDOW_MS + DRAIN_GRACE_MS + 50000, 12345), 0u);
+    CHECK_EQ(drain.notified, 5u + (DRAIN_WINDOW_MS + 6) / 7 + 3);
+
+    // An empty window closes everyone at once
+    drainStart(&drain, 0, 0, 0, 0);
+    CHECK_EQ(drainCloseIn(&drain, 0, 777), 0u);
+    CHECK_EQ(drainRetryAfter(&drain, 777), 0u);
+    CHECK(drainExpired(&drain, 0));
+
+    // millis() wraps during the window
+    drainStart(&drain, 0xFFFFF000, DRAIN_WINDOW_MS, DRAIN_RETRY_SPREAD_MS, DRAIN_GRACE_MS);
+    uint32_t elapsed = 0x2000;  // now = 0x1000
+    CHECK_EQ(drainCloseIn(&drain, 0x1000, DRAIN_WINDOW_MS - elapsed - 1), DRAIN_WINDOW_MS - elapsed - 1);
+    CHECK_EQ(drainCloseIn(&drain, 0x1000, DRAIN_WINDOW_MS - elapsed), 0u);
+    CHECK(!drainExpired(&drain, 0x1000));
+    CHECK(drainExpired(&drain, 0xFFFFF000 + DRAIN_WINDOW_MS + DRAIN_GRACE_MS));
+}
+
+static void testRetryAndRefuse() {
+    DrainSchedule drain;
+    drainInit(&drain);
+    drainStart(&drain, 500, DRAIN_WINDOW_MS, DRAIN_RETRY_SPREAD_MS, DRAIN_GRACE_MS);
+    CHECK_EQ(drainRetryAfter(&drain, 0), 0u);
+    CHECK_EQ(drainRetryAfter(&drain, DRAIN_RETRY_SPREAD_MS - 1), (uint32_t)DRAIN_RETRY_SPREAD_MS - 1);
+    CHECK_EQ(drainRetryAfter(&drain, DRAIN_RETRY_SPREAD_MS), 0u);
+
+    // Refused peers come back after the window and grace, plus the spread
+    const uint32_t end = DRAIN_WINDOW_MS + DRAIN_GRACE_MS;
+    CHECK_EQ(drainRefuse(&drain, 500, 0), end);
+    CHECK_EQ(drainRefuse(&drain, 500 + 3000, DRAIN_RETRY_SPREAD_MS - 1), end - 3000 + DRAIN_RETRY_SPREAD_MS - 1);
+    CHECK_EQ(drainRefuse(&drain, 500 + DRAIN_WINDOW_MS, 0), (uint32_t)DRAIN_GRACE_MS);
+    CHECK_EQ(drainRefuse(&drain, 500 + end - 1, 0), 1u);
+    CHECK_EQ(drainRefuse(&drain, 500 + end, 0), 0u);
+    CHECK_EQ(drainRefuse(&drain, 500 + end + 60000, 42), 42u);
+    CHECK_EQ(drain.refused, 6u);
+
+    CHECK(!drainExpired(&drain, 500 + end - 1));
+    CHECK(drainExpired(&drain, 500 + end));
+    drainInit(&drain);
+    CHECK(!drainExpired(&drain, 500 + end));  // Not draining
+}
+
+static void testReconnectSpread() {
+    const int peers = 200;
+    const int seconds = DRAIN_WINDOW_MS / 1000 + DRAIN_RETRY_SPREAD_MS / 1000 + 2;
+    std::mt19937 rng(7);
+    int dropped[seconds] = {0}, drained[seconds] = {0};
+    uint32_t lastMs = 0;
+
+    DrainSchedule drain;
+    drainInit(&drain);
+    drainStart(&drain, 0, DRAIN_WINDOW_MS, DRAIN_RETRY_SPREAD_MS, DRAIN_GRACE_MS);
+    for (int i = 0; i < peers; i++) {
+        dropped[(rng() % 1000) / 1000]++;
+        uint32_t closeIn = drainCloseIn(&drain, 0, rng());
+        uint32_t at = closeIn + drainRetryAfter(&drain, rng());
+        CHECK(closeIn < DRAIN_WINDOW_MS);
+        CHECK(at < DRAIN_WINDOW_MS + DRAIN_RETRY_SPREAD_MS);
+        drained[at / 1000]++;
+        if (at > lastMs) lastMs = at;
+    }
+
+    int droppedPeak = 0, drainedPeak = 0;
+    for (int s = 0; s < seconds; s++) {
+        if (dropped[s] > droppedPeak) droppedPeak = dropped[s];
+        if (drained[s] > drainedPeak) drainedPeak = drained[s];
+    }
+    BENCH("%d peers reconnecting after a restart:\n", peers);
+    BENCH("  all dropped at once: peak %3d/s\n", droppedPeak);
+    BENCH("  drained (%u s window, %u s retry spread): peak %3d/s, last after %.1f s\n",
+          DRAIN_WINDOW_MS / 1000, DRAIN_RETRY_SPREAD_MS / 1000, drainedPeak, lastMs / 1000.0);
+    CHECK_EQ(droppedPeak, peers);
+    CHECK(drainedPeak * 5 < peers);
+}
+
+int main() {
+    testCloseIn();
+    testRetryAndRefuse();
+    testReconnectSpread();
+    return testResult("test_drain_schedule");
+}
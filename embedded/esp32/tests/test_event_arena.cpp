@@ -0,0 +1,186 @@
+/*
+ * PigeonHub host test - event_arena.cpp
+ *
+ * Counts every heap call in the process (malloc and friends are wrapped
+ * around glibc's) to show that handling an event the way the sketch does -
+ * a converted frame, a stamped copy and a generated reply, then reset -
+ * never touches the heap while it fits the arena, and that spills are both
+ * counted and freed.
+ */
+
+#include "host_test.h"
+#include "event_arena.h"
+#include "wire_codec.h"
+#include <stdlib.h>
+#include <string.h>
+
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t n, size_t size);
+extern "C" void* __libc_realloc(void* p, size_t size);
+extern "C" void __libc_free(void* p);
+
+static size_t heapAllocs = 0;
+static size_t heapFrees = 0;
+
+extern "C" void* malloc(size_t size) {
+    heapAllocs++;
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t n, size_t size) {
+    heapAllocs++;
+    return __libc_calloc(n, size);
+}
+
+extern "C" void* realloc(void* p, size_t size) {
+    heapAllocs++;
+    return __libc_realloc(p, size);
+}
+
+extern "C" void free(void* p) {
+    if (p) heapFrees++;
+    __libc_free(p);
+}
+
+#define ARENA_SIZE (8 * 1024)  // EVENT_ARENA_SIZE in main.cpp
+alignas(ARENA_ALIGN) static uint8_t arenaBuf[ARENA_SIZE];
+
+static const char ICE[] =
+    "{\"type\":\"ice-candidate\",\"data\":{\"candidate\":\"candidate:842163049 1 udp 1677729535 "
+    "203.0.113.7 51234 typ srflx raddr 192.168.4.2 rport 51234 generation 0\",\"sdpMid\":\"0\","
+    "\"sdpMLineIndex\":0},\"networkName\":\"global\","
+    "\"fromPeerId\":\"0a1b2c3d4e5f60718293a4b5c6d7e8f901234567\","
+    "\"targetPeerId\":\"fedcba98765432100123456789abcdef00112233\"}";
+
+// One relayed signaling message: v1 -> v2 for the target, a stamped v1
+// copy for the uplink and an ack
+static bool handleEvent(EventArena* arena, uint32_t seq) {
+    WireMsg msg;
+    if (!wireParseJson(ICE, sizeof(ICE) - 1, &msg)) return false;
+
+    size_t frameLen = wireEncodedSize(&msg);
+    uint8_t* frame = (uint8_t*)arenaAlloc(arena, frameLen);
+    if (!frame || wireEncode(&msg, frame, frameLen) != frameLen) return false;
+
+    msg.timestamp = 1729260000000ull + seq;
+    size_t jsonCap = wireJsonSize(&msg) + 1;
+    char* stamped = (char*)arenaAlloc(arena, jsonCap);
+    if (!stamped || !wireRenderJson(&msg, stamped, jsonCap)) return false;
+
+    size_t ackLen = 0;
+    char* ack = arenaPrintf(arena, &ackLen, "{\"type\":\"ack\",\"seq\":%u,\"bytes\":%zu}", seq, frameLen);
+    return ack && ackLen > 0;
+}
+
+static void testNoHeapPerEvent() {
+    EventArena arena;
+    arenaInit(&arena, arenaBuf, sizeof(arenaBuf));
+
+    // Warm up whatever libc allocates lazily (stdio locale data etc.)
+    handleEvent(&arena, 0);
+    arenaReset(&arena);
+
+    const uint32_t events = 100000;
+    size_t allocsBefore = heapAllocs;
+    size_t freesBefore = heapFrees;
+    bool ok = true;
+    for (uint32_t i = 1; i <= events; i++) {
+        ok = handleEvent(&arena, i) && ok;
+        arenaReset(&arena);
+    }
+    CHECK(ok);
+    CHECK_EQ(heapAllocs - allocsBefore, 0);
+    CHECK_EQ(heapFrees - freesBefore, 0);
+    CHECK_EQ(arena.overflows, 0);
+    CHECK_EQ(arena.resets, events + 1);
+    CHECK(arena.highWater > 0 && arena.highWater < ARENA_SIZE);
+    CHECK_EQ(arena.used, 0);
+}
+
+static void testAlignmentAndReset() {
+    EventArena arena;
+    arenaInit(&arena, arenaBuf, sizeof(arenaBuf));
+    uint8_t* a = (uint8_t*)arenaAlloc(&arena, 3);
+    uint8_t* b = (uint8_t*)arenaAlloc(&arena, 1);
+    uint8_t* c = (uint8_t*)arenaAlloc(&arena, 0);
+    CHECK(a == arenaBuf);
+    CHECK_EQ(b - a, ARENA_ALIGN);
+    CHECK_EQ((uintptr_t)c % ARENA_ALIGN, 0);
+    CHECK_EQ(arena.highWater, 2 * ARENA_ALIGN);
+
+    size_t len = 0;
+    char* s = arenaPrintf(&arena, &len, "%s-%d", "peer", 42);
+    CHECK(s && strcmp(s, "peer-42") == 0);
+    CHECK_EQ(len, 7);
+
+    arenaReset(&arena);
+    CHECK(arenaAlloc(&arena, 1) == arenaBuf);
+    // High water is kept across resets
+    CHECK(arena.highWater >= 2 * ARENA_ALIGN + 8);
+}
+
+static void testSpill() {
+    EventArena arena;
+    arenaInit(&arena, arenaBuf, sizeof(arenaBuf));
+
+    // Exactly full stays in the arena
+    CHECK(arenaAlloc(&arena, ARENA_SIZE) == arenaBuf);
+    CHECK_EQ(arena.overflows, 0);
+    arenaReset(&arena);
+
+    size_t allocsBefore = heapAllocs;
+    size_t freesBefore = heapFrees;
+    CHECK(arenaAlloc(&arena, ARENA_SIZE - 16) != NULL);
+    for (int i = 0; i < ARENA_SPILL_MAX; i++) {
+        void* p = arenaAlloc(&arena, 64);
+        CHECK(p != NULL);
+        CHECK(p < (void*)arenaBuf || p >= (void*)(arenaBuf + ARENA_SIZE));
+    }
+    CHECK_EQ(heapAllocs - allocsBefore, ARENA_SPILL_MAX);
+    CHECK_EQ(arena.overflows, ARENA_SPILL_MAX);
+
+    // Past the spill limit requests fail instead of growing the heap
+    CHECK(arenaAlloc(&arena, 64) == NULL);
+    CHECK_EQ(arena.overflows, ARENA_SPILL_MAX + 1);
+    CHECK_EQ(heapAllocs - allocsBefore, ARENA_SPILL_MAX);
+
+    // Small requests still fit in what is left of the arena
+    CHECK(arenaAlloc(&arena, 8) != NULL);
+
+    arenaReset(&arena);
+    CHECK_EQ(heapFrees - freesBefore, ARENA_SPILL_MAX);
+    CHECK_EQ(arena.spillCount, 0);
+}
+
+static void bench() {
+    EventArena arena;
+    arenaInit(&arena, arenaBuf, sizeof(arenaBuf));
+    const int rounds = 1000000;
+    volatile uintptr_t sink = 0;
+
+    uint64_t t0 = testNowNs();
+    for (int i = 0; i < rounds; i++) {
+        sink += (uintptr_t)arenaAlloc(&arena, 240);
+        sink += (uintptr_t)arenaAlloc(&arena, 380);
+        arenaReset(&arena);
+    }
+    uint64_t t1 = testNowNs();
+    for (int i = 0; i < rounds; i++) {
+        void* a = malloc(240);
+        void* b = malloc(380);
+        sink += (uintptr_t)a + (uintptr_t)b;
+        free(b);
+        free(a);
+    }
+    uint64_t t2 = testNowNs();
+    BENCH("two allocations + release: arena %.1f ns, malloc/free %.1f ns\n",
+          (double)(t1 - t0) / rounds, (double)(t2 - t1) / rounds);
+}
+
+int main() {
+    testNoHeapPerEvent();
+    testAlignmentAndReset();
+    testSpill();
+    bench();
+    return testResult("test_event_arena");
+}
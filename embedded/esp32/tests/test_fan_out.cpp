@@ -0,0 +1,276 @@
+/*
+ * PigeonHub host test - fan-out framing
+ *
+ * fan_out.cpp renders a message once per encoding into the event arena
+ * behind header room, and main.cpp sends that buffer with headerToPayload.
+ * The loop it replaced converted per recipient, and the WebSockets library
+ * then copied every frame under 1400 bytes into a fresh malloc'd buffer to
+ * put the header in front. Both are driven here through a model of the
+ * library's sendFrame, with each socket write going to /dev/null, for 10,
+ * 100 and 1000 recipients (half v1 JSON, half v2). The bytes on the wire
+ * must match.
+ */
+
+#include "host_test.h"
+#include "event_arena.h"
+#include "wire_codec.h"
+#include "fan_out.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// links2004 WebSockets.h
+#define WEBSOCKETS_MAX_HEADER_SIZE  14
+#define WS_INTERN_BUFFER_MAX        1400
+#define WS_OP_TEXT    0x1
+#define WS_OP_BINARY  0x2
+
+#define ANNOUNCED "{\"peerId\":\"0a1b2c3d4e5f60718293a4b5c6d7e8f901234567\",\"isHub\":false}"
+
+static uint8_t arenaBuf[64 * 1024] __attribute__((aligned(8)));
+static EventArena arena;
+
+static int devNull = -1;
+static std::vector<std::string>* capture;  // Per-recipient bytes, or NULL for /dev/null
+static uint32_t socketWrites;
+static uint32_t heapCalls;
+
+static void socketWrite(int client, const uint8_t* data, size_t len) {
+    socketWrites++;
+    if (capture) {
+        (*capture)[client].append((const char*)data, len);
+    } else if (write(devNull, data, len) < 0) {
+        CHECK(false);
+    }
+}
+
+// Unmasked server frame header, as WebSockets::createHeader writes it
+static size_t frameHeader(uint8_t* out, uint8_t opcode, size_t len) {
+    out[0] = 0x80 | opcode;
+    if (len < 126) {
+        out[1] = len;
+        return 2;
+    }
+    if (len <= 0xFFFF) {
+        out[1] = 126;
+        out[2] = len >> 8;
+        out[3] = len;
+        return 4;
+    }
+    out[1] = 127;
+    for (int i = 0; i < 8; i++) out[2 + i] = (uint64_t)len >> (56 - 8 * i);
+    return 10;
+}
+
+// WebSockets::sendFrame(). Without headerToPayload `payload` is the data,
+// copied behind a header in a malloc'd buffer when it is short enough.
+// With it, `payload` is the start of WEBSOCKETS_MAX_HEADER_SIZE reserved
+// bytes followed by `len` bytes of data; the header goes at the end of the
+// reserved bytes and header and data are written together.
+static void sendFrame(int client, uint8_t opcode, uint8_t* payload, size_t len, bool headerToPayload) {
+    uint8_t header[WEBSOCKETS_MAX_HEADER_SIZE];
+    size_t headerLen = frameHeader(header, opcode, len);
+    if (headerToPayload) {
+        uint8_t* headerPtr = payload + WEBSOCKETS_MAX_HEADER_SIZE - headerLen;
+        memcpy(headerPtr, header, headerLen);
+        socketWrite(client, headerPtr, headerLen + len);
+    } else if (len > 0 && len < WS_INTERN_BUFFER_MAX) {
+        uint8_t* buf = (uint8_t*)malloc(WEBSOCKETS_MAX_HEADER_SIZE + len);
+        heapCalls += 2;
+        uint8_t* start = buf + WEBSOCKETS_MAX_HEADER_SIZE - headerLen;
+        memcpy(start, header, headerLen);
+        memcpy(buf + WEBSOCKETS_MAX_HEADER_SIZE, payload, len);
+        socketWrite(client, start, headerLen + len);
+        free(buf);
+    } else {
+        socketWrite(client, header, headerLen);
+        socketWrite(client, payload, len);
+    }
+}
+
+// convertFrame() in main.cpp
+static uint8_t* convert(const WireMsg* msg, uint8_t wire, size_t* len) {
+    uint8_t* frame;
+    if (wire == WIRE_V2) {
+        size_t cap = wireEncodedSize(msg);
+        frame = (uint8_t*)arenaAlloc(&arena, cap);
+        *len = wireEncode(msg, frame, cap);
+    } else {
+        size_t cap = wireJsonSize(msg) + 1;
+        frame = (uint8_t*)arenaAlloc(&arena, cap);
+        *len = wireRenderJson(msg, (char*)frame, cap);
+    }
+    return frame;
+}
+
+static uint8_t recipientWire(int i) {
+    return i % 2 ? WIRE_V2 : WIRE_V1;
+}
+
+// The loop before FanOut: sendWire() per recipient
+static uint32_t perRecipient(const WireMsg* msg, int recipients) {
+    uint32_t renders = 0;
+    for (int i = 0; i < recipients; i++) {
+        uint8_t wire = recipientWire(i);
+        size_t len;
+        uint8_t* frame = convert(msg, wire, &len);
+        renders++;
+        sendFrame(i, wire == WIRE_V2 ? WS_OP_BINARY : WS_OP_TEXT, frame, len, false);
+        // The hub has far fewer peers than this; keep the arena from spilling
+        arenaReset(&arena);
+    }
+    return renders;
+}
+
+// fanOutBegin()/fanOutSend() in main.cpp
+static uint32_t fannedOut(const WireMsg* msg, const uint8_t* frame, size_t frameLen, int recipients) {
+    FanOut fan;
+    fanOutInit(&fan, msg, frame, frameLen, WIRE_V1);
+    for (int i = 0; i < recipients; i++) {
+        uint8_t wire = fanOutWire(&fan, recipientWire(i));
+        size_t len = 0;
+        uint8_t* buf = fanOutBuffer(&fan, &arena, wire, &len);
+        CHECK(buf != NULL);
+        if (!buf) return fan.renders;
+        sendFrame(i, wire == WIRE_V2 ? WS_OP_BINARY : WS_OP_TEXT, buf, len, true);
+    }
+    return fan.renders;
+}
+
+static WireMsg peerDiscovered() {
+    WireMsg msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.type = WIRE_PEER_DISCOVERED;
+    msg.flags = WIRE_FLAG_SYSTEM;
+    msg.timestamp = 1729260000123ull;
+    msg.ns = "global";
+    msg.nsLen = 6;
+    msg.blob = (const uint8_t*)ANNOUNCED;
+    msg.blobLen = strlen(ANNOUNCED);
+    return msg;
+}
+
+// Payload of one unmasked frame as it went out, or "" if the header is off
+static std::string framePayload(const std::string& sent) {
+    if (sent.size() < 2) return "";
+    size_t len = (uint8_t)sent[1];
+    size_t headerLen = 2;
+    if (len == 126) {
+        len = (uint8_t)sent[2] << 8 | (uint8_t)sent[3];
+        headerLen = 4;
+    }
+    return sent.size() == headerLen + len ? sent.substr(headerLen) : "";
+}
+
+static void testSameBytes(size_t blobLen, size_t headerLen) {
+    std::string blob = "{\"pad\":\"";
+    blob.append(blobLen - blob.size() - 2, 'x');
+    blob += "\"}";
+    WireMsg msg = peerDiscovered();
+    msg.blob = (const uint8_t*)blob.data();
+    msg.blobLen = blob.size();
+
+    const int recipients = 6;
+    std::vector<std::string> before(recipients), after(recipients);
+    capture = &before;
+    CHECK_EQ(perRecipient(&msg, recipients), (uint32_t)recipients);
+    capture = &after;
+    CHECK_EQ(fannedOut(&msg, NULL, 0, recipients), 2u);
+    capture = NULL;
+
+    for (int i = 0; i < recipients; i++) {
+        CHECK(!before[i].empty() && before[i] == after[i]);
+    }
+    CHECK_EQ((uint8_t)after[0][0], 0x80 | WS_OP_TEXT);
+    CHECK_EQ((uint8_t)after[1][0], 0x80 | WS_OP_BINARY);
+
+    size_t len;
+    uint8_t* json = convert(&msg, WIRE_V1, &len);
+    CHECK(framePayload(after[0]) == std::string((const char*)json, len));
+    CHECK_EQ(after[0].size() - len, headerLen);
+    arenaReset(&arena);
+}
+
+// A received v1 frame goes to v1 peers byte for byte and is converted once
+// for the v2 ones; without a msg it goes to everyone unchanged
+static void testForwarded() {
+    WireMsg msg = peerDiscovered();
+    size_t frameLen;
+    uint8_t* frame = convert(&msg, WIRE_V1, &frameLen);
+    std::string received((const char*)frame, frameLen);
+    const int recipients = 4;
+
+    std::vector<std::string> sent(recipients);
+    capture = &sent;
+    CHECK_EQ(fannedOut(&msg, frame, frameLen, recipients), 2u);
+    CHECK(framePayload(sent[0]) == received);
+    CHECK(framePayload(sent[2]) == received);
+    CHECK_EQ((uint8_t)sent[1][0], 0x80 | WS_OP_BINARY);
+    WireMsg decoded;
+    std::string v2 = framePayload(sent[1]);
+    CHECK(wireDecode((const uint8_t*)v2.data(), v2.size(), &decoded));
+    CHECK_EQ(decoded.type, WIRE_PEER_DISCOVERED);
+
+    std::vector<std::string> unchanged(recipients);
+    capture = &unchanged;
+    CHECK_EQ(fannedOut(NULL, frame, frameLen, recipients), 1u);
+    for (int i = 0; i < recipients; i++) {
+        CHECK_EQ((uint8_t)unchanged[i][0], 0x80 | WS_OP_TEXT);
+        CHECK(framePayload(unchanged[i]) == received);
+    }
+    capture = NULL;
+    arenaReset(&arena);
+}
+
+static void benchFanOut() {
+    WireMsg msg = peerDiscovered();
+    const int sizes[] = { 10, 100, 1000 };
+    BENCH("peer-discovered to N recipients (half v1, half v2), per message:\n");
+    for (int recipients : sizes) {
+        int rounds = 200000 / recipients;
+        uint32_t stats[2][3];  // renders, writes, heap calls
+
+        uint64_t ns[2];
+        for (int fanned = 0; fanned < 2; fanned++) {
+            uint32_t renders = 0;
+            socketWrites = 0;
+            heapCalls = 0;
+            uint64_t start = testNowNs();
+            for (int r = 0; r < rounds; r++) {
+                renders += fanned ? fannedOut(&msg, NULL, 0, recipients) : perRecipient(&msg, recipients);
+                arenaReset(&arena);
+            }
+            ns[fanned] = (testNowNs() - start) / rounds;
+            stats[fanned][0] = renders / rounds;
+            stats[fanned][1] = socketWrites / rounds;
+            stats[fanned][2] = heapCalls / rounds;
+        }
+        CHECK_EQ(stats[1][0], 2u);
+        CHECK_EQ(stats[1][1], (uint32_t)recipients);
+        CHECK_EQ(stats[1][2], 0u);
+        CHECK_EQ(stats[0][2], 2u * recipients);
+
+        BENCH("  %4d: per recipient %8llu ns (%4u renders, %4u mallocs)   fan-out %8llu ns (%u renders)   %.2fx\n",
+              recipients, (unsigned long long)ns[0], stats[0][0], stats[0][2] / 2,
+              (unsigned long long)ns[1], stats[1][0], (double)ns[0] / ns[1]);
+    }
+}
+
+int main() {
+    devNull = open("/dev/null", O_WRONLY);
+    CHECK(devNull >= 0);
+    arenaInit(&arena, arenaBuf, sizeof(arenaBuf));
+
+    testSameBytes(12, 2);    // Short frame header
+    testSameBytes(600, 4);   // 16-bit length, copied by the library
+    testSameBytes(3000, 4);  // Written in two parts by the library
+    testForwarded();
+    benchFanOut();
+
+    CHECK_EQ(arena.overflows, 0u);
+    close(devNull);
+    return testResult("test_fan_out");
+}
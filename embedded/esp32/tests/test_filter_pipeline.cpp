@@ -0,0 +1,285 @@
+/*
+ * PigeonHub host test - filter_pipeline.cpp
+ *
+ * Plugins are native exports behind the wasm3 stand-in in wasm3_fake/.
+ * Covers the order plugins run in and the first drop ending the chain, the
+ * view layout (with a message too long to copy whole), per-call cycle and
+ * memory accounting, the strikes that disable an overrunning or trapping
+ * plugin (which then passes everything), and plugins rejected at load.
+ */
+
+#include "host_test.h"
+#include "filter_pipeline.h"
+#include "m3_env.h"
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+static uint32_t testCycles = 0;
+static std::string callLog;      // Plugin names, in call order
+static uint32_t slowCycles = 0;  // Cycles the "slow" plugin takes per call
+
+static uint32_t clockFn() {
+    return testCycles;
+}
+
+static uint32_t getU32(const uint8_t* p) {
+    return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static void logCall(IM3Runtime rt) {
+    FilterPlugin* plugin = (FilterPlugin*)m3_GetUserData(rt);
+    if (!callLog.empty()) callLog += ",";
+    callLog += plugin->name;
+}
+
+static M3Result viewExport(IM3Runtime rt, const int32_t* a, int32_t* r) {
+    *r = fakeWasmAlloc(rt, FILTER_VIEW_SIZE);
+    return m3Err_none;
+}
+
+// Drops messages in the "blocked" namespace
+static M3Result denyFilter(IM3Runtime rt, const int32_t* a, int32_t* r) {
+    logCall(rt);
+    uint8_t* view = fakeWasmPtr(rt, a[0], FILTER_VIEW_SIZE);
+    if (!view) return m3Err_trapOutOfBoundsMemoryAccess;
+    uint32_t nsLen = getU32(view + 12);
+    *r = nsLen == 7 && memcmp(view + 24, "blocked", 7) == 0 ? FILTER_DROP : FILTER_PASS;
+    testCycles += 100;
+    return m3Err_none;
+}
+
+// Drops messages over 100 bytes
+static M3Result capFilter(IM3Runtime rt, const int32_t* a, int32_t* r) {
+    logCall(rt);
+    uint8_t* view = fakeWasmPtr(rt, a[0], FILTER_VIEW_SIZE);
+    if (!view) return m3Err_trapOutOfBoundsMemoryAccess;
+    *r = getU32(view + 8) > 100 ? FILTER_DROP : FILTER_PASS;
+    testCycles += 50;
+    return m3Err_none;
+}
+
+static M3Result slowFilter(IM3Runtime rt, const int32_t* a, int32_t* r) {
+    logCall(rt);
+    testCycles += slowCycles;
+    *r = FILTER_DROP;
+    return m3Err_none;
+}
+
+static M3Result trapFilter(IM3Runtime rt, const int32_t* a, int32_t* r) {
+    logCall(rt);
+    *r = FILTER_DROP;
+    return m3Err_trapOutOfBoundsMemoryAccess;
+}
+
+// Allocates a page per call, so its linear memory grows
+static M3Result growFilter(IM3Runtime rt, const int32_t* a, int32_t* r) {
+    logCall(rt);
+    if (!fakeWasmAlloc(rt, 64 * 1024)) return "[trap] out of memory";
+    *r = FILTER_PASS;
+    return m3Err_none;
+}
+
+// Copies the view it was given to lastView
+static uint8_t lastView[FILTER_VIEW_SIZE];
+static M3Result copyFilter(IM3Runtime rt, const int32_t* a, int32_t* r) {
+    logCall(rt);
+    uint8_t* view = fakeWasmPtr(rt, a[0], FILTER_VIEW_SIZE);
+    if (!view) return m3Err_trapOutOfBoundsMemoryAccess;
+    memcpy(lastView, view, sizeof(lastView));
+    *r = FILTER_PASS;
+    return m3Err_none;
+}
+
+// filter_view() pointing at the last 16 bytes of memory
+static M3Result shortViewExport(IM3Runtime rt, const int32_t* a, int32_t* r) {
+    uint32_t size = 0;
+    m3_GetMemory(rt, &size, 0);
+    *r = size - 16;
+    return m3Err_none;
+}
+
+static const FakeExport denyModule[] = { { "filter_view", viewExport, 0 }, { "filter", denyFilter, 1 }, { NULL } };
+static const FakeExport capModule[] = { { "filter_view", viewExport, 0 }, { "filter", capFilter, 1 }, { NULL } };
+static const FakeExport slowModule[] = { { "filter_view", viewExport, 0 }, { "filter", slowFilter, 1 }, { NULL } };
+static const FakeExport trapModule[] = { { "filter_view", viewExport, 0 }, { "filter", trapFilter, 1 }, { NULL } };
+static const FakeExport growModule[] = { { "filter_view", viewExport, 0 }, { "filter", growFilter, 1 }, { NULL } };
+static const FakeExport copyModule[] = { { "filter_view", viewExport, 0 }, { "filter", copyFilter, 1 }, { NULL } };
+static const FakeExport shortViewModule[] = { { "filter_view", shortViewExport, 0 }, { "filter", copyFilter, 1 }, { NULL } };
+static const FakeExport noFilterModule[] = { { "filter_view", viewExport, 0 }, { NULL } };
+
+// Module bytes are the registered name; the pipeline takes ownership
+static M3Result add(FilterPipeline* pipe, const char* module, const char* name,
+                    uint32_t cycleBudget = 0, uint32_t memoryBudget = 0) {
+    return filterPipelineAdd(pipe, name, (uint8_t*)strdup(module), strlen(module), cycleBudget, memoryBudget);
+}
+
+static int run(FilterPipeline* pipe, const char* ns, size_t length, int* dropper) {
+    static uint8_t data[2048];
+    memset(data, 'm', sizeof(data));
+    FilterMessage msg = { FILTER_FROM_PEER, 3, ns, strlen(ns), "offer", 5, data, length };
+    callLog.clear();
+    return filterPipelineRun(pipe, &msg, dropper);
+}
+
+static void testChain() {
+    FilterPipeline pipe;
+    filterPipelineInit(&pipe, clockFn);
+    CHECK(add(&pipe, "deny", "deny-ns") == m3Err_none);
+    CHECK(add(&pipe, "cap", "size-cap") == m3Err_none);
+    CHECK(add(&pipe, "copy", "observer") == m3Err_none);
+    CHECK_EQ(pipe.count, 3);
+
+    int dropper = -1;
+    CHECK_EQ(run(&pipe, "global", 40, &dropper), FILTER_PASS);
+    CHECK(callLog == "deny-ns,size-cap,observer");
+    CHECK_EQ(dropper, -1);
+
+    // The first drop ends the chain
+    CHECK_EQ(run(&pipe, "blocked", 40, &dropper), FILTER_DROP);
+    CHECK(callLog == "deny-ns");
+    CHECK_EQ(dropper, 0);
+    CHECK_EQ(run(&pipe, "global", 200, &dropper), FILTER_DROP);
+    CHECK(callLog == "deny-ns,size-cap");
+    CHECK_EQ(dropper, 1);
+
+    CHECK_EQ(pipe.plugins[0].calls, 3u);
+    CHECK_EQ(pipe.plugins[0].drops, 1u);
+    CHECK_EQ(pipe.plugins[1].calls, 2u);
+    CHECK_EQ(pipe.plugins[1].drops, 1u);
+    CHECK_EQ(pipe.plugins[2].calls, 1u);
+
+    // Cycles are what the clock advanced across each call
+    CHECK_EQ(pipe.plugins[0].cycles, 300u);
+    CHECK_EQ(pipe.plugins[0].maxCycles, 100u);
+    CHECK_EQ(pipe.plugins[1].cycles, 100u);
+    CHECK_EQ(pipe.plugins[2].cycles, 0u);
+
+    filterPipelineClear(&pipe);
+    CHECK_EQ(pipe.count, 0);
+    CHECK_EQ(run(&pipe, "blocked", 40, &dropper), FILTER_PASS);
+    CHECK(callLog.empty());
+}
+
+static void testView() {
+    FilterPipeline pipe;
+    filterPipelineInit(&pipe, clockFn);
+    CHECK(add(&pipe, "copy", "observer") == m3Err_none);
+
+    int dropper = -1;
+    run(&pipe, "global", 40, &dropper);
+    CHECK_EQ(getU32(lastView + 0), FILTER_FROM_PEER);
+    CHECK_EQ(getU32(lastView + 4), 3u);
+    CHECK_EQ(getU32(lastView + 8), 40u);
+    CHECK_EQ(getU32(lastView + 12), 6u);
+    CHECK_EQ(getU32(lastView + 16), 5u);
+    CHECK_EQ(getU32(lastView + 20), 40u);
+    CHECK(memcmp(lastView + 24, "globaloffer", 11) == 0);
+    CHECK_EQ(lastView[24 + 11], 'm');
+
+    // Only what fits is copied; the length is the full one
+    run(&pipe, "global", 2000, &dropper);
+    CHECK_EQ(getU32(lastView + 8), 2000u);
+    CHECK_EQ(getU32(lastView + 20), FILTER_VIEW_SIZE - 24 - 11);
+    CHECK_EQ(lastView[FILTER_VIEW_SIZE - 1], 'm');
+    filterPipelineClear(&pipe);
+}
+
+static void testStrikes() {
+    FilterPipeline pipe;
+    filterPipelineInit(&pipe, clockFn);
+    CHECK(add(&pipe, "slow", "slow", 1000) == m3Err_none);
+    CHECK(add(&pipe, "trap", "trap") == m3Err_none);
+    CHECK(add(&pipe, "cap", "size-cap") == m3Err_none);
+
+    // Within budget the slow plugin's drop counts
+    int dropper = -1;
+    slowCycles = 1000;
+    CHECK_EQ(run(&pipe, "global", 40, &dropper), FILTER_DROP);
+    CHECK_EQ(dropper, 0);
+    CHECK_EQ(pipe.plugins[0].overruns, 0u);
+
+    // Over it, the call still decides but earns a strike
+    slowCycles = 1001;
+    for (int i = 0; i < FILTER_MAX_STRIKES; i++) {
+        CHECK(pipe.plugins[0].enabled);
+        CHECK_EQ(run(&pipe, "global", 40, &dropper), FILTER_DROP);
+    }
+    CHECK(!pipe.plugins[0].enabled);
+    CHECK_EQ(pipe.plugins[0].overruns, (uint32_t)FILTER_MAX_STRIKES);
+    CHECK_EQ(pipe.plugins[0].maxCycles, 1001u);
+    CHECK(strcmp(pipe.plugins[0].lastError, "cycle budget exceeded") == 0);
+
+    // The slow plugin is skipped; the trapping one fails open
+    for (int i = 0; i < FILTER_MAX_STRIKES; i++) {
+        CHECK_EQ(run(&pipe, "global", 40, &dropper), FILTER_PASS);
+        CHECK(callLog == "trap,size-cap");
+    }
+    CHECK(!pipe.plugins[1].enabled);
+    CHECK_EQ(pipe.plugins[1].errors, (uint32_t)FILTER_MAX_STRIKES);
+    CHECK_EQ(pipe.plugins[1].drops, 0u);
+    CHECK(strcmp(pipe.plugins[1].lastError, m3Err_trapOutOfBoundsMemoryAccess) == 0);
+
+    CHECK_EQ(run(&pipe, "global", 200, &dropper), FILTER_DROP);
+    CHECK(callLog == "size-cap");
+    CHECK_EQ(dropper, 2);
+    filterPipelineClear(&pipe);
+}
+
+static void testMemory() {
+    FilterPipeline pipe;
+    filterPipelineInit(&pipe, clockFn);
+    CHECK(add(&pipe, "grow", "grow", 0, 3 * 64 * 1024) == m3Err_none);
+    CHECK_EQ(pipe.plugins[0].memoryBudget, 3u * 64 * 1024);
+    CHECK_EQ(pipe.plugins[0].memoryBytes, 64u * 1024);
+
+    int dropper = -1;
+    run(&pipe, "global", 40, &dropper);
+    CHECK_EQ(pipe.plugins[0].memoryBytes, 2u * 64 * 1024);
+    run(&pipe, "global", 40, &dropper);
+    CHECK_EQ(pipe.plugins[0].memoryBytes, 3u * 64 * 1024);
+    CHECK_EQ(pipe.plugins[0].errors, 0u);
+
+    // Growing past the budget traps
+    CHECK_EQ(run(&pipe, "global", 40, &dropper), FILTER_PASS);
+    CHECK_EQ(pipe.plugins[0].memoryBytes, 3u * 64 * 1024);
+    CHECK_EQ(pipe.plugins[0].errors, 1u);
+    filterPipelineClear(&pipe);
+}
+
+static void testLoad() {
+    FilterPipeline pipe;
+    filterPipelineInit(&pipe, clockFn);
+    CHECK(add(&pipe, "nope", "missing") != m3Err_none);
+    CHECK(add(&pipe, "nofilter", "no-filter") == m3Err_functionLookupFailed);
+    CHECK(strcmp(add(&pipe, "shortview", "short-view"), "filter view outside plugin memory") == 0);
+    CHECK_EQ(pipe.count, 0);
+
+    for (int i = 0; i < FILTER_MAX_PLUGINS; i++) CHECK(add(&pipe, "cap", "size-cap") == m3Err_none);
+    CHECK(strcmp(add(&pipe, "cap", "one-too-many"), "filter pipeline full") == 0);
+    CHECK_EQ(pipe.count, FILTER_MAX_PLUGINS);
+
+    // Names are cut to fit
+    filterPipelineClear(&pipe);
+    CHECK(add(&pipe, "cap", "a-very-long-plugin-name") == m3Err_none);
+    CHECK_EQ(strlen(pipe.plugins[0].name), FILTER_NAME_LEN - 1u);
+    filterPipelineClear(&pipe);
+}
+
+int main() {
+    fakeWasmRegister("deny", denyModule);
+    fakeWasmRegister("cap", capModule);
+    fakeWasmRegister("slow", slowModule);
+    fakeWasmRegister("trap", trapModule);
+    fakeWasmRegister("grow", growModule);
+    fakeWasmRegister("copy", copyModule);
+    fakeWasmRegister("shortview", shortViewModule);
+    fakeWasmRegister("nofilter", noFilterModule);
+
+    testChain();
+    testView();
+    testStrikes();
+    testMemory();
+    testLoad();
+    return testResult("test_filter_pipeline");
+}
@@ -0,0 +1,239 @@
+/*
+ * PigeonHub host test - ice_coalescer.cpp
+ *
+ * A burst of trickled candidates goes out as the first one alone and then
+ * one merged "ice-candidates" array. Queued candidates are flushed ahead of
+ * any other frame for the pair, when the window expires, and when a pair
+ * reaches ICE_BATCH_MAX or ICE_BATCH_BYTES. Pairs beyond ICE_BATCH_SLOTS are
+ * not batched; dropped connections lose their queue.
+ */
+
+#include "host_test.h"
+#include "ice_coalescer.h"
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define WINDOW_MS  20
+
+struct Sent {
+    uint8_t to;
+    uint8_t type;
+    std::string blob;
+    uint64_t timestamp;
+};
+
+static std::vector<Sent> sent;
+
+static void flush(uint8_t to, const WireMsg* msg) {
+    sent.push_back({to, msg->type, std::string((const char*)msg->blob, msg->blobLen), msg->timestamp});
+    CHECK(msg->flags & WIRE_FLAG_FROM);
+    CHECK(msg->flags & WIRE_FLAG_TARGET);
+    CHECK(msg->nsLen == 6 && memcmp(msg->ns, "global", 6) == 0);
+}
+
+static std::string blobs[64];
+
+static WireMsg candidate(int n, int from = 1) {
+    WireMsg msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.type = WIRE_ICE_CANDIDATE;
+    msg.flags = WIRE_FLAG_FROM | WIRE_FLAG_TARGET;
+    msg.timestamp = 1000 + n;
+    memset(msg.from, from, WIRE_PEER_ID_LEN);
+    memset(msg.target, 0xEE, WIRE_PEER_ID_LEN);
+    msg.ns = "global";
+    msg.nsLen = 6;
+    blobs[n] = "{\"candidate\":\"c" + std::to_string(n) + "\"}";
+    msg.blob = (const uint8_t*)blobs[n].data();
+    msg.blobLen = blobs[n].size();
+    return msg;
+}
+
+static void setup(IceCoalescer* ice) {
+    iceCoalescerInit(ice, WINDOW_MS, flush);
+    sent.clear();
+}
+
+static void testBatching() {
+    IceCoalescer ice;
+    setup(&ice);
+    WireMsg msg = candidate(0);
+    CHECK(!iceCoalescerOffer(&ice, 3, &msg, 100));  // First: the caller sends it
+    for (int i = 1; i <= 3; i++) {
+        msg = candidate(i);
+        CHECK(iceCoalescerOffer(&ice, 3, &msg, 100 + i));
+    }
+    CHECK(sent.empty());
+
+    iceCoalescerPoll(&ice, 100 + WINDOW_MS - 1);
+    CHECK(sent.empty());
+    iceCoalescerPoll(&ice, 100 + WINDOW_MS);
+    CHECK_EQ(sent.size(), 1u);
+    CHECK_EQ(sent[0].to, 3);
+    CHECK_EQ(sent[0].type, WIRE_ICE_CANDIDATES);
+    CHECK(sent[0].blob == "[" + blobs[1] + "," + blobs[2] + "," + blobs[3] + "]");
+    CHECK_EQ(sent[0].timestamp, 1003u);
+    CHECK_EQ(ice.candidates, 4u);
+    CHECK_EQ(ice.merged, 3u);
+    CHECK_EQ(ice.messages, 1u);
+
+    // The window is closed: the next candidate opens a new one
+    msg = candidate(4);
+    CHECK(!iceCoalescerOffer(&ice, 3, &msg, 200));
+
+    // A window with a single queued candidate sends it as a plain one
+    msg = candidate(5);
+    CHECK(iceCoalescerOffer(&ice, 3, &msg, 201));
+    iceCoalescerPoll(&ice, 200 + WINDOW_MS);
+    CHECK_EQ(sent.size(), 2u);
+    CHECK_EQ(sent[1].type, WIRE_ICE_CANDIDATE);
+    CHECK(sent[1].blob == blobs[5]);
+}
+
+static void testNonIceFlushes() {
+    IceCoalescer ice;
+    setup(&ice);
+    WireMsg msg = candidate(0);
+    iceCoalescerOffer(&ice, 3, &msg, 100);
+    msg = candidate(1);
+    CHECK(iceCoalescerOffer(&ice, 3, &msg, 101));
+    msg = candidate(2);
+    CHECK(iceCoalescerOffer(&ice, 3, &msg, 102));
+
+    // An answer for the same pair must not overtake them
+    WireMsg answer = candidate(3);
+    answer.type = WIRE_ANSWER;
+    CHECK(!iceCoalescerOffer(&ice, 3, &answer, 103));
+    CHECK_EQ(sent.size(), 1u);
+    CHECK(sent[0].blob == "[" + blobs[1] + "," + blobs[2] + "]");
+
+    // Verbatim JSON candidates can't be merged either
+    msg = candidate(4);
+    iceCoalescerOffer(&ice, 3, &msg, 104);
+    msg = candidate(5);
+    CHECK(iceCoalescerOffer(&ice, 3, &msg, 105));
+    WireMsg raw = candidate(6);
+    raw.flags |= WIRE_FLAG_RAW;
+    CHECK(!iceCoalescerOffer(&ice, 3, &raw, 106));
+    CHECK_EQ(sent.size(), 2u);
+
+    // A frame streamed around the coalescer flushes explicitly
+    msg = candidate(7);
+    iceCoalescerOffer(&ice, 3, &msg, 107);
+    msg = candidate(8);
+    CHECK(iceCoalescerOffer(&ice, 3, &msg, 108));
+    iceCoalescerFlush(&ice, 3, msg.from);
+    CHECK_EQ(sent.size(), 3u);
+    CHECK_EQ(sent[2].type, WIRE_ICE_CANDIDATE);
+
+    // Another sender's frames leave the pair alone
+    msg = candidate(9);
+    iceCoalescerOffer(&ice, 3, &msg, 110);
+    msg = candidate(10);
+    CHECK(iceCoalescerOffer(&ice, 3, &msg, 111));
+    WireMsg other = candidate(11, 2);
+    other.type = WIRE_OFFER;
+    CHECK(!iceCoalescerOffer(&ice, 3, &other, 112));
+    CHECK_EQ(sent.size(), 3u);
+}
+
+static void testTimeout() {
+    IceCoalescer ice;
+    setup(&ice);
+    WireMsg msg = candidate(0);
+    iceCoalescerOffer(&ice, 3, &msg, 100);
+    msg = candidate(1);
+    CHECK(iceCoalescerOffer(&ice, 3, &msg, 110));
+
+    // A candidate after the window closes sends the queue first and goes
+    // out itself, opening a new window
+    msg = candidate(2);
+    CHECK(!iceCoalescerOffer(&ice, 3, &msg, 100 + WINDOW_MS));
+    CHECK_EQ(sent.size(), 1u);
+    CHECK(sent[0].blob == blobs[1]);
+    msg = candidate(3);
+    CHECK(iceCoalescerOffer(&ice, 3, &msg, 100 + WINDOW_MS + 1));
+
+    // Across a wrap of the millisecond clock
+    setup(&ice);
+    msg = candidate(0);
+    iceCoalescerOffer(&ice, 3, &msg, 0xFFFFFFF0u);
+    msg = candidate(1);
+    CHECK(iceCoalescerOffer(&ice, 3, &msg, 0xFFFFFFF8u));
+    iceCoalescerPoll(&ice, 2);
+    CHECK(sent.empty());
+    iceCoalescerPoll(&ice, 0xFFFFFFF0u + WINDOW_MS);
+    CHECK_EQ(sent.size(), 1u);
+}
+
+static void testPerPairLimits() {
+    IceCoalescer ice;
+    setup(&ice);
+    WireMsg msg = candidate(0);
+    iceCoalescerOffer(&ice, 3, &msg, 100);
+    for (int i = 1; i <= ICE_BATCH_MAX; i++) {
+        msg = candidate(i);
+        CHECK(iceCoalescerOffer(&ice, 3, &msg, 101));
+    }
+    // ICE_BATCH_MAX queued: sent at once, the window stays open
+    CHECK_EQ(sent.size(), 1u);
+    CHECK_EQ(ice.merged, (uint32_t)ICE_BATCH_MAX);
+    msg = candidate(ICE_BATCH_MAX + 1);
+    CHECK(iceCoalescerOffer(&ice, 3, &msg, 102));
+
+    // Data past ICE_BATCH_BYTES: what is queued goes first
+    setup(&ice);
+    std::string big(ICE_BATCH_BYTES / 2, 'x');
+    msg = candidate(0);
+    iceCoalescerOffer(&ice, 4, &msg, 100);
+    msg = candidate(1);
+    msg.blob = (const uint8_t*)big.data();
+    msg.blobLen = big.size();
+    CHECK(iceCoalescerOffer(&ice, 4, &msg, 101));
+    CHECK(iceCoalescerOffer(&ice, 4, &msg, 102));
+    CHECK_EQ(sent.size(), 1u);
+    CHECK(sent[0].blob == big);
+    CHECK_EQ(sent[0].type, WIRE_ICE_CANDIDATE);
+
+    // One that could never fit is sent on its own
+    std::string huge(ICE_BATCH_BYTES, 'y');
+    msg.blob = (const uint8_t*)huge.data();
+    msg.blobLen = huge.size();
+    CHECK(!iceCoalescerOffer(&ice, 4, &msg, 103));
+    CHECK_EQ(sent.size(), 2u);
+}
+
+static void testSlots() {
+    IceCoalescer ice;
+    setup(&ice);
+    WireMsg msg;
+    for (int i = 0; i < ICE_BATCH_SLOTS; i++) {
+        msg = candidate(0, 10 + i);
+        iceCoalescerOffer(&ice, 3, &msg, 100);
+    }
+    // Every window is taken: another pair isn't batched
+    msg = candidate(0, 99);
+    CHECK(!iceCoalescerOffer(&ice, 3, &msg, 101));
+    CHECK(!iceCoalescerOffer(&ice, 3, &msg, 102));
+    msg = candidate(1, 10);
+    CHECK(iceCoalescerOffer(&ice, 3, &msg, 103));
+
+    // A closed connection's queue is discarded, and frees its windows
+    iceCoalescerDrop(&ice, 3);
+    iceCoalescerPoll(&ice, 1000);
+    CHECK(sent.empty());
+    msg = candidate(2, 99);
+    CHECK(!iceCoalescerOffer(&ice, 3, &msg, 1001));
+    msg = candidate(3, 99);
+    CHECK(iceCoalescerOffer(&ice, 3, &msg, 1002));
+}
+
+int main() {
+    testBatching();
+    testNonIceFlushes();
+    testTimeout();
+    testPerPairLimits();
+    testSlots();
+    return testResult("test_ice_coalescer");
+}
@@ -0,0 +1,241 @@
+/*
+ * PigeonHub host test - mem_policy.cpp
+ *
+ * Runs the placement policy against a simulated two-tier heap (a capacity
+ * per tier on top of malloc): HOT/BULK placement, behaviour without PSRAM
+ * and with PSRAM full, realloc moving blocks between tiers, the placement
+ * statistics, and the counters staying exact under concurrent use. A
+ * simulated hub load reports internal RAM with and without PSRAM.
+ */
+
+#include "host_test.h"
+#include "mem_policy.h"
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+#define BULK_MIN 256  // MEM_BULK_MIN in main.cpp
+
+struct SimBlock {
+    size_t size;
+    uint8_t tier;
+    uint8_t pad[7];
+};
+
+static size_t simCap[MEM_TIER_COUNT];
+static size_t simUsed[MEM_TIER_COUNT];
+
+static void* simAlloc(uint8_t tier, size_t size) {
+    size_t used = __atomic_load_n(&simUsed[tier], __ATOMIC_RELAXED);
+    do {
+        if (size > simCap[tier] - used) return NULL;
+    } while (!__atomic_compare_exchange_n(&simUsed[tier], &used, used + size, true,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    SimBlock* b = (SimBlock*)malloc(sizeof(SimBlock) + size);
+    b->size = size;
+    b->tier = tier;
+    return b + 1;
+}
+
+static void simRelease(void* p) {
+    SimBlock* b = (SimBlock*)p - 1;
+    __atomic_sub_fetch(&simUsed[b->tier], b->size, __ATOMIC_RELAXED);
+    free(b);
+}
+
+static const MemBackend simBackend = { simAlloc, simRelease };
+
+static void simReset(size_t internal, size_t psram) {
+    simCap[MEM_INTERNAL] = internal;
+    simCap[MEM_PSRAM] = psram;
+    simUsed[MEM_INTERNAL] = simUsed[MEM_PSRAM] = 0;
+}
+
+static void testPlacement() {
+    MemPolicy policy;
+    simReset(64 * 1024, 1024 * 1024);
+    memPolicyInit(&policy, &simBackend, true, BULK_MIN);
+
+    void* hot = memAlloc(&policy, MEM_HOT, 4096);
+    void* bulk = memAlloc(&policy, MEM_BULK, 4096);
+    void* smallBulk = memAlloc(&policy, MEM_BULK, BULK_MIN - 1);
+    void* edgeBulk = memAlloc(&policy, MEM_BULK, BULK_MIN);
+    CHECK_EQ(memTierOf(hot), MEM_INTERNAL);
+    CHECK_EQ(memTierOf(bulk), MEM_PSRAM);
+    CHECK_EQ(memTierOf(smallBulk), MEM_INTERNAL);
+    CHECK_EQ(memTierOf(edgeBulk), MEM_PSRAM);
+    CHECK_EQ((uintptr_t)bulk % 8, 0);
+
+    CHECK_EQ(policy.tiers[MEM_INTERNAL].allocs, 2);
+    CHECK_EQ(policy.tiers[MEM_PSRAM].allocs, 2);
+    CHECK_EQ(policy.tiers[MEM_INTERNAL].bytes, 4096 + BULK_MIN - 1);
+    CHECK_EQ(policy.tiers[MEM_PSRAM].bytes, 4096 + BULK_MIN);
+    CHECK_EQ(policy.fallbacks, 0);
+
+    memFree(&policy, bulk);
+    memFree(&policy, hot);
+    CHECK_EQ(policy.tiers[MEM_PSRAM].frees, 1);
+    CHECK_EQ(policy.tiers[MEM_PSRAM].bytes, BULK_MIN);
+    CHECK_EQ(policy.tiers[MEM_PSRAM].highWater, 4096 + BULK_MIN);
+    CHECK_EQ(policy.tiers[MEM_INTERNAL].highWater, 4096 + BULK_MIN - 1);
+    memFree(&policy, smallBulk);
+    memFree(&policy, edgeBulk);
+    memFree(&policy, NULL);
+    CHECK_EQ(policy.tiers[MEM_INTERNAL].bytes, 0);
+    CHECK_EQ(policy.tiers[MEM_PSRAM].bytes, 0);
+    CHECK_EQ(simUsed[MEM_INTERNAL] + simUsed[MEM_PSRAM], 0);
+}
+
+static void testNoPsram() {
+    MemPolicy policy;
+    simReset(64 * 1024, 0);
+    memPolicyInit(&policy, &simBackend, false, BULK_MIN);
+
+    void* bulk = memAlloc(&policy, MEM_BULK, 16 * 1024);
+    CHECK(bulk != NULL);
+    CHECK_EQ(memTierOf(bulk), MEM_INTERNAL);
+    // PSRAM is never tried, so nothing counts as a failure or fallback
+    CHECK_EQ(policy.tiers[MEM_PSRAM].failures, 0);
+    CHECK_EQ(policy.fallbacks, 0);
+    memFree(&policy, bulk);
+}
+
+static void testPsramFull() {
+    MemPolicy policy;
+    simReset(64 * 1024, 32 * 1024);
+    memPolicyInit(&policy, &simBackend, true, BULK_MIN);
+
+    void* a = memAlloc(&policy, MEM_BULK, 20 * 1024);
+    void* b = memAlloc(&policy, MEM_BULK, 20 * 1024);
+    CHECK_EQ(memTierOf(a), MEM_PSRAM);
+    CHECK_EQ(memTierOf(b), MEM_INTERNAL);
+    CHECK_EQ(policy.tiers[MEM_PSRAM].failures, 1);
+    CHECK_EQ(policy.fallbacks, 1);
+
+    // Both tiers exhausted
+    void* c = memAlloc(&policy, MEM_BULK, 60 * 1024);
+    CHECK(c == NULL);
+    CHECK_EQ(policy.tiers[MEM_PSRAM].failures, 2);
+    CHECK_EQ(policy.tiers[MEM_INTERNAL].failures, 1);
+    CHECK_EQ(policy.fallbacks, 2);
+
+    // HOT never spills into PSRAM, even when internal RAM is short
+    void* hot = memAlloc(&policy, MEM_HOT, 50 * 1024);
+    CHECK(hot == NULL);
+    CHECK_EQ(policy.tiers[MEM_PSRAM].failures, 2);
+
+    memFree(&policy, a);
+    memFree(&policy, b);
+}
+
+static void testCallocRealloc() {
+    MemPolicy policy;
+    simReset(64 * 1024, 1024 * 1024);
+    memPolicyInit(&policy, &simBackend, true, BULK_MIN);
+
+    uint8_t* z = (uint8_t*)memCalloc(&policy, MEM_HOT, 16, 8);
+    bool zeroed = true;
+    for (int i = 0; i < 128; i++) zeroed = zeroed && z[i] == 0;
+    CHECK(zeroed);
+    CHECK(memCalloc(&policy, MEM_HOT, SIZE_MAX / 2, 4) == NULL);
+    memFree(&policy, z);
+
+    // A growing upload buffer starts internal and moves to PSRAM
+    char* buf = (char*)memRealloc(&policy, NULL, MEM_BULK, 64);
+    CHECK_EQ(memTierOf(buf), MEM_INTERNAL);
+    strcpy(buf, "upload");
+    buf = (char*)memRealloc(&policy, buf, MEM_BULK, 4096);
+    CHECK_EQ(memTierOf(buf), MEM_PSRAM);
+    CHECK(strcmp(buf, "upload") == 0);
+
+    // Small shrinks stay in place; large ones give the memory back
+    char* same = (char*)memRealloc(&policy, buf, MEM_BULK, 4096 - 100);
+    CHECK(same == buf);
+    char* shrunk = (char*)memRealloc(&policy, same, MEM_BULK, 100);
+    CHECK(shrunk != same);
+    CHECK_EQ(memTierOf(shrunk), MEM_INTERNAL);
+    CHECK(strcmp(shrunk, "upload") == 0);
+    CHECK(memRealloc(&policy, shrunk, MEM_BULK, 0) == NULL);
+
+    CHECK_EQ(policy.tiers[MEM_INTERNAL].bytes, 0);
+    CHECK_EQ(policy.tiers[MEM_PSRAM].bytes, 0);
+    CHECK_EQ(policy.tiers[MEM_INTERNAL].allocs, policy.tiers[MEM_INTERNAL].frees);
+    CHECK_EQ(policy.tiers[MEM_PSRAM].allocs, policy.tiers[MEM_PSRAM].frees);
+}
+
+// mbedTLS allocates from other tasks; the counters must not lose updates
+static void testConcurrentStats() {
+    MemPolicy policy;
+    simReset(SIZE_MAX, SIZE_MAX);
+    memPolicyInit(&policy, &simBackend, true, BULK_MIN);
+
+    const int threads = 4;
+    const int rounds = 50000;
+    std::thread workers[threads];
+    for (int t = 0; t < threads; t++) {
+        workers[t] = std::thread([&policy, t]() {
+            for (int i = 0; i < rounds; i++) {
+                void* p = memAlloc(&policy, (i + t) & 1 ? MEM_BULK : MEM_HOT, 64 + (i % 1024));
+                memFree(&policy, p);
+            }
+        });
+    }
+    for (int t = 0; t < threads; t++) workers[t].join();
+
+    uint32_t allocs = policy.tiers[MEM_INTERNAL].allocs + policy.tiers[MEM_PSRAM].allocs;
+    uint32_t frees = policy.tiers[MEM_INTERNAL].frees + policy.tiers[MEM_PSRAM].frees;
+    CHECK_EQ(allocs, threads * rounds);
+    CHECK_EQ(frees, threads * rounds);
+    CHECK_EQ(policy.tiers[MEM_INTERNAL].bytes, 0);
+    CHECK_EQ(policy.tiers[MEM_PSRAM].bytes, 0);
+    CHECK(policy.tiers[MEM_PSRAM].highWater >= BULK_MIN);
+}
+
+// 20 TLS peers: a connection record and parse state (HOT), plus TLS record
+// buffers and a send queue (BULK) each. Reports where the bytes land.
+static void simulateHubLoad(bool psram) {
+    MemPolicy policy;
+    simReset(320 * 1024, psram ? 2 * 1024 * 1024 : 0);
+    memPolicyInit(&policy, &simBackend, psram, BULK_MIN);
+
+    const int peers = 20;
+    void* blocks[peers][4];
+    int placed = 0;
+    for (int i = 0; i < peers; i++) {
+        blocks[i][0] = memAlloc(&policy, MEM_HOT, 192);        // Connection record
+        blocks[i][1] = memAlloc(&policy, MEM_HOT, 96);         // Parse state
+        blocks[i][2] = memAlloc(&policy, MEM_BULK, 16 * 1024 + 325);  // TLS in record
+        blocks[i][3] = memAlloc(&policy, MEM_BULK, 4 * 1024);  // TLS out record / send queue
+        for (int k = 0; k < 4; k++) placed += blocks[i][k] != NULL;
+    }
+
+    BENCH("%-11s %2d peers: internal %6zu B, PSRAM %7zu B, %d/%d blocks placed, %u fallbacks\n",
+          psram ? "with PSRAM" : "no PSRAM", peers,
+          policy.tiers[MEM_INTERNAL].highWater, policy.tiers[MEM_PSRAM].highWater,
+          placed, peers * 4, policy.fallbacks);
+
+    if (psram) {
+        CHECK_EQ(placed, peers * 4);
+        CHECK_EQ(policy.tiers[MEM_INTERNAL].highWater, peers * (192 + 96));
+    } else {
+        // 320 KB of internal RAM can't hold 20 sets of TLS buffers
+        CHECK(placed < peers * 4);
+        CHECK(policy.tiers[MEM_INTERNAL].failures > 0);
+    }
+
+    for (int i = 0; i < peers; i++) {
+        for (int k = 0; k < 4; k++) memFree(&policy, blocks[i][k]);
+    }
+    CHECK_EQ(policy.tiers[MEM_INTERNAL].bytes + policy.tiers[MEM_PSRAM].bytes, 0);
+}
+
+int main() {
+    testPlacement();
+    testNoPsram();
+    testPsramFull();
+    testCallocRealloc();
+    testConcurrentStats();
+    simulateHubLoad(true);
+    simulateHubLoad(false);
+    return testResult("test_mem_policy");
+}
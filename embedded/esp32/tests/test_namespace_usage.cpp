@@ -0,0 +1,147 @@
+/*
+ * PigeonHub host test - namespace_usage.cpp
+ *
+ * Per-slot accounting by direction and wire type, top-N ranking (ties, N
+ * past the number of named slots, every rank), and a slot handed to a new
+ * name after eviction starting from zero, as acquireNamespace() in main.cpp
+ * drives it.
+ */
+
+#include "host_test.h"
+#include "namespace_usage.h"
+#include <string.h>
+#include <set>
+
+static NamespaceTable table;
+static NamespaceUsage usage;
+
+// acquireNamespace() in main.cpp
+static int acquire(const char* name, uint32_t now) {
+    bool known = nsFind(&table, name, strlen(name)) != NAMESPACE_NONE;
+    int id = nsAcquire(&table, name, strlen(name), now);
+    if (id != NAMESPACE_NONE && !known) nsUsageReset(&usage, id, now);
+    return id;
+}
+
+static void reset() {
+    nsInit(&table);
+    nsUsageInit(&usage);
+}
+
+static void testAccounting() {
+    reset();
+    int a = acquire("alpha", 100);
+    int b = acquire("beta", 200);
+    CHECK(a != b);
+    CHECK_EQ(usage.ns[a].sinceMs, 100u);
+
+    nsUsageFrame(&usage, a, NS_FROM_PEER, WIRE_OFFER, 300);
+    nsUsageFrame(&usage, a, NS_FROM_PEER, WIRE_OFFER, 200);
+    nsUsageFrame(&usage, a, NS_TO_UPLINK, WIRE_ANSWER, 50);
+    nsUsageBytes(&usage, a, NS_TO_UPLINK, 1000);  // Rest of a streamed frame
+    nsUsageFrame(&usage, b, NS_TO_PEER, 250, 10);  // Unknown type counts as other
+    nsUsageFrame(&usage, a, NS_DIRECTION_COUNT, WIRE_OFFER, 10);
+    nsUsageFrame(&usage, NAMESPACE_NONE, NS_FROM_PEER, WIRE_OFFER, 10);
+    nsUsageJoin(&usage, a, 3);
+    nsUsageJoin(&usage, a, 2);
+    nsUsageRelayMiss(&usage, a);
+    nsUsageIntroductions(&usage, a, 6);
+
+    const NsUsage* ns = &usage.ns[a];
+    CHECK_EQ(ns->frames[NS_FROM_PEER][WIRE_OFFER], 2u);
+    CHECK_EQ(ns->bytes[NS_FROM_PEER], 500u);
+    CHECK_EQ(nsUsageFrames(ns, NS_TO_UPLINK), 1u);
+    CHECK_EQ(ns->bytes[NS_TO_UPLINK], 1050u);
+    CHECK_EQ(nsUsageFrames(ns, NS_TO_PEER), 0u);
+    CHECK_EQ(ns->joins, 2u);
+    CHECK_EQ(ns->peersMax, 3u);
+    CHECK_EQ(ns->relayMisses, 1u);
+    CHECK_EQ(ns->introductions, 6u);
+
+    CHECK_EQ(usage.ns[b].frames[NS_TO_PEER][WIRE_OTHER], 1u);
+    CHECK_EQ(usage.ns[b].bytes[NS_TO_PEER], 10u);
+    CHECK_EQ(nsUsageFrames(&usage.ns[b], NS_FROM_PEER), 0u);
+}
+
+static void testTop() {
+    reset();
+    int ids[NAMESPACE_MAX + 4];
+    CHECK_EQ(nsUsageTop(&usage, &table, NS_RANK_BYTES, ids, 5), 0);
+
+    int a = acquire("a", 1), b = acquire("b", 2), c = acquire("c", 3), d = acquire("d", 4);
+    nsUsageFrame(&usage, a, NS_FROM_PEER, WIRE_OFFER, 100);
+    nsUsageFrame(&usage, b, NS_FROM_PEER, WIRE_OFFER, 400);
+    nsUsageFrame(&usage, c, NS_TO_PEER, WIRE_OFFER, 400);  // Ties with b
+    for (int i = 0; i < 5; i++) nsUsageFrame(&usage, d, NS_FROM_PEER, WIRE_ICE_CANDIDATE, 10);
+    acquire("c", 5);
+    acquire("c", 6);
+    acquire("a", 7);
+
+    // N past the named slots: all four, highest first
+    int n = nsUsageTop(&usage, &table, NS_RANK_BYTES, ids, NAMESPACE_MAX + 4);
+    CHECK_EQ(n, 4);
+    CHECK(std::set<int>({ids[0], ids[1]}) == std::set<int>({b, c}));
+    CHECK_EQ(ids[2], a);
+    CHECK_EQ(ids[3], d);
+
+    // A tie that fits is reported whole; one that doesn't gives either
+    n = nsUsageTop(&usage, &table, NS_RANK_BYTES, ids, 2);
+    CHECK_EQ(n, 2);
+    CHECK(std::set<int>({ids[0], ids[1]}) == std::set<int>({b, c}));
+    n = nsUsageTop(&usage, &table, NS_RANK_BYTES, ids, 1);
+    CHECK_EQ(n, 1);
+    CHECK(ids[0] == b || ids[0] == c);
+
+    n = nsUsageTop(&usage, &table, NS_RANK_FRAMES, ids, 1);
+    CHECK_EQ(n, 1);
+    CHECK_EQ(ids[0], d);
+
+    n = nsUsageTop(&usage, &table, NS_RANK_PEERS, ids, 2);
+    CHECK_EQ(n, 2);
+    CHECK_EQ(ids[0], c);
+    CHECK_EQ(ids[1], a);
+}
+
+static void testEvictedSlot() {
+    reset();
+    int ids[NAMESPACE_MAX];
+    char name[8];
+    for (int i = 0; i < NAMESPACE_MAX; i++) {
+        snprintf(name, sizeof(name), "ns%d", i);
+        int id = acquire(name, 10 + i);
+        CHECK_EQ(id, i);
+        nsUsageFrame(&usage, id, NS_FROM_PEER, WIRE_OFFER, 1000 + i);
+        nsUsageJoin(&usage, id, 1);
+    }
+    CHECK_EQ(acquire("late", 100), NAMESPACE_NONE);
+
+    // ns3 and ns7 empty out; ns3 was used least recently, so it goes first
+    nsRelease(&table, 7);
+    nsRelease(&table, 3);
+    int late = acquire("late", 200);
+    CHECK_EQ(late, 3);
+    const NsUsage* ns = &usage.ns[late];
+    CHECK_EQ(ns->sinceMs, 200u);
+    CHECK_EQ(ns->bytes[NS_FROM_PEER], 0u);
+    CHECK_EQ(ns->joins, 0u);
+    CHECK_EQ(usage.ns[7].bytes[NS_FROM_PEER], 1007u);
+
+    // A name coming back to its own cached slot keeps counting
+    int again = acquire("ns7", 300);
+    CHECK_EQ(again, 7);
+    CHECK_EQ(usage.ns[7].bytes[NS_FROM_PEER], 1007u);
+
+    nsUsageFrame(&usage, late, NS_FROM_PEER, WIRE_OFFER, 5000);
+    int n = nsUsageTop(&usage, &table, NS_RANK_BYTES, ids, 3);
+    CHECK_EQ(n, 3);
+    CHECK_EQ(ids[0], late);
+    CHECK_EQ(ids[1], NAMESPACE_MAX - 1);
+    CHECK(strcmp(nsName(&table, ids[0]), "late") == 0);
+}
+
+int main() {
+    testAccounting();
+    testTop();
+    testEvictedSlot();
+    return testResult("test_namespace_usage");
+}
@@ -0,0 +1,146 @@
+/*
+ * PigeonHub host test - peer_directory.cpp
+ *
+ * Random put/get/remove sequences checked against std::map after every
+ * operation, with SHA-1-like IDs and with IDs crafted to share a home slot
+ * (long probe runs that wrap around the table). The benchmark compares a
+ * lookup with the connection-table scan it replaced.
+ */
+
+#include "host_test.h"
+#include "peer_directory.h"
+#include <array>
+#include <map>
+#include <random>
+#include <string.h>
+#include <vector>
+
+typedef std::array<uint8_t, WIRE_PEER_ID_LEN> PeerId;
+
+static PeerId randomId(std::mt19937& rng, bool colliding) {
+    PeerId id;
+    for (auto& b : id) b = (uint8_t)rng();
+    if (colliding) {
+        // Only 4 home slots, all near the end of the table, so runs wrap
+        id[0] = (uint8_t)(PEER_DIR_SLOTS - 1 - (rng() & 3));
+        id[1] = id[2] = id[3] = 0;
+    }
+    return id;
+}
+
+// Every mapping in the model is found, and the counts agree
+static bool matchesModel(PeerDirectory* dir, const std::map<PeerId, uint8_t>& model) {
+    if (dir->count != model.size()) return false;
+    for (const auto& entry : model) {
+        if (peerDirGet(dir, entry.first.data()) != entry.second) return false;
+    }
+    return true;
+}
+
+static void fuzz(uint32_t seed, bool colliding, int ops) {
+    std::mt19937 rng(seed);
+    PeerDirectory dir;
+    peerDirInit(&dir);
+    std::map<PeerId, uint8_t> model;
+    std::vector<PeerId> known;  // IDs seen so far, so operations hit existing keys
+    int mismatches = 0;
+
+    for (int op = 0; op < ops; op++) {
+        bool reuse = !known.empty() && rng() % 3 != 0;
+        PeerId id = reuse ? known[rng() % known.size()] : randomId(rng, colliding);
+        if (!reuse) known.push_back(id);
+        uint8_t owner = (uint8_t)(rng() % 24);
+
+        switch (rng() % 3) {
+        case 0: {
+            bool full = model.size() >= PEER_DIR_SLOTS - 1 && !model.count(id);
+            bool ok = peerDirPut(&dir, id.data(), owner);
+            if (ok == full) mismatches++;
+            if (ok) model[id] = owner;
+            break;
+        }
+        case 1: {
+            auto it = model.find(id);
+            uint8_t expected = it == model.end() ? PEER_DIR_NONE : it->second;
+            if (peerDirGet(&dir, id.data()) != expected) mismatches++;
+            break;
+        }
+        case 2: {
+            // Half the removes name the current owner, half a stale one
+            auto it = model.find(id);
+            if (it != model.end() && rng() & 1) owner = it->second;
+            peerDirRemove(&dir, id.data(), owner);
+            if (it != model.end() && it->second == owner) model.erase(it);
+            break;
+        }
+        }
+        if (!matchesModel(&dir, model)) mismatches++;
+    }
+    CHECK_EQ(mismatches, 0);
+    // Exactly one slot must stay empty so probes terminate
+    CHECK(dir.count <= PEER_DIR_SLOTS - 1);
+}
+
+static void testBasics() {
+    PeerDirectory dir;
+    peerDirInit(&dir);
+    std::mt19937 rng(1);
+    PeerId a = randomId(rng, false), b = randomId(rng, false);
+
+    CHECK_EQ(peerDirGet(&dir, a.data()), PEER_DIR_NONE);
+    CHECK(peerDirPut(&dir, a.data(), 3));
+    CHECK(peerDirPut(&dir, a.data(), 5));  // A reconnect takes the ID over
+    CHECK_EQ(dir.count, 1);
+    CHECK_EQ(peerDirGet(&dir, a.data()), 5);
+
+    peerDirRemove(&dir, a.data(), 3);  // The old connection closing is ignored
+    CHECK_EQ(peerDirGet(&dir, a.data()), 5);
+    peerDirRemove(&dir, a.data(), 5);
+    CHECK_EQ(peerDirGet(&dir, a.data()), PEER_DIR_NONE);
+    peerDirRemove(&dir, b.data(), 1);  // Absent
+    CHECK_EQ(dir.count, 0);
+
+    CHECK_EQ(dir.lookups, 4);
+    CHECK_EQ(dir.hits, 2);
+    CHECK(dir.probes >= dir.lookups);
+}
+
+static void bench() {
+    const int peers = 24;  // MAX_CONNECTIONS on a PSRAM board
+    std::mt19937 rng(7);
+    PeerDirectory dir;
+    peerDirInit(&dir);
+    PeerId ids[peers];
+    for (int i = 0; i < peers; i++) {
+        ids[i] = randomId(rng, false);
+        peerDirPut(&dir, ids[i].data(), (uint8_t)i);
+    }
+
+    const int rounds = 2000000;
+    volatile unsigned sink = 0;
+    uint64_t t0 = testNowNs();
+    for (int r = 0; r < rounds; r++) sink += peerDirGet(&dir, ids[r % peers].data());
+    uint64_t t1 = testNowNs();
+    for (int r = 0; r < rounds; r++) {
+        const uint8_t* want = ids[r % peers].data();
+        for (int i = 0; i < peers; i++) {
+            if (memcmp(ids[i].data(), want, WIRE_PEER_ID_LEN) == 0) {
+                sink += i;
+                break;
+            }
+        }
+    }
+    uint64_t t2 = testNowNs();
+    BENCH("%d peers: directory lookup %.1f ns (%.2f probes), table scan %.1f ns\n", peers,
+          (double)(t1 - t0) / rounds, (double)dir.probes / dir.lookups, (double)(t2 - t1) / rounds);
+}
+
+int main() {
+    testBasics();
+    for (uint32_t seed = 1; seed <= 20; seed++) {
+        fuzz(seed, false, 5000);
+        fuzz(seed, true, 5000);
+    }
+    bench();
+    return testResult("test_peer_directory");
+}
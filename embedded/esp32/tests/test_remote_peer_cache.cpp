@@ -0,0 +1,165 @@
+/*
+ * PigeonHub host test - remote_peer_cache.cpp
+ *
+ * TTL expiry, eviction of the oldest entry once all REMOTE_CACHE_SLOTS are
+ * taken, removal by peer ID across namespaces, the served/stale counters,
+ * and two namespace names with the same FNV-1a hash (which the cache can't
+ * tell apart, by design).
+ */
+
+#include "host_test.h"
+#include "remote_peer_cache.h"
+#include <string.h>
+
+#define TTL_MS  120000
+
+static const char DATA[] = "{\"peerId\":\"0a1b2c3d4e5f60718293a4b5c6d7e8f901234567\",\"isHub\":false}";
+
+static void makeId(uint8_t id[REMOTE_CACHE_ID_LEN], int n) {
+    memset(id, 0, REMOTE_CACHE_ID_LEN);
+    id[0] = (uint8_t)n;
+    id[REMOTE_CACHE_ID_LEN - 1] = (uint8_t)(n >> 8);
+}
+
+static bool put(RemotePeerCache* cache, const char* ns, int n, uint32_t now) {
+    uint8_t id[REMOTE_CACHE_ID_LEN];
+    makeId(id, n);
+    return remoteCachePut(cache, ns, strlen(ns), id, 0, DATA, strlen(DATA), now);
+}
+
+static int collect(RemotePeerCache* cache, const char* ns, uint32_t now, RemotePeer** out) {
+    return remoteCacheCollect(cache, ns, strlen(ns), now, out, REMOTE_CACHE_SLOTS);
+}
+
+static bool holds(RemotePeerCache* cache, const char* ns, int n, uint32_t now) {
+    RemotePeer* found[REMOTE_CACHE_SLOTS];
+    uint8_t id[REMOTE_CACHE_ID_LEN];
+    makeId(id, n);
+    int count = collect(cache, ns, now, found);
+    for (int i = 0; i < count; i++) {
+        if (memcmp(found[i]->id, id, REMOTE_CACHE_ID_LEN) == 0) return true;
+    }
+    return false;
+}
+
+static void testTtl() {
+    RemotePeerCache cache;
+    remoteCacheInit(&cache, TTL_MS);
+    CHECK(put(&cache, "global", 1, 1000));
+    CHECK(put(&cache, "global", 2, 50000));
+
+    RemotePeer* found[REMOTE_CACHE_SLOTS];
+    CHECK_EQ(collect(&cache, "global", 1000 + TTL_MS - 1, found), 2);
+    CHECK_EQ(collect(&cache, "global", 1000 + TTL_MS, found), 1);
+    CHECK_EQ(cache.expired, 1u);
+    CHECK_EQ(remoteCacheSize(&cache), 1);
+
+    // Seen again: the TTL starts over
+    CHECK(put(&cache, "global", 2, 150000));
+    CHECK_EQ(cache.refreshed, 1u);
+    CHECK_EQ(collect(&cache, "global", 150000 + TTL_MS - 1, found), 1);
+    CHECK_EQ(collect(&cache, "global", 150000 + TTL_MS, found), 0);
+
+    // Across a wrap of the millisecond clock
+    CHECK(put(&cache, "global", 3, 0xFFFFFF00u));
+    CHECK_EQ(collect(&cache, "global", 0x100, found), 1);
+
+    // Data too long to cache
+    char big[REMOTE_CACHE_DATA_MAX + 1];
+    memset(big, 'x', sizeof(big));
+    uint8_t id[REMOTE_CACHE_ID_LEN];
+    makeId(id, 9);
+    CHECK(!remoteCachePut(&cache, "global", 6, id, 0, big, REMOTE_CACHE_DATA_MAX, 0));
+    CHECK(remoteCachePut(&cache, "global", 6, id, 0, big, REMOTE_CACHE_DATA_MAX - 1, 0x200));
+}
+
+static void testEviction() {
+    RemotePeerCache cache;
+    remoteCacheInit(&cache, TTL_MS);
+    for (int i = 0; i < REMOTE_CACHE_SLOTS; i++) CHECK(put(&cache, "global", i, 100 + i));
+    CHECK_EQ(remoteCacheSize(&cache), REMOTE_CACHE_SLOTS);
+    CHECK_EQ(cache.evicted, 0u);
+
+    // Peer 0 is refreshed, so 1 is now the oldest and makes room
+    CHECK(put(&cache, "global", 0, 500));
+    CHECK(put(&cache, "global", 100, 600));
+    CHECK_EQ(cache.evicted, 1u);
+    CHECK_EQ(cache.stored, (uint32_t)REMOTE_CACHE_SLOTS + 1);
+    CHECK_EQ(remoteCacheSize(&cache), REMOTE_CACHE_SLOTS);
+    CHECK(!holds(&cache, "global", 1, 700));
+    CHECK(holds(&cache, "global", 0, 700));
+    CHECK(holds(&cache, "global", 100, 700));
+
+    CHECK(put(&cache, "lab", 101, 800));
+    CHECK(!holds(&cache, "global", 2, 900));
+    CHECK_EQ(cache.evicted, 2u);
+}
+
+static void testRemove() {
+    RemotePeerCache cache;
+    remoteCacheInit(&cache, TTL_MS);
+    CHECK(put(&cache, "global", 7, 0));
+    CHECK(put(&cache, "lab", 7, 0));  // The same peer in two namespaces
+    CHECK(put(&cache, "lab", 8, 0));
+
+    uint8_t id[REMOTE_CACHE_ID_LEN];
+    makeId(id, 7);
+    remoteCacheRemove(&cache, id);
+    CHECK_EQ(cache.removed, 2u);
+    CHECK_EQ(remoteCacheSize(&cache), 1);
+    CHECK(!holds(&cache, "global", 7, 10));
+    CHECK(holds(&cache, "lab", 8, 10));
+
+    makeId(id, 99);
+    remoteCacheRemove(&cache, id);
+    CHECK_EQ(cache.removed, 2u);
+
+    // The freed slots are reused before anything is evicted
+    for (int i = 0; i < REMOTE_CACHE_SLOTS - 1; i++) CHECK(put(&cache, "global", 200 + i, 20));
+    CHECK_EQ(cache.evicted, 0u);
+}
+
+static void testServed() {
+    RemotePeerCache cache;
+    remoteCacheInit(&cache, TTL_MS);
+    CHECK(put(&cache, "global", 1, 1000));
+    CHECK(put(&cache, "global", 2, 4000));
+
+    RemotePeer* found[REMOTE_CACHE_SLOTS];
+    int n = collect(&cache, "global", 5000, found);
+    remoteCacheServed(&cache, found, n, 5000);
+    n = collect(&cache, "lab", 5000, found);
+    remoteCacheServed(&cache, found, n, 5000);
+    CHECK_EQ(cache.lookups, 2u);
+    CHECK_EQ(cache.hits, 1u);
+    CHECK_EQ(cache.served, 2u);
+    CHECK_EQ(cache.staleMsTotal, 4000u + 1000u);
+    CHECK_EQ(cache.staleMsMax, 4000u);
+}
+
+// "net-948199" and "net-1123634" share FNV-1a hash 0xcbee4f7f. Entries are
+// keyed by the hash, so the two names act as one namespace: a peer cached
+// under one is introduced to joiners of the other.
+static void testHashCollision() {
+    RemotePeerCache cache;
+    remoteCacheInit(&cache, TTL_MS);
+    CHECK(put(&cache, "net-948199", 1, 0));
+    CHECK(put(&cache, "net-1123634", 2, 0));
+    CHECK(holds(&cache, "net-1123634", 1, 10));
+    CHECK(holds(&cache, "net-948199", 2, 10));
+
+    // The same peer under both names is a refresh, not a second entry
+    CHECK(put(&cache, "net-1123634", 1, 20));
+    CHECK_EQ(cache.refreshed, 1u);
+    CHECK_EQ(remoteCacheSize(&cache), 2);
+    CHECK(!holds(&cache, "net-948198", 1, 30));
+}
+
+int main() {
+    testTtl();
+    testEviction();
+    testRemove();
+    testServed();
+    testHashCollision();
+    return testResult("test_remote_peer_cache");
+}
@@ -0,0 +1,169 @@
+/*
+ * PigeonHub host test - signal_timing.cpp
+ *
+ * log2 histogram bucketing and percentiles, offer/answer pairing by path,
+ * candidates in both directions, answers without an offer, pairs finished
+ * when they go quiet and evicted when every slot is busy.
+ */
+
+#include "host_test.h"
+#include "signal_timing.h"
+#include <string.h>
+
+#define IDLE_MS  10000
+
+static const uint8_t* peer(int n) {
+    static uint8_t ids[8][SIGNAL_ID_LEN];
+    memset(ids[n], 0, SIGNAL_ID_LEN);
+    ids[n][0] = (uint8_t)(n + 1);
+    return ids[n];
+}
+
+static void testBuckets() {
+    SignalHistogram hist;
+    memset(&hist, 0, sizeof(hist));
+    CHECK_EQ(signalHistPercentile(&hist, 50), 0u);
+
+    // Bucket i counts values below 2^i
+    signalHistRecord(&hist, 0);
+    signalHistRecord(&hist, 1);
+    signalHistRecord(&hist, 3);
+    signalHistRecord(&hist, 4);
+    signalHistRecord(&hist, 1000);
+    CHECK_EQ(hist.buckets[0], 1u);
+    CHECK_EQ(hist.buckets[1], 1u);
+    CHECK_EQ(hist.buckets[2], 1u);
+    CHECK_EQ(hist.buckets[3], 1u);
+    CHECK_EQ(hist.buckets[10], 1u);
+    CHECK_EQ(hist.count, 5u);
+    CHECK_EQ(hist.total, 1008u);
+    CHECK_EQ(hist.max, 1000u);
+
+    // The last bucket is open-ended
+    signalHistRecord(&hist, 1u << (SIGNAL_HIST_BUCKETS - 2));
+    signalHistRecord(&hist, 0xFFFFFFFFu);
+    CHECK_EQ(hist.buckets[SIGNAL_HIST_BUCKETS - 1], 2u);
+    CHECK_EQ(hist.max, 0xFFFFFFFFu);
+}
+
+static void testPercentiles() {
+    SignalHistogram hist;
+    memset(&hist, 0, sizeof(hist));
+    for (int i = 0; i < 90; i++) signalHistRecord(&hist, 20);   // Bucket 5, below 32
+    for (int i = 0; i < 9; i++) signalHistRecord(&hist, 200);   // Bucket 8, below 256
+    signalHistRecord(&hist, 300);
+
+    CHECK_EQ(signalHistPercentile(&hist, 0), 32u);
+    CHECK_EQ(signalHistPercentile(&hist, 50), 32u);
+    CHECK_EQ(signalHistPercentile(&hist, 90), 32u);
+    CHECK_EQ(signalHistPercentile(&hist, 91), 256u);
+    CHECK_EQ(signalHistPercentile(&hist, 99), 256u);
+    // The top bucket's bound is past the largest value, which caps it
+    CHECK_EQ(signalHistPercentile(&hist, 100), 300u);
+}
+
+static void testPairing() {
+    SignalTiming timing;
+    signalTimingInit(&timing, IDLE_MS);
+    const uint8_t *a = peer(0), *b = peer(1), *c = peer(2), *d = peer(3);
+
+    // Local pair a -> b: answered after 150 ms, candidates both ways
+    signalForwarded(&timing, SIGNAL_OFFER, a, b, false, 40, 1000);
+    signalForwarded(&timing, SIGNAL_CANDIDATE, a, b, false, 40, 1050);
+    signalForwarded(&timing, SIGNAL_ANSWER, b, a, false, 40, 1150);
+    signalForwarded(&timing, SIGNAL_CANDIDATE, b, a, false, 40, 1400);
+
+    // c -> d with the answer coming over the uplink
+    signalForwarded(&timing, SIGNAL_OFFER, c, d, false, 40, 2000);
+    signalForwarded(&timing, SIGNAL_ANSWER, d, c, true, 40, 2600);
+
+    CHECK_EQ(signalActivePairs(&timing), 2);
+    CHECK_EQ(timing.hists[SIGNAL_RESIDENCE_US].count, 6u);
+    CHECK_EQ(timing.hists[SIGNAL_ANSWER_LOCAL_MS].count, 1u);
+    CHECK_EQ(timing.hists[SIGNAL_ANSWER_LOCAL_MS].max, 150u);
+    CHECK_EQ(timing.hists[SIGNAL_ANSWER_UPLINK_MS].count, 1u);
+    CHECK_EQ(timing.hists[SIGNAL_ANSWER_UPLINK_MS].max, 600u);
+
+    // A second answer, and one for an offer the hub never saw
+    signalForwarded(&timing, SIGNAL_ANSWER, b, a, false, 40, 1500);
+    signalForwarded(&timing, SIGNAL_ANSWER, a, d, false, 40, 1500);
+    CHECK_EQ(timing.unmatched, 2u);
+    CHECK_EQ(timing.hists[SIGNAL_ANSWER_LOCAL_MS].count, 1u);
+    CHECK_EQ(signalActivePairs(&timing), 2);
+
+    // Nothing is finished before the pair has been quiet for idleMs
+    signalTimingPoll(&timing, 1500 + IDLE_MS - 1);
+    CHECK_EQ(signalActivePairs(&timing), 2);
+    CHECK_EQ(timing.hists[SIGNAL_ICE_SPAN_MS].count, 0u);
+
+    // a/b expires: its candidate span and setup time are recorded. c/d
+    // had no candidates, so it leaves nothing.
+    signalTimingPoll(&timing, 2600 + IDLE_MS);
+    CHECK_EQ(signalActivePairs(&timing), 0);
+    CHECK_EQ(timing.hists[SIGNAL_ICE_SPAN_MS].count, 1u);
+    CHECK_EQ(timing.hists[SIGNAL_ICE_SPAN_MS].max, 350u);
+    CHECK_EQ(timing.hists[SIGNAL_SETUP_MS].count, 1u);
+    CHECK_EQ(timing.hists[SIGNAL_SETUP_MS].max, 400u);
+}
+
+static void testRenegotiation() {
+    SignalTiming timing;
+    signalTimingInit(&timing, IDLE_MS);
+    const uint8_t *a = peer(0), *b = peer(1);
+
+    // Candidates before any offer start a pair without one
+    signalForwarded(&timing, SIGNAL_CANDIDATE, a, b, false, 10, 100);
+    signalForwarded(&timing, SIGNAL_CANDIDATE, a, b, false, 10, 300);
+    signalForwarded(&timing, SIGNAL_ANSWER, b, a, false, 10, 400);
+    CHECK_EQ(timing.unmatched, 1u);
+
+    // A new offer finishes that pair (span only, no setup) and starts over
+    signalForwarded(&timing, SIGNAL_OFFER, a, b, false, 10, 500);
+    CHECK_EQ(timing.hists[SIGNAL_ICE_SPAN_MS].count, 1u);
+    CHECK_EQ(timing.hists[SIGNAL_ICE_SPAN_MS].max, 200u);
+    CHECK_EQ(timing.hists[SIGNAL_SETUP_MS].count, 0u);
+    CHECK_EQ(signalActivePairs(&timing), 1);
+
+    signalForwarded(&timing, SIGNAL_ANSWER, b, a, false, 10, 520);
+    CHECK_EQ(timing.hists[SIGNAL_ANSWER_LOCAL_MS].max, 20u);
+}
+
+static void testEviction() {
+    SignalTiming timing;
+    signalTimingInit(&timing, IDLE_MS);
+    uint8_t offerer[SIGNAL_ID_LEN] = {0}, answerer[SIGNAL_ID_LEN] = {0};
+    for (int i = 0; i < SIGNAL_PAIRS; i++) {
+        offerer[0] = (uint8_t)i;
+        answerer[0] = (uint8_t)(100 + i);
+        signalForwarded(&timing, SIGNAL_OFFER, offerer, answerer, false, 10, 1000 + i);
+        signalForwarded(&timing, SIGNAL_CANDIDATE, offerer, answerer, false, 10, 1100 + i);
+    }
+    CHECK_EQ(signalActivePairs(&timing), SIGNAL_PAIRS);
+
+    // Pair 0 is active again, so pair 1 is the least recent: it makes room
+    // and its times are recorded
+    offerer[0] = 0;
+    answerer[0] = 100;
+    signalForwarded(&timing, SIGNAL_CANDIDATE, offerer, answerer, false, 10, 1200);
+    offerer[0] = 200;
+    signalForwarded(&timing, SIGNAL_OFFER, offerer, answerer, false, 10, 1300);
+    CHECK_EQ(timing.evicted, 1u);
+    CHECK_EQ(signalActivePairs(&timing), SIGNAL_PAIRS);
+    CHECK_EQ(timing.hists[SIGNAL_SETUP_MS].count, 1u);
+    CHECK_EQ(timing.hists[SIGNAL_SETUP_MS].max, 100u);  // Offer at 1001, candidate at 1101
+
+    // The evicted pair's answer no longer matches
+    offerer[0] = 1;
+    answerer[0] = 101;
+    signalForwarded(&timing, SIGNAL_ANSWER, answerer, offerer, false, 10, 1400);
+    CHECK_EQ(timing.unmatched, 1u);
+}
+
+int main() {
+    testBuckets();
+    testPercentiles();
+    testPairing();
+    testRenegotiation();
+    testEviction();
+    return testResult("test_signal_timing");
+}
@@ -0,0 +1,161 @@
+/*
+ * PigeonHub host test - stun_server.cpp
+ *
+ * A Binding request over loopback UDP to a responder thread that works the
+ * way the hub's loop does (recvfrom, stunRespond, sendto). The reply's
+ * XOR-MAPPED-ADDRESS must decode to the client's own address. Then the
+ * datagrams stunRespond() has to drop: short, wrong type, no magic cookie,
+ * a length that doesn't match the datagram or isn't a multiple of 4.
+ */
+
+#include "host_test.h"
+#include "stun_server.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <string.h>
+#include <initializer_list>
+#include <thread>
+
+static const uint8_t TRANSACTION[12] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+
+// Binding request with `attrLen` bytes of (zeroed) attributes
+static size_t bindingRequest(uint8_t* out, uint16_t attrLen) {
+    memset(out, 0, STUN_HEADER_SIZE + attrLen);
+    out[1] = 0x01;
+    out[2] = attrLen >> 8;
+    out[3] = attrLen;
+    out[4] = 0x21; out[5] = 0x12; out[6] = 0xA4; out[7] = 0x42;
+    memcpy(out + 8, TRANSACTION, 12);
+    return STUN_HEADER_SIZE + attrLen;
+}
+
+static int udpSocket(sockaddr_in* addr) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    memset(addr, 0, sizeof(*addr));
+    addr->sin_family = AF_INET;
+    addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(*addr);
+    CHECK(bind(fd, (sockaddr*)addr, sizeof(*addr)) == 0);
+    getsockname(fd, (sockaddr*)addr, &len);
+    timeval tv = { 0, 200000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    return fd;
+}
+
+// The hub's stunStep(), on a Linux socket; answers `count` datagrams
+static void responder(int fd, int count, StunStats* stats) {
+    for (int i = 0; i < count; i++) {
+        uint8_t packet[576];
+        sockaddr_in from;
+        socklen_t fromLen = sizeof(from);
+        ssize_t n = recvfrom(fd, packet, sizeof(packet), 0, (sockaddr*)&from, &fromLen);
+        if (n < 0) continue;
+        uint8_t reply[STUN_RESPONSE_SIZE];
+        size_t replyLen = stunRespond(stats, packet, n, ntohl(from.sin_addr.s_addr),
+                                      ntohs(from.sin_port), reply);
+        if (replyLen) sendto(fd, reply, replyLen, 0, (sockaddr*)&from, fromLen);
+    }
+}
+
+static void testLoopback() {
+    sockaddr_in hubAddr, clientAddr;
+    int hub = udpSocket(&hubAddr);
+    int client = udpSocket(&clientAddr);
+    StunStats stats = { 0, 0 };
+    std::thread hubThread(responder, hub, 3, &stats);
+
+    uint8_t request[64], reply[64];
+    // Plain request, one with 8 bytes of attributes, then one to drop
+    for (uint16_t attrLen : { 0, 8, 3 }) {
+        size_t len = bindingRequest(request, attrLen);
+        sendto(client, request, len, 0, (sockaddr*)&hubAddr, sizeof(hubAddr));
+        sockaddr_in from;
+        socklen_t fromLen = sizeof(from);
+        ssize_t n = recvfrom(client, reply, sizeof(reply), 0, (sockaddr*)&from, &fromLen);
+        if (attrLen % 4) {
+            CHECK_EQ(n, -1);  // Timed out: no reply
+            continue;
+        }
+
+        CHECK_EQ(n, STUN_RESPONSE_SIZE);
+        CHECK(from.sin_port == hubAddr.sin_port);
+        CHECK_EQ(reply[0] << 8 | reply[1], 0x0101);
+        CHECK_EQ(reply[2] << 8 | reply[3], 12);
+        CHECK(memcmp(reply + 4, request + 4, 16) == 0);
+
+        const uint8_t* attr = reply + STUN_HEADER_SIZE;
+        CHECK_EQ(attr[0] << 8 | attr[1], 0x0020);
+        CHECK_EQ(attr[2] << 8 | attr[3], 8);
+        CHECK_EQ(attr[5], 0x01);
+        uint16_t port = (attr[6] << 8 | attr[7]) ^ 0x2112;
+        uint32_t addr = ((uint32_t)attr[8] << 24 | attr[9] << 16 | attr[10] << 8 | attr[11]) ^ 0x2112A442;
+        CHECK_EQ(port, ntohs(clientAddr.sin_port));
+        CHECK_EQ(addr, INADDR_LOOPBACK);
+    }
+
+    hubThread.join();
+    CHECK_EQ(stats.requests, 2u);
+    CHECK_EQ(stats.dropped, 1u);
+    close(hub);
+    close(client);
+}
+
+static void testDrops() {
+    StunStats stats = { 0, 0 };
+    uint8_t packet[64], out[STUN_RESPONSE_SIZE];
+    size_t len = bindingRequest(packet, 4);
+    CHECK_EQ(stunRespond(&stats, packet, len, 0x0A000001, 5000, out), STUN_RESPONSE_SIZE);
+
+    // Shorter than a header, including a header cut short
+    CHECK_EQ(stunRespond(&stats, packet, 0, 0x0A000001, 5000, out), 0u);
+    CHECK_EQ(stunRespond(&stats, packet, STUN_HEADER_SIZE - 1, 0x0A000001, 5000, out), 0u);
+
+    // Length field against the datagram size
+    CHECK_EQ(stunRespond(&stats, packet, len - 4, 0x0A000001, 5000, out), 0u);
+    CHECK_EQ(stunRespond(&stats, packet, len + 4, 0x0A000001, 5000, out), 0u);
+
+    // Attributes not padded to 4 bytes, with the length matching the datagram
+    for (uint16_t attrLen : { 1, 2, 3, 5 }) {
+        size_t n = bindingRequest(packet, attrLen);
+        CHECK_EQ(stunRespond(&stats, packet, n, 0x0A000001, 5000, out), 0u);
+    }
+
+    // RFC 3489 (no magic cookie), with each cookie byte wrong in turn
+    for (int i = 4; i < 8; i++) {
+        len = bindingRequest(packet, 0);
+        packet[i] ^= 0x01;
+        CHECK_EQ(stunRespond(&stats, packet, len, 0x0A000001, 5000, out), 0u);
+    }
+
+    // Other methods and classes, and the top two bits (not STUN)
+    const uint16_t types[] = { 0x0101, 0x0011, 0x0111, 0x0003, 0x4001, 0x8001 };
+    for (uint16_t type : types) {
+        len = bindingRequest(packet, 0);
+        packet[0] = type >> 8;
+        packet[1] = type;
+        CHECK_EQ(stunRespond(&stats, packet, len, 0x0A000001, 5000, out), 0u);
+    }
+
+    CHECK_EQ(stats.requests, 1u);
+    CHECK_EQ(stats.dropped, 4u + 4u + 4u + 6u);
+}
+
+static void testMappedAddress() {
+    StunStats stats = { 0, 0 };
+    uint8_t packet[STUN_HEADER_SIZE], out[STUN_RESPONSE_SIZE];
+    size_t len = bindingRequest(packet, 0);
+    CHECK_EQ(stunRespond(&stats, packet, len, 0xC0A80402, 0xD2F1, out), STUN_RESPONSE_SIZE);
+    // 192.168.4.2:53993 XOR 0x2112A442
+    const uint8_t expected[] = { 0x00, 0x01, 0xF3, 0xE3, 0xE1, 0xBA, 0xA0, 0x40 };
+    CHECK(memcmp(out + STUN_HEADER_SIZE + 4, expected, sizeof(expected)) == 0);
+}
+
+int main() {
+    testLoopback();
+    testDrops();
+    testMappedAddress();
+    return testResult("test_stun_server");
+}
@@ -0,0 +1,482 @@
+/*
+ * PigeonHub host test - turn_relay.cpp over loopback UDP
+ *
+ * The relay runs in a hub thread with a Linux backend: a server socket on
+ * 127.0.0.1, one UDP socket per allocation, OpenSSL for MD5 and HMAC-SHA1.
+ * The hub loop is stunPoll() from main.cpp, including its oversize check. A
+ * client allocates with long-term credentials and is refused (403) when it
+ * points permissions or channels at loopback, 0.0.0.0/8, multicast or a hub
+ * address. Its Send indications there are dropped. It then relays to a peer
+ * on this machine's first non-loopback address, by Send/Data indication and
+ * by ChannelData.
+ *
+ * The benchmark echoes ChannelData through the relay and reports packets
+ * and bytes per second of hub CPU time, socket calls included: the
+ * throughput of one core.
+ */
+
+#include "host_test.h"
+#include "turn_relay.h"
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <ifaddrs.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#define UDP_DATAGRAM_MAX  1472
+#define UDP_POLL_BATCH    8
+#define SECRET            "harness-secret"
+#define NETWORK           "net"
+#define HUB_OTHER_ADDR    0x0A090807  // 10.9.8.7, as if the hub's WiFi address
+
+// ============================================================================
+// Hub: backend and loop
+// ============================================================================
+
+static int serverSocket = -1;
+static int relaySockets[TURN_MAX_ALLOCATIONS] = { -1, -1, -1, -1 };
+static TurnRelay relay;
+static std::mutex relayLock;          // Stats are read from the client thread
+static std::atomic<bool> hubRunning;
+static uint32_t oversize;
+static uint64_t startNs;
+
+static uint32_t nowMs() {
+    return (uint32_t)((testNowNs() - startNs) / 1000000);
+}
+
+static int openUdp(uint32_t addr, uint16_t port) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr.s_addr = htonl(addr);
+    if (bind(fd, (sockaddr*)&local, sizeof(local)) < 0) {
+        close(fd);
+        return -1;
+    }
+    int buf = 1 << 20;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buf, sizeof(buf));
+    return fd;
+}
+
+static uint16_t localPort(int fd) {
+    sockaddr_in local;
+    socklen_t len = sizeof(local);
+    getsockname(fd, (sockaddr*)&local, &len);
+    return ntohs(local.sin_port);
+}
+
+static void longTermKey(const char* username, size_t len, uint8_t key[16]) {
+    char material[128];
+    int n = snprintf(material, sizeof(material), "%.*s:%s:%s", (int)len, username, TURN_REALM, SECRET);
+    EVP_Digest(material, n, key, NULL, EVP_md5(), NULL);
+}
+
+static int backendKey(const char* username, size_t len, uint8_t key[16]) {
+    size_t nsLen = 0;
+    while (nsLen < len && username[nsLen] != ':') nsLen++;
+    if (nsLen != strlen(NETWORK) || memcmp(username, NETWORK, nsLen) != 0) return -1;
+    longTermKey(username, len, key);
+    return 0;
+}
+
+static void backendHmac(const uint8_t* key, size_t keyLen, const uint8_t* data, size_t len, uint8_t out[20]) {
+    unsigned int outLen = 20;
+    HMAC(EVP_sha1(), key, keyLen, data, len, out, &outLen);
+}
+
+static uint16_t backendOpenRelay(int slot) {
+    int fd = openUdp(INADDR_ANY, 0);
+    if (fd < 0) return 0;
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    relaySockets[slot] = fd;
+    return localPort(fd);
+}
+
+static void backendCloseRelay(int slot) {
+    close(relaySockets[slot]);
+    relaySockets[slot] = -1;
+}
+
+static bool backendLocalAddress(uint32_t addr) {
+    return addr == INADDR_LOOPBACK || addr == HUB_OTHER_ADDR;
+}
+
+static const TurnBackend backend = {
+    backendKey, backendHmac, backendOpenRelay, backendCloseRelay, backendLocalAddress
+};
+
+static void sendUdp(int fd, const uint8_t* data, size_t len, uint32_t addr, uint16_t port) {
+    sockaddr_in to;
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_port = htons(port);
+    to.sin_addr.s_addr = htonl(addr);
+    sendto(fd, data, len, 0, (sockaddr*)&to, sizeof(to));
+}
+
+static void turnSend(const TurnSend* send) {
+    if (send->len == 0) return;
+    int fd = send->relay == TURN_VIA_SERVER ? serverSocket : relaySockets[send->relay];
+    sendUdp(fd, send->data, send->len, send->addr, send->port);
+}
+
+// stunPoll() with a poll() wait; hub CPU time goes to *cpuNs
+static void hubLoop(uint64_t* cpuNs) {
+    static uint8_t udpBuffer[TURN_HEADROOM + UDP_DATAGRAM_MAX + 4];
+    while (hubRunning) {
+        pollfd fds[1 + TURN_MAX_ALLOCATIONS];
+        int count = 0;
+        fds[count++] = { serverSocket, POLLIN, 0 };
+        for (int slot = 0; slot < TURN_MAX_ALLOCATIONS; slot++) {
+            if (relaySockets[slot] >= 0) fds[count++] = { relaySockets[slot], POLLIN, 0 };
+        }
+        if (poll(fds, count, 5) <= 0) continue;
+
+        timespec cpu0, cpu1;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu0);
+        std::lock_guard<std::mutex> guard(relayLock);
+        uint32_t now = nowMs();
+        for (int i = 0; i < UDP_POLL_BATCH; i++) {
+            sockaddr_in from;
+            socklen_t fromLen = sizeof(from);
+            int len = recvfrom(serverSocket, udpBuffer, UDP_DATAGRAM_MAX + 1, MSG_DONTWAIT,
+                               (sockaddr*)&from, &fromLen);
+            if (len < 0) break;
+            if (len > UDP_DATAGRAM_MAX) {
+                oversize++;
+                continue;
+            }
+            uint8_t response[TURN_RESPONSE_MAX];
+            TurnSend send;
+            if (turnFromClient(&relay, udpBuffer, len, ntohl(from.sin_addr.s_addr), ntohs(from.sin_port),
+                               INADDR_LOOPBACK, now, response, &send)) {
+                turnSend(&send);
+            }
+        }
+        for (int slot = 0; slot < TURN_MAX_ALLOCATIONS; slot++) {
+            for (int i = 0; relaySockets[slot] >= 0 && i < UDP_POLL_BATCH; i++) {
+                sockaddr_in from;
+                socklen_t fromLen = sizeof(from);
+                uint8_t* packet = udpBuffer + TURN_HEADROOM;
+                int len = recvfrom(relaySockets[slot], packet, UDP_DATAGRAM_MAX + 1, 0, (sockaddr*)&from, &fromLen);
+                if (len < 0) break;
+                if (len > UDP_DATAGRAM_MAX) {
+                    oversize++;
+                    continue;
+                }
+                TurnSend send;
+                turnFromPeer(&relay, slot, packet, len, ntohl(from.sin_addr.s_addr), ntohs(from.sin_port),
+                             now, &send);
+                turnSend(&send);
+            }
+        }
+        turnPoll(&relay, now);
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu1);
+        *cpuNs += (cpu1.tv_sec - cpu0.tv_sec) * 1000000000ull + cpu1.tv_nsec - cpu0.tv_nsec;
+    }
+}
+
+// ============================================================================
+// Client
+// ============================================================================
+
+static void put16(uint8_t* p, uint16_t v) {
+    p[0] = v >> 8;
+    p[1] = v;
+}
+
+static void put32(uint8_t* p, uint32_t v) {
+    put16(p, v >> 16);
+    put16(p + 2, v);
+}
+
+static uint16_t get16(const uint8_t* p) {
+    return p[0] << 8 | p[1];
+}
+
+struct Request {
+    uint8_t buf[1600];
+    size_t len;
+};
+
+static uint32_t transactionCounter;
+
+static void begin(Request* r, uint16_t type) {
+    memset(r->buf, 0, 20);
+    put16(r->buf, type);
+    put32(r->buf + 4, 0x2112A442);
+    put32(r->buf + 16, ++transactionCounter);
+    r->len = 20;
+}
+
+static uint8_t* attr(Request* r, uint16_t type, size_t len) {
+    uint8_t* a = r->buf + r->len;
+    put16(a, type);
+    put16(a + 2, len);
+    size_t padded = (len + 3) & ~3u;
+    memset(a + 4, 0, padded);
+    r->len += 4 + padded;
+    put16(r->buf + 2, r->len - 20);
+    return a + 4;
+}
+
+static void xorAddress(Request* r, uint16_t type, uint32_t addr, uint16_t port) {
+    uint8_t* v = attr(r, type, 8);
+    v[1] = 0x01;
+    put16(v + 2, port ^ 0x2112);
+    put32(v + 4, addr ^ 0x2112A442);
+}
+
+static char nonce[TURN_NONCE_LEN + 1];
+
+static void authenticate(Request* r) {
+    memcpy(attr(r, 0x0006, strlen(NETWORK)), NETWORK, strlen(NETWORK));
+    memcpy(attr(r, 0x0014, strlen(TURN_REALM)), TURN_REALM, strlen(TURN_REALM));
+    memcpy(attr(r, 0x0015, TURN_NONCE_LEN), nonce, TURN_NONCE_LEN);
+    uint8_t key[16];
+    longTermKey(NETWORK, strlen(NETWORK), key);
+    size_t covered = r->len;
+    uint8_t* mac = attr(r, 0x0008, 20);
+    backendHmac(key, 16, r->buf, covered, mac);
+}
+
+static int clientSocket, peerSocket;
+static uint32_t peerAddr;
+static uint16_t hubPort, relayPort;
+
+static int exchange(Request* r, uint8_t* reply, size_t cap) {
+    sendUdp(clientSocket, r->buf, r->len, INADDR_LOOPBACK, hubPort);
+    int n = recv(clientSocket, reply, cap, 0);
+    return n;
+}
+
+// Error code of a response, 0 for success, -1 for none
+static int responseCode(const uint8_t* reply, int len) {
+    if (len < 20) return -1;
+    if ((get16(reply) & 0x0110) == 0x0100) return 0;
+    for (int pos = 20; pos + 8 <= len; pos += 4 + ((get16(reply + pos + 2) + 3) & ~3)) {
+        if (get16(reply + pos) == 0x0009) return reply[pos + 6] * 100 + reply[pos + 7];
+    }
+    return -1;
+}
+
+static int request(uint16_t method, uint32_t addr, uint16_t port, int channel) {
+    Request r;
+    begin(&r, method);
+    if (channel >= 0) put16(attr(&r, 0x000C, 4), channel);
+    xorAddress(&r, 0x0012, addr, port);
+    authenticate(&r);
+    uint8_t reply[512];
+    return responseCode(reply, exchange(&r, reply, sizeof(reply)));
+}
+
+static void sendIndication(uint32_t addr, uint16_t port, const char* data) {
+    Request r;
+    begin(&r, 0x0016);
+    xorAddress(&r, 0x0012, addr, port);
+    memcpy(attr(&r, 0x0013, strlen(data)), data, strlen(data));
+    sendUdp(clientSocket, r.buf, r.len, INADDR_LOOPBACK, hubPort);
+}
+
+static void setTimeout(int fd, int ms) {
+    timeval tv = { ms / 1000, (ms % 1000) * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+}
+
+// First non-loopback IPv4 address of this machine, or 0
+static uint32_t externalAddress() {
+    ifaddrs* list;
+    uint32_t found = 0;
+    if (getifaddrs(&list) != 0) return 0;
+    for (ifaddrs* i = list; i && !found; i = i->ifa_next) {
+        if (!i->ifa_addr || i->ifa_addr->sa_family != AF_INET) continue;
+        uint32_t addr = ntohl(((sockaddr_in*)i->ifa_addr)->sin_addr.s_addr);
+        if (addr >> 24 != 127) found = addr;
+    }
+    freeifaddrs(list);
+    return found;
+}
+
+static void testAllocate() {
+    uint8_t reply[512];
+    Request r;
+    begin(&r, 0x0003);
+    put32(attr(&r, 0x0019, 4), 17u << 24);
+    int n = exchange(&r, reply, sizeof(reply));
+    CHECK_EQ(responseCode(reply, n), 401);
+    for (int pos = 20; pos + 4 <= n; pos += 4 + ((get16(reply + pos + 2) + 3) & ~3)) {
+        if (get16(reply + pos) == 0x0015) memcpy(nonce, reply + pos + 4, TURN_NONCE_LEN);
+    }
+
+    begin(&r, 0x0003);
+    put32(attr(&r, 0x0019, 4), 17u << 24);
+    authenticate(&r);
+    n = exchange(&r, reply, sizeof(reply));
+    CHECK_EQ(responseCode(reply, n), 0);
+    for (int pos = 20; pos + 4 <= n; pos += 4 + ((get16(reply + pos + 2) + 3) & ~3)) {
+        if (get16(reply + pos) == 0x0016) relayPort = get16(reply + pos + 6) ^ 0x2112;
+    }
+    CHECK(relayPort != 0);
+}
+
+static void testForbiddenPeers() {
+    const uint32_t forbidden[] = {
+        INADDR_LOOPBACK, 0x7F000102, 0x00000009, 0xE0000001, 0xFFFFFFFF, HUB_OTHER_ADDR
+    };
+    for (uint32_t addr : forbidden) {
+        CHECK_EQ(request(0x0008, addr, 9, -1), 403);
+        CHECK_EQ(request(0x0009, addr, 9, 0x4001), 403);
+    }
+
+    // A Send indication to the hub's server port must not come back to the client
+    sendIndication(INADDR_LOOPBACK, hubPort, "to myself");
+    uint8_t reply[64];
+    setTimeout(clientSocket, 100);
+    CHECK_EQ(recv(clientSocket, reply, sizeof(reply), 0), -1);
+    setTimeout(clientSocket, 2000);
+
+    std::lock_guard<std::mutex> guard(relayLock);
+    CHECK_EQ(relay.forbidden, 2 * 6 + 1);
+}
+
+static void testRelay() {
+    uint16_t peerPort = localPort(peerSocket);
+    CHECK_EQ(request(0x0008, peerAddr, peerPort, -1), 0);
+
+    // Send indication out, Data indication back
+    sendIndication(peerAddr, peerPort, "hello peer");
+    uint8_t buf[1600];
+    sockaddr_in from;
+    socklen_t fromLen = sizeof(from);
+    int n = recvfrom(peerSocket, buf, sizeof(buf), 0, (sockaddr*)&from, &fromLen);
+    CHECK(n == 10 && memcmp(buf, "hello peer", 10) == 0);
+    CHECK_EQ(ntohs(from.sin_port), relayPort);
+
+    sendUdp(peerSocket, (const uint8_t*)"hello client", 12, INADDR_LOOPBACK, relayPort);
+    n = recv(clientSocket, buf, sizeof(buf), 0);
+    CHECK_EQ(get16(buf), 0x0017);
+    CHECK(n >= 36 + 12 && memcmp(buf + 36, "hello client", 12) == 0);
+
+    // ChannelData both ways
+    CHECK_EQ(request(0x0009, peerAddr, peerPort, 0x4000), 0);
+    uint8_t frame[4 + 8];
+    put16(frame, 0x4000);
+    put16(frame + 2, 8);
+    memcpy(frame + 4, "channel!", 8);
+    sendUdp(clientSocket, frame, sizeof(frame), INADDR_LOOPBACK, hubPort);
+    n = recv(peerSocket, buf, sizeof(buf), 0);
+    CHECK(n == 8 && memcmp(buf, "channel!", 8) == 0);
+    sendUdp(peerSocket, (const uint8_t*)"back", 4, INADDR_LOOPBACK, relayPort);
+    n = recv(clientSocket, buf, sizeof(buf), 0);
+    CHECK(n == 8 && get16(buf) == 0x4000 && get16(buf + 2) == 4 && memcmp(buf + 4, "back", 4) == 0);
+
+    // Too long for the hub: dropped, not relayed cut short
+    uint8_t big[UDP_DATAGRAM_MAX + 8];
+    memset(big, 0, sizeof(big));
+    put16(big, 0x4000);
+    put16(big + 2, UDP_DATAGRAM_MAX + 4);
+    sendUdp(clientSocket, big, sizeof(big), INADDR_LOOPBACK, hubPort);
+    sendUdp(peerSocket, big, UDP_DATAGRAM_MAX + 1, INADDR_LOOPBACK, relayPort);
+    setTimeout(peerSocket, 100);
+    setTimeout(clientSocket, 100);
+    CHECK_EQ(recv(peerSocket, buf, sizeof(buf), 0), -1);
+    CHECK_EQ(recv(clientSocket, buf, sizeof(buf), 0), -1);
+    setTimeout(peerSocket, 2000);
+    setTimeout(clientSocket, 2000);
+    std::lock_guard<std::mutex> guard(relayLock);
+    CHECK_EQ(oversize, 2u);
+}
+
+// ChannelData client -> peer -> client, `window` packets in flight
+static void benchRelay(const uint64_t* hubCpuNs) {
+    const size_t sizes[] = { 100, 500, 1200 };
+    BENCH("TURN relay, ChannelData echoed by the peer, per core of hub CPU:\n");
+    for (size_t payload : sizes) {
+        const int packets = 40000, window = 32;
+        uint8_t frame[4 + 1200], buf[1600];
+        put16(frame, 0x4000);
+        put16(frame + 2, payload);
+        memset(frame + 4, 0x5A, payload);
+
+        uint64_t cpuBefore;
+        {
+            std::lock_guard<std::mutex> guard(relayLock);
+            cpuBefore = *hubCpuNs;
+        }
+        uint64_t start = testNowNs();
+        int sent = 0, received = 0, lost = 0;
+        while (received + lost < packets) {
+            while (sent < packets && sent - received - lost < window) {
+                sendUdp(clientSocket, frame, 4 + payload, INADDR_LOOPBACK, hubPort);
+                sent++;
+            }
+            int n = recv(peerSocket, buf, sizeof(buf), 0);
+            if (n < 0) {
+                lost += sent - received - lost;  // Timed out: the window was dropped
+                continue;
+            }
+            sendUdp(peerSocket, buf, n, INADDR_LOOPBACK, relayPort);
+            n = recv(clientSocket, buf, sizeof(buf), 0);
+            if (n == (int)(4 + payload)) received++;
+            else lost++;
+        }
+        uint64_t wallNs = testNowNs() - start;
+        uint64_t cpuNs;
+        {
+            std::lock_guard<std::mutex> guard(relayLock);
+            cpuNs = *hubCpuNs - cpuBefore;
+        }
+        CHECK(lost < packets / 100);
+        // Each round trip is two relayed datagrams
+        double perSec = 2.0 * received * 1e9 / cpuNs;
+        BENCH("  %4zu B: %8.0f datagrams/s, %6.1f MB/s per core (%.0f%% of one core busy, %d lost)\n",
+              payload, perSec, perSec * payload / 1e6, 100.0 * cpuNs / wallNs, lost);
+    }
+}
+
+int main() {
+    startNs = testNowNs();
+    serverSocket = openUdp(INADDR_LOOPBACK, 0);
+    hubPort = localPort(serverSocket);
+    fcntl(serverSocket, F_SETFL, O_NONBLOCK);
+    turnInit(&relay, &backend, "0123456789abcdef", 2, 1, 1u << 30, 1u << 30);
+
+    uint64_t hubCpuNs = 0;
+    hubRunning = true;
+    std::thread hub(hubLoop, &hubCpuNs);
+
+    clientSocket = openUdp(INADDR_LOOPBACK, 0);
+    setTimeout(clientSocket, 2000);
+    testAllocate();
+    testForbiddenPeers();
+
+    peerAddr = externalAddress();
+    if (peerAddr) {
+        peerSocket = openUdp(peerAddr, 0);
+        setTimeout(peerSocket, 2000);
+        testRelay();
+        setTimeout(peerSocket, 200);
+        setTimeout(clientSocket, 200);
+        benchRelay(&hubCpuNs);
+        close(peerSocket);
+    } else {
+        BENCH("no non-loopback IPv4 address; relaying to a peer not tested\n");
+    }
+
+    hubRunning = false;
+    hub.join();
+    close(clientSocket);
+    close(serverSocket);
+    return testResult("test_turn_relay");
+}
@@ -0,0 +1,125 @@
+/*
+ * PigeonHub host test - uplink_backoff.cpp
+ *
+ * Backoff sequence, jitter range and the stable-uplink reset, then 200 hubs
+ * that lose the same bootstrap hub for 20 s. Each reconnects either on the
+ * fixed 10 s library timer that drove retries before the uplink state
+ * machine, or with the state machine's backoff. Reported: peak connects per
+ * second the bootstrap hub sees once it is back, and how long until every
+ * hub is connected again.
+ */
+
+#include "host_test.h"
+#include "uplink_backoff.h"
+#include <random>
+#include <vector>
+#include <algorithm>
+
+static void testSequence() {
+    UplinkBackoff b;
+    uplinkBackoffInit(&b, UPLINK_BACKOFF_MIN_MS, UPLINK_BACKOFF_MAX_MS, UPLINK_STABLE_MS);
+
+    const uint32_t expected[] = { 1000, 2000, 4000, 8000, 16000, 32000, 60000, 60000 };
+    for (uint32_t want : expected) {
+        uplinkBackoffFailed(&b, false, 0, 0);
+        CHECK_EQ(b.backoffMs, want);
+        CHECK_EQ(b.retryMs, want / 2);  // random 0: the low end
+    }
+
+    // A drop after a short session keeps backing off...
+    uplinkBackoffFailed(&b, true, UPLINK_STABLE_MS - 1, 0);
+    CHECK_EQ(b.backoffMs, UPLINK_BACKOFF_MAX_MS);
+    // ...a stable one starts over
+    uplinkBackoffFailed(&b, true, UPLINK_STABLE_MS, 0);
+    CHECK_EQ(b.backoffMs, UPLINK_BACKOFF_MIN_MS);
+    uplinkBackoffFailed(&b, false, 0, 0);
+    CHECK_EQ(b.backoffMs, 2 * UPLINK_BACKOFF_MIN_MS);
+
+    uplinkBackoffReset(&b);
+    uplinkBackoffFailed(&b, false, 0, 0);
+    CHECK_EQ(b.backoffMs, UPLINK_BACKOFF_MIN_MS);
+
+    // Jitter covers 50-100% of the backoff, for odd values too
+    uplinkBackoffInit(&b, 1001, UPLINK_BACKOFF_MAX_MS, UPLINK_STABLE_MS);
+    uint32_t lo = UINT32_MAX, hi = 0;
+    for (uint32_t r = 0; r < 5000; r++) {
+        uplinkBackoffReset(&b);
+        uint32_t retry = uplinkBackoffFailed(&b, false, 0, r);
+        lo = std::min(lo, retry);
+        hi = std::max(hi, retry);
+    }
+    CHECK_EQ(lo, 501);
+    CHECK_EQ(hi, 1001);
+
+    // Degenerate limits
+    uplinkBackoffInit(&b, 0, 0, 0);
+    CHECK(uplinkBackoffFailed(&b, false, 0, 7) >= 1);
+    uplinkBackoffInit(&b, 3000000000u, 4000000000u, 0);
+    uplinkBackoffFailed(&b, false, 0, 0);
+    uplinkBackoffFailed(&b, false, 0, 0);
+    CHECK_EQ(b.backoffMs, 4000000000u);
+}
+
+struct StormStats {
+    uint32_t peakPerSec;
+    uint32_t allBackMs;  // After the bootstrap hub came back
+    uint32_t attempts;
+};
+
+// Every hub drops at t=0; the bootstrap hub refuses connections until downMs
+static StormStats reconnect(bool backoff, int hubs, uint32_t downMs) {
+    std::mt19937 rng(9);
+    std::vector<uint32_t> connectTimes;
+    uint32_t attempts = 0;
+
+    for (int h = 0; h < hubs; h++) {
+        UplinkBackoff b;
+        uplinkBackoffInit(&b, UPLINK_BACKOFF_MIN_MS, UPLINK_BACKOFF_MAX_MS, UPLINK_STABLE_MS);
+        // The loss is seen within one loop pass; a hub had been up for hours
+        uint32_t t = rng() % 20;
+        uint32_t next = backoff ? t + uplinkBackoffFailed(&b, true, 3600000, rng()) : t + 10000;
+        while (true) {
+            attempts++;
+            if (next >= downMs) {
+                connectTimes.push_back(next);
+                break;
+            }
+            // A refused connect fails within a round trip
+            next += 50 + rng() % 50;
+            next += backoff ? uplinkBackoffFailed(&b, false, 0, rng()) : 10000;
+        }
+    }
+
+    std::sort(connectTimes.begin(), connectTimes.end());
+    StormStats s = { 0, connectTimes.back() - downMs, attempts };
+    size_t start = 0;
+    for (size_t i = 0; i < connectTimes.size(); i++) {
+        while (connectTimes[start] + 1000 <= connectTimes[i]) start++;
+        s.peakPerSec = std::max(s.peakPerSec, (uint32_t)(i - start + 1));
+    }
+    return s;
+}
+
+static void testReconnectSpread() {
+    const int hubs = 200;
+    const uint32_t downMs = 20000;
+    StormStats timer = reconnect(false, hubs, downMs);
+    StormStats jittered = reconnect(true, hubs, downMs);
+
+    BENCH("%d hubs, bootstrap hub down %u s:\n", hubs, downMs / 1000);
+    BENCH("  fixed 10 s timer: peak %3u connects/s, all back %5u ms later, %u attempts\n",
+          timer.peakPerSec, timer.allBackMs, timer.attempts);
+    BENCH("  backoff + jitter: peak %3u connects/s, all back %5u ms later, %u attempts\n",
+          jittered.peakPerSec, jittered.allBackMs, jittered.attempts);
+
+    CHECK_EQ(timer.peakPerSec, hubs);  // Lockstep
+    CHECK(jittered.peakPerSec < hubs / 4);
+    // Worst case is one full backoff step after the bootstrap hub returns
+    CHECK(jittered.allBackMs <= 32000 + 100);
+}
+
+int main() {
+    testSequence();
+    testReconnectSpread();
+    return testResult("test_uplink_backoff");
+}
@@ -0,0 +1,346 @@
+/*
+ * PigeonHub host test - uplink_mux.cpp
+ *
+ * Strict priority, deficit round robin between namespaces, the link credit
+ * and drop accounting (full stream, out of streams, over maxBytes, out of
+ * memory, cleared), then a multi-hub simulation under skewed namespace
+ * load. Four hubs share a bootstrap hub. Hubs 0 and 1 flood announces in
+ * one hot namespace while three other namespaces trickle ICE candidates
+ * between hubs. Each hub's uplink is either a plain socket (first come,
+ * first served, as before the mux) or the mux; the bootstrap hub relays
+ * unchanged. Reported: candidate latency from sender to receiving hub, and
+ * what was dropped.
+ */
+
+#include "host_test.h"
+#include "uplink_mux.h"
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+// UPLINK_QUEUE_MAX in main.cpp on a board with PSRAM
+#define QUEUE_MAX  (16 * 1024)
+
+static bool allocFails;
+static uint32_t liveBlocks;
+
+static void* testAlloc(uint8_t, size_t size) {
+    if (allocFails) return NULL;
+    liveBlocks++;
+    return malloc(size);
+}
+
+static void testRelease(void* p) {
+    liveBlocks--;
+    free(p);
+}
+
+static const MemBackend testBackend = { testAlloc, testRelease };
+static MemPolicy mem;
+
+// Frames record their first byte, which the tests set to the stream key
+static std::vector<uint8_t> sentKeys;
+static std::vector<size_t> sentLens;
+
+static void recordSend(const uint8_t* data, size_t len) {
+    sentKeys.push_back(data[0]);
+    sentLens.push_back(len);
+}
+
+static bool push(UplinkMux* mux, uint32_t key, uint8_t priority, size_t len, uint32_t now) {
+    static uint8_t frame[2048];
+    memset(frame, key, len);
+    return uplinkMuxPush(mux, key, priority, frame, len, now);
+}
+
+static void testPriority() {
+    UplinkMux mux;
+    uplinkMuxInit(&mux, &mem, 0, 10000, 512, 100000, 0);
+
+    CHECK(uplinkMuxDirect(&mux, UPLINK_PRIO_BULK, 100, 0));
+    CHECK(push(&mux, 1, UPLINK_PRIO_BULK, 100, 0));
+    // Bulk now waits behind bulk; signaling doesn't
+    CHECK(!uplinkMuxDirect(&mux, UPLINK_PRIO_BULK, 100, 0));
+    CHECK(uplinkMuxDirect(&mux, UPLINK_PRIO_SIGNAL, 100, 0));
+    CHECK(push(&mux, 2, UPLINK_PRIO_SIGNAL, 100, 0));
+    CHECK(!uplinkMuxDirect(&mux, UPLINK_PRIO_SIGNAL, 100, 0));
+    CHECK(!uplinkMuxDirect(&mux, UPLINK_PRIO_BULK, 100, 0));
+    CHECK(push(&mux, 1, UPLINK_PRIO_BULK, 100, 0));
+    CHECK(push(&mux, 3, UPLINK_PRIO_SIGNAL, 100, 0));
+
+    sentKeys.clear();
+    uplinkMuxPoll(&mux, 0, recordSend);
+    CHECK_EQ(sentKeys.size(), 4u);
+    // Both signaling streams before any bulk, whatever the round-robin start
+    CHECK(sentKeys.size() == 4 && sentKeys[0] != 1 && sentKeys[1] != 1 && sentKeys[2] == 1 && sentKeys[3] == 1);
+    CHECK_EQ(mux.stats[UPLINK_PRIO_SIGNAL].direct, 1u);
+    CHECK_EQ(mux.stats[UPLINK_PRIO_SIGNAL].sent, 2u);
+    CHECK_EQ(mux.stats[UPLINK_PRIO_BULK].direct, 1u);
+    CHECK_EQ(mux.stats[UPLINK_PRIO_BULK].sent, 2u);
+    CHECK_EQ(mux.bytes, 0u);
+    CHECK(uplinkMuxDirect(&mux, UPLINK_PRIO_BULK, 100, 0));
+}
+
+// Two backlogged namespaces with 400 and 100 byte frames get equal bytes
+static void testFairness() {
+    UplinkMux mux;
+    uplinkMuxInit(&mux, &mem, 0, 4000, UPLINK_MUX_QUANTUM, 100000, 0);
+    for (int i = 0; i < UPLINK_MUX_DEPTH; i++) {
+        CHECK(push(&mux, 1, UPLINK_PRIO_BULK, 400, 0));
+        CHECK(push(&mux, 2, UPLINK_PRIO_BULK, 100, 0));
+    }
+
+    sentKeys.clear();
+    sentLens.clear();
+    uplinkMuxPoll(&mux, 0, recordSend);
+    // The credit ran out partway
+    CHECK(mux.pending[UPLINK_PRIO_BULK] > 0);
+    size_t bytes[3] = {0, 0, 0}, total = 0;
+    for (size_t i = 0; i < sentKeys.size(); i++) {
+        bytes[sentKeys[i]] += sentLens[i];
+        total += sentLens[i];
+        CHECK((size_t)std::max(bytes[1], bytes[2]) - std::min(bytes[1], bytes[2]) <= UPLINK_MUX_QUANTUM + 400);
+    }
+    CHECK(total >= 4000 && total < 4000 + 400);
+    CHECK(bytes[1] > 0 && bytes[2] > 0);
+    uplinkMuxClear(&mux);
+}
+
+static void testCredit() {
+    UplinkMux mux;
+    uplinkMuxInit(&mux, &mem, 1000, 1000, 512, 100000, 0);
+    CHECK(uplinkMuxDirect(&mux, UPLINK_PRIO_SIGNAL, 600, 0));
+    // A frame goes out while any credit is left, overdrawing it
+    CHECK(uplinkMuxDirect(&mux, UPLINK_PRIO_SIGNAL, 600, 0));
+    CHECK_EQ(mux.credit, -200);
+    CHECK(!uplinkMuxDirect(&mux, UPLINK_PRIO_SIGNAL, 1, 100));
+    CHECK(!uplinkMuxDirect(&mux, UPLINK_PRIO_SIGNAL, 1, 200));
+    CHECK(uplinkMuxDirect(&mux, UPLINK_PRIO_SIGNAL, 1, 201));
+    // Refill stops at the burst
+    CHECK(uplinkMuxDirect(&mux, UPLINK_PRIO_SIGNAL, 1000, 60000));
+    CHECK_EQ(mux.credit, 0);
+
+    // The queue drains as credit comes back
+    for (int i = 0; i < 4; i++) CHECK(push(&mux, 1, UPLINK_PRIO_BULK, 300, 60000));
+    sentKeys.clear();
+    uplinkMuxPoll(&mux, 60000, recordSend);
+    CHECK_EQ(sentKeys.size(), 0u);
+    uplinkMuxPoll(&mux, 60001, recordSend);  // 1 byte of credit: one frame
+    CHECK_EQ(sentKeys.size(), 1u);
+    uplinkMuxPoll(&mux, 60600, recordSend);  // -299 + 599 = 300: one more
+    CHECK_EQ(sentKeys.size(), 2u);
+    uplinkMuxPoll(&mux, 70000, recordSend);
+    CHECK_EQ(sentKeys.size(), 4u);
+    CHECK_EQ(mux.stats[UPLINK_PRIO_BULK].waitMsMax, 10000u);
+    CHECK_EQ(mux.stats[UPLINK_PRIO_BULK].waitMsTotal, 1u + 600 + 10000 + 10000);
+}
+
+static void testDrops() {
+    UplinkMux mux;
+    uplinkMuxInit(&mux, &mem, 0, 0, 512, 1000, 0);
+    uint32_t blocks = liveBlocks;
+
+    // maxBytes covers all streams together
+    CHECK(push(&mux, 1, UPLINK_PRIO_BULK, 400, 0));
+    CHECK(push(&mux, 2, UPLINK_PRIO_SIGNAL, 400, 0));
+    CHECK(!push(&mux, 3, UPLINK_PRIO_BULK, 400, 0));
+    CHECK(push(&mux, 3, UPLINK_PRIO_BULK, 200, 0));
+    CHECK(!push(&mux, 1, UPLINK_PRIO_SIGNAL, 1, 0));
+    CHECK_EQ(mux.bytes, 1000u);
+    CHECK_EQ(mux.stats[UPLINK_PRIO_BULK].dropped, 1u);
+    CHECK_EQ(mux.stats[UPLINK_PRIO_SIGNAL].dropped, 1u);
+    CHECK_EQ(liveBlocks, blocks + 3);
+    // A refused push doesn't keep a stream
+    int active = 0;
+    for (int i = 0; i < UPLINK_MUX_STREAMS; i++) active += mux.streams[i].active;
+    CHECK_EQ(active, 3);
+
+    // Clearing counts everything queued as dropped and frees it
+    uplinkMuxClear(&mux);
+    CHECK_EQ(mux.stats[UPLINK_PRIO_BULK].dropped, 3u);
+    CHECK_EQ(mux.stats[UPLINK_PRIO_SIGNAL].dropped, 2u);
+    CHECK_EQ(mux.bytes, 0u);
+    CHECK_EQ(mux.pending[UPLINK_PRIO_BULK] + mux.pending[UPLINK_PRIO_SIGNAL], 0);
+    CHECK_EQ(liveBlocks, blocks);
+
+    // Stream depth, then the stream table
+    uplinkMuxInit(&mux, &mem, 0, 0, 512, 100000, 0);
+    for (int i = 0; i < UPLINK_MUX_DEPTH; i++) CHECK(push(&mux, 1, UPLINK_PRIO_BULK, 10, 0));
+    CHECK(!push(&mux, 1, UPLINK_PRIO_BULK, 10, 0));
+    for (int key = 2; key <= UPLINK_MUX_STREAMS; key++) CHECK(push(&mux, key, UPLINK_PRIO_BULK, 10, 0));
+    CHECK(!push(&mux, 1, UPLINK_PRIO_SIGNAL, 10, 0));  // Same key, other priority: a new stream
+    CHECK(!push(&mux, 99, UPLINK_PRIO_BULK, 10, 0));
+    CHECK_EQ(mux.stats[UPLINK_PRIO_BULK].dropped, 2u);
+    CHECK_EQ(mux.stats[UPLINK_PRIO_SIGNAL].dropped, 1u);
+
+    // Out of memory
+    allocFails = true;
+    CHECK(!push(&mux, 2, UPLINK_PRIO_BULK, 10, 0));
+    allocFails = false;
+    CHECK_EQ(mux.stats[UPLINK_PRIO_BULK].dropped, 3u);
+    CHECK_EQ(mux.stats[UPLINK_PRIO_BULK].queued, (uint32_t)(UPLINK_MUX_DEPTH + UPLINK_MUX_STREAMS - 1));
+    uplinkMuxClear(&mux);
+    CHECK_EQ(liveBlocks, blocks);
+}
+
+// ============================================================================
+// Multi-hub simulation
+// ============================================================================
+
+#define HUBS            4
+#define SIM_MS          3000
+#define WIRE_UP_BPMS    128.0   // Hub uplink, bytes per ms: twice the mux rate
+#define WIRE_DOWN_BPMS  256.0   // Bootstrap hub to each hub
+#define ANNOUNCE_LEN    400
+#define CANDIDATE_LEN   200
+
+struct SimFrame {
+    int from;
+    int to;                 // -1: every other hub (announce)
+    bool candidate;
+    uint32_t createdMs;
+};
+
+struct Arrival {
+    double atMs;
+    int frame;
+};
+
+struct SimStats {
+    std::vector<double> candidateMs;
+    uint32_t candidatesDropped;
+    uint32_t announcesDropped;
+};
+
+static std::vector<SimFrame> simFrames;
+static std::deque<Arrival> atBootstrap;  // Kept in time order
+static double upFree[HUBS];
+static int sendingHub;
+static uint32_t simNow;
+
+static void putOnUplink(int hub, int frame, size_t len, uint32_t now) {
+    upFree[hub] = std::max(upFree[hub], (double)now) + len / WIRE_UP_BPMS;
+    Arrival a = { upFree[hub], frame };
+    auto pos = std::upper_bound(atBootstrap.begin(), atBootstrap.end(), a,
+                                [](const Arrival& x, const Arrival& y) { return x.atMs < y.atMs; });
+    atBootstrap.insert(pos, a);
+}
+
+static void muxSend(const uint8_t* data, size_t len) {
+    int frame;
+    memcpy(&frame, data, sizeof(frame));
+    putOnUplink(sendingHub, frame, len, simNow);
+}
+
+static SimStats simulate(bool useMux, int floodAnnounces) {
+    SimStats stats = {};
+    simFrames.clear();
+    atBootstrap.clear();
+    double downFree[HUBS] = {0};
+    UplinkMux muxes[HUBS];
+    for (int h = 0; h < HUBS; h++) {
+        upFree[h] = 0;
+        uplinkMuxInit(&muxes[h], &mem, UPLINK_MUX_RATE, UPLINK_MUX_BURST, UPLINK_MUX_QUANTUM,
+                      QUEUE_MAX, 0);
+    }
+
+    for (simNow = 0; simNow < SIM_MS; simNow++) {
+        // Frames created this ms: namespace key, priority, frame
+        struct Out { int hub; uint32_t key; uint8_t priority; size_t len; int frame; };
+        std::vector<Out> out;
+        auto create = [&](int from, int to, bool candidate, uint32_t key) {
+            simFrames.push_back({from, to, candidate, simNow});
+            out.push_back({from, key, (uint8_t)(candidate ? UPLINK_PRIO_SIGNAL : UPLINK_PRIO_BULK),
+                           (size_t)(candidate ? CANDIDATE_LEN : ANNOUNCE_LEN), (int)simFrames.size() - 1});
+        };
+
+        // Hot namespace 1: hubs 0 and 1 flood announces at 1/ms from t=500
+        if (simNow >= 500 && simNow < 500 + (uint32_t)floodAnnounces) {
+            create(0, -1, false, 1);
+            create(1, -1, false, 1);
+        }
+        // Namespaces 2-4: every hub sends a candidate to the next one every
+        // 10 ms, and announces now and then
+        for (int h = 0; h < HUBS; h++) {
+            uint32_t key = 2 + h % 3;
+            if ((simNow + h * 3) % 10 == 0) create(h, (h + 1) % HUBS, true, key);
+            if ((simNow + h * 37) % 250 == 0) create(h, -1, false, key);
+        }
+
+        for (const Out& o : out) {
+            if (!useMux) {
+                putOnUplink(o.hub, o.frame, o.len, simNow);
+                continue;
+            }
+            UplinkMux* mux = &muxes[o.hub];
+            if (uplinkMuxDirect(mux, o.priority, o.len, simNow)) {
+                putOnUplink(o.hub, o.frame, o.len, simNow);
+            } else {
+                uint8_t data[ANNOUNCE_LEN];
+                memset(data, 0, sizeof(data));
+                memcpy(data, &o.frame, sizeof(o.frame));
+                if (!uplinkMuxPush(mux, o.key, o.priority, data, o.len, simNow)) {
+                    if (o.priority == UPLINK_PRIO_SIGNAL) stats.candidatesDropped++;
+                    else stats.announcesDropped++;
+                }
+            }
+        }
+        if (useMux) {
+            for (int h = 0; h < HUBS; h++) {
+                sendingHub = h;
+                uplinkMuxPoll(&muxes[h], simNow, muxSend);
+            }
+        }
+
+        // The bootstrap hub relays in arrival order, one FIFO per downlink
+        while (!atBootstrap.empty() && atBootstrap.front().atMs <= simNow + 1) {
+            Arrival a = atBootstrap.front();
+            atBootstrap.pop_front();
+            const SimFrame& f = simFrames[a.frame];
+            size_t len = f.candidate ? CANDIDATE_LEN : ANNOUNCE_LEN;
+            for (int h = 0; h < HUBS; h++) {
+                if (h == f.from || (f.to >= 0 && h != f.to)) continue;
+                downFree[h] = std::max(downFree[h], a.atMs) + len / WIRE_DOWN_BPMS;
+                if (f.candidate) stats.candidateMs.push_back(downFree[h] - f.createdMs);
+            }
+        }
+    }
+    for (int h = 0; h < HUBS; h++) uplinkMuxClear(&muxes[h]);
+    return stats;
+}
+
+static void benchHubs() {
+    BENCH("%d hubs, hubs 0-1 flooding announces in one namespace, candidates elsewhere:\n", HUBS);
+    for (int flood : { 20, 120, 600 }) {
+        SimStats fifo = simulate(false, flood);
+        SimStats mux = simulate(true, flood);
+        for (SimStats* s : { &fifo, &mux }) std::sort(s->candidateMs.begin(), s->candidateMs.end());
+        auto p99 = [](const std::vector<double>& v) { return v[v.size() * 99 / 100]; };
+        auto avg = [](const std::vector<double>& v) {
+            double sum = 0;
+            for (double x : v) sum += x;
+            return sum / v.size();
+        };
+        BENCH("  %3d announces/hub: candidate latency  plain avg %6.1f p99 %6.1f max %6.1f ms\n",
+              flood, avg(fifo.candidateMs), p99(fifo.candidateMs), fifo.candidateMs.back());
+        BENCH("                                         mux   avg %6.1f p99 %6.1f max %6.1f ms,"
+              " %u announces dropped\n",
+              avg(mux.candidateMs), p99(mux.candidateMs), mux.candidateMs.back(), mux.announcesDropped);
+        CHECK_EQ(mux.candidatesDropped, 0u);
+        CHECK_EQ(mux.candidateMs.size(), fifo.candidateMs.size());
+        CHECK(mux.candidateMs.back() <= fifo.candidateMs.back());
+    }
+}
+
+int main() {
+    memPolicyInit(&mem, &testBackend, false, 0);
+    testPriority();
+    testFairness();
+    testCredit();
+    testDrops();
+    benchHubs();
+    CHECK_EQ(liveBlocks, 0u);
+    return testResult("test_uplink_mux");
+}
@@ -0,0 +1,257 @@
+/*
+ * PigeonHub host test - uplink frames over loopback TLS
+ *
+ * sendUplinkFrame (main.cpp) copies a frame behind header room and sends
+ * with headerToPayload, so the WebSockets client masks it in place and hands
+ * header and payload to TLS in one write: one record per frame. Before, a
+ * frame under 1400 bytes took a temporary malloc'd copy, and a larger one
+ * went out as two writes, header and payload, and so two records.
+ *
+ * Both paths send masked client frames over a real TLS 1.3 connection
+ * (OpenSSL, AES-128-GCM) on 127.0.0.1 to a server thread that unmasks and
+ * checks every frame. Reported per frame size: records per frame and
+ * throughput. The ESP32 runs mbedtls, so only the ratios carry over.
+ */
+
+#include "host_test.h"
+#include <openssl/ssl.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+// links2004 WebSockets.h
+#define WEBSOCKETS_MAX_HEADER_SIZE  14
+#define WS_INTERN_BUFFER_MAX        1400
+
+#define FRAME_MAX  8192
+
+static SSL_CTX* serverCtx;
+static SSL_CTX* clientCtx;
+static uint32_t recordsSent;
+
+static void countRecords(int write_p, int, int contentType, const void*, size_t, SSL*, void*) {
+    if (write_p && contentType == SSL3_RT_HEADER) recordsSent++;
+}
+
+static void makeContexts() {
+    EVP_PKEY* key = EVP_EC_gen("P-256");
+    X509* cert = X509_new();
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_set_pubkey(cert, key);
+    X509_NAME_add_entry_by_txt(X509_get_subject_name(cert), "CN", MBSTRING_ASC,
+                               (const unsigned char*)"pigeonhub.test", -1, -1, 0);
+    X509_set_issuer_name(cert, X509_get_subject_name(cert));
+    X509_sign(cert, key, EVP_sha256());
+
+    serverCtx = SSL_CTX_new(TLS_server_method());
+    SSL_CTX_use_certificate(serverCtx, cert);
+    SSL_CTX_use_PrivateKey(serverCtx, key);
+    SSL_CTX_set_min_proto_version(serverCtx, TLS1_3_VERSION);
+    SSL_CTX_set_ciphersuites(serverCtx, "TLS_AES_128_GCM_SHA256");
+
+    clientCtx = SSL_CTX_new(TLS_client_method());
+    SSL_CTX_set_verify(clientCtx, SSL_VERIFY_NONE, NULL);
+    SSL_CTX_set_min_proto_version(clientCtx, TLS1_3_VERSION);
+    SSL_CTX_set_ciphersuites(clientCtx, "TLS_AES_128_GCM_SHA256");
+    SSL_CTX_set_msg_callback(clientCtx, countRecords);
+
+    X509_free(cert);
+    EVP_PKEY_free(key);
+}
+
+static bool readFull(SSL* ssl, uint8_t* buf, size_t len) {
+    while (len > 0) {
+        int n = SSL_read(ssl, buf, len);
+        if (n <= 0) return false;
+        buf += n;
+        len -= n;
+    }
+    return true;
+}
+
+static uint8_t expectedByte(uint32_t frame, size_t i) {
+    return 'a' + (frame + i) % 26;
+}
+
+// Server side: unmasks `frames` text frames of `len` bytes and checks them
+static void serve(int fd, int frames, size_t len, int* bad) {
+    SSL* ssl = SSL_new(serverCtx);
+    SSL_set_fd(ssl, fd);
+    *bad = SSL_accept(ssl) == 1 ? 0 : frames;
+    static uint8_t payload[FRAME_MAX];
+    for (int f = 0; f < frames && *bad == 0; f++) {
+        uint8_t hdr[14];
+        if (!readFull(ssl, hdr, 2)) { *bad = frames; break; }
+        size_t n = hdr[1] & 0x7F, ext = n == 126 ? 2 : n == 127 ? 8 : 0;
+        if (!readFull(ssl, hdr + 2, ext + 4)) { *bad = frames; break; }
+        if (ext) {
+            n = 0;
+            for (size_t i = 0; i < ext; i++) n = n << 8 | hdr[2 + i];
+        }
+        const uint8_t* mask = hdr + 2 + ext;
+        if (hdr[0] != 0x81 || !(hdr[1] & 0x80) || n != len || !readFull(ssl, payload, n)) {
+            *bad = frames;
+            break;
+        }
+        for (size_t i = 0; i < n; i++) {
+            if ((payload[i] ^ mask[i % 4]) != expectedByte(f, i)) {
+                (*bad)++;
+                break;
+            }
+        }
+    }
+    SSL_shutdown(ssl);
+    SSL_free(ssl);
+    close(fd);
+}
+
+// Masked client frame header, as WebSockets::createHeader writes it
+static size_t frameHeader(uint8_t* out, size_t len, const uint8_t* mask) {
+    out[0] = 0x81;
+    size_t n;
+    if (len < 126) {
+        out[1] = 0x80 | len;
+        n = 2;
+    } else if (len <= 0xFFFF) {
+        out[1] = 0x80 | 126;
+        out[2] = len >> 8;
+        out[3] = len;
+        n = 4;
+    } else {
+        out[1] = 0x80 | 127;
+        for (int i = 0; i < 8; i++) out[2 + i] = (uint64_t)len >> (56 - 8 * i);
+        n = 10;
+    }
+    memcpy(out + n, mask, 4);
+    return n + 4;
+}
+
+static void maskPayload(uint8_t* p, size_t len, const uint8_t* mask) {
+    for (size_t i = 0; i < len; i++) p[i] ^= mask[i % 4];
+}
+
+// WebSockets::sendFrame as bootstrapHub.sendTXT(frame, len) used it
+static void sendBefore(SSL* ssl, const uint8_t* frame, size_t len, const uint8_t* mask) {
+    uint8_t header[WEBSOCKETS_MAX_HEADER_SIZE];
+    size_t headerLen = frameHeader(header, len, mask);
+    if (len < WS_INTERN_BUFFER_MAX) {
+        uint8_t* buf = (uint8_t*)malloc(WEBSOCKETS_MAX_HEADER_SIZE + len);
+        uint8_t* payload = buf + WEBSOCKETS_MAX_HEADER_SIZE;
+        memcpy(payload, frame, len);
+        maskPayload(payload, len, mask);
+        memcpy(payload - headerLen, header, headerLen);
+        SSL_write(ssl, payload - headerLen, headerLen + len);
+        free(buf);
+    } else {
+        // The library masks the caller's buffer in place; frame is const here
+        static uint8_t masked[FRAME_MAX];
+        memcpy(masked, frame, len);
+        maskPayload(masked, len, mask);
+        SSL_write(ssl, header, headerLen);
+        SSL_write(ssl, masked, len);
+    }
+}
+
+// WebSockets::sendFrame with headerToPayload: `payload` is the start of
+// WEBSOCKETS_MAX_HEADER_SIZE reserved bytes with `len` bytes of data behind
+// them. The data is masked in place and the header written at the end of
+// the reserved bytes, so both go out in one write.
+static void sendInPlace(SSL* ssl, uint8_t* payload, size_t len, const uint8_t* mask) {
+    uint8_t header[WEBSOCKETS_MAX_HEADER_SIZE];
+    size_t headerLen = frameHeader(header, len, mask);
+    maskPayload(payload + WEBSOCKETS_MAX_HEADER_SIZE, len, mask);
+    uint8_t* headerPtr = payload + WEBSOCKETS_MAX_HEADER_SIZE - headerLen;
+    memcpy(headerPtr, header, headerLen);
+    SSL_write(ssl, headerPtr, headerLen + len);
+}
+
+// sendUplinkFrame: the frame copied behind header room in the event arena,
+// and the start of the room handed to the library
+static void sendAfter(SSL* ssl, const uint8_t* frame, size_t len, const uint8_t* mask) {
+    static uint8_t arena[WEBSOCKETS_MAX_HEADER_SIZE + FRAME_MAX];
+    memcpy(arena + WEBSOCKETS_MAX_HEADER_SIZE, frame, len);
+    sendInPlace(ssl, arena, len, mask);
+}
+
+struct RunResult {
+    double recordsPerFrame;
+    double mbps;
+    int bad;
+};
+
+static RunResult run(bool after, size_t len, int frames) {
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addrLen = sizeof(addr);
+    CHECK(bind(listener, (sockaddr*)&addr, sizeof(addr)) == 0);
+    CHECK(listen(listener, 1) == 0);
+    getsockname(listener, (sockaddr*)&addr, &addrLen);
+
+    int bad = 0;
+    std::thread server([&] {
+        int fd = accept(listener, NULL, NULL);
+        serve(fd, frames, len, &bad);
+    });
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));  // As lwIP sends
+    CHECK(connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0);
+    SSL* ssl = SSL_new(clientCtx);
+    SSL_set_fd(ssl, fd);
+    CHECK(SSL_connect(ssl) == 1);
+
+    static uint8_t frame[FRAME_MAX];
+    const uint8_t mask[4] = { 0x37, 0xfa, 0x21, 0x3d };
+    recordsSent = 0;
+    uint64_t start = testNowNs();
+    for (int f = 0; f < frames; f++) {
+        for (size_t i = 0; i < len; i++) frame[i] = expectedByte(f, i);
+        if (after) sendAfter(ssl, frame, len, mask);
+        else sendBefore(ssl, frame, len, mask);
+    }
+    uint32_t records = recordsSent;
+    server.join();
+    uint64_t ns = testNowNs() - start;
+
+    SSL_free(ssl);
+    close(fd);
+    close(listener);
+    RunResult r = { (double)records / frames, (double)len * frames * 1000.0 / ns, bad };
+    return r;
+}
+
+int main() {
+    makeContexts();
+
+    // Typical uplink traffic: an announce, an ICE candidate, an offer, a large SDP
+    const size_t sizes[] = { 200, 700, 1400, 4000 };
+    const int frames = 20000;
+    BENCH("uplink frames over loopback TLS 1.3 (AES-128-GCM), %d frames each:\n", frames);
+    for (size_t len : sizes) {
+        RunResult before = run(false, len, frames);
+        RunResult after = run(true, len, frames);
+        CHECK_EQ(before.bad, 0);
+        CHECK_EQ(after.bad, 0);
+        CHECK(after.recordsPerFrame == 1.0);
+        CHECK(before.recordsPerFrame == (len < WS_INTERN_BUFFER_MAX ? 1.0 : 2.0));
+        BENCH("  %4zu B: before %.0f record(s)/frame %7.1f MB/s   after %.0f record/frame %7.1f MB/s\n",
+              len, before.recordsPerFrame, before.mbps, after.recordsPerFrame, after.mbps);
+    }
+
+    SSL_CTX_free(serverCtx);
+    SSL_CTX_free(clientCtx);
+    return testResult("test_uplink_tls");
+}
@@ -0,0 +1,214 @@
+/*
+ * PigeonHub host test - warm_state.cpp
+ *
+ * Round trip, and every rejection the header promises: CRC, version,
+ * magic, truncated blob and a payload length that does not match the layout.
+ * A full remote peer cache goes through saveWarmState()/restoreWarmState()
+ * as main.cpp does it and comes back with its ages.
+ */
+
+#include "host_test.h"
+#include "warm_state.h"
+#include "remote_peer_cache.h"
+#include <string.h>
+
+static void fillState(WarmState* state) {
+    memset(state, 0, sizeof(*state));
+    strcpy(state->hubPeerId, "0123456789abcdef0123456789abcdef01234567");
+    strcpy(state->uplinkHost, "pigeonhub.fly.dev");
+    state->uplinkPort = 443;
+    strcpy(state->namespaces[0], "global");
+    strcpy(state->namespaces[NAMESPACE_MAX - 1], "lab");
+    state->counters.boots = 7;
+    state->counters.warmBoots = 6;
+    state->counters.framesIn = 0xDEADBEEF;
+    state->counters.framesRelayed = 12345;
+    state->counters.framesUplinked = 42;
+    state->counters.relayMisses = 3;
+}
+
+static void testRoundTrip() {
+    WarmState in, out;
+    uint8_t blob[WARM_STATE_BLOB_SIZE];
+    fillState(&in);
+
+    size_t len = warmStateEncode(&in, blob, sizeof(blob));
+    CHECK(len > WARM_STATE_HEADER_SIZE);
+    CHECK(len <= WARM_STATE_BLOB_SIZE);
+
+    memset(&out, 0xAA, sizeof(out));
+    out.remotePeers = NULL;
+    CHECK(warmStateDecode(blob, len, &out));
+    CHECK(strcmp(out.hubPeerId, in.hubPeerId) == 0);
+    CHECK(strcmp(out.uplinkHost, in.uplinkHost) == 0);
+    CHECK_EQ(out.uplinkPort, 443);
+    CHECK(strcmp(out.namespaces[0], "global") == 0);
+    CHECK(strcmp(out.namespaces[NAMESPACE_MAX - 1], "lab") == 0);
+    CHECK_EQ(out.namespaces[1][0], 0);
+    CHECK(memcmp(&out.counters, &in.counters, sizeof(in.counters)) == 0);
+
+    // Trailing RTC bytes past the blob are ignored
+    CHECK(warmStateDecode(blob, sizeof(blob), &out));
+
+    // Encoding needs room for the whole blob
+    CHECK_EQ(warmStateEncode(&in, blob, len - 1), 0);
+    CHECK_EQ(warmStateEncode(&in, blob, WARM_STATE_HEADER_SIZE - 1), 0);
+}
+
+// Unterminated strings are re-terminated rather than overrunning
+static void testStringsTerminated() {
+    WarmState in, out;
+    uint8_t blob[WARM_STATE_BLOB_SIZE];
+    fillState(&in);
+    memset(in.uplinkHost, 'x', sizeof(in.uplinkHost));
+
+    size_t len = warmStateEncode(&in, blob, sizeof(blob));
+    CHECK(warmStateDecode(blob, len, &out));
+    CHECK_EQ(strlen(out.uplinkHost), WARM_UPLINK_HOST_LEN - 1);
+}
+
+static void testCorruption() {
+    WarmState in, out;
+    uint8_t blob[WARM_STATE_BLOB_SIZE];
+    fillState(&in);
+    size_t len = warmStateEncode(&in, blob, sizeof(blob));
+
+    // Any flipped payload bit fails the CRC, and out is left untouched
+    for (size_t i = WARM_STATE_HEADER_SIZE; i < len; i += 17) {
+        blob[i] ^= 0x10;
+        memset(&out, 0x5A, sizeof(out));
+        CHECK(!warmStateDecode(blob, len, &out));
+        CHECK_EQ(((uint8_t*)&out)[0], 0x5A);
+        blob[i] ^= 0x10;
+    }
+    CHECK(warmStateDecode(blob, len, &out));
+
+    // So does a flipped CRC byte
+    blob[8] ^= 1;
+    CHECK(!warmStateDecode(blob, len, &out));
+    blob[8] ^= 1;
+
+    // Power-on garbage
+    uint8_t zeros[WARM_STATE_BLOB_SIZE] = {0};
+    CHECK(!warmStateDecode(zeros, sizeof(zeros), &out));
+    blob[0] ^= 0xFF;
+    CHECK(!warmStateDecode(blob, len, &out));
+}
+
+static void testVersionMismatch() {
+    WarmState in, out;
+    uint8_t blob[WARM_STATE_BLOB_SIZE];
+    fillState(&in);
+    size_t len = warmStateEncode(&in, blob, sizeof(blob));
+
+    // The version is outside the CRC; it must be checked on its own
+    blob[4] = WARM_STATE_VERSION + 1;
+    CHECK(!warmStateDecode(blob, len, &out));
+    blob[4] = WARM_STATE_VERSION - 1;
+    CHECK(!warmStateDecode(blob, len, &out));
+    blob[4] = WARM_STATE_VERSION;
+    CHECK(warmStateDecode(blob, len, &out));
+}
+
+static void testTruncated() {
+    WarmState in, out;
+    uint8_t blob[WARM_STATE_BLOB_SIZE];
+    fillState(&in);
+    size_t len = warmStateEncode(&in, blob, sizeof(blob));
+
+    for (size_t cut = 0; cut < len; cut++) {
+        CHECK(!warmStateDecode(blob, cut, &out));
+    }
+
+    // A shorter payload with a valid CRC (an older, smaller layout) is a
+    // layout mismatch, not a partial restore
+    size_t shortPayload = len - WARM_STATE_HEADER_SIZE - 4;
+    blob[6] = (uint8_t)shortPayload;
+    blob[7] = (uint8_t)(shortPayload >> 8);
+    uint32_t crc = warmStateCrc32(blob + WARM_STATE_HEADER_SIZE, shortPayload);
+    for (int i = 0; i < 4; i++) blob[8 + i] = (uint8_t)(crc >> (8 * i));
+    CHECK(!warmStateDecode(blob, len, &out));
+
+    // And a longer one (a newer layout)
+    size_t longPayload = len - WARM_STATE_HEADER_SIZE + 4;
+    memset(blob + len, 0, 4);
+    blob[6] = (uint8_t)longPayload;
+    blob[7] = (uint8_t)(longPayload >> 8);
+    crc = warmStateCrc32(blob + WARM_STATE_HEADER_SIZE, longPayload);
+    for (int i = 0; i < 4; i++) blob[8 + i] = (uint8_t)(crc >> (8 * i));
+    CHECK(!warmStateDecode(blob, len + 4, &out));
+}
+
+static void testRemotePeers() {
+    WarmState in, out;
+    uint8_t blob[WARM_STATE_BLOB_SIZE];
+    fillState(&in);
+
+    // Every slot taken, with the longest data the cache keeps; entry i is
+    // 121 - i seconds old at the save, so 0 and 1 have expired
+    RemotePeerCache cache;
+    remoteCacheInit(&cache, 120000);
+    char data[REMOTE_CACHE_DATA_MAX];
+    memset(data, 'd', sizeof(data) - 1);
+    for (int i = 0; i < REMOTE_CACHE_SLOTS; i++) {
+        uint8_t id[REMOTE_CACHE_ID_LEN] = { (uint8_t)i };
+        const char* ns = i % 2 ? "lab" : "global";
+        CHECK(remoteCachePut(&cache, ns, strlen(ns), id, (uint8_t)i, data, sizeof(data) - 1 - i, 1000 * i));
+    }
+    in.remotePeers = &cache;
+    in.nowMs = 121000;
+    size_t len = warmStateEncode(&in, blob, sizeof(blob));
+    CHECK(len > 0 && len <= WARM_STATE_BLOB_SIZE);
+
+    // Restored on a clock that started over, by a firmware with a shorter
+    // TTL: entries 2..6 are past it
+    RemotePeerCache restored;
+    remoteCacheInit(&restored, 115000);
+    out.remotePeers = &restored;
+    out.nowMs = 3000;
+    CHECK(warmStateDecode(blob, len, &out));
+    CHECK(out.remotePeers == &restored);
+    CHECK_EQ(remoteCacheSize(&restored), REMOTE_CACHE_SLOTS - 7);
+
+    RemotePeer* found[REMOTE_CACHE_SLOTS];
+    int n = remoteCacheCollect(&restored, "lab", 3, out.nowMs, found, REMOTE_CACHE_SLOTS);
+    CHECK_EQ(n, 9);  // 7, 9 ... 23
+    for (int i = 0; i < n; i++) {
+        int index = found[i]->id[0];
+        CHECK(index % 2 == 1 && index >= 7);
+        CHECK_EQ(found[i]->flags, index);
+        CHECK_EQ(out.nowMs - found[i]->seenMs, in.nowMs - 1000u * index);
+        CHECK_EQ(strlen(found[i]->data), sizeof(data) - 1 - index);
+    }
+
+    // Decoding without a cache skips them
+    out.remotePeers = NULL;
+    CHECK(warmStateDecode(blob, len, &out));
+    CHECK(strcmp(out.hubPeerId, in.hubPeerId) == 0);
+
+    // A count past the cache is a layout mismatch, even with a valid CRC
+    size_t countAt = WARM_STATE_HEADER_SIZE + WARM_PEER_ID_LEN + WARM_UPLINK_HOST_LEN + 2 +
+                     sizeof(in.namespaces) + sizeof(in.counters);
+    CHECK_EQ(blob[countAt], REMOTE_CACHE_SLOTS - 2);
+    blob[countAt] = REMOTE_CACHE_SLOTS + 1;
+    uint32_t crc = warmStateCrc32(blob + WARM_STATE_HEADER_SIZE, len - WARM_STATE_HEADER_SIZE);
+    for (int i = 0; i < 4; i++) blob[8 + i] = (uint8_t)(crc >> (8 * i));
+    CHECK(!warmStateDecode(blob, len, &out));
+}
+
+static void testCrc32() {
+    // Standard check value for CRC-32/ISO-HDLC
+    CHECK_EQ(warmStateCrc32((const uint8_t*)"123456789", 9), 0xCBF43926u);
+    CHECK_EQ(warmStateCrc32(NULL, 0), 0);
+}
+
+int main() {
+    testRoundTrip();
+    testStringsTerminated();
+    testCorruption();
+    testVersionMismatch();
+    testTruncated();
+    testRemotePeers();
+    testCrc32();
+    return testResult("test_warm_state");
+}
@@ -0,0 +1,156 @@
+/*
+ * PigeonHub host test - wasm_image.cpp
+ *
+ * The LZ4 block decoder on hand-built blocks: literals, overlapping matches
+ * and length extensions, then input cut short at every byte, match offsets
+ * of zero or before the start of the output, output that doesn't fit, and
+ * random blocks. Nothing may be written past the destination. Then the
+ * image header: magic, and a raw size that disagrees with the block or
+ * doesn't fit the buffer.
+ */
+
+#include "host_test.h"
+#include "wasm_image.h"
+#include <string.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#define GUARD       0xA5
+#define GUARD_LEN   64
+
+typedef std::vector<uint8_t> Bytes;
+
+// "abcd", a match 4 back of 8 bytes, then "xyz12" as the last literals
+static const Bytes BLOCK = { 0x44, 'a', 'b', 'c', 'd', 0x04, 0x00, 0x50, 'x', 'y', 'z', '1', '2' };
+static const char BLOCK_OUT[] = "abcdabcdabcdxyz12";
+
+// Decodes into a dstLen buffer followed by guard bytes, which must survive
+static int decode(const Bytes& src, size_t dstLen, std::string* out = NULL) {
+    std::vector<uint8_t> dst(dstLen + GUARD_LEN, GUARD);
+    int n = lz4DecodeBlock(src.data(), src.size(), dst.data(), dstLen);
+    for (size_t i = dstLen; i < dst.size(); i++) CHECK_EQ(dst[i], GUARD);
+    CHECK(n <= (int)dstLen);
+    if (out && n >= 0) out->assign((const char*)dst.data(), n);
+    return n;
+}
+
+static Bytes image(uint32_t rawSize, const Bytes& block) {
+    Bytes img = { 'P', 'H', 'W', '2' };
+    for (int i = 0; i < 4; i++) img.push_back((uint8_t)(rawSize >> (8 * i)));
+    for (int i = 0; i < WASM_IMAGE_BUILD_ID_LEN; i++) img.push_back((uint8_t)(0x10 + i));
+    img.insert(img.end(), block.begin(), block.end());
+    return img;
+}
+
+static void testDecode() {
+    std::string out;
+    CHECK_EQ(decode(BLOCK, 64, &out), 17);
+    CHECK(out == BLOCK_OUT);
+    CHECK_EQ(decode(BLOCK, 17, &out), 17);  // Exactly enough room
+
+    // A match overlapping its own output repeats it
+    CHECK_EQ(decode({ 0x16, 'a', 0x01, 0x00, 0x10, 'z' }, 64, &out), 12);
+    CHECK(out == "aaaaaaaaaaaz");
+
+    // Length extensions: 15 + 255 + 0 literals, then a 4 + 15 + 1 byte match
+    Bytes lit = { 0xFF, 255, 0 };
+    for (int i = 0; i < 270; i++) lit.push_back((uint8_t)('a' + i % 26));
+    lit.insert(lit.end(), { 26, 0, 1, 0x10, '!' });
+    CHECK_EQ(decode(lit, 512, &out), 270 + 20 + 1);
+    CHECK(out.compare(270, 20, out, 244, 20) == 0);
+
+    CHECK_EQ(decode({}, 16), 0);
+    CHECK_EQ(decode({ 0x00 }, 16), 0);
+}
+
+static void testTruncated() {
+    // Cut inside the first literals, the offset or the last token: an error.
+    // Cut right after a sequence's literals: a valid but shorter block.
+    for (size_t len = 1; len < BLOCK.size(); len++) {
+        Bytes cut(BLOCK.begin(), BLOCK.begin() + len);
+        std::string out;
+        int n = decode(cut, 64, &out);
+        if (len == 5) {
+            CHECK_EQ(n, 4);
+        } else if (len == 7) {
+            CHECK_EQ(n, 12);
+        } else {
+            CHECK_EQ(n, -1);
+        }
+    }
+
+    // A length extension that runs off the end
+    CHECK_EQ(decode({ 0xF0, 255, 255 }, 1024), -1);
+    CHECK_EQ(decode({ 0x1F, 'a', 0x01, 0x00, 255 }, 1024), -1);
+}
+
+static void testBadOffset() {
+    CHECK_EQ(decode({ 0x44, 'a', 'b', 'c', 'd', 0x00, 0x00, 0x00 }, 64), -1);  // Zero
+    CHECK_EQ(decode({ 0x44, 'a', 'b', 'c', 'd', 0x05, 0x00, 0x00 }, 64), -1);  // Before the output
+    CHECK_EQ(decode({ 0x44, 'a', 'b', 'c', 'd', 0x04, 0x00, 0x00 }, 64), 12);  // Its first byte
+    CHECK_EQ(decode({ 0x04, 0x01, 0x00, 0x00 }, 64), -1);                      // Nothing written yet
+    CHECK_EQ(decode({ 0x44, 'a', 'b', 'c', 'd', 0xFF, 0xFF, 0x00 }, 64), -1);
+}
+
+static void testOutputFull() {
+    CHECK_EQ(decode(BLOCK, 3), -1);   // Literals don't fit
+    CHECK_EQ(decode(BLOCK, 11), -1);  // The match doesn't
+    CHECK_EQ(decode(BLOCK, 16), -1);  // The last literals don't
+    CHECK_EQ(decode(BLOCK, 0), -1);
+}
+
+static void testRandom() {
+    std::mt19937 rng(76);
+    int decoded = 0;
+    for (int round = 0; round < 20000; round++) {
+        Bytes src(rng() % 64);
+        for (uint8_t& b : src) b = (uint8_t)rng();
+        // A short first literal run, so some blocks get past the first match
+        if (src.size() > 3 && round % 2) src[0] &= 0x1F;
+        if (decode(src, rng() % 256) >= 0) decoded++;
+    }
+    CHECK(decoded > 0);
+}
+
+static void testImage() {
+    Bytes img = image(17, BLOCK);
+    uint8_t dst[64];
+    CHECK_EQ(wasmImageRawSize(img.data(), img.size()), 17u);
+    CHECK_EQ(wasmImageInflate(img.data(), img.size(), dst, sizeof(dst)), 17u);
+    CHECK(memcmp(dst, BLOCK_OUT, 17) == 0);
+
+    char id[WASM_IMAGE_BUILD_ID_LEN * 2 + 1];
+    CHECK(wasmImageBuildId(img.data(), img.size(), id, sizeof(id)));
+    CHECK(strcmp(id, "1011121314151617") == 0);
+    CHECK(!wasmImageBuildId(img.data(), img.size(), id, sizeof(id) - 1));
+
+    // The header's size has to match what the block decodes to
+    img = image(16, BLOCK);
+    CHECK_EQ(wasmImageInflate(img.data(), img.size(), dst, sizeof(dst)), 0u);
+    img = image(18, BLOCK);
+    CHECK_EQ(wasmImageInflate(img.data(), img.size(), dst, sizeof(dst)), 0u);
+    img = image(17, BLOCK);
+    CHECK_EQ(wasmImageInflate(img.data(), img.size(), dst, 16), 0u);
+    CHECK_EQ(wasmImageInflate(img.data(), img.size() - 1, dst, sizeof(dst)), 0u);
+
+    img = image(0, {});
+    CHECK_EQ(wasmImageRawSize(img.data(), img.size()), 0u);
+    CHECK_EQ(wasmImageInflate(img.data(), img.size(), dst, sizeof(dst)), 0u);
+
+    img = image(17, BLOCK);
+    img[3] = '1';
+    CHECK_EQ(wasmImageRawSize(img.data(), img.size()), 0u);
+    CHECK_EQ(wasmImageRawSize(img.data(), WASM_IMAGE_HEADER_SIZE - 1), 0u);
+    CHECK_EQ(wasmImageRawSize(NULL, 0), 0u);
+}
+
+int main() {
+    testDecode();
+    testTruncated();
+    testBadOffset();
+    testOutputFull();
+    testRandom();
+    testImage();
+    return testResult("test_wasm_image");
+}
@@ -0,0 +1,287 @@
+/*
+ * PigeonHub host test - wasm_slot.cpp
+ *
+ * Hot-swap migration between two slots. pigeonhub_client.c is compiled in
+ * twice (one namespace per slot, so each has its own ServerState) and
+ * exposed through the wasm3 stand-in in wasm3_fake/. Covers the snapshot
+ * round trip, restore rejecting a snapshot of another version, a new module
+ * without restore, and memory that moves while the snapshot is staged.
+ */
+
+#include "host_test.h"
+#include "wasm_slot.h"
+#include "m3_env.h"
+#include <stdlib.h>
+#include <string.h>
+
+static uint32_t testMillis = 1000;
+
+#define HOST_IMPORTS \
+    int ws_server_start(int port) { return 0; } \
+    void ws_server_stop() {} \
+    int ws_send_to_peer(int peer_id, const char* data, int data_len) { return data_len; } \
+    int ws_broadcast(const char* data, int data_len, int exclude_peer_id) { return data_len; } \
+    void log_message(const char* msg, int msg_len) {} \
+    void get_device_id(char* buffer, int buffer_len) { snprintf(buffer, buffer_len, "test-device"); } \
+    uint32_t millis() { return testMillis; }
+
+namespace hubOld {
+#include "../pigeonhub_client.c"
+HOST_IMPORTS
+void get_build_id(char* buffer, int buffer_len) { snprintf(buffer, buffer_len, "old"); }
+}
+
+namespace hubNew {
+#include "../pigeonhub_client.c"
+HOST_IMPORTS
+void get_build_id(char* buffer, int buffer_len) { snprintf(buffer, buffer_len, "new"); }
+}
+
+// Export wrappers: i32 arguments, pointers are offsets into the runtime's memory
+#define MODULE_EXPORTS(ns) \
+    static M3Result ns##Init(IM3Runtime rt, const int32_t* a, int32_t* r) { *r = ns::init(); return m3Err_none; } \
+    static M3Result ns##Start(IM3Runtime rt, const int32_t* a, int32_t* r) { *r = ns::start_server(a[0]); return m3Err_none; } \
+    static M3Result ns##Connected(IM3Runtime rt, const int32_t* a, int32_t* r) { ns::on_peer_connected(a[0]); return m3Err_none; } \
+    static M3Result ns##Disconnected(IM3Runtime rt, const int32_t* a, int32_t* r) { ns::on_peer_disconnected(a[0]); return m3Err_none; } \
+    static M3Result ns##Loop(IM3Runtime rt, const int32_t* a, int32_t* r) { ns::loop(); return m3Err_none; } \
+    static M3Result ns##Message(IM3Runtime rt, const int32_t* a, int32_t* r) { \
+        uint8_t* msg = fakeWasmPtr(rt, a[1], a[2]); \
+        if (!msg) return m3Err_trapOutOfBoundsMemoryAccess; \
+        ns::on_message(a[0], (const char*)msg, a[2]); \
+        return m3Err_none; \
+    } \
+    static M3Result ns##Snapshot(IM3Runtime rt, const int32_t* a, int32_t* r) { \
+        uint8_t* buf = fakeWasmPtr(rt, a[0], a[1]); \
+        if (!buf) return m3Err_trapOutOfBoundsMemoryAccess; \
+        *r = ns::snapshot((char*)buf, a[1]); \
+        return m3Err_none; \
+    } \
+    static M3Result ns##Restore(IM3Runtime rt, const int32_t* a, int32_t* r) { \
+        uint8_t* buf = fakeWasmPtr(rt, a[0], a[1]); \
+        if (!buf) return m3Err_trapOutOfBoundsMemoryAccess; \
+        *r = ns::restore((const char*)buf, a[1]); \
+        return m3Err_none; \
+    }
+
+MODULE_EXPORTS(hubOld)
+MODULE_EXPORTS(hubNew)
+
+static M3Result wasmMalloc(IM3Runtime rt, const int32_t* a, int32_t* r) {
+    *r = (int32_t)fakeWasmAlloc(rt, (uint32_t)a[0]);
+    return m3Err_none;
+}
+
+static M3Result wasmFree(IM3Runtime rt, const int32_t* a, int32_t* r) {
+    return m3Err_none;
+}
+
+// A module from a future build whose snapshot layout is version 2
+static M3Result futureSnapshot(IM3Runtime rt, const int32_t* a, int32_t* r) {
+    uint8_t* buf = fakeWasmPtr(rt, a[0], a[1]);
+    if (!buf) return m3Err_trapOutOfBoundsMemoryAccess;
+    hubOld::SnapshotHeader header = {0};
+    header.version = 2;
+    header.server_running = 1;
+    memcpy(buf, &header, sizeof(header));
+    *r = sizeof(header);
+    return m3Err_none;
+}
+
+#define REQUIRED_EXPORTS(ns) \
+    { "init", ns##Init, 0 }, \
+    { "start_server", ns##Start, 1 }, \
+    { "on_peer_connected", ns##Connected, 1 }, \
+    { "on_peer_disconnected", ns##Disconnected, 1 }, \
+    { "on_message", ns##Message, 3 }, \
+    { "loop", ns##Loop, 0 }, \
+    { "malloc", wasmMalloc, 1 }, \
+    { "free", wasmFree, 1 }
+
+static const FakeExport oldExports[] = {
+    REQUIRED_EXPORTS(hubOld),
+    { "snapshot", hubOldSnapshot, 2 },
+    { "restore", hubOldRestore, 2 },
+    { NULL, NULL, 0 }
+};
+
+static const FakeExport newExports[] = {
+    REQUIRED_EXPORTS(hubNew),
+    { "snapshot", hubNewSnapshot, 2 },
+    { "restore", hubNewRestore, 2 },
+    { NULL, NULL, 0 }
+};
+
+// A pre-snapshot module (baseline builds export neither call)
+static const FakeExport legacyExports[] = {
+    REQUIRED_EXPORTS(hubNew),
+    { NULL, NULL, 0 }
+};
+
+static const FakeExport futureExports[] = {
+    REQUIRED_EXPORTS(hubOld),
+    { "snapshot", futureSnapshot, 2 },
+    { NULL, NULL, 0 }
+};
+
+static M3Result loadSlot(WasmSlot* slot, const char* name) {
+    size_t len = strlen(name);
+    uint8_t* buf = (uint8_t*)malloc(len);
+    memcpy(buf, name, len);
+    M3Result result = wasmSlotLoad(slot, buf, len, 8192, 256 * 1024, NULL);
+    if (!result) result = m3_CallV(slot->init);
+    return result;
+}
+
+static void sendJoin(WasmSlot* slot, int peer, const char* peerId) {
+    char json[128];
+    int len = snprintf(json, sizeof(json), "{\"type\":\"join\",\"peerId\":\"%s\"}", peerId);
+    uint32_t ptr = fakeWasmAlloc(slot->runtime, len + 1);
+    memcpy(fakeWasmPtr(slot->runtime, ptr, len + 1), json, len + 1);
+    CHECK(m3_CallV(slot->onMessage, peer, ptr, len) == m3Err_none);
+}
+
+// Old module with `peers` connected, joined and some traffic counted
+static void bringUpOld(WasmSlot* slot, int peers) {
+    memset(&hubOld::state, 0, sizeof(hubOld::state));
+    CHECK(loadSlot(slot, "old") == m3Err_none);
+    CHECK(m3_CallV(slot->startServer, 3000) == m3Err_none);
+    for (int i = 0; i < peers; i++) {
+        char peerId[64];
+        snprintf(peerId, sizeof(peerId), "%040d", 7000 + i);
+        CHECK(m3_CallV(slot->onPeerConnected, 100 + i) == m3Err_none);
+        sendJoin(slot, 100 + i, peerId);
+    }
+    CHECK_EQ(hubOld::get_peer_count(), peers);
+}
+
+static void testRoundTrip() {
+    WasmSlot prev, next;
+    testMillis = 1000;
+    bringUpOld(&prev, 5);
+    testMillis = 2500;
+    memset(&hubNew::state, 0, sizeof(hubNew::state));
+    CHECK(loadSlot(&next, "new") == m3Err_none);
+    CHECK(next.snapshot && next.restore);
+    CHECK_EQ(hubNew::get_peer_count(), 0);
+
+    CHECK(wasmSlotMigrate(&prev, &next) == m3Err_none);
+    CHECK(hubNew::is_running());
+    CHECK_EQ(hubNew::state.port, 3000);
+    CHECK_EQ(hubNew::get_peer_count(), 5);
+    CHECK_EQ(hubNew::state.messages_received, hubOld::state.messages_received);
+    CHECK_EQ(hubNew::state.start_time, 1000);
+    CHECK(strcmp(hubNew::state.build_id, "new") == 0);
+    for (int i = 0; i < 5; i++) {
+        char peerId[64];
+        snprintf(peerId, sizeof(peerId), "%040d", 7000 + i);
+        hubNew::PeerConnection* peer = hubNew::find_peer(100 + i);
+        CHECK(peer != NULL);
+        if (peer) CHECK(strcmp(peer->client_peer_id, peerId) == 0);
+    }
+
+    // The migrated peers keep working in the new module
+    CHECK(m3_CallV(next.onPeerDisconnected, 102) == m3Err_none);
+    CHECK_EQ(hubNew::get_peer_count(), 4);
+    // ...and the old module was left intact
+    CHECK_EQ(hubOld::get_peer_count(), 5);
+
+    wasmSlotFree(&prev);
+    wasmSlotFree(&next);
+}
+
+// The snapshot is staged through host memory because restore's malloc may
+// grow (and move) the new module's memory
+static void testMemoryMoves() {
+    WasmSlot prev, next;
+    bringUpOld(&prev, MAX_PEERS);
+    memset(&hubNew::state, 0, sizeof(hubNew::state));
+    CHECK(loadSlot(&next, "new") == m3Err_none);
+
+    fakeWasmAlloc(next.runtime, FAKE_WASM_PAGE - next.runtime->heapTop - 16);
+    uint8_t* before = next.runtime->memory;
+    CHECK(wasmSlotMigrate(&prev, &next) == m3Err_none);
+    CHECK(next.runtime->memory != before);
+    CHECK_EQ(hubNew::get_peer_count(), MAX_PEERS);
+
+    wasmSlotFree(&prev);
+    wasmSlotFree(&next);
+}
+
+static void testRejectsOtherVersion() {
+    WasmSlot prev, next;
+    memset(&hubNew::state, 0, sizeof(hubNew::state));
+    CHECK(loadSlot(&prev, "future") == m3Err_none);
+    CHECK(loadSlot(&next, "new") == m3Err_none);
+
+    M3Result result = wasmSlotMigrate(&prev, &next);
+    CHECK(result != m3Err_none);
+    CHECK(result && strcmp(result, "restore rejected snapshot") == 0);
+    CHECK(!hubNew::is_running());
+    CHECK_EQ(hubNew::get_peer_count(), 0);
+
+    wasmSlotFree(&prev);
+    wasmSlotFree(&next);
+}
+
+static void testMissingExports() {
+    WasmSlot prev, next;
+    bringUpOld(&prev, 2);
+    CHECK(loadSlot(&next, "legacy") == m3Err_none);
+    CHECK(next.restore == NULL);
+
+    M3Result result = wasmSlotMigrate(&prev, &next);
+    CHECK(result && strcmp(result, "new module does not export restore") == 0);
+    // Nothing was taken from the old module
+    CHECK_EQ(hubOld::get_peer_count(), 2);
+
+    // And the other way round: nothing to snapshot
+    result = wasmSlotMigrate(&next, &prev);
+    CHECK(result && strcmp(result, "active module does not export snapshot") == 0);
+
+    wasmSlotFree(&prev);
+    wasmSlotFree(&next);
+}
+
+static void testLoadErrors() {
+    WasmSlot slot;
+    uint8_t* buf = (uint8_t*)malloc(4);
+    memcpy(buf, "nope", 4);
+    CHECK(wasmSlotLoad(&slot, buf, 4, 8192, 0, NULL) != m3Err_none);
+    CHECK(slot.runtime == NULL && slot.buf == NULL);
+}
+
+// Host cost of the handover, the part of completeModuleSwap() that is
+// reported as lastSwapPauseUs. Native code stands in for the interpreter.
+static void benchMigrate() {
+    const int rounds = 2000;
+    uint64_t total = 0;
+    for (int i = 0; i < rounds; i++) {
+        WasmSlot prev, next;
+        bringUpOld(&prev, MAX_PEERS);
+        memset(&hubNew::state, 0, sizeof(hubNew::state));
+        loadSlot(&next, "new");
+        uint64_t start = testNowNs();
+        CHECK(wasmSlotMigrate(&prev, &next) == m3Err_none);
+        total += testNowNs() - start;
+        wasmSlotFree(&prev);
+        wasmSlotFree(&next);
+    }
+    BENCH("migrate %d peers (%zu-byte snapshot): %.2f us per swap\n", MAX_PEERS,
+          sizeof(hubOld::SnapshotHeader) + MAX_PEERS * sizeof(hubOld::SnapshotPeer),
+          total / 1000.0 / rounds);
+}
+
+int main() {
+    fakeWasmRegister("old", oldExports);
+    fakeWasmRegister("new", newExports);
+    fakeWasmRegister("legacy", legacyExports);
+    fakeWasmRegister("future", futureExports);
+
+    testRoundTrip();
+    testMemoryMoves();
+    testRejectsOtherVersion();
+    testMissingExports();
+    testLoadErrors();
+    benchMigrate();
+    return testResult("test_wasm_slot");
+}
@@ -0,0 +1,252 @@
+/*
+ * PigeonHub host test - wire_codec.cpp
+ *
+ * v1 <-> v2 conversion of typical signaling, the WIRE_FLAG_RAW fallback,
+ * malformed v2 frames, flags and namespaces a client may not send, and
+ * wirePeek() on a truncated message. The benchmark
+ * reports parse/serialize cost per message and the v2 size against JSON.
+ */
+
+#include "host_test.h"
+#include "wire_codec.h"
+#include <string.h>
+
+#define FROM_ID   "0a1b2c3d4e5f60718293a4b5c6d7e8f901234567"
+#define TARGET_ID "fedcba98765432100123456789abcdef00112233"
+
+static const char OFFER[] =
+    "{\"type\":\"offer\",\"data\":{\"type\":\"offer\",\"sdp\":\"v=0\\r\\no=- 4611731400430051336 2 IN IP4 127.0.0.1\\r\\n"
+    "s=-\\r\\nt=0 0\\r\\na=group:BUNDLE 0\\r\\na=extmap-allow-mixed\\r\\na=msid-semantic: WMS\\r\\n"
+    "m=application 9 UDP/DTLS/SCTP webrtc-datachannel\\r\\nc=IN IP4 0.0.0.0\\r\\n"
+    "a=ice-ufrag:Hs7e\\r\\na=ice-pwd:3Ykd9vG0nTq8Qm6jJ5r2bA1c\\r\\na=ice-options:trickle\\r\\n"
+    "a=fingerprint:sha-256 6B:8B:5D:EA:59:04:20:23:29:C8:87:1C:CF:CC:78:0F:8B:F5:6A:5D:B4:3A:37:5E:"
+    "0C:AF:E5:59:13:B4:4E:1E\\r\\na=setup:actpass\\r\\na=mid:0\\r\\na=sctp-port:5000\\r\\n"
+    "a=max-message-size:262144\\r\\n\"},"
+    "\"networkName\":\"global\",\"fromPeerId\":\"" FROM_ID "\",\"targetPeerId\":\"" TARGET_ID "\","
+    "\"timestamp\":1729260000123}";
+
+static const char ICE[] =
+    "{\"type\":\"ice-candidate\",\"data\":{\"candidate\":\"candidate:842163049 1 udp 1677729535 "
+    "203.0.113.7 51234 typ srflx raddr 192.168.4.2 rport 51234 generation 0 ufrag Hs7e network-cost 999\","
+    "\"sdpMid\":\"0\",\"sdpMLineIndex\":0},\"networkName\":\"global\",\"fromPeerId\":\"" FROM_ID "\","
+    "\"targetPeerId\":\"" TARGET_ID "\",\"timestamp\":1729260000456}";
+
+static const char ANNOUNCE[] =
+    "{\"type\":\"announce\",\"data\":{\"peerId\":\"" FROM_ID "\",\"isHub\":false},"
+    "\"networkName\":\"global\",\"fromPeerId\":\"" FROM_ID "\",\"timestamp\":1729260000789}";
+
+static const char CUSTOM[] =
+    "{\"type\":\"chat\",\"data\":\"hi\",\"fromPeerId\":\"" FROM_ID "\",\"room\":7}";
+
+static const char* const SAMPLES[] = { OFFER, ICE, ANNOUNCE, CUSTOM };
+static const char* const SAMPLE_NAMES[] = { "offer", "ice-candidate", "announce", "raw (unknown type)" };
+#define SAMPLE_COUNT 4
+
+// JSON -> v2 -> JSON must reproduce the original for messages in canonical order
+static void testRoundTrip() {
+    for (int i = 0; i < SAMPLE_COUNT; i++) {
+        const char* json = SAMPLES[i];
+        size_t len = strlen(json);
+        WireMsg msg, decoded;
+        CHECK(wireParseJson(json, len, &msg));
+
+        uint8_t frame[2048];
+        size_t frameLen = wireEncode(&msg, frame, sizeof(frame));
+        CHECK_EQ(frameLen, wireEncodedSize(&msg));
+        CHECK(wireDecode(frame, frameLen, &decoded));
+        CHECK_EQ(decoded.type, msg.type);
+        CHECK_EQ(decoded.flags, msg.flags & ~WIRE_FLAGS_HUB_SET);
+        CHECK_EQ(decoded.timestamp, msg.timestamp);
+
+        // The hub stamps the sender it knows, as handlePeerFrame() does
+        if (msg.flags & WIRE_FLAG_FROM) {
+            memcpy(decoded.from, msg.from, WIRE_PEER_ID_LEN);
+            decoded.flags |= WIRE_FLAG_FROM;
+        }
+
+        char out[2048];
+        size_t outLen = wireRenderJson(&decoded, out, sizeof(out));
+        CHECK_EQ(outLen, wireJsonSize(&decoded));
+        CHECK_EQ(outLen, len);
+        CHECK(outLen == len && memcmp(out, json, len) == 0);
+    }
+}
+
+static void testFields() {
+    WireMsg msg;
+    CHECK(wireParseJson(OFFER, strlen(OFFER), &msg));
+    CHECK_EQ(msg.type, WIRE_OFFER);
+    CHECK_EQ(msg.flags, WIRE_FLAG_FROM | WIRE_FLAG_TARGET);
+    CHECK_EQ(msg.timestamp, 1729260000123ull);
+    CHECK(msg.nsLen == 6 && memcmp(msg.ns, "global", 6) == 0);
+    char hex[WIRE_PEER_ID_LEN * 2 + 1];
+    wireIdToHex(msg.target, hex);
+    CHECK(strcmp(hex, TARGET_ID) == 0);
+
+    // Unknown types and extra fields fall back to the verbatim message
+    CHECK(wireParseJson(CUSTOM, strlen(CUSTOM), &msg));
+    CHECK_EQ(msg.type, WIRE_OTHER);
+    CHECK(msg.flags & WIRE_FLAG_RAW);
+    CHECK(msg.flags & WIRE_FLAG_FROM);
+    CHECK(msg.blob == (const uint8_t*)CUSTOM);
+
+    // Short peer IDs and "system" senders
+    const char* shortId = "{\"type\":\"offer\",\"fromPeerId\":\"abc\"}";
+    CHECK(wireParseJson(shortId, strlen(shortId), &msg));
+    CHECK(msg.flags & WIRE_FLAG_RAW);
+    const char* system = "{\"type\":\"connected\",\"fromPeerId\":\"system\"}";
+    CHECK(wireParseJson(system, strlen(system), &msg));
+    CHECK_EQ(msg.flags, WIRE_FLAG_SYSTEM);
+
+    const char* hub = "{\"type\":\"announce\",\"data\":{\"isHub\":true}}";
+    CHECK(wireParseJson(hub, strlen(hub), &msg));
+    CHECK(msg.flags & WIRE_FLAG_HUB);
+
+    // Not JSON objects
+    CHECK(!wireParseJson("[1,2]", 5, &msg));
+    CHECK(!wireParseJson("{\"type\":\"offer\"", 15, &msg));
+    CHECK(!wireParseJson("", 0, &msg));
+}
+
+static void testMalformedFrames() {
+    WireMsg msg;
+    uint8_t frame[256];
+    CHECK(wireParseJson(ICE, strlen(ICE), &msg));
+    size_t len = wireEncode(&msg, frame, sizeof(frame));
+    CHECK(len > 0);
+    CHECK(wireDecode(frame, len, &msg));
+
+    CHECK(!wireDecode(frame, WIRE_HEADER_SIZE - 1, &msg));
+    frame[0] = 1;
+    CHECK(!wireDecode(frame, len, &msg));
+    frame[0] = WIRE_V2_VERSION;
+    frame[1] = WIRE_TYPE_COUNT;
+    CHECK(!wireDecode(frame, len, &msg));
+    frame[1] = WIRE_ICE_CANDIDATE;
+    frame[3] = 255;  // Namespace runs past the frame
+    CHECK(!wireDecode(frame, WIRE_HEADER_SIZE + 10, &msg));
+    frame[3] = 6;
+
+    // WIRE_OTHER must be raw, and raw needs a blob
+    frame[1] = WIRE_OTHER;
+    CHECK(!wireDecode(frame, len, &msg));
+    frame[2] |= WIRE_FLAG_RAW;
+    CHECK(wireDecode(frame, len, &msg));
+    CHECK(!wireDecode(frame, WIRE_HEADER_SIZE + 6, &msg));
+
+    // Encoding refuses a short buffer
+    CHECK(wireParseJson(ICE, strlen(ICE), &msg));
+    CHECK_EQ(wireEncode(&msg, frame, wireEncodedSize(&msg) - 1), 0);
+    char out[64];
+    CHECK_EQ(wireRenderJson(&msg, out, sizeof(out)), 0);
+}
+
+// A client can't claim to be the hub or another peer, and can't smuggle
+// JSON into v1 through the namespace
+static void testUntrustedFields() {
+    WireMsg msg;
+    uint8_t frame[512];
+    CHECK(wireParseJson(ICE, strlen(ICE), &msg));
+    msg.flags |= WIRE_FLAG_SYSTEM;
+    size_t len = wireEncode(&msg, frame, sizeof(frame));
+    CHECK(len > 0);
+    CHECK(frame[2] & WIRE_FLAG_SYSTEM);
+    CHECK(frame[2] & WIRE_FLAG_FROM);
+
+    WireMsg decoded;
+    CHECK(wireDecode(frame, len, &decoded));
+    CHECK_EQ(decoded.flags, WIRE_FLAG_TARGET);
+    uint8_t zero[WIRE_PEER_ID_LEN] = {0};
+    CHECK(memcmp(decoded.from, zero, WIRE_PEER_ID_LEN) == 0);
+    char out[512];
+    size_t outLen = wireRenderJson(&decoded, out, sizeof(out));
+    CHECK(outLen > 0);
+    out[outLen] = '\0';
+    CHECK(strstr(out, "fromPeerId") == NULL);
+    CHECK(wirePeek(frame, WIRE_HEADER_SIZE + 6, WIRE_V2, &decoded));
+    CHECK_EQ(decoded.flags, WIRE_FLAG_TARGET);
+
+    // Hub and raw flags are the client's to set
+    frame[2] |= WIRE_FLAG_HUB | WIRE_FLAG_RAW;
+    CHECK(wireDecode(frame, len, &decoded));
+    CHECK_EQ(decoded.flags, WIRE_FLAG_HUB | WIRE_FLAG_RAW | WIRE_FLAG_TARGET);
+    frame[2] &= ~(WIRE_FLAG_HUB | WIRE_FLAG_RAW);
+
+    // Namespace "global": any quote, backslash or control byte fails
+    const uint8_t bad[] = { '"', '\\', '\n', 0x00, 0x1f };
+    for (uint8_t b : bad) {
+        frame[WIRE_HEADER_SIZE + 2] = b;
+        CHECK(!wireDecode(frame, len, &decoded));
+        CHECK(!wirePeek(frame, WIRE_HEADER_SIZE + 6, WIRE_V2, &decoded));
+    }
+    frame[WIRE_HEADER_SIZE + 2] = 0x7f;
+    CHECK(wireDecode(frame, len, &decoded));
+    frame[WIRE_HEADER_SIZE + 2] = 0xc3;  // UTF-8 passes through
+    CHECK(wireDecode(frame, len, &decoded));
+}
+
+// Routing fields come out of the first bytes of a streamed offer
+static void testPeek() {
+    WireMsg msg;
+    const char* sdp = strstr(OFFER, "\"sdp\"");
+    size_t cut = sdp - OFFER + 40;
+    CHECK(wirePeek((const uint8_t*)OFFER, cut, WIRE_V1, &msg));
+    CHECK_EQ(msg.type, WIRE_OFFER);
+
+    // Routing fields before the SDP are found too
+    char reordered[2048];
+    int n = snprintf(reordered, sizeof(reordered),
+                     "{\"type\":\"offer\",\"targetPeerId\":\"%s\",\"networkName\":\"lab\",%s",
+                     TARGET_ID, strstr(OFFER, "\"data\""));
+    CHECK(wirePeek((const uint8_t*)reordered, n / 3, WIRE_V1, &msg));
+    CHECK(msg.flags & WIRE_FLAG_TARGET);
+    CHECK(msg.nsLen == 3 && memcmp(msg.ns, "lab", 3) == 0);
+
+    CHECK(wireParseJson(OFFER, strlen(OFFER), &msg));
+    uint8_t frame[2048];
+    wireEncode(&msg, frame, sizeof(frame));
+    WireMsg peeked;
+    CHECK(wirePeek(frame, WIRE_HEADER_SIZE + 6, WIRE_V2, &peeked));
+    CHECK(memcmp(peeked.target, msg.target, WIRE_PEER_ID_LEN) == 0);
+    CHECK(!wirePeek(frame, WIRE_HEADER_SIZE - 1, WIRE_V2, &peeked));
+}
+
+static void bench() {
+    const int rounds = 200000;
+    for (int i = 0; i < SAMPLE_COUNT; i++) {
+        const char* json = SAMPLES[i];
+        size_t len = strlen(json);
+        WireMsg msg;
+        uint8_t frame[2048];
+        char out[2048];
+        volatile size_t sink = 0;
+
+        uint64_t t0 = testNowNs();
+        for (int r = 0; r < rounds; r++) sink += wireParseJson(json, len, &msg);
+        uint64_t t1 = testNowNs();
+        for (int r = 0; r < rounds; r++) sink += wireEncode(&msg, frame, sizeof(frame));
+        uint64_t t2 = testNowNs();
+        size_t frameLen = wireEncode(&msg, frame, sizeof(frame));
+        for (int r = 0; r < rounds; r++) sink += wireDecode(frame, frameLen, &msg);
+        uint64_t t3 = testNowNs();
+        for (int r = 0; r < rounds; r++) sink += wireRenderJson(&msg, out, sizeof(out));
+        uint64_t t4 = testNowNs();
+        CHECK(sink > 0);
+
+        BENCH("%-18s json %4zu B  v2 %4zu B (%5.1f%%)  parse %6.1f ns  encode %5.1f ns  "
+              "decode %5.1f ns  render %6.1f ns\n",
+              SAMPLE_NAMES[i], len, frameLen, 100.0 * frameLen / len,
+              (double)(t1 - t0) / rounds, (double)(t2 - t1) / rounds,
+              (double)(t3 - t2) / rounds, (double)(t4 - t3) / rounds);
+    }
+}
+
+int main() {
+    testRoundTrip();
+    testFields();
+    testMalformedFrames();
+    testUntrustedFields();
+    testPeek();
+    bench();
+    return testResult("test_wire_codec");
+}
@@ -0,0 +1,156 @@
+/*
+ * PigeonHub host test - xor_distance.cpp
+ *
+ * xorClosest() against a full sort, then the discovery simulation behind
+ * DISCOVERY_K_MIN. Peers with random IDs join one at a time and each
+ * newcomer is introduced to its K closest peers; then a share of them leave
+ * at random, with no re-introduction. Reported per mesh size and K:
+ * introduction frames against full-namespace discovery, and how many of
+ * the remaining peers are cut off from the largest connected group.
+ *
+ * A hub introduces only among its own connections, so a namespace there
+ * holds at most MAX_CONNECTIONS peers, which main.cpp keeps within
+ * DISCOVERY_K_MESH. At that size DISCOVERY_K_MIN must be the smallest K
+ * that leaves under 0.5% of the survivors cut off.
+ */
+
+#include "host_test.h"
+#include "xor_distance.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#define K_MAX  8
+
+typedef std::vector<uint8_t> Id;
+
+static Id randomId(std::mt19937& rng) {
+    Id id(XOR_ID_LEN);
+    for (auto& b : id) b = rng();
+    return id;
+}
+
+static void testClosest() {
+    std::mt19937 rng(1);
+    for (int round = 0; round < 200; round++) {
+        size_t count = 1 + rng() % 40;
+        std::vector<Id> ids;
+        for (size_t i = 0; i < count; i++) ids.push_back(randomId(rng));
+        if (count > 3) ids[2] = ids[1];  // Equal IDs are allowed
+        Id target = randomId(rng);
+
+        std::vector<XorCandidate> candidates;
+        for (size_t i = 0; i < count; i++) candidates.push_back({ids[i].data(), (int)i});
+        size_t k = rng() % 10;
+        size_t got = xorClosest(target.data(), candidates.data(), count, k);
+        CHECK_EQ(got, std::min(k, count));
+
+        std::vector<int> order(count);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return xorCompare(target.data(), ids[a].data(), ids[b].data()) < 0;
+        });
+        for (size_t i = 0; i < got; i++) {
+            CHECK_EQ(xorCompare(target.data(), candidates[i].id, ids[order[i]].data()), 0);
+        }
+        // Everything past k is a permutation of the rest
+        std::vector<int> seen;
+        for (auto& c : candidates) seen.push_back(c.index);
+        std::sort(seen.begin(), seen.end());
+        for (size_t i = 0; i < count; i++) CHECK_EQ(seen[i], (int)i);
+    }
+
+    uint8_t a[XOR_ID_LEN] = {0}, b[XOR_ID_LEN] = {0}, t[XOR_ID_LEN] = {0};
+    b[XOR_ID_LEN - 1] = 1;
+    CHECK(xorCompare(t, a, b) < 0);
+    CHECK(xorCompare(t, b, a) > 0);
+    CHECK_EQ(xorCompare(t, a, a), 0);
+    t[0] = 0x80;  // Leading bit dominates
+    a[0] = 0x80;
+    b[0] = 0x00;
+    b[XOR_ID_LEN - 1] = 0;
+    CHECK(xorCompare(t, a, b) < 0);
+}
+
+static int findRoot(std::vector<int>& parent, int x) {
+    while (parent[x] != x) x = parent[x] = parent[parent[x]];
+    return x;
+}
+
+struct MeshResult {
+    uint64_t frames[K_MAX + 1];     // Introductions, two per pair
+    uint64_t survivors;
+    uint64_t cutOff[K_MAX + 1];     // Survivors outside the largest group
+    int splitRuns[K_MAX + 1];       // Runs where anyone was cut off
+};
+
+// One mesh: every newcomer's K_MAX closest, so each K is a prefix
+static void simulate(int n, double leaving, uint32_t seed, MeshResult* result) {
+    std::mt19937 rng(seed);
+    std::vector<Id> ids;
+    std::vector<std::vector<int>> closest(n);  // Nearest first, at most K_MAX
+    for (int i = 0; i < n; i++) {
+        ids.push_back(randomId(rng));
+        std::vector<XorCandidate> candidates;
+        for (int j = 0; j < i; j++) candidates.push_back({ids[j].data(), j});
+        size_t k = xorClosest(ids[i].data(), candidates.data(), candidates.size(), K_MAX);
+        for (size_t c = 0; c < k; c++) closest[i].push_back(candidates[c].index);
+    }
+
+    std::vector<bool> left(n, false);
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+    for (int i = 0; i < (int)(n * leaving); i++) left[order[i]] = true;
+    int remaining = n - (int)(n * leaving);
+    result->survivors += remaining;
+
+    for (int k = 1; k <= K_MAX; k++) {
+        std::vector<int> parent(n), size(n, 0);
+        std::iota(parent.begin(), parent.end(), 0);
+        for (int i = 0; i < n; i++) {
+            int links = std::min(k, (int)closest[i].size());
+            result->frames[k] += 2 * links;
+            for (int c = 0; c < links; c++) {
+                int j = closest[i][c];
+                if (!left[i] && !left[j]) parent[findRoot(parent, i)] = findRoot(parent, j);
+            }
+        }
+        int largest = 0;
+        for (int i = 0; i < n; i++) {
+            if (!left[i]) largest = std::max(largest, ++size[findRoot(parent, i)]);
+        }
+        result->cutOff[k] += remaining - largest;
+        if (remaining > largest) result->splitRuns[k]++;
+    }
+}
+
+static void benchMesh() {
+    const int sizes[] = { DISCOVERY_K_MESH, 50, 500, 5000 };
+    const int runs[] = { 1000, 200, 40, 4 };
+    const double leaving = 0.2;
+    BENCH("discovery by K closest, %d%% of peers leaving afterwards:\n", (int)(leaving * 100));
+    for (int s = 0; s < 4; s++) {
+        int n = sizes[s];
+        MeshResult r = {};
+        for (int run = 0; run < runs[s]; run++) simulate(n, leaving, 100 + run, &r);
+        if (n == DISCOVERY_K_MESH) {
+            CHECK(r.cutOff[DISCOVERY_K_MIN] * 200 < r.survivors);
+            CHECK(r.cutOff[DISCOVERY_K_MIN - 1] * 200 >= r.survivors);
+        }
+        BENCH("  n=%d (%d runs), full discovery %llu frames:\n", n, runs[s],
+              (unsigned long long)n * (n - 1));
+        for (int k = 1; k <= K_MAX; k++) {
+            BENCH("    K=%d: %8llu frames, %5.2f%% of survivors cut off, split in %3d%% of runs\n",
+                  k, (unsigned long long)(r.frames[k] / runs[s]),
+                  100.0 * r.cutOff[k] / r.survivors, 100 * r.splitRuns[k] / runs[s]);
+        }
+    }
+}
+
+int main() {
+    testClosest();
+    benchMesh();
+    return testResult("test_xor_distance");
+}
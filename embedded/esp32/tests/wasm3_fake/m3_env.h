@@ -0,0 +1,38 @@
+/*
+ * PigeonHub host tests - wasm3 stand-in internals (see wasm3.h)
+ */
+
+#ifndef PIGEONHUB_FAKE_M3_ENV_H
+#define PIGEONHUB_FAKE_M3_ENV_H
+
+#include "wasm3.h"
+
+#define FAKE_WASM_PAGE       65536
+#define FAKE_WASM_FUNCTIONS  16
+
+struct M3Environment {
+    int runtimes;
+};
+
+struct M3Module {
+    const FakeExport* exports;
+};
+
+struct M3Function {
+    IM3Runtime runtime;
+    const FakeExport* exp;
+    int32_t result;
+};
+
+struct M3Runtime {
+    uint32_t memoryLimit;  // Bytes, 0 = unlimited (as in wasm3)
+    void* userData;
+    IM3Module module;
+    uint8_t* memory;
+    uint32_t memorySize;
+    uint32_t heapTop;
+    M3Function functions[FAKE_WASM_FUNCTIONS];
+    int functionCount;
+};
+
+#endif // PIGEONHUB_FAKE_M3_ENV_H
@@ -0,0 +1,62 @@
+/*
+ * PigeonHub host tests - wasm3 stand-in
+ *
+ * The subset of the wasm3 API that wasm_slot.cpp uses, backed by native
+ * "modules": tables of exports that run against a per-runtime linear memory.
+ * It lets the slot and migration logic run on Linux without the wasm3
+ * sources; the module bytes passed to m3_ParseModule are the name of a table
+ * registered with fakeWasmRegister().
+ */
+
+#ifndef PIGEONHUB_FAKE_WASM3_H
+#define PIGEONHUB_FAKE_WASM3_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef const char* M3Result;
+#define m3Err_none ((M3Result)0)
+
+extern M3Result m3Err_functionLookupFailed;
+extern M3Result m3Err_trapOutOfBoundsMemoryAccess;
+
+typedef struct M3Environment* IM3Environment;
+typedef struct M3Runtime* IM3Runtime;
+typedef struct M3Module* IM3Module;
+typedef struct M3Function* IM3Function;
+
+// A native export: i32 arguments in, at most one i32 result out
+typedef M3Result (*FakeExportFn)(IM3Runtime runtime, const int32_t* args, int32_t* result);
+
+struct FakeExport {
+    const char* name;
+    FakeExportFn fn;
+    int argc;
+};
+
+// exports ends with a { NULL } entry; name must outlive the test
+void fakeWasmRegister(const char* name, const FakeExport* exports);
+
+// Module-side malloc: bumps a heap in linear memory, growing (and moving)
+// the memory like memory.grow. Returns 0 when memoryLimit would be exceeded.
+uint32_t fakeWasmAlloc(IM3Runtime runtime, uint32_t size);
+
+// Host pointer for [ptr, ptr + len), or NULL if out of bounds
+uint8_t* fakeWasmPtr(IM3Runtime runtime, uint32_t ptr, uint32_t len);
+
+IM3Environment m3_NewEnvironment(void);
+void m3_FreeEnvironment(IM3Environment env);
+IM3Runtime m3_NewRuntime(IM3Environment env, uint32_t stackSize, void* userData);
+void m3_FreeRuntime(IM3Runtime runtime);
+void* m3_GetUserData(IM3Runtime runtime);
+uint8_t* m3_GetMemory(IM3Runtime runtime, uint32_t* size, uint32_t index);
+
+M3Result m3_ParseModule(IM3Environment env, IM3Module* module, const uint8_t* bytes, uint32_t len);
+void m3_FreeModule(IM3Module module);
+M3Result m3_LoadModule(IM3Runtime runtime, IM3Module module);
+
+M3Result m3_FindFunction(IM3Function* function, IM3Runtime runtime, const char* name);
+M3Result m3_CallV(IM3Function function, ...);
+M3Result m3_GetResultsV(IM3Function function, ...);
+
+#endif // PIGEONHUB_FAKE_WASM3_H
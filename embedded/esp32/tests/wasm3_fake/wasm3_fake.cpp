@@ -0,0 +1,143 @@
+/*
+ * PigeonHub host tests - wasm3 stand-in
+ */
+
+#include "m3_env.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+M3Result m3Err_functionLookupFailed = "function lookup failed";
+M3Result m3Err_trapOutOfBoundsMemoryAccess = "[trap] out of bounds memory access";
+
+#define FAKE_WASM_MODULES 8
+
+struct FakeModuleEntry {
+    const char* name;
+    const FakeExport* exports;
+};
+
+static FakeModuleEntry registry[FAKE_WASM_MODULES];
+static int registryCount = 0;
+
+void fakeWasmRegister(const char* name, const FakeExport* exports) {
+    if (registryCount < FAKE_WASM_MODULES) registry[registryCount++] = { name, exports };
+}
+
+uint32_t fakeWasmAlloc(IM3Runtime runtime, uint32_t size) {
+    uint32_t ptr = (runtime->heapTop + 7) & ~7u;
+    if (size > UINT32_MAX - ptr) return 0;
+    uint32_t needed = ptr + size;
+    if (needed > runtime->memorySize) {
+        uint32_t grown = (needed + FAKE_WASM_PAGE - 1) / FAKE_WASM_PAGE * FAKE_WASM_PAGE;
+        if (runtime->memoryLimit && grown > runtime->memoryLimit) return 0;
+
+        // Always move, so callers that keep host pointers across a grow break
+        uint8_t* memory = (uint8_t*)calloc(1, grown);
+        if (!memory) return 0;
+        memcpy(memory, runtime->memory, runtime->memorySize);
+        memset(runtime->memory, 0xDD, runtime->memorySize);
+        free(runtime->memory);
+        runtime->memory = memory;
+        runtime->memorySize = grown;
+    }
+    runtime->heapTop = needed;
+    return ptr;
+}
+
+uint8_t* fakeWasmPtr(IM3Runtime runtime, uint32_t ptr, uint32_t len) {
+    if (ptr > runtime->memorySize || len > runtime->memorySize - ptr) return NULL;
+    return runtime->memory + ptr;
+}
+
+IM3Environment m3_NewEnvironment(void) {
+    return (IM3Environment)calloc(1, sizeof(M3Environment));
+}
+
+void m3_FreeEnvironment(IM3Environment env) {
+    free(env);
+}
+
+IM3Runtime m3_NewRuntime(IM3Environment env, uint32_t stackSize, void* userData) {
+    IM3Runtime runtime = (IM3Runtime)calloc(1, sizeof(M3Runtime));
+    if (!runtime) return NULL;
+    runtime->userData = userData;
+    runtime->heapTop = 1024;  // Keep 0 an invalid pointer, like a shadow stack would
+    env->runtimes++;
+    return runtime;
+}
+
+void m3_FreeRuntime(IM3Runtime runtime) {
+    if (runtime->module) m3_FreeModule(runtime->module);
+    free(runtime->memory);
+    free(runtime);
+}
+
+void* m3_GetUserData(IM3Runtime runtime) {
+    return runtime->userData;
+}
+
+uint8_t* m3_GetMemory(IM3Runtime runtime, uint32_t* size, uint32_t index) {
+    if (index != 0 || !runtime->memory) return NULL;
+    if (size) *size = runtime->memorySize;
+    return runtime->memory;
+}
+
+M3Result m3_ParseModule(IM3Environment env, IM3Module* module, const uint8_t* bytes, uint32_t len) {
+    for (int i = 0; i < registryCount; i++) {
+        if (strlen(registry[i].name) == len && memcmp(registry[i].name, bytes, len) == 0) {
+            *module = (IM3Module)calloc(1, sizeof(M3Module));
+            if (!*module) return "out of memory";
+            (*module)->exports = registry[i].exports;
+            return m3Err_none;
+        }
+    }
+    return "malformed module";
+}
+
+void m3_FreeModule(IM3Module module) {
+    free(module);
+}
+
+M3Result m3_LoadModule(IM3Runtime runtime, IM3Module module) {
+    if (runtime->module) return "runtime already has a module";
+    runtime->module = module;
+    runtime->memorySize = FAKE_WASM_PAGE;
+    runtime->memory = (uint8_t*)calloc(1, runtime->memorySize);
+    return runtime->memory ? m3Err_none : "out of memory";
+}
+
+M3Result m3_FindFunction(IM3Function* function, IM3Runtime runtime, const char* name) {
+    *function = NULL;
+    if (!runtime->module) return m3Err_functionLookupFailed;
+    for (const FakeExport* exp = runtime->module->exports; exp->name; exp++) {
+        if (strcmp(exp->name, name) != 0) continue;
+        if (runtime->functionCount == FAKE_WASM_FUNCTIONS) return "too many functions";
+        M3Function* fn = &runtime->functions[runtime->functionCount++];
+        fn->runtime = runtime;
+        fn->exp = exp;
+        fn->result = 0;
+        *function = fn;
+        return m3Err_none;
+    }
+    return m3Err_functionLookupFailed;
+}
+
+M3Result m3_CallV(IM3Function function, ...) {
+    int32_t args[8] = {0};
+    va_list ap;
+    va_start(ap, function);
+    for (int i = 0; i < function->exp->argc && i < 8; i++) args[i] = va_arg(ap, int32_t);
+    va_end(ap);
+    function->result = 0;
+    return function->exp->fn(function->runtime, args, &function->result);
+}
+
+M3Result m3_GetResultsV(IM3Function function, ...) {
+    va_list ap;
+    va_start(ap, function);
+    int32_t* out = va_arg(ap, int32_t*);
+    va_end(ap);
+    *out = function->result;
+    return m3Err_none;
+}